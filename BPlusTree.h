@@ -0,0 +1,823 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file BPlusTree.h
+ * @class BPlusTree
+ * @brief B+ tree template mapping keys to values.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 2.1
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Internal nodes hold up to ORDER - 1 keys and ORDER children, and leaves
+ *    up to ORDER - 1 keys and their values, all in fixed-size arrays inside
+ *    the node, so searching a node reads consecutive memory. ORDER is a
+ *    template parameter so nodes can be sized to cache lines or pages: a
+ *    leaf of <int, int> is about 8 * ORDER bytes. Nodes are searched with
+ *    NodeSearch, which compares int keys with SIMD. Nodes come from a
+ *    NodePool for each kind of node, never from new, and leaves are linked
+ *    both ways in key order, so iterators and ranges can walk the leaves
+ *    forward and backward.
+ * \n
+ * \n bulkLoad builds the tree bottom-up from keys already in order, as in
+ *    an index file: it fills each leaf to a fill factor in one pass, then
+ *    builds each level of internal nodes over the level below, with no
+ *    splits. A fill factor below 1 leaves room in every node, so later
+ *    inserts do not split at once.
+ * \n
+ * \n Every node but the root keeps at least MIN_KEYS keys. Inserting into
+ *    a full node splits it, and removing from a node at the minimum borrows
+ *    from or merges with a sibling, so every leaf stays at the same depth.
+ * \n
+ * \n Iterators stay valid until the tree is next changed. Keys are unique:
+ *    inserting a key already present leaves its value alone, as std::map
+ *    does.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef BPLUSTREE_H
+#define BPLUSTREE_H
+
+#include <iostream>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include "NodePool.h"
+#include "NodeSearch.h"
+
+/*!
+ * @brief B+ Tree implementation.
+ *
+ * @tparam KeyType Type of the keys in the tree.
+ * @tparam ValueType Type of the values associated with the keys. Must be default-constructible.
+ * @tparam ORDER Maximum children of an internal node. At least 3.
+ */
+template <typename KeyType, typename ValueType, int ORDER = 32>
+class BPlusTree {
+    static_assert(ORDER >= 3, "A B+ tree node needs room for at least 3 children");
+
+public:
+    static const int MAX_KEYS = ORDER - 1;  /*!< Most keys in a node. */
+    static const int MIN_KEYS = MAX_KEYS / 2; /*!< Fewest keys in a node other than the root. */
+
+private:
+    /*!
+     * @brief The part shared by both kinds of node.
+     * @details The key array has one spare slot, so a full node can take one
+     *    more key before it is split.
+     */
+    struct Node {
+        bool isLeaf; /*!< Indicates whether the node is a leaf node. */
+        int count; /*!< Number of keys in use. */
+        KeyType keys[MAX_KEYS + 1]; /*!< Keys stored in the node, in order. */
+
+        explicit Node(bool isLeaf) : isLeaf(isLeaf), count(0) {}
+    };
+
+    /*!
+     * @brief A node whose children hold keys below keys[0], from keys[0] to below keys[1], and so on.
+     */
+    struct InternalNode : Node {
+        Node* children[ORDER + 1]; /*!< count + 1 children. */
+
+        InternalNode() : Node(false) {}
+    };
+
+    /*!
+     * @brief A node holding keys and their values.
+     */
+    struct LeafNode : Node {
+        ValueType values[MAX_KEYS + 1]; /*!< Values associated with the keys. */
+        LeafNode* next; /*!< The leaf with the next greater keys, or nullptr. */
+        LeafNode* prev; /*!< The leaf with the next lesser keys, or nullptr. */
+
+        LeafNode() : Node(true), next(nullptr), prev(nullptr) {}
+    };
+
+    Node* root; /*!< Pointer to the root of the tree, or nullptr when empty. */
+    LeafNode* firstLeaf; /*!< The leaf with the least keys, where iteration starts. */
+    LeafNode* lastLeaf; /*!< The leaf with the greatest keys, where backward iteration starts. */
+    size_t keyCount; /*!< Number of keys in the tree. */
+    NodePool<LeafNode> leafPool;
+    NodePool<InternalNode> internalPool;
+
+public:
+    /*!
+     * @brief Position of one key and value, in key order.
+     *
+     * @tparam IS_CONST Whether the value may be changed through the iterator.
+     */
+    template <bool IS_CONST>
+    class IteratorBase {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+
+        IteratorBase() : tree(nullptr), leaf(nullptr), index(0) {}
+
+        /// @brief A const iterator can be made from a non-const one.
+        template <bool OTHER_CONST, typename = typename std::enable_if<IS_CONST || !OTHER_CONST>::type>
+        IteratorBase(const IteratorBase<OTHER_CONST>& other) : tree(other.tree), leaf(other.leaf), index(other.index) {}
+
+        const KeyType& key() const { return leaf->keys[index]; }
+
+        typename std::conditional<IS_CONST, const ValueType&, ValueType&>::type value() const {
+            return leaf->values[index];
+        }
+
+        IteratorBase& operator++() {
+            if (++index == leaf->count) {
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        IteratorBase operator++(int) {
+            IteratorBase before = *this;
+            ++*this;
+            return before;
+        }
+
+        /// @brief Moves to the next lesser key. end() moves to the greatest key.
+        IteratorBase& operator--() {
+            if (leaf == nullptr) {
+                leaf = tree->lastLeaf;
+                index = leaf->count - 1;
+            }
+            else if (index == 0) {
+                leaf = leaf->prev;
+                index = leaf->count - 1;
+            }
+            else {
+                index--;
+            }
+            return *this;
+        }
+
+        IteratorBase operator--(int) {
+            IteratorBase before = *this;
+            --*this;
+            return before;
+        }
+
+        bool operator==(const IteratorBase& other) const { return leaf == other.leaf && index == other.index; }
+        bool operator!=(const IteratorBase& other) const { return !(*this == other); }
+
+    private:
+        friend class BPlusTree;
+        template <bool> friend class IteratorBase;
+
+        const BPlusTree* tree; /*!< For stepping back from the end. */
+        LeafNode* leaf; /*!< nullptr at the end. */
+        int index;
+
+        IteratorBase(const BPlusTree* tree, LeafNode* leaf, int index) : tree(tree), leaf(leaf), index(index) {
+            if (this->leaf != nullptr && this->index == this->leaf->count) {
+                this->leaf = this->leaf->next; // Past the last key of a leaf is the start of the next
+                this->index = 0;
+            }
+        }
+    };
+
+    typedef IteratorBase<false> iterator;
+    typedef IteratorBase<true> const_iterator;
+
+    /*!
+     * @brief The keys from one iterator up to another, for range-based for loops.
+     * @details Walk it backward by decrementing end().
+     */
+    template <class Iterator>
+    struct RangeOf {
+        Iterator first; /*!< The first key in the range. */
+        Iterator last; /*!< Just past the last key in the range. */
+
+        Iterator begin() const { return first; }
+        Iterator end() const { return last; }
+        bool empty() const { return first == last; }
+    };
+
+    typedef RangeOf<iterator> Range;
+    typedef RangeOf<const_iterator> ConstRange;
+
+    /*!
+     * @brief Constructor for the B+ Tree.
+     */
+    BPlusTree() : root(nullptr), firstLeaf(nullptr), lastLeaf(nullptr), keyCount(0) {}
+
+    /*!
+     * @brief Destructor for the B+ Tree. The pools free the nodes.
+     */
+    ~BPlusTree() {}
+
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    /*!
+     * @brief Inserts a key-value pair into the B+ Tree.
+     *
+     * @param key The key to insert.
+     * @param value The value associated with the key.
+     * @return false if the key was already in the tree, whose value is then unchanged.
+     */
+    bool insert(const KeyType& key, const ValueType& value) {
+        if (!root) {
+            firstLeaf = leafPool.allocate();
+            lastLeaf = firstLeaf;
+            root = firstLeaf;
+        }
+
+        KeyType splitKey;
+        Node* splitRight = nullptr;
+        if (!insertKey(root, key, value, splitKey, splitRight)) {
+            return false;
+        }
+        keyCount++;
+
+        if (splitRight) {
+            // The root split, so the tree grows a level
+            InternalNode* newRoot = internalPool.allocate();
+            newRoot->count = 1;
+            newRoot->keys[0] = splitKey;
+            newRoot->children[0] = root;
+            newRoot->children[1] = splitRight;
+            root = newRoot;
+        }
+        return true;
+    }
+
+    /*!
+     * @brief Removes a key from the B+ Tree.
+     *
+     * @param key The key to remove.
+     * @return false if the key was not in the tree.
+     */
+    bool remove(const KeyType& key) {
+        if (!root || !removeKey(root, key)) {
+            return false;
+        }
+        keyCount--;
+
+        if (!root->isLeaf && root->count == 0) {
+            // The root's children merged into one, so the tree shrinks a level
+            InternalNode* oldRoot = static_cast<InternalNode*>(root);
+            root = oldRoot->children[0];
+            internalPool.release(oldRoot);
+        }
+        else if (root->isLeaf && root->count == 0) {
+            leafPool.release(static_cast<LeafNode*>(root));
+            root = nullptr;
+            firstLeaf = nullptr;
+            lastLeaf = nullptr;
+        }
+        return true;
+    }
+
+    /*!
+     * @brief Removes every key.
+     */
+    void clear() {
+        leafPool.clear();
+        internalPool.clear();
+        root = nullptr;
+        firstLeaf = nullptr;
+        lastLeaf = nullptr;
+        keyCount = 0;
+    }
+
+    /*!
+     * @brief Replaces the contents of the tree with keys already in ascending order, building it bottom-up.
+     *
+     * @param keys The keys, in strictly ascending order.
+     * @param values The value of each key, in the same order.
+     * @param fillFactor The share of each node's capacity to fill, from 0.5 to 1. Every
+     *      node still holds at least MIN_KEYS keys.
+     * @return false, leaving the tree empty, if the arrays differ in size or the keys are not in order.
+     */
+    bool bulkLoad(const std::vector<KeyType>& keys, const std::vector<ValueType>& values, double fillFactor = 1.0) {
+        clear();
+        if (keys.size() != values.size()) {
+            return false;
+        }
+        for (size_t i = 1; i < keys.size(); i++) {
+            if (!(keys[i - 1] < keys[i])) {
+                return false;
+            }
+        }
+        if (keys.empty()) {
+            return true;
+        }
+        fillFactor = std::min(1.0, std::max(0.5, fillFactor));
+
+        // The leaves, linked in order, and the least key under each node of the level being built
+        std::vector<Node*> level;
+        std::vector<KeyType> leastKeys;
+        size_t next = 0;
+        for (int count : groupSizes(keys.size(), static_cast<int>(fillFactor * MAX_KEYS + 0.5), MIN_KEYS, MAX_KEYS)) {
+            LeafNode* leaf = leafPool.allocate();
+            std::copy(keys.begin() + next, keys.begin() + next + count, leaf->keys);
+            std::copy(values.begin() + next, values.begin() + next + count, leaf->values);
+            leaf->count = count;
+            next += count;
+            if (lastLeaf) {
+                lastLeaf->next = leaf;
+                leaf->prev = lastLeaf;
+            } else {
+                firstLeaf = leaf;
+            }
+            lastLeaf = leaf;
+            level.push_back(leaf);
+            leastKeys.push_back(leaf->keys[0]);
+        }
+
+        // Each internal level separates its children by the least key under each child after the first
+        while (level.size() > 1) {
+            std::vector<Node*> parents;
+            std::vector<KeyType> parentLeastKeys;
+            next = 0;
+            for (int children : groupSizes(level.size(), static_cast<int>(fillFactor * ORDER + 0.5), MIN_KEYS + 1, ORDER)) {
+                InternalNode* parent = internalPool.allocate();
+                std::copy(level.begin() + next, level.begin() + next + children, parent->children);
+                std::copy(leastKeys.begin() + next + 1, leastKeys.begin() + next + children, parent->keys);
+                parent->count = children - 1;
+                parents.push_back(parent);
+                parentLeastKeys.push_back(leastKeys[next]);
+                next += children;
+            }
+            level.swap(parents);
+            leastKeys.swap(parentLeastKeys);
+        }
+        root = level[0];
+        keyCount = keys.size();
+        return true;
+    }
+
+    /*!
+     * @brief Finds a key.
+     *
+     * @return An iterator at the key, or end() if it is not in the tree.
+     */
+    iterator find(const KeyType& key) {
+        iterator it = lower_bound(key);
+        return (it != end() && !(key < it.key())) ? it : end();
+    }
+
+    const_iterator find(const KeyType& key) const {
+        return const_cast<BPlusTree*>(this)->find(key);
+    }
+
+    /*!
+     * @brief Finds the first key that is not less than key.
+     *
+     * @return An iterator at that key, or end() if every key is less.
+     */
+    iterator lower_bound(const KeyType& key) {
+        if (!root) {
+            return end();
+        }
+        LeafNode* leaf = findLeaf(key);
+        return iterator(this, leaf, lowerBoundInNode(leaf->keys, leaf->count, key));
+    }
+
+    const_iterator lower_bound(const KeyType& key) const {
+        return const_cast<BPlusTree*>(this)->lower_bound(key);
+    }
+
+    /*!
+     * @brief Finds the first key that is greater than key.
+     *
+     * @return An iterator at that key, or end() if no key is greater.
+     */
+    iterator upper_bound(const KeyType& key) {
+        if (!root) {
+            return end();
+        }
+        LeafNode* leaf = findLeaf(key);
+        return iterator(this, leaf, upperBoundInNode(leaf->keys, leaf->count, key));
+    }
+
+    const_iterator upper_bound(const KeyType& key) const {
+        return const_cast<BPlusTree*>(this)->upper_bound(key);
+    }
+
+    /*!
+     * @brief The keys from low to high, both included, in order.
+     */
+    Range range(const KeyType& low, const KeyType& high) {
+        Range keys = { lower_bound(low), upper_bound(high) };
+        if (high < low) {
+            keys.last = keys.first;
+        }
+        return keys;
+    }
+
+    ConstRange range(const KeyType& low, const KeyType& high) const {
+        Range keys = const_cast<BPlusTree*>(this)->range(low, high);
+        ConstRange constKeys = { keys.first, keys.last };
+        return constKeys;
+    }
+
+    /*!
+     * @brief Whether a key is in the tree.
+     */
+    bool contains(const KeyType& key) const {
+        return find(key) != end();
+    }
+
+    iterator begin() { return iterator(this, firstLeaf, 0); }
+    iterator end() { return iterator(this, nullptr, 0); }
+    const_iterator begin() const { return const_iterator(this, firstLeaf, 0); }
+    const_iterator end() const { return const_iterator(this, nullptr, 0); }
+
+    /*!
+     * @brief The number of keys in the tree.
+     */
+    size_t size() const { return keyCount; }
+
+    bool empty() const { return keyCount == 0; }
+
+    /*!
+     * @brief Bytes the node pools hold, including released nodes kept for reuse.
+     */
+    size_t memoryBytes() const { return leafPool.capacityBytes() + internalPool.capacityBytes(); }
+
+    /*!
+     * @brief Whether every node but the root holds MIN_KEYS to MAX_KEYS keys and every leaf is at the same depth.
+     * @details Walks the whole tree, so it is meant for tests.
+     */
+    bool isBalanced() const {
+        int leafDepth = -1;
+        return root == nullptr || isBalanced(root, 0, leafDepth);
+    }
+
+    /*!
+     * @brief Prints the B+ Tree.
+     */
+    void print() const {
+        printTree(root, 0);
+    }
+
+private:
+    /**
+     * @brief The position of the first key in a node that is not less than key.
+     * @details With int keys, NodeSearch compares them with SIMD.
+     */
+    static int lowerBoundInNode(const KeyType* keys, int count, const KeyType& key) {
+        return NodeSearch<KeyType>::lowerBound(keys, count, key);
+    }
+
+    /**
+     * @brief The position of the first key in a node that is greater than key.
+     */
+    static int upperBoundInNode(const KeyType* keys, int count, const KeyType& key) {
+        return NodeSearch<KeyType>::upperBound(keys, count, key);
+    }
+
+    /**
+     * @brief Splits items into groups of perGroup, then tops up a short last group so none has fewer than minimum.
+     * @details The last group borrows from the groups before it, each keeping at
+     *    least minimum. If they cannot spare enough, its items are spread over
+     *    them instead, each taking up to maximum, which always fits since
+     *    maximum is at least twice minimum less one. A single group may have
+     *    fewer than minimum: it becomes the root.
+     */
+    static std::vector<int> groupSizes(size_t items, int perGroup, int minimum, int maximum) {
+        perGroup = std::min(maximum, std::max(std::max(minimum, 1), perGroup));
+        std::vector<int> sizes(items / perGroup, perGroup);
+        int remainder = static_cast<int>(items % perGroup);
+        if (remainder > 0) {
+            sizes.push_back(remainder);
+        }
+        if (sizes.size() > 1 && sizes.back() < minimum) {
+            for (size_t i = sizes.size() - 1; i-- > 0 && sizes.back() < minimum;) {
+                int moved = std::min(minimum - sizes.back(), sizes[i] - minimum);
+                sizes[i] -= moved;
+                sizes.back() += moved;
+            }
+            if (sizes.back() < minimum) {
+                int rest = sizes.back();
+                sizes.pop_back();
+                for (size_t i = sizes.size(); i-- > 0 && rest > 0;) {
+                    int moved = std::min(rest, maximum - sizes[i]);
+                    sizes[i] += moved;
+                    rest -= moved;
+                }
+            }
+        }
+        return sizes;
+    }
+
+    /**
+     * @brief The child of an internal node whose keys would include key.
+     */
+    static int findChildIndex(const InternalNode* node, const KeyType& key) {
+        return upperBoundInNode(node->keys, node->count, key);
+    }
+
+    /**
+     * @brief Goes down from the root to the leaf whose keys would include key.
+     */
+    LeafNode* findLeaf(const KeyType& key) const {
+        Node* node = root;
+        while (!node->isLeaf) {
+            const InternalNode* internal = static_cast<const InternalNode*>(node);
+            node = internal->children[findChildIndex(internal, key)];
+        }
+        return static_cast<LeafNode*>(node);
+    }
+
+    /**
+     * @brief Inserts a key-value pair into the subtree of node, splitting nodes that overflow.
+     *
+     * @param node The node to start the insertion.
+     * @param key The key to insert.
+     * @param value The value associated with the key.
+     * @param splitKey Set, if node was split, to the least key of the new right node's subtree.
+     * @param splitRight Set, if node was split, to the new right node. Otherwise left alone.
+     * @return false if the key was already present.
+     */
+    bool insertKey(Node* node, const KeyType& key, const ValueType& value, KeyType& splitKey, Node*& splitRight) {
+        if (node->isLeaf) {
+            LeafNode* leaf = static_cast<LeafNode*>(node);
+            int index = lowerBoundInNode(leaf->keys, leaf->count, key);
+            if (index < leaf->count && !(key < leaf->keys[index])) {
+                return false;
+            }
+            std::copy_backward(leaf->keys + index, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+            std::move_backward(leaf->values + index, leaf->values + leaf->count, leaf->values + leaf->count + 1);
+            leaf->keys[index] = key;
+            leaf->values[index] = value;
+            leaf->count++;
+
+            if (leaf->count > MAX_KEYS) {
+                splitLeaf(leaf, splitKey, splitRight);
+            }
+            return true;
+        }
+
+        InternalNode* internal = static_cast<InternalNode*>(node);
+        int childIndex = findChildIndex(internal, key);
+        KeyType childSplitKey;
+        Node* childSplitRight = nullptr;
+        if (!insertKey(internal->children[childIndex], key, value, childSplitKey, childSplitRight)) {
+            return false;
+        }
+
+        if (childSplitRight) {
+            // Add the new child and the key separating it from its left sibling
+            std::copy_backward(internal->keys + childIndex, internal->keys + internal->count,
+                               internal->keys + internal->count + 1);
+            std::copy_backward(internal->children + childIndex + 1, internal->children + internal->count + 1,
+                               internal->children + internal->count + 2);
+            internal->keys[childIndex] = childSplitKey;
+            internal->children[childIndex + 1] = childSplitRight;
+            internal->count++;
+
+            if (internal->count > MAX_KEYS) {
+                splitInternal(internal, splitKey, splitRight);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Moves the upper half of an overfull leaf to a new leaf after it.
+     */
+    void splitLeaf(LeafNode* leaf, KeyType& splitKey, Node*& splitRight) {
+        LeafNode* right = leafPool.allocate();
+        int middle = leaf->count / 2;
+        right->count = leaf->count - middle;
+        std::copy(leaf->keys + middle, leaf->keys + leaf->count, right->keys);
+        std::move(leaf->values + middle, leaf->values + leaf->count, right->values);
+        leaf->count = middle;
+
+        right->next = leaf->next;
+        right->prev = leaf;
+        if (right->next) {
+            right->next->prev = right;
+        } else {
+            lastLeaf = right;
+        }
+        leaf->next = right;
+
+        splitKey = right->keys[0];
+        splitRight = right;
+    }
+
+    /**
+     * @brief Moves the upper half of an overfull internal node to a new node, and its middle key up.
+     */
+    void splitInternal(InternalNode* node, KeyType& splitKey, Node*& splitRight) {
+        InternalNode* right = internalPool.allocate();
+        int middle = node->count / 2;
+        right->count = node->count - middle - 1;
+        std::copy(node->keys + middle + 1, node->keys + node->count, right->keys);
+        std::copy(node->children + middle + 1, node->children + node->count + 1, right->children);
+        splitKey = node->keys[middle];
+        node->count = middle;
+        splitRight = right;
+    }
+
+    /**
+     * @brief Removes a key from the subtree of node, fixing children that fall below MIN_KEYS.
+     *
+     * @param node The node to start the removal.
+     * @param key The key to remove.
+     * @return false if the key was not present.
+     */
+    bool removeKey(Node* node, const KeyType& key) {
+        if (node->isLeaf) {
+            LeafNode* leaf = static_cast<LeafNode*>(node);
+            int index = lowerBoundInNode(leaf->keys, leaf->count, key);
+            if (index == leaf->count || key < leaf->keys[index]) {
+                return false;
+            }
+            std::copy(leaf->keys + index + 1, leaf->keys + leaf->count, leaf->keys + index);
+            std::move(leaf->values + index + 1, leaf->values + leaf->count, leaf->values + index);
+            leaf->count--;
+            return true;
+        }
+
+        InternalNode* internal = static_cast<InternalNode*>(node);
+        int childIndex = findChildIndex(internal, key);
+        if (!removeKey(internal->children[childIndex], key)) {
+            return false;
+        }
+        if (internal->children[childIndex]->count < MIN_KEYS) {
+            handleUnderflow(internal, childIndex);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Handles underflow of a node during removal.
+     *
+     * @param parentNode The parent node.
+     * @param childIndex The index of the child node.
+     */
+    void handleUnderflow(InternalNode* parentNode, int childIndex) {
+        Node* leftSibling = (childIndex > 0) ? parentNode->children[childIndex - 1] : nullptr;
+        Node* rightSibling = (childIndex < parentNode->count) ? parentNode->children[childIndex + 1] : nullptr;
+
+        if (leftSibling && leftSibling->count > MIN_KEYS) {
+            borrowFromLeftSibling(parentNode, childIndex);
+        } else if (rightSibling && rightSibling->count > MIN_KEYS) {
+            borrowFromRightSibling(parentNode, childIndex);
+        } else if (leftSibling) {
+            mergeChildren(parentNode, childIndex - 1);
+        } else if (rightSibling) {
+            mergeChildren(parentNode, childIndex);
+        }
+    }
+
+    /**
+     * @brief Moves the last key of the left sibling to the front of the child.
+     *
+     * @param parentNode The parent node.
+     * @param childIndex The index of the child node.
+     */
+    void borrowFromLeftSibling(InternalNode* parentNode, int childIndex) {
+        Node* child = parentNode->children[childIndex];
+        Node* left = parentNode->children[childIndex - 1];
+        std::copy_backward(child->keys, child->keys + child->count, child->keys + child->count + 1);
+
+        if (child->isLeaf) {
+            LeafNode* childLeaf = static_cast<LeafNode*>(child);
+            LeafNode* leftLeaf = static_cast<LeafNode*>(left);
+            std::move_backward(childLeaf->values, childLeaf->values + childLeaf->count,
+                               childLeaf->values + childLeaf->count + 1);
+            childLeaf->keys[0] = leftLeaf->keys[leftLeaf->count - 1];
+            childLeaf->values[0] = leftLeaf->values[leftLeaf->count - 1];
+            parentNode->keys[childIndex - 1] = childLeaf->keys[0];
+        } else {
+            // The separator comes down and the left sibling's last key goes up
+            InternalNode* childInternal = static_cast<InternalNode*>(child);
+            InternalNode* leftInternal = static_cast<InternalNode*>(left);
+            std::copy_backward(childInternal->children, childInternal->children + childInternal->count + 1,
+                               childInternal->children + childInternal->count + 2);
+            childInternal->keys[0] = parentNode->keys[childIndex - 1];
+            childInternal->children[0] = leftInternal->children[leftInternal->count];
+            parentNode->keys[childIndex - 1] = leftInternal->keys[leftInternal->count - 1];
+        }
+        child->count++;
+        left->count--;
+    }
+
+    /**
+     * @brief Moves the first key of the right sibling to the end of the child.
+     *
+     * @param parentNode The parent node.
+     * @param childIndex The index of the child node.
+     */
+    void borrowFromRightSibling(InternalNode* parentNode, int childIndex) {
+        Node* child = parentNode->children[childIndex];
+        Node* right = parentNode->children[childIndex + 1];
+
+        if (child->isLeaf) {
+            LeafNode* childLeaf = static_cast<LeafNode*>(child);
+            LeafNode* rightLeaf = static_cast<LeafNode*>(right);
+            childLeaf->keys[childLeaf->count] = rightLeaf->keys[0];
+            childLeaf->values[childLeaf->count] = std::move(rightLeaf->values[0]);
+            std::copy(rightLeaf->keys + 1, rightLeaf->keys + rightLeaf->count, rightLeaf->keys);
+            std::move(rightLeaf->values + 1, rightLeaf->values + rightLeaf->count, rightLeaf->values);
+            parentNode->keys[childIndex] = rightLeaf->keys[0];
+        } else {
+            // The separator comes down and the right sibling's first key goes up
+            InternalNode* childInternal = static_cast<InternalNode*>(child);
+            InternalNode* rightInternal = static_cast<InternalNode*>(right);
+            childInternal->keys[childInternal->count] = parentNode->keys[childIndex];
+            childInternal->children[childInternal->count + 1] = rightInternal->children[0];
+            parentNode->keys[childIndex] = rightInternal->keys[0];
+            std::copy(rightInternal->keys + 1, rightInternal->keys + rightInternal->count, rightInternal->keys);
+            std::copy(rightInternal->children + 1, rightInternal->children + rightInternal->count + 1,
+                      rightInternal->children);
+        }
+        child->count++;
+        right->count--;
+    }
+
+    /**
+     * @brief Merges the child at leftIndex with the child after it, releasing the right one.
+     *
+     * @param parentNode The parent node of the merging nodes.
+     * @param leftIndex The index of the left node within the parent's children.
+     */
+    void mergeChildren(InternalNode* parentNode, int leftIndex) {
+        Node* left = parentNode->children[leftIndex];
+        Node* right = parentNode->children[leftIndex + 1];
+
+        if (left->isLeaf) {
+            LeafNode* leftLeaf = static_cast<LeafNode*>(left);
+            LeafNode* rightLeaf = static_cast<LeafNode*>(right);
+            std::copy(rightLeaf->keys, rightLeaf->keys + rightLeaf->count, leftLeaf->keys + leftLeaf->count);
+            std::move(rightLeaf->values, rightLeaf->values + rightLeaf->count, leftLeaf->values + leftLeaf->count);
+            leftLeaf->count += rightLeaf->count;
+            leftLeaf->next = rightLeaf->next;
+            if (leftLeaf->next) {
+                leftLeaf->next->prev = leftLeaf;
+            } else {
+                lastLeaf = leftLeaf;
+            }
+            leafPool.release(rightLeaf);
+        } else {
+            // The separator comes down between the two halves
+            InternalNode* leftInternal = static_cast<InternalNode*>(left);
+            InternalNode* rightInternal = static_cast<InternalNode*>(right);
+            leftInternal->keys[leftInternal->count] = parentNode->keys[leftIndex];
+            std::copy(rightInternal->keys, rightInternal->keys + rightInternal->count,
+                      leftInternal->keys + leftInternal->count + 1);
+            std::copy(rightInternal->children, rightInternal->children + rightInternal->count + 1,
+                      leftInternal->children + leftInternal->count + 1);
+            leftInternal->count += rightInternal->count + 1;
+            internalPool.release(rightInternal);
+        }
+
+        std::copy(parentNode->keys + leftIndex + 1, parentNode->keys + parentNode->count, parentNode->keys + leftIndex);
+        std::copy(parentNode->children + leftIndex + 2, parentNode->children + parentNode->count + 1,
+                  parentNode->children + leftIndex + 1);
+        parentNode->count--;
+    }
+
+    /**
+     * @brief Checks the key counts in the subtree of node, and that its leaves are at leafDepth, or sets it at the first.
+     */
+    bool isBalanced(const Node* node, int depth, int& leafDepth) const {
+        if (node != root && (node->count < MIN_KEYS || node->count > MAX_KEYS)) {
+            return false;
+        }
+        if (node->isLeaf) {
+            if (leafDepth == -1) {
+                leafDepth = depth;
+            }
+            return depth == leafDepth;
+        }
+        const InternalNode* internal = static_cast<const InternalNode*>(node);
+        for (int i = 0; i <= internal->count; ++i) {
+            if (!isBalanced(internal->children[i], depth + 1, leafDepth)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void printTree(const Node* node, int level) const {
+        if (node) {
+            std::cout << "Level " << level << ": ";
+            for (int i = 0; i < node->count; ++i) {
+                std::cout << node->keys[i] << " ";
+            }
+            std::cout << std::endl;
+
+            if (!node->isLeaf) {
+                const InternalNode* internal = static_cast<const InternalNode*>(node);
+                for (int i = 0; i <= internal->count; ++i) {
+                    printTree(internal->children[i], level + 1);
+                }
+            }
+        }
+    }
+};
+
+#endif // BPLUSTREE_H
@@ -0,0 +1,250 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file BPlusTreeBenchmark.cpp
+ * @brief Compares BPlusTree of several orders with std::map on the ZIP codes.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Reads the ZIP codes of a CSV file, in the file's order, and for
+ *    std::map and BPlusTree<int, int, ORDER> of each order times inserting
+ *    every key into an empty tree, finding every key in a random order,
+ *    and iterating the whole tree. Before timing, each tree is checked to
+ *    iterate the same keys as the std::map.
+ * \n
+ * \n It then times building a BPlusTree<int, int> from keys in ascending
+ *    order, as an index is built from blocked_Index.txt, by inserting them
+ *    one at a time and by bulkLoad with fill factors of 1 and 0.7: for the
+ *    sorted ZIP codes and for synthetic keys of each --build-sizes size.
+ *    The node memory of each result goes to standard error.
+ * \n
+ * \n --copies n repeats the keys n times, each copy offset by 100000, to
+ *    see how the trees behave once they no longer fit in the cache.
+ * \n
+ * \n Usage: BPlusTreeBenchmark.exe [--file <csv>] [--copies n]
+ *    [--build-sizes a,b,c] [--warmup n] [--reps n] [--format csv|json]
+ * \n --file defaults to us_postal_codes_rand.csv, whose records are in a
+ *    random order. --build-sizes defaults to 10000000. Run from the
+ *    repository root.
+ * \n Results are named "<operation>/<tree>" and "build/<method>/<keys>",
+ *    per key.
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include "BenchmarkHarness.h"
+#include "BPlusTree.h"
+
+using namespace std;
+
+/// @brief The first field of every line after the header.
+static vector<int> readKeys(const string& fileName) {
+    vector<int> keys;
+    ifstream file(fileName);
+    string line;
+    getline(file, line);
+    while (getline(file, line)) {
+        if (!line.empty()) {
+            keys.push_back(atoi(line.c_str()));
+        }
+    }
+    return keys;
+}
+
+/// @brief Checks a tree against the std::map, then times insert, find and iteration.
+template <class Tree>
+static bool benchmarkTree(BenchmarkHarness& harness, const string& treeName, const vector<int>& keys,
+                          const vector<int>& targets, const map<int, int>& expected) {
+    Tree checked;
+    for (int key : keys) {
+        checked.insert(key, key);
+    }
+    bool same = checked.size() == expected.size();
+    auto expectedIt = expected.begin();
+    for (auto it = checked.begin(); same && it != checked.end(); ++it, ++expectedIt) {
+        same = it.key() == expectedIt->first && it.value() == expectedIt->second;
+    }
+    if (!same) {
+        cerr << "Error: " << treeName << " does not hold the same keys as std::map." << endl;
+        return false;
+    }
+
+    unique_ptr<Tree> tree;
+    harness.run("insert/" + treeName, keys.size(),
+        [&]() {
+            for (int key : keys) {
+                tree->insert(key, key);
+            }
+        },
+        [&]() { tree.reset(new Tree()); });
+    tree.reset();
+
+    harness.run("find/" + treeName, targets.size(), [&]() {
+        long long sum = 0;
+        for (int target : targets) {
+            sum += checked.find(target).value();
+        }
+        doNotOptimize(sum);
+    });
+
+    harness.run("iterate/" + treeName, keys.size(), [&]() {
+        long long sum = 0;
+        for (auto it = checked.begin(); it != checked.end(); ++it) {
+            sum += it.value();
+        }
+        doNotOptimize(sum);
+    });
+
+    cerr << treeName << ": " << checked.memoryBytes() / 1024 << " KiB of nodes for "
+         << checked.size() << " keys" << endl;
+    return true;
+}
+
+/// @brief Times building a tree from sorted keys by insertion and by bulk loading.
+static void benchmarkBuild(BenchmarkHarness& harness, const vector<int>& sortedKeys) {
+    typedef BPlusTree<int, int> Tree;
+    const string size = to_string(sortedKeys.size());
+    unique_ptr<Tree> tree;
+    auto report = [&](const string& name) {
+        cerr << name << "/" << size << ": " << tree->memoryBytes() / 1024 << " KiB of nodes" << endl;
+    };
+
+    harness.run("build/insert/" + size, sortedKeys.size(),
+        [&]() {
+            for (int key : sortedKeys) {
+                tree->insert(key, key);
+            }
+        },
+        [&]() { tree.reset(new Tree()); });
+    report("build/insert");
+
+    const double fillFactors[] = { 1.0, 0.7 };
+    for (double fillFactor : fillFactors) {
+        const string name = "build/bulkLoad" + to_string(static_cast<int>(fillFactor * 100));
+        harness.run(name + "/" + size, sortedKeys.size(),
+            [&]() { tree->bulkLoad(sortedKeys, sortedKeys, fillFactor); },
+            [&]() { tree.reset(new Tree()); });
+        report(name);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    string fileName = "us_postal_codes_rand.csv";
+    int copies = 1;
+    vector<long long> buildSizes = { 10000000 };
+    int warmupRuns = 2;
+    int repetitions = 20;
+    string format = "csv";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        if (flag == "--file") { fileName = argv[i + 1]; }
+        else if (flag == "--copies") { copies = max(1, atoi(argv[i + 1])); }
+        else if (flag == "--build-sizes") {
+            buildSizes.clear();
+            stringstream list(argv[i + 1]);
+            string size;
+            while (getline(list, size, ',')) {
+                buildSizes.push_back(atoll(size.c_str()));
+            }
+        }
+        else if (flag == "--warmup") { warmupRuns = atoi(argv[i + 1]); }
+        else if (flag == "--reps") { repetitions = atoi(argv[i + 1]); }
+        else if (flag == "--format") { format = argv[i + 1]; }
+        else {
+            cerr << "Error: Unknown option " << flag << endl;
+            return 1;
+        }
+    }
+
+    vector<int> zipCodes = readKeys(fileName);
+    if (zipCodes.empty()) {
+        cerr << "Error: No keys read from " << fileName << ". Run from the repository root." << endl;
+        return 1;
+    }
+    vector<int> keys;
+    for (int copy = 0; copy < copies; copy++) {
+        for (int zipCode : zipCodes) {
+            keys.push_back(zipCode + copy * 100000);
+        }
+    }
+
+    // Every key, in a different random order from the insertions
+    vector<int> targets = keys;
+    mt19937 random(337);
+    shuffle(targets.begin(), targets.end(), random);
+
+    map<int, int> expected;
+    BenchmarkHarness harness(warmupRuns, repetitions);
+    {
+        unique_ptr<map<int, int> > tree;
+        harness.run("insert/std::map", keys.size(),
+            [&]() {
+                for (int key : keys) {
+                    tree->insert(make_pair(key, key));
+                }
+            },
+            [&]() { tree.reset(new map<int, int>()); });
+
+        for (int key : keys) {
+            expected.insert(make_pair(key, key));
+        }
+        harness.run("find/std::map", targets.size(), [&]() {
+            long long sum = 0;
+            for (int target : targets) {
+                sum += expected.find(target)->second;
+            }
+            doNotOptimize(sum);
+        });
+        harness.run("iterate/std::map", keys.size(), [&]() {
+            long long sum = 0;
+            for (const auto& entry : expected) {
+                sum += entry.second;
+            }
+            doNotOptimize(sum);
+        });
+    }
+
+    bool correct = true;
+    correct = benchmarkTree<BPlusTree<int, int, 4> >(harness, "BPlusTree<4>", keys, targets, expected) && correct;
+    correct = benchmarkTree<BPlusTree<int, int, 8> >(harness, "BPlusTree<8>", keys, targets, expected) && correct;
+    correct = benchmarkTree<BPlusTree<int, int, 16> >(harness, "BPlusTree<16>", keys, targets, expected) && correct;
+    correct = benchmarkTree<BPlusTree<int, int, 32> >(harness, "BPlusTree<32>", keys, targets, expected) && correct;
+    correct = benchmarkTree<BPlusTree<int, int, 64> >(harness, "BPlusTree<64>", keys, targets, expected) && correct;
+    correct = benchmarkTree<BPlusTree<int, int, 128> >(harness, "BPlusTree<128>", keys, targets, expected) && correct;
+
+    vector<int> sortedKeys = keys;
+    sort(sortedKeys.begin(), sortedKeys.end());
+    sortedKeys.erase(unique(sortedKeys.begin(), sortedKeys.end()), sortedKeys.end());
+    benchmarkBuild(harness, sortedKeys);
+
+    uniform_int_distribution<int> anyGap(1, 100);
+    for (long long size : buildSizes) {
+        vector<int> synthetic(size);
+        int key = 0;
+        for (int& next : synthetic) {
+            key += anyGap(random);
+            next = key;
+        }
+        benchmarkBuild(harness, synthetic);
+    }
+
+    if (format == "json") {
+        harness.writeJSON(cout);
+    } else {
+        harness.writeCSV(cout);
+    }
+    return correct ? 0 : 1;
+}
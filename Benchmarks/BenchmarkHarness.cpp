@@ -0,0 +1,110 @@
+/// @file BenchmarkHarness.cpp
+/// @class BenchmarkHarness
+/// See BenchmarkHarness.h for full documentation.
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include "BenchmarkHarness.h"
+
+typedef std::chrono::steady_clock Clock;
+
+
+BenchmarkHarness::BenchmarkHarness(int warmupRuns, int repetitions)
+    : warmupRuns(std::max(0, warmupRuns)), repetitions(std::max(1, repetitions)) {
+}
+
+
+/// @brief Whether a benchmark passes the filter.
+bool BenchmarkHarness::isSelected(const std::string& name) const {
+    return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+
+/// @brief Runs and records one benchmark.
+bool BenchmarkHarness::run(const std::string& name, long long itemsPerRepetition,
+                           const std::function<void()>& body, const std::function<void()>& setup) {
+    if (!isSelected(name)) {
+        return false;
+    }
+    itemsPerRepetition = std::max(1LL, itemsPerRepetition);
+
+    for (int i = 0; i < warmupRuns; i++) {
+        if (setup) {
+            setup();
+        }
+        body();
+    }
+
+    std::vector<double> nsPerItem;
+    for (int i = 0; i < repetitions; i++) {
+        if (setup) {
+            setup();
+        }
+        Clock::time_point start = Clock::now();
+        body();
+        double elapsedNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        nsPerItem.push_back(elapsedNs / itemsPerRepetition);
+    }
+    std::sort(nsPerItem.begin(), nsPerItem.end());
+
+    Result result;
+    result.name = name;
+    result.itemsPerRepetition = itemsPerRepetition;
+    result.repetitions = repetitions;
+    result.minNs = nsPerItem.front();
+    result.maxNs = nsPerItem.back();
+    result.meanNs = 0;
+    for (double ns : nsPerItem) {
+        result.meanNs += ns;
+    }
+    result.meanNs /= nsPerItem.size();
+    result.p50Ns = percentile(nsPerItem, 0.50);
+    result.p90Ns = percentile(nsPerItem, 0.90);
+    result.p99Ns = percentile(nsPerItem, 0.99);
+    results.push_back(result);
+
+    std::cerr << name << ": " << result.p50Ns << " ns/item (p50)" << std::endl;
+    return true;
+}
+
+
+/// @brief Linearly interpolated percentile of sorted values.
+double BenchmarkHarness::percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    double position = fraction * (sorted.size() - 1);
+    size_t lower = static_cast<size_t>(position);
+    if (lower + 1 >= sorted.size()) {
+        return sorted.back();
+    }
+    return sorted[lower] + (position - lower) * (sorted[lower + 1] - sorted[lower]);
+}
+
+
+/// @brief Writes the results with a header line.
+void BenchmarkHarness::writeCSV(std::ostream& out) const {
+    out << "name,items_per_repetition,repetitions,min_ns,mean_ns,p50_ns,p90_ns,p99_ns,max_ns,items_per_s\n";
+    for (const Result& result : results) {
+        out << result.name << "," << result.itemsPerRepetition << "," << result.repetitions << ","
+            << result.minNs << "," << result.meanNs << "," << result.p50Ns << "," << result.p90Ns << ","
+            << result.p99Ns << "," << result.maxNs << "," << 1e9 / result.meanNs << "\n";
+    }
+}
+
+
+/// @brief Writes the settings and results as a JSON object.
+void BenchmarkHarness::writeJSON(std::ostream& out) const {
+    out << "{\n  \"warmup_runs\": " << warmupRuns << ",\n  \"repetitions\": " << repetitions << ",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& result = results[i];
+        out << (i == 0 ? "\n" : ",\n")
+            << "    {\"name\": \"" << result.name << "\", \"items_per_repetition\": " << result.itemsPerRepetition
+            << ", \"min_ns\": " << result.minNs << ", \"mean_ns\": " << result.meanNs
+            << ", \"p50_ns\": " << result.p50Ns << ", \"p90_ns\": " << result.p90Ns
+            << ", \"p99_ns\": " << result.p99Ns << ", \"max_ns\": " << result.maxNs
+            << ", \"items_per_s\": " << 1e9 / result.meanNs << "}";
+    }
+    out << "\n  ]\n}\n";
+}
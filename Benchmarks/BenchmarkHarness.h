@@ -0,0 +1,105 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file BenchmarkHarness.h
+ * @class BenchmarkHarness
+ * @brief Runs timed benchmarks with warmup and repetitions and reports percentiles.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Each benchmark is a body that performs a fixed number of operations
+ *    (items). The harness runs the body a number of warmup times untimed,
+ *    then times every repetition separately and converts each one to
+ *    nanoseconds per item, so the spread between repetitions is visible.
+ * \n
+ * \n An optional setup function runs untimed before every warmup run and
+ *    repetition, for work such as reopening a file or emptying a tree.
+ * \n
+ * \n Results can be written as CSV or JSON, one entry per benchmark:
+ * \n  -- name, items per repetition, repetitions
+ * \n  -- min, mean, p50, p90, p99 and max nanoseconds per item
+ * \n  -- items per second at the mean
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef BENCHMARKHARNESS_H
+#define BENCHMARKHARNESS_H
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Keeps the compiler from optimizing away a value that is otherwise unused.
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+class BenchmarkHarness {
+public:
+    /// @brief Timings of one benchmark, in nanoseconds per item.
+    struct Result {
+        std::string name;
+        long long itemsPerRepetition;
+        int repetitions;
+        double minNs;
+        double meanNs;
+        double p50Ns;
+        double p90Ns;
+        double p99Ns;
+        double maxNs;
+    };
+
+    /**
+     * @brief Construct a new Benchmark Harness object.
+     * @param warmupRuns Untimed runs before the repetitions.
+     * @param repetitions Timed runs of each benchmark.
+     */
+    BenchmarkHarness(int warmupRuns = 2, int repetitions = 20);
+
+    /// @brief Only runs benchmarks whose name contains the filter. Empty runs everything.
+    void setFilter(const std::string& filter) { this->filter = filter; }
+
+    /// @brief Whether a benchmark passes the filter, to skip its preparation when it does not.
+    bool isSelected(const std::string& name) const;
+
+    /**
+     * @brief Runs and records one benchmark.
+     * @param name The name of the benchmark, such as "BlockBuffer::readBlock".
+     * @param itemsPerRepetition The number of operations each call of body performs.
+     * @param body The timed work.
+     * @param setup Untimed work before each run, or nullptr.
+     * @return false if the benchmark was skipped by the filter.
+     */
+    bool run(const std::string& name, long long itemsPerRepetition,
+             const std::function<void()>& body, const std::function<void()>& setup = nullptr);
+
+    /// @brief Writes the results with a header line.
+    void writeCSV(std::ostream& out) const;
+
+    /// @brief Writes the settings and results as a JSON object.
+    void writeJSON(std::ostream& out) const;
+
+    const std::vector<Result>& getResults() const { return results; }
+
+    /**
+     * @brief Linearly interpolated percentile of sorted values.
+     * @param sorted Values in ascending order.
+     * @param fraction The percentile as a fraction, such as 0.99.
+     */
+    static double percentile(const std::vector<double>& sorted, double fraction);
+
+private:
+    int warmupRuns;
+    int repetitions;
+    std::string filter;
+    std::vector<Result> results;
+};
+
+#endif // BENCHMARKHARNESS_H
@@ -0,0 +1,150 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file BlockIndexBenchmark.cpp
+ * @brief Compares the BlockIndex search layouts on the real index and on large synthetic ones.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n For blocked_Index.txt and for synthetic indexes of each size given,
+ *    times BlockIndex::findBlock ("the first block whose greatest key is at
+ *    least the target") for random targets with each layout: SORTED
+ *    (std::lower_bound), EYTZINGER, STATIC_BTREE and LEARNED. Before
+ *    timing, every layout is checked to give the same answer as
+ *    std::lower_bound for every target. The number of segments in each
+ *    level of the learned index goes to standard error.
+ * \n
+ * \n Synthetic indexes have strictly increasing keys with random gaps of 1
+ *    to 100, like the greatest keys of a large blocked file.
+ * \n
+ * \n Usage: BlockIndexBenchmark.exe [--sizes a,b,c] [--queries n]
+ *    [--warmup n] [--reps n] [--format csv|json]
+ * \n --sizes defaults to 100000,1000000,10000000 and --queries, the targets
+ *    per repetition, to 100000. Run from the repository root.
+ * \n Results are named "findBlock/<layout>/<blocks>", in nanoseconds per
+ *    lookup.
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdlib>
+#include "BenchmarkHarness.h"
+#include "BlockIndex.h"
+
+using namespace std;
+
+const string BLOCK_INDEX_FILE = "blocked_Index.txt";
+
+/// @brief Checks every layout against std::lower_bound, then times each one.
+static bool benchmarkIndex(BenchmarkHarness& harness, BlockIndex& index, const vector<int>& targets) {
+    const vector<int>& keys = index.getGreatestKeys();
+    const BlockIndex::Layout layouts[] = { BlockIndex::SORTED, BlockIndex::EYTZINGER, BlockIndex::STATIC_BTREE, BlockIndex::LEARNED };
+
+    for (BlockIndex::Layout layout : layouts) {
+        index.setLayout(layout);
+        for (int target : targets) {
+            size_t expected = lower_bound(keys.begin(), keys.end(), target) - keys.begin();
+            if (index.lowerBound(target) != expected) {
+                cerr << "Error: " << BlockIndex::layoutName(layout) << " gives the wrong block for "
+                     << target << " in an index of " << index.size() << " blocks." << endl;
+                return false;
+            }
+        }
+        if (layout == BlockIndex::LEARNED) {
+            cerr << "Learned index of " << index.size() << " blocks: segments per level";
+            for (size_t segments : index.getLearnedLevelSizes()) {
+                cerr << " " << segments;
+            }
+            cerr << endl;
+        }
+
+        harness.run(string("findBlock/") + BlockIndex::layoutName(layout) + "/" + to_string(index.size()),
+                    targets.size(), [&]() {
+            long long sum = 0;
+            for (int target : targets) {
+                sum += index.findBlock(target);
+            }
+            doNotOptimize(sum);
+        });
+    }
+    return true;
+}
+
+/// @brief Random targets from just below the first key to just past the last.
+static vector<int> makeTargets(const vector<int>& keys, int count, mt19937& random) {
+    uniform_int_distribution<int> anyTarget(keys.front() - 1, keys.back() + 1);
+    vector<int> targets(count);
+    for (int& target : targets) {
+        target = anyTarget(random);
+    }
+    return targets;
+}
+
+int main(int argc, char* argv[]) {
+    vector<long long> sizes = { 100000, 1000000, 10000000 };
+    int queries = 100000;
+    int warmupRuns = 2;
+    int repetitions = 20;
+    string format = "csv";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        if (flag == "--sizes") {
+            sizes.clear();
+            stringstream list(argv[i + 1]);
+            string size;
+            while (getline(list, size, ',')) {
+                sizes.push_back(atoll(size.c_str()));
+            }
+        }
+        else if (flag == "--queries") { queries = max(1, atoi(argv[i + 1])); }
+        else if (flag == "--warmup") { warmupRuns = atoi(argv[i + 1]); }
+        else if (flag == "--reps") { repetitions = atoi(argv[i + 1]); }
+        else if (flag == "--format") { format = argv[i + 1]; }
+        else {
+            cerr << "Error: Unknown option " << flag << endl;
+            return 1;
+        }
+    }
+
+    BenchmarkHarness harness(warmupRuns, repetitions);
+    mt19937 random(331);
+    bool correct = true;
+
+    BlockIndex index;
+    if (index.load(BLOCK_INDEX_FILE) && !index.empty()) {
+        correct = benchmarkIndex(harness, index, makeTargets(index.getGreatestKeys(), queries, random)) && correct;
+    }
+    else {
+        cerr << "Warning: " << BLOCK_INDEX_FILE << " not loaded. Run from the repository root." << endl;
+    }
+
+    uniform_int_distribution<int> anyGap(1, 100);
+    for (long long size : sizes) {
+        vector<int> keys(size);
+        vector<long long> rbns(size);
+        int key = 0;
+        for (long long i = 0; i < size; i++) {
+            key += anyGap(random);
+            keys[i] = key;
+            rbns[i] = i + 1;
+        }
+        BlockIndex synthetic;
+        synthetic.assign(keys, rbns);
+        correct = benchmarkIndex(harness, synthetic, makeTargets(keys, queries, random)) && correct;
+    }
+
+    if (format == "json") {
+        harness.writeJSON(cout);
+    } else {
+        harness.writeCSV(cout);
+    }
+    return correct ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file BlockSizeBenchmark.cpp
+ * @brief Sweeps block sizes and fill factors for the blocked sequence set.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n For every combination of block size (512 B to 64 KiB) and fill factor,
+ *    the length-indicated source file is converted to a blocked file with
+ *    BlockWriter and then measured:
+ * \n  -- File size of the blocked file
+ * \n  -- Point-lookup latency of BlockSearch::searchForRecord
+ * \n  -- Scan throughput of reading every record with ZipCodeBuffer
+ * \n
+ * \n Results are printed as CSV, one row per configuration.
+ * \n
+ * \n Usage: BlockSizeBenchmark.exe [source file] [lookups per configuration]
+ * \n The source defaults to us_postal_codes.txt.
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include "HeaderBuffer.h"
+#include "ZipCodeBuffer.h"
+#include "BlockWriter.h"
+#include "BlockSearch.h"
+
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+/// @brief Milliseconds elapsed since the given start time.
+static double millisecondsSince(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+/// @brief Size of a file in bytes.
+static long long fileSize(const string& fileName) {
+    ifstream file(fileName, ios::binary | ios::ate);
+    return file.is_open() ? static_cast<long long>(file.tellg()) : -1;
+}
+
+int main(int argc, char* argv[]) {
+    string sourceFile = (argc > 1) ? argv[1] : "us_postal_codes.txt";
+    size_t numLookups = (argc > 2) ? stoul(argv[2]) : 500;
+
+    // Read the source records once
+    vector<string> records;
+    {
+        ifstream source(sourceFile);
+        if (!source.is_open()) {
+            cerr << "Error: Could not open " << sourceFile << endl;
+            return 1;
+        }
+        ZipCodeBuffer buffer(source, 'L', HeaderBuffer(sourceFile));
+        string record;
+        while (!(record = buffer.readNextRecordString()).empty()) {
+            records.push_back(record);
+        }
+    }
+    if (records.empty()) {
+        cerr << "Error: No records in " << sourceFile << endl;
+        return 1;
+    }
+
+    // Look up keys spread evenly through the file
+    vector<int> lookupKeys;
+    for (size_t i = 0; i < numLookups; i++) {
+        const string& record = records[(i * 7919) % records.size()];
+        lookupKeys.push_back(stoi(record.substr(0, record.find(','))));
+    }
+
+    const int blockSizes[] = { 512, 1024, 2048, 4096, 8192, 16384, 32768, 65536 };
+    const int fillPercents[] = { 50, 75, 90, 100 };
+    const string dataFile = "bench_blocked.txt";
+    const string indexFile = "bench_blocked_index.txt";
+
+    cout << "block_size,fill_percent,blocks,file_bytes,build_ms,lookup_us_avg,scan_ms,scan_records_per_s,scan_mb_per_s" << endl;
+
+    for (int blockSize : blockSizes) {
+        for (int fillPercent : fillPercents) {
+            // Generate the blocked file and its index
+            Clock::time_point start = Clock::now();
+            BlockWriter writer(dataFile, indexFile, blockSize, fillPercent);
+            for (const string& record : records) {
+                writer.addRecord(record);
+            }
+            writer.close();
+            double buildMs = millisecondsSince(start);
+            long long bytes = fileSize(dataFile);
+
+            // Point lookups through the block index
+            BlockSearch searcher(indexFile, dataFile);
+            size_t found = 0;
+            start = Clock::now();
+            for (int key : lookupKeys) {
+                if (searcher.searchForRecord(key) != "-1") {
+                    found++;
+                }
+            }
+            double lookupUs = millisecondsSince(start) * 1000.0 / lookupKeys.size();
+            if (found != lookupKeys.size()) {
+                cerr << "Warning: " << lookupKeys.size() - found << " lookups failed for block size "
+                     << blockSize << " at " << fillPercent << "% fill" << endl;
+            }
+
+            // Full scan of the sequence set in logical order
+            size_t scanned = 0;
+            start = Clock::now();
+            {
+                ifstream scanFile(dataFile, ios::binary);
+                ZipCodeBuffer buffer(scanFile, 'B', HeaderBuffer(dataFile));
+                while (!buffer.readNextRecord().zipCode.empty()) {
+                    scanned++;
+                }
+            }
+            double scanMs = millisecondsSince(start);
+
+            cout << blockSize << "," << fillPercent << "," << writer.getBlockCount() << "," << bytes << ","
+                 << buildMs << "," << lookupUs << "," << scanMs << ","
+                 << scanned / (scanMs / 1000.0) << "," << (bytes / 1048576.0) / (scanMs / 1000.0) << endl;
+        }
+    }
+
+    remove(dataFile.c_str());
+    remove(indexFile.c_str());
+    return 0;
+}
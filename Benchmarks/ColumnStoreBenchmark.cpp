@@ -0,0 +1,151 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file ColumnStoreBenchmark.cpp
+ * @brief Compares the state extrema table computed from parsed records and from a ColumnStore.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Builds the columns of --file, then times the extrema of every state,
+ *    as ZipCodeTableViewer shows them, computed:
+ * \n  -- rows: by reading and parsing every record with ZipCodeBuffer, as
+ *       the viewer does for C and L files
+ * \n  -- columns: by ColumnStore::stateExtrema over the mapped columns
+ * \n  -- columns/open: the same, after mapping the column file
+ * \n Both must give the same table, or the benchmark fails. The data file
+ *    bytes, column file bytes and states go to standard error.
+ * \n
+ * \n Usage: ColumnStoreBenchmark.exe [--file <file>] [--warmup n] [--reps n]
+ *    [--format csv|json]
+ * \n --file defaults to us_postal_codes_blocked.txt. Run from the
+ *    repository root. Results are per record.
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdlib>
+#include <sys/stat.h>
+#include "BenchmarkHarness.h"
+#include "ColumnStore.h"
+#include "ZipCodeBuffer.h"
+#include "HeaderBuffer.h"
+
+using namespace std;
+
+/// @brief The east, west, north and south ZIP codes of every state, by the viewer's row by row rules.
+static map<string, vector<string> > rowExtrema(const string& fileName) {
+    ifstream file(fileName, ios::binary);
+    HeaderBuffer headerBuffer(fileName);
+    char fileType = 'C';
+    if (fileName.find(".csv") == string::npos) {
+        headerBuffer.readHeader();
+        fileType = (headerBuffer.getBlockSize() == 0) ? 'L' : 'B';
+    }
+    ZipCodeBuffer buffer(file, fileType, headerBuffer);
+    map<string, vector<double> > coordinates;
+    map<string, vector<string> > zipCodes;
+    while (true) {
+        ZipCodeRecord record = buffer.readNextRecord();
+        if (record.zipCode == "") {
+            break;
+        }
+        auto found = coordinates.find(record.state);
+        if (found == coordinates.end()) {
+            coordinates[record.state] = { record.longitude, record.longitude, record.latitude, record.latitude };
+            zipCodes[record.state] = vector<string>(4, record.zipCode);
+            continue;
+        }
+        vector<double>& extrema = found->second;
+        if (record.longitude < extrema[0]) {
+            extrema[0] = record.longitude;
+            zipCodes[record.state][0] = record.zipCode;
+        }
+        else if (record.longitude > extrema[1]) {
+            extrema[1] = record.longitude;
+            zipCodes[record.state][1] = record.zipCode;
+        }
+        if (record.latitude > extrema[2]) {
+            extrema[2] = record.latitude;
+            zipCodes[record.state][2] = record.zipCode;
+        }
+        else if (record.latitude < extrema[3]) {
+            extrema[3] = record.latitude;
+            zipCodes[record.state][3] = record.zipCode;
+        }
+    }
+    return zipCodes;
+}
+
+/// @brief The same table from the columns.
+static map<string, vector<string> > columnExtrema(const ColumnStore& columns) {
+    map<string, vector<string> > zipCodes;
+    for (const ColumnStore::Extrema& extrema : columns.stateExtrema()) {
+        vector<string>& stateZipCodes = zipCodes[columns.stateName(extrema.state)];
+        for (uint32_t zipCode : extrema.zipCodes) {
+            stateZipCodes.push_back(to_string(zipCode));
+        }
+    }
+    return zipCodes;
+}
+
+int main(int argc, char* argv[]) {
+    string fileName = "us_postal_codes_blocked.txt";
+    int warmupRuns = 2;
+    int repetitions = 20;
+    string format = "csv";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        if (flag == "--file") { fileName = argv[i + 1]; }
+        else if (flag == "--warmup") { warmupRuns = atoi(argv[i + 1]); }
+        else if (flag == "--reps") { repetitions = atoi(argv[i + 1]); }
+        else if (flag == "--format") { format = argv[i + 1]; }
+        else {
+            cerr << "Error: Unknown option " << flag << endl;
+            return 1;
+        }
+    }
+
+    if (!ColumnStore::build(fileName)) {
+        return 1;
+    }
+    ColumnStore columns(fileName);
+    if (!columns.open()) {
+        return 1;
+    }
+    if (rowExtrema(fileName) != columnExtrema(columns)) {
+        cerr << "Error: The column extrema differ from the row extrema." << endl;
+        return 1;
+    }
+    struct stat status;
+    long long dataBytes = (stat(fileName.c_str(), &status) == 0) ? status.st_size : 0;
+    cerr << columns.rowCount() << " records, " << columns.stateCount() << " states, " << dataBytes
+         << " data bytes, " << columns.imageBytes() << " column bytes" << endl;
+
+    int rows = static_cast<int>(columns.rowCount());
+    BenchmarkHarness harness(warmupRuns, repetitions);
+    harness.run("rows", rows, [&]() {
+        doNotOptimize(rowExtrema(fileName).size());
+    });
+    harness.run("columns", rows, [&]() {
+        doNotOptimize(columns.stateExtrema().size());
+    });
+    harness.run("columns/open", rows, [&]() {
+        ColumnStore opened(fileName);
+        doNotOptimize(opened.open() ? opened.stateExtrema().size() : 0);
+    });
+
+    if (format == "json") {
+        harness.writeJSON(cout);
+    } else {
+        harness.writeCSV(cout);
+    }
+    return 0;
+}
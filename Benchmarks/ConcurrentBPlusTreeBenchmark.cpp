@@ -0,0 +1,162 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file ConcurrentBPlusTreeBenchmark.cpp
+ * @brief Measures ConcurrentBPlusTree throughput as threads are added, against BPlusTree behind a mutex.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Fills each tree with every even key below 2 * --keys, then for 1, 2,
+ *    4, ... threads up to --max-threads has every thread run --operations
+ *    random operations on random keys below 2 * --keys at the same time:
+ * \n  -- read_heavy: 95% find, 2.5% insert and 2.5% remove.
+ * \n  -- mixed: 50% find, 25% insert and 25% remove.
+ * \n The trees are ConcurrentBPlusTree<int, int> and BPlusTree<int, int>
+ *    with one std::mutex around every operation. Inserts and removes are
+ *    equally likely, so the trees stay about the same size.
+ * \n
+ * \n Usage: ConcurrentBPlusTreeBenchmark.exe [--keys n] [--operations n]
+ *    [--max-threads n]
+ * \n --keys defaults to 1000000, --operations, per thread, to 1000000,
+ *    and --max-threads to the number of hardware threads.
+ * \n Prints CSV: threads, workload, tree, operations, seconds, operations
+ *    per second, and the speedup over the same tree and workload on one
+ *    thread.
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include "BPlusTree.h"
+#include "ConcurrentBPlusTree.h"
+#include "BenchmarkHarness.h"
+
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+/// @brief Runs body on the given number of threads at once and returns the seconds taken.
+static double runThreads(int threads, const function<void(int)>& body) {
+    vector<thread> workers;
+    Clock::time_point start = Clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(thread(body, t));
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+/// @brief BPlusTree with one lock around every operation, the baseline.
+class LockedBPlusTree {
+public:
+    bool find(int key, int& value) {
+        lock_guard<mutex> lock(treeMutex);
+        BPlusTree<int, int>::iterator it = tree.find(key);
+        if (it == tree.end()) {
+            return false;
+        }
+        value = it.value();
+        return true;
+    }
+    bool insert(int key, int value) {
+        lock_guard<mutex> lock(treeMutex);
+        return tree.insert(key, value);
+    }
+    bool remove(int key) {
+        lock_guard<mutex> lock(treeMutex);
+        return tree.remove(key);
+    }
+
+private:
+    mutex treeMutex;
+    BPlusTree<int, int> tree;
+};
+
+/// @brief A small, fast random number generator, so the benchmark measures the trees.
+struct XorShift {
+    unsigned long long state;
+    explicit XorShift(unsigned long long seed) : state(seed * 0x9E3779B97F4A7C15ULL + 1) {}
+    unsigned long long next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+/// @brief Runs a workload with more and more threads, printing a CSV line for each.
+template <class Tree>
+static void benchmarkTree(const string& treeName, int keys, long long operations, int maxThreads) {
+    // Percent of operations that find, the rest split evenly between insert and remove
+    const pair<string, int> workloads[] = { make_pair(string("read_heavy"), 95), make_pair(string("mixed"), 50) };
+    for (const pair<string, int>& workload : workloads) {
+        Tree tree;
+        for (int key = 0; key < 2 * keys; key += 2) {
+            tree.insert(key, key);
+        }
+
+        double baseline = 0;
+        for (int threads = 1; ; threads = min(threads * 2, maxThreads)) {
+            double seconds = runThreads(threads, [&](int t) {
+                XorShift random(331 + t);
+                long long found = 0;
+                for (long long i = 0; i < operations; i++) {
+                    unsigned long long draw = random.next();
+                    int key = static_cast<int>((draw >> 8) % (2 * keys));
+                    int percent = static_cast<int>(draw % 100);
+                    if (percent < workload.second) {
+                        int value;
+                        found += tree.find(key, value);
+                    } else if (draw >> 63) {
+                        tree.insert(key, key);
+                    } else {
+                        tree.remove(key);
+                    }
+                }
+                doNotOptimize(found);
+            });
+            double rate = operations * threads / seconds;
+            if (threads == 1) {
+                baseline = rate;
+            }
+            cout << threads << "," << workload.first << "," << treeName << "," << operations * threads << ","
+                 << seconds << "," << rate << "," << rate / baseline << endl;
+            if (threads == maxThreads) {
+                break;
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int keys = 1000000;
+    long long operations = 1000000;
+    int maxThreads = max(1u, thread::hardware_concurrency());
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        if (flag == "--keys") { keys = max(1, atoi(argv[i + 1])); }
+        else if (flag == "--operations") { operations = max(1LL, atoll(argv[i + 1])); }
+        else if (flag == "--max-threads") { maxThreads = max(1, atoi(argv[i + 1])); }
+        else {
+            cerr << "Error: Unknown option " << flag << endl;
+            return 1;
+        }
+    }
+
+    cout << "threads,workload,tree,operations,seconds,ops_per_s,speedup" << endl;
+    benchmarkTree<ConcurrentBPlusTree<int, int> >("ConcurrentBPlusTree", keys, operations, maxThreads);
+    benchmarkTree<LockedBPlusTree>("BPlusTree+mutex", keys, operations, maxThreads);
+    return 0;
+}
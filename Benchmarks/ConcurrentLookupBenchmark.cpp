@@ -0,0 +1,142 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file ConcurrentLookupBenchmark.cpp
+ * @brief Measures lookup throughput of one shared ZipCodeStore as threads are added.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Opens one ZipCodeStore, reads its keys with a Cursor, then for 1, 2,
+ *    4, ... threads up to --max-threads has every thread look up
+ *    --lookups random keys in the shared store at the same time. The block
+ *    cache is warmed by one pass over the keys first, so the results show
+ *    how lookups scale with cores rather than with the disk.
+ * \n
+ * \n Usage: ConcurrentLookupBenchmark.exe [--file <file>] [--lookups n]
+ *    [--max-threads n] [--cursors]
+ * \n --lookups is per thread and defaults to 200000. --max-threads defaults
+ *    to the number of hardware threads. --cursors also measures every
+ *    thread scanning the whole file with its own Cursor.
+ * \n Prints CSV: threads, operation, operations, seconds, operations per
+ *    second, and the speedup over one thread.
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include <functional>
+#include "ZipCodeStore.h"
+#include "Benchmarks/BenchmarkHarness.h"
+
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+/// @brief Runs body on the given number of threads at once and returns the seconds taken.
+static double runThreads(int threads, const function<void(int)>& body) {
+    vector<thread> workers;
+    Clock::time_point start = Clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(thread(body, t));
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    string fileName = "us_postal_codes_blocked.txt";
+    long long lookupsPerThread = 200000;
+    int maxThreads = max(1u, thread::hardware_concurrency());
+    bool measureCursors = false;
+
+    for (int i = 1; i < argc; i++) {
+        string flag = argv[i];
+        if (flag == "--cursors") { measureCursors = true; }
+        else if (i + 1 < argc && flag == "--file") { fileName = argv[++i]; }
+        else if (i + 1 < argc && flag == "--lookups") { lookupsPerThread = max(1LL, atoll(argv[++i])); }
+        else if (i + 1 < argc && flag == "--max-threads") { maxThreads = max(1, atoi(argv[++i])); }
+        else {
+            cerr << "Error: Unknown option " << flag << endl;
+            return 1;
+        }
+    }
+
+    ZipCodeStore store(fileName);
+    if (!store.open()) {
+        return 1;
+    }
+
+    // Read every key once, which also warms the block cache
+    vector<int> keys;
+    {
+        ZipCodeStore::Cursor cursor = store.seek(0);
+        string record;
+        while (cursor.next(record)) {
+            keys.push_back(atoi(record.c_str()));
+        }
+    }
+    if (keys.empty()) {
+        cerr << "Error: " << fileName << " has no records." << endl;
+        return 1;
+    }
+
+    cout << "threads,operation,operations,seconds,ops_per_s,speedup" << endl;
+    double lookupBaseline = 0;
+    double scanBaseline = 0;
+    for (int threads = 1; ; threads = min(threads * 2, maxThreads)) {
+        vector<long long> misses(threads, 0);
+        double seconds = runThreads(threads, [&](int t) {
+            mt19937 random(331 + t);
+            uniform_int_distribution<size_t> anyKey(0, keys.size() - 1);
+            string record;
+            for (long long i = 0; i < lookupsPerThread; i++) {
+                if (!store.lookup(keys[anyKey(random)], record)) {
+                    misses[t]++;
+                }
+                doNotOptimize(record);
+            }
+        });
+        for (long long missed : misses) {
+            if (missed > 0) {
+                cerr << "Warning: " << missed << " lookups found no record." << endl;
+            }
+        }
+        double rate = lookupsPerThread * threads / seconds;
+        if (threads == 1) {
+            lookupBaseline = rate;
+        }
+        cout << threads << ",lookup," << lookupsPerThread * threads << "," << seconds << ","
+             << rate << "," << rate / lookupBaseline << endl;
+
+        if (measureCursors) {
+            seconds = runThreads(threads, [&](int) {
+                ZipCodeStore::Cursor cursor = store.seek(0);
+                string record;
+                while (cursor.next(record)) {
+                    doNotOptimize(record);
+                }
+            });
+            rate = static_cast<double>(keys.size()) * threads / seconds;
+            if (threads == 1) {
+                scanBaseline = rate;
+            }
+            cout << threads << ",cursor_scan," << keys.size() * threads << "," << seconds << ","
+                 << rate << "," << rate / scanBaseline << endl;
+        }
+
+        if (threads == maxThreads) {
+            break;
+        }
+    }
+    return 0;
+}
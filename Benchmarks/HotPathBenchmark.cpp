@@ -0,0 +1,261 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file HotPathBenchmark.cpp
+ * @brief Micro- and macro-benchmarks of every hot path, run through BenchmarkHarness.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Benchmarks, in nanoseconds per item:
+ * \n  -- ZipCodeBuffer::parseRecord on every record string
+ * \n  -- ZipCodeBuffer::readNextRecord scanning the C, L and B files
+ * \n  -- BlockBuffer::readBlock on random RBNs
+ * \n  -- BlockSearch::searchForRecord on random keys
+ * \n  -- BlockSearch::searchRange over random ranges of 100 ZIP codes
+ * \n  -- ZipCodeIndexer::createIndex and loadIndexFromRAM (per record)
+ * \n  -- BPlusTree insert and remove of random keys
+ * \n  -- HeaderBuffer::readHeader of the blocked file
+ * \n
+ * \n Usage: HotPathBenchmark.exe [--warmup n] [--reps n] [--filter name]
+ *    [--format csv|json] [--output file] [--latency text|json]
+ * \n With --latency, the per-query latency histograms of the lookup paths
+ *    (see LatencyHistogram.h) are also written to standard error.
+ * \n Run from the repository root, where the data files are. Results go to
+ *    standard output unless an output file is given; progress goes to
+ *    standard error.
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <random>
+#include <cstdio>
+#include "BenchmarkHarness.h"
+#include "HeaderBuffer.h"
+#include "ZipCodeBuffer.h"
+#include "ZipCodeIndexer.h"
+#include "BlockBuffer.h"
+#include "BlockSearch.h"
+#include "BPlusTree.h"
+#include "LatencyHistogram.h"
+
+using namespace std;
+
+const string CSV_FILE = "us_postal_codes.csv";
+const string LENGTH_INDICATED_FILE = "us_postal_codes.txt";
+const string BLOCKED_FILE = "us_postal_codes_blocked.txt";
+const string BLOCK_INDEX_FILE = "blocked_Index.txt";
+const string BENCH_INDEX_FILE = "bench_hot_path_index.txt";
+
+const int RANDOM_READS = 1000;      // Blocks read per readBlock repetition
+const int RANDOM_SEARCHES = 100;    // Keys searched per searchForRecord repetition
+const int TREE_KEYS = 10000;        // Keys inserted per BPlusTree repetition
+const int HEADER_READS = 100;       // Headers parsed per readHeader repetition
+
+/// @brief Reads every raw record string of a file.
+static vector<string> readRecordStrings(const string& fileName, char fileType) {
+    vector<string> records;
+    ifstream file(fileName, ios::binary);
+    ZipCodeBuffer buffer(file, fileType, HeaderBuffer(fileName));
+    string record;
+    while (!(record = buffer.readNextRecordString()).empty()) {
+        records.push_back(record);
+    }
+    return records;
+}
+
+/// @brief Benchmarks a full scan of one file with readNextRecord.
+static void benchmarkScan(BenchmarkHarness& harness, const string& fileName, char fileType, long long recordCount) {
+    unique_ptr<ifstream> file;
+    unique_ptr<ZipCodeBuffer> buffer;
+    harness.run(string("ZipCodeBuffer::readNextRecord/") + fileType, recordCount,
+        [&]() {
+            ZipCodeRecord record;
+            while (!(record = buffer->readNextRecord()).zipCode.empty()) {
+                doNotOptimize(record);
+            }
+        },
+        [&]() {
+            buffer.reset();
+            file.reset(new ifstream(fileName, ios::binary));
+            buffer.reset(new ZipCodeBuffer(*file, fileType, HeaderBuffer(fileName)));
+        });
+}
+
+int main(int argc, char* argv[]) {
+    int warmupRuns = 2;
+    int repetitions = 20;
+    string filter, format = "csv", outputFile, latencyFormat;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        if (flag == "--warmup") { warmupRuns = stoi(argv[i + 1]); }
+        else if (flag == "--reps") { repetitions = stoi(argv[i + 1]); }
+        else if (flag == "--filter") { filter = argv[i + 1]; }
+        else if (flag == "--format") { format = argv[i + 1]; }
+        else if (flag == "--output") { outputFile = argv[i + 1]; }
+        else if (flag == "--latency") { latencyFormat = argv[i + 1]; }
+        else {
+            cerr << "Error: Unknown option " << flag << endl;
+            return 1;
+        }
+    }
+
+    BenchmarkHarness harness(warmupRuns, repetitions);
+    harness.setFilter(filter);
+
+    vector<string> records = readRecordStrings(LENGTH_INDICATED_FILE, 'L');
+    if (records.empty()) {
+        cerr << "Error: No records in " << LENGTH_INDICATED_FILE << ". Run from the repository root." << endl;
+        return 1;
+    }
+    mt19937 random(331);
+
+    // Parsing alone, without I/O
+    {
+        ifstream file(LENGTH_INDICATED_FILE, ios::binary);
+        ZipCodeBuffer buffer(file, 'L', HeaderBuffer(LENGTH_INDICATED_FILE));
+        harness.run("ZipCodeBuffer::parseRecord", records.size(), [&]() {
+            for (const string& record : records) {
+                doNotOptimize(buffer.parseRecord(record));
+            }
+        });
+    }
+
+    // Sequential scans of each file type
+    benchmarkScan(harness, CSV_FILE, 'C', records.size());
+    benchmarkScan(harness, LENGTH_INDICATED_FILE, 'L', records.size());
+    benchmarkScan(harness, BLOCKED_FILE, 'B', records.size());
+
+    // Random block reads
+    if (harness.isSelected("BlockBuffer::readBlock")) {
+        HeaderBuffer header(BLOCKED_FILE);
+        header.readHeader();
+        uniform_int_distribution<long long> anyBlock(0, header.getRBNA() - 1);
+        vector<long long> rbns;
+        for (int i = 0; i < RANDOM_READS; i++) {
+            rbns.push_back(anyBlock(random));
+        }
+        ifstream file(BLOCKED_FILE, ios::binary);
+        BlockBuffer blockBuffer(file, header);
+        harness.run("BlockBuffer::readBlock", RANDOM_READS, [&]() {
+            for (long long rbn : rbns) {
+                doNotOptimize(blockBuffer.readBlock(rbn));
+            }
+        });
+    }
+
+    // Point lookups through the block index
+    {
+        vector<int> keys;
+        uniform_int_distribution<size_t> anyRecord(0, records.size() - 1);
+        for (int i = 0; i < RANDOM_SEARCHES; i++) {
+            const string& record = records[anyRecord(random)];
+            keys.push_back(stoi(record.substr(0, record.find(','))));
+        }
+        BlockSearch searcher(BLOCK_INDEX_FILE, BLOCKED_FILE);
+        harness.run("BlockSearch::searchForRecord", RANDOM_SEARCHES, [&]() {
+            for (int key : keys) {
+                doNotOptimize(searcher.searchForRecord(key));
+            }
+        });
+        harness.run("BlockSearch::searchRange", RANDOM_SEARCHES, [&]() {
+            for (int key : keys) {
+                doNotOptimize(searcher.searchRange(key, key + 99));
+            }
+        });
+    }
+
+    // Building and loading the length-indicated file's index
+    if (harness.isSelected("ZipCodeIndexer::createIndex") || harness.isSelected("ZipCodeIndexer::loadIndexFromRAM")) {
+        ifstream file(LENGTH_INDICATED_FILE, ios::binary);
+        HeaderBuffer header(LENGTH_INDICATED_FILE);
+        unique_ptr<ZipCodeIndexer> indexer;
+        harness.run("ZipCodeIndexer::createIndex", records.size(),
+            [&]() { indexer->createIndex(); },
+            [&]() {
+                file.clear();
+                file.seekg(0);
+                indexer.reset(new ZipCodeIndexer(file, 'L', BENCH_INDEX_FILE, header));
+            });
+        if (!indexer) {
+            indexer.reset(new ZipCodeIndexer(file, 'L', BENCH_INDEX_FILE, header));
+            indexer->createIndex();
+        }
+        indexer->writeIndexToFile();
+
+        harness.run("ZipCodeIndexer::loadIndexFromRAM", records.size(),
+            [&]() { indexer->loadIndexFromRAM(); },
+            [&]() {
+                file.clear();
+                file.seekg(0);
+                indexer.reset(new ZipCodeIndexer(file, 'L', BENCH_INDEX_FILE, header));
+            });
+        indexer.reset();
+        remove(BENCH_INDEX_FILE.c_str());
+    }
+
+    // The in-memory B+ tree
+    {
+        vector<int> keys;
+        for (int i = 0; i < TREE_KEYS; i++) {
+            keys.push_back(static_cast<int>(random() % 1000000));
+        }
+        unique_ptr<BPlusTree<int, int> > tree;
+        harness.run("BPlusTree::insert", TREE_KEYS,
+            [&]() {
+                for (int key : keys) {
+                    tree->insert(key, key);
+                }
+            },
+            [&]() { tree.reset(new BPlusTree<int, int>()); });
+
+        harness.run("BPlusTree::remove", TREE_KEYS,
+            [&]() {
+                for (int key : keys) {
+                    tree->remove(key);
+                }
+            },
+            [&]() {
+                tree.reset(new BPlusTree<int, int>());
+                for (int key : keys) {
+                    tree->insert(key, key);
+                }
+            });
+    }
+
+    // Parsing the metadata header
+    {
+        HeaderBuffer header(BLOCKED_FILE);
+        harness.run("HeaderBuffer::readHeader", HEADER_READS, [&]() {
+            for (int i = 0; i < HEADER_READS; i++) {
+                header.readHeader();
+                doNotOptimize(header.getBlockCount());
+            }
+        });
+    }
+
+    ofstream output;
+    if (!outputFile.empty()) {
+        output.open(outputFile);
+    }
+    ostream& out = outputFile.empty() ? cout : output;
+    if (format == "json") {
+        harness.writeJSON(out);
+    } else {
+        harness.writeCSV(out);
+    }
+
+    if (latencyFormat == "json") {
+        LatencyHistogram::writeAllJSON(cerr);
+    } else if (!latencyFormat.empty()) {
+        LatencyHistogram::printAll(cerr);
+    }
+    return 0;
+}
@@ -0,0 +1,152 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file LoadGenerator.cpp
+ * @brief Drives the query server with concurrent clients and reports throughput and latency.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Fetches the ZIP codes the server holds with one range request, then
+ *    opens the given number of connections, each on its own thread, and
+ *    sends requests for random ZIP codes as fast as the server answers:
+ *    single lookups, or batches when --batch is more than 1. Each request's
+ *    round trip is recorded in a LatencyHistogram, and the histograms of the
+ *    connections are merged at the end.
+ * \n
+ * \n Start the server first, for example:
+ * \n ZipCode.exe --serve us_postal_codes_blocked.txt
+ * \n
+ * \n Usage: LoadGenerator.exe [--socket <path>] [--connections n] [--requests n]
+ *    [--batch n] [--stop]
+ * \n --requests is per connection. --stop stops the server afterwards.
+ * \n Prints one CSV line: connections, batch, requests, lookups per second,
+ *    and the mean, p50, p99, p99.9 and max round trip in microseconds.
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include <unistd.h>
+#include "QueryProtocol.h"
+#include "LatencyHistogram.h"
+
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+/// @brief Sends one request and waits for its response.
+static bool roundTrip(int fd, const string& request, vector<string>& lines) {
+    string response;
+    return QueryProtocol::writeFrame(fd, request) && QueryProtocol::readFrame(fd, response)
+        && QueryProtocol::parseResponse(response, lines);
+}
+
+int main(int argc, char* argv[]) {
+    string socketPath = QueryProtocol::DEFAULT_SOCKET_PATH;
+    int connections = 4;
+    long long requestsPerConnection = 10000;
+    int batchSize = 1;
+    bool stopServer = false;
+
+    for (int i = 1; i < argc; i++) {
+        string flag = argv[i];
+        if (flag == "--stop") { stopServer = true; }
+        else if (i + 1 < argc && flag == "--socket") { socketPath = argv[++i]; }
+        else if (i + 1 < argc && flag == "--connections") { connections = max(1, atoi(argv[++i])); }
+        else if (i + 1 < argc && flag == "--requests") { requestsPerConnection = max(1LL, atoll(argv[++i])); }
+        else if (i + 1 < argc && flag == "--batch") { batchSize = max(1, atoi(argv[++i])); }
+        else {
+            cerr << "Error: Unknown option " << flag << endl;
+            return 1;
+        }
+    }
+
+    // Learn the keys from the server itself
+    vector<int> keys;
+    {
+        int fd = QueryProtocol::connectToServer(socketPath);
+        vector<string> records;
+        if (fd < 0 || !roundTrip(fd, "R 0 2147483647", records) || records.empty()) {
+            cerr << "Error: Could not read the keys from the server." << endl;
+            return 1;
+        }
+        for (const string& record : records) {
+            keys.push_back(atoi(record.c_str()));
+        }
+        ::close(fd);
+    }
+
+    vector<LatencyHistogram*> histograms;
+    vector<thread> workers;
+    vector<int> failures(connections, 0);
+    for (int c = 0; c < connections; c++) {
+        histograms.push_back(new LatencyHistogram());
+    }
+
+    Clock::time_point start = Clock::now();
+    for (int c = 0; c < connections; c++) {
+        workers.push_back(thread([&, c]() {
+            int fd = QueryProtocol::connectToServer(socketPath);
+            if (fd < 0) {
+                failures[c]++;
+                return;
+            }
+            mt19937 random(331 + c);
+            uniform_int_distribution<size_t> anyKey(0, keys.size() - 1);
+            vector<string> lines;
+
+            for (long long r = 0; r < requestsPerConnection; r++) {
+                string request = (batchSize == 1) ? "Z" : "B";
+                for (int b = 0; b < batchSize; b++) {
+                    request += " " + to_string(keys[anyKey(random)]);
+                }
+                Clock::time_point sent = Clock::now();
+                if (!roundTrip(fd, request, lines) || lines.size() != static_cast<size_t>(batchSize)) {
+                    failures[c]++;
+                }
+                histograms[c]->record(chrono::duration_cast<chrono::nanoseconds>(Clock::now() - sent).count());
+            }
+            ::close(fd);
+        }));
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+
+    LatencyHistogram merged;
+    int failed = 0;
+    for (int c = 0; c < connections; c++) {
+        merged.merge(*histograms[c]);
+        failed += failures[c];
+        delete histograms[c];
+    }
+    if (failed > 0) {
+        cerr << "Warning: " << failed << " requests failed." << endl;
+    }
+
+    long long totalRequests = requestsPerConnection * connections;
+    cout << "connections,batch,requests,lookups_per_s,mean_us,p50_us,p99_us,p999_us,max_us" << endl;
+    cout << connections << "," << batchSize << "," << totalRequests << "," << totalRequests * batchSize / seconds << ","
+         << merged.getMean() / 1000.0 << "," << merged.percentile(0.50) / 1000.0 << ","
+         << merged.percentile(0.99) / 1000.0 << "," << merged.percentile(0.999) / 1000.0 << ","
+         << merged.getMax() / 1000.0 << endl;
+
+    if (stopServer) {
+        int fd = QueryProtocol::connectToServer(socketPath);
+        vector<string> lines;
+        if (fd >= 0) {
+            roundTrip(fd, "S", lines);
+            ::close(fd);
+        }
+    }
+    return failed > 0 ? 1 : 0;
+}
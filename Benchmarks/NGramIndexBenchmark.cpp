@@ -0,0 +1,155 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file NGramIndexBenchmark.cpp
+ * @brief Measures NGramIndex fuzzy search of misspelled place names against scanning every name.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Misspells random place names of --file with one or two random edits,
+ *    a substitution, insertion, deletion or swap of neighbours, then times:
+ * \n  -- search/<edits>: NGramIndex::search of a misspelling, best 10
+ * \n  -- scan/<edits>: NGramIndex::editDistance from the misspelling to
+ *       every distinct place name, the search without an index
+ * \n How often the misspelled name is among the matches, the terms, the
+ *    trigrams and the index bytes go to standard error.
+ * \n
+ * \n Usage: NGramIndexBenchmark.exe [--file <file>] [--queries n]
+ *    [--warmup n] [--reps n] [--format csv|json]
+ * \n --file defaults to us_postal_codes.csv and --queries, per repetition,
+ *    to 1000; the scans run a tenth as many. Run from the repository root.
+ * \n Results are per query.
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdlib>
+#include "BenchmarkHarness.h"
+#include "NGramIndex.h"
+#include "SecondaryIndex.h"
+#include "ZipCodeBuffer.h"
+#include "HeaderBuffer.h"
+
+using namespace std;
+
+/// @brief The distinct normalized place names of a file.
+static vector<string> readPlaceTerms(const string& fileName) {
+    ifstream file(fileName, ios::binary);
+    HeaderBuffer headerBuffer(fileName);
+    char fileType = 'C';
+    if (fileName.find(".csv") == string::npos) {
+        headerBuffer.readHeader();
+        fileType = (headerBuffer.getBlockSize() == 0) ? 'L' : 'B';
+    }
+    ZipCodeBuffer buffer(file, fileType, headerBuffer);
+    set<string> placeTerms;
+    string record;
+    while (!(record = buffer.readNextRecordString()).empty()) {
+        placeTerms.insert(SecondaryIndex::placeTerm(buffer.parseRecord(record).placeName));
+    }
+    return vector<string>(placeTerms.begin(), placeTerms.end());
+}
+
+/// @brief A name with edits random changes of one letter each.
+static string misspell(string name, int edits, mt19937& random) {
+    uniform_int_distribution<int> anyLetter('a', 'z');
+    for (int e = 0; e < edits && name.size() > 1; e++) {
+        size_t at = uniform_int_distribution<size_t>(0, name.size() - 2)(random);
+        switch (random() % 4) {
+            case 0: name[at] = static_cast<char>(anyLetter(random)); break;
+            case 1: name.insert(name.begin() + at, static_cast<char>(anyLetter(random))); break;
+            case 2: name.erase(at, 1); break;
+            default: swap(name[at], name[at + 1]); break;
+        }
+    }
+    return name;
+}
+
+int main(int argc, char* argv[]) {
+    string fileName = "us_postal_codes.csv";
+    int queryCount = 1000;
+    int warmupRuns = 2;
+    int repetitions = 20;
+    string format = "csv";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        if (flag == "--file") { fileName = argv[i + 1]; }
+        else if (flag == "--queries") { queryCount = max(10, atoi(argv[i + 1])); }
+        else if (flag == "--warmup") { warmupRuns = atoi(argv[i + 1]); }
+        else if (flag == "--reps") { repetitions = atoi(argv[i + 1]); }
+        else if (flag == "--format") { format = argv[i + 1]; }
+        else {
+            cerr << "Error: Unknown option " << flag << endl;
+            return 1;
+        }
+    }
+
+    if (!NGramIndex::build(fileName)) {
+        return 1;
+    }
+    NGramIndex index(fileName);
+    if (!index.open()) {
+        return 1;
+    }
+    cerr << index.termCount() << " terms, " << index.gramCount() << " trigrams, " << index.imageBytes() << " bytes"
+         << endl;
+
+    vector<string> placeTerms = readPlaceTerms(fileName);
+    mt19937 random(1044);
+    uniform_int_distribution<size_t> anyName(0, placeTerms.size() - 1);
+
+    BenchmarkHarness harness(warmupRuns, repetitions);
+    for (int edits = 1; edits <= 2; edits++) {
+        vector<pair<string, string> > queries;     // Misspelling and the name it came from
+        for (int q = 0; q < queryCount; q++) {
+            const string& name = placeTerms[anyName(random)];
+            queries.push_back(make_pair(misspell(name, edits, random), name));
+        }
+
+        size_t found = 0;
+        for (const pair<string, string>& query : queries) {
+            for (const NGramIndex::Match& match : index.search(query.first, 10)) {
+                if (match.field == SecondaryIndex::PLACE && SecondaryIndex::placeTerm(match.name) == query.second) {
+                    found++;
+                    break;
+                }
+            }
+        }
+        cerr << edits << " edit(s): the name is among the matches of " << 100.0 * found / queries.size()
+             << "% of misspellings" << endl;
+
+        harness.run("search/" + to_string(edits), queryCount, [&]() {
+            size_t matches = 0;
+            for (const pair<string, string>& query : queries) {
+                matches += index.search(query.first, 10).size();
+            }
+            doNotOptimize(matches);
+        });
+        harness.run("scan/" + to_string(edits), queryCount / 10, [&]() {
+            int closest = 0;
+            for (int q = 0; q < queryCount / 10; q++) {
+                const string key = SecondaryIndex::normalize(queries[q].first);
+                for (const string& name : placeTerms) {
+                    closest += NGramIndex::editDistance(key, name) <= edits;
+                }
+            }
+            doNotOptimize(closest);
+        });
+    }
+
+    if (format == "json") {
+        harness.writeJSON(cout);
+    } else {
+        harness.writeCSV(cout);
+    }
+    return 0;
+}
@@ -0,0 +1,144 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file NodeSearchBenchmark.cpp
+ * @brief Compares the ways of searching the int keys of one B+ tree node, for each node size.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n For each node size, fills enough nodes of sorted random keys to make
+ *    about --keys keys in all, then times finding the lower bound of a
+ *    random target in a random node with std::lower_bound and with each
+ *    NodeSearchKernels counting kernel: scalar, SSE2, and AVX2 when the CPU
+ *    has it. Every kernel is first checked against std::lower_bound. The
+ *    kernel BPlusTree uses in this build goes to standard error.
+ * \n
+ * \n Usage: NodeSearchBenchmark.exe [--sizes a,b,c] [--keys n]
+ *    [--queries n] [--warmup n] [--reps n] [--format csv|json]
+ * \n --sizes defaults to 4,8,16,32,64,128,256, --keys to 65536, which fits
+ *    in the L2 cache so the search itself is measured, and --queries, per
+ *    repetition, to 100000.
+ * \n Results are named "nodeSearch/<method>/<keys per node>", in
+ *    nanoseconds per search.
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include "BenchmarkHarness.h"
+#include "NodeSearch.h"
+
+using namespace std;
+
+typedef int (*CountLess)(const int* keys, int count, int key);
+
+/// @brief Checks a kernel against std::lower_bound, then times it. A template so the kernel can be inlined.
+template <CountLess countLess>
+static bool benchmarkMethod(BenchmarkHarness& harness, const string& name, const vector<int>& keys,
+                            int nodeKeys, const vector<pair<int, int> >& queries) {
+    for (const pair<int, int>& query : queries) {
+        const int* node = &keys[static_cast<size_t>(query.first) * nodeKeys];
+        int expected = static_cast<int>(lower_bound(node, node + nodeKeys, query.second) - node);
+        if (countLess(node, nodeKeys, query.second) != expected) {
+            cerr << "Error: " << name << " gives the wrong position for " << query.second
+                 << " in a node of " << nodeKeys << " keys." << endl;
+            return false;
+        }
+    }
+
+    harness.run("nodeSearch/" + name + "/" + to_string(nodeKeys), queries.size(), [&]() {
+        long long sum = 0;
+        for (const pair<int, int>& query : queries) {
+            sum += countLess(&keys[static_cast<size_t>(query.first) * nodeKeys], nodeKeys, query.second);
+        }
+        doNotOptimize(sum);
+    });
+    return true;
+}
+
+/// @brief std::lower_bound in the same shape as the kernels.
+static int lowerBoundSearch(const int* keys, int count, int key) {
+    return static_cast<int>(lower_bound(keys, keys + count, key) - keys);
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> sizes = { 4, 8, 16, 32, 64, 128, 256 };
+    int totalKeys = 65536;
+    int queryCount = 100000;
+    int warmupRuns = 2;
+    int repetitions = 20;
+    string format = "csv";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        if (flag == "--sizes") {
+            sizes.clear();
+            stringstream list(argv[i + 1]);
+            string size;
+            while (getline(list, size, ',')) {
+                sizes.push_back(max(1, atoi(size.c_str())));
+            }
+        }
+        else if (flag == "--keys") { totalKeys = max(1, atoi(argv[i + 1])); }
+        else if (flag == "--queries") { queryCount = max(1, atoi(argv[i + 1])); }
+        else if (flag == "--warmup") { warmupRuns = atoi(argv[i + 1]); }
+        else if (flag == "--reps") { repetitions = atoi(argv[i + 1]); }
+        else if (flag == "--format") { format = argv[i + 1]; }
+        else {
+            cerr << "Error: Unknown option " << flag << endl;
+            return 1;
+        }
+    }
+
+    cerr << "BPlusTree searches int keys with the " << NodeSearchKernels::countLessName() << " kernel." << endl;
+
+    BenchmarkHarness harness(warmupRuns, repetitions);
+    mt19937 random(347);
+    uniform_int_distribution<int> anyGap(1, 100);
+    bool correct = true;
+
+    for (int nodeKeys : sizes) {
+        // Each node holds sorted keys with random gaps, like a leaf of ZIP codes
+        int nodes = max(1, totalKeys / nodeKeys);
+        vector<int> keys(static_cast<size_t>(nodes) * nodeKeys);
+        for (int n = 0; n < nodes; n++) {
+            int key = 0;
+            for (int k = 0; k < nodeKeys; k++) {
+                key += anyGap(random);
+                keys[static_cast<size_t>(n) * nodeKeys + k] = key;
+            }
+        }
+        uniform_int_distribution<int> anyNode(0, nodes - 1);
+        uniform_int_distribution<int> anyTarget(0, nodeKeys * 100 + 1);
+        vector<pair<int, int> > queries(queryCount);
+        for (pair<int, int>& query : queries) {
+            query = make_pair(anyNode(random), anyTarget(random));
+        }
+
+        correct = benchmarkMethod<lowerBoundSearch>(harness, "std::lower_bound", keys, nodeKeys, queries) && correct;
+        correct = benchmarkMethod<NodeSearchKernels::countLessScalar>(harness, "scalar", keys, nodeKeys, queries) && correct;
+#if defined(__SSE2__)
+        correct = benchmarkMethod<NodeSearchKernels::countLessSSE2>(harness, "sse2", keys, nodeKeys, queries) && correct;
+#endif
+#if defined(NODESEARCH_HAS_AVX2_KERNEL)
+        if (__builtin_cpu_supports("avx2")) {
+            correct = benchmarkMethod<NodeSearchKernels::countLessAVX2>(harness, "avx2", keys, nodeKeys, queries) && correct;
+        }
+#endif
+    }
+
+    if (format == "json") {
+        harness.writeJSON(cout);
+    } else {
+        harness.writeCSV(cout);
+    }
+    return correct ? 0 : 1;
+}
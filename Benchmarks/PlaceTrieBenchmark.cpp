@@ -0,0 +1,135 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file PlaceTrieBenchmark.cpp
+ * @brief Measures PlaceTrie prefix completion, opening, and memory per place name.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Builds the trie of --file, then times:
+ * \n  -- open: mapping the index file and checking its header
+ * \n  -- complete/<length>: the best --count completions of a random
+ *       prefix of that many characters of a random place name
+ * \n  -- lookup: the ZIP codes of a random whole place name
+ * \n The names, nodes, index bytes and bytes per distinct name go to
+ *    standard error.
+ * \n
+ * \n Usage: PlaceTrieBenchmark.exe [--file <file>] [--count n]
+ *    [--queries n] [--warmup n] [--reps n] [--format csv|json]
+ * \n --file defaults to us_postal_codes.csv, --count to 10 and --queries,
+ *    per repetition, to 10000. Run from the repository root.
+ * \n Results are named "open", "complete/<prefix length>" and "lookup",
+ *    per call.
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdlib>
+#include "BenchmarkHarness.h"
+#include "PlaceTrie.h"
+#include "ZipCodeBuffer.h"
+#include "HeaderBuffer.h"
+
+using namespace std;
+
+/// @brief The place name of every record of a file.
+static vector<string> readPlaceNames(const string& fileName) {
+    ifstream file(fileName, ios::binary);
+    HeaderBuffer headerBuffer(fileName);
+    char fileType = 'C';
+    if (fileName.find(".csv") == string::npos) {
+        headerBuffer.readHeader();
+        fileType = (headerBuffer.getBlockSize() == 0) ? 'L' : 'B';
+    }
+    ZipCodeBuffer buffer(file, fileType, headerBuffer);
+    vector<string> placeNames;
+    string record;
+    while (!(record = buffer.readNextRecordString()).empty()) {
+        placeNames.push_back(buffer.parseRecord(record).placeName);
+    }
+    return placeNames;
+}
+
+int main(int argc, char* argv[]) {
+    string fileName = "us_postal_codes.csv";
+    size_t count = 10;
+    int queryCount = 10000;
+    int warmupRuns = 2;
+    int repetitions = 20;
+    string format = "csv";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        if (flag == "--file") { fileName = argv[i + 1]; }
+        else if (flag == "--count") { count = max(1, atoi(argv[i + 1])); }
+        else if (flag == "--queries") { queryCount = max(1, atoi(argv[i + 1])); }
+        else if (flag == "--warmup") { warmupRuns = atoi(argv[i + 1]); }
+        else if (flag == "--reps") { repetitions = atoi(argv[i + 1]); }
+        else if (flag == "--format") { format = argv[i + 1]; }
+        else {
+            cerr << "Error: Unknown option " << flag << endl;
+            return 1;
+        }
+    }
+
+    if (!PlaceTrie::build(fileName)) {
+        return 1;
+    }
+    PlaceTrie trie(fileName);
+    if (!trie.open()) {
+        return 1;
+    }
+    cerr << trie.nameCount() << " names, " << trie.nodeCount() << " nodes, " << trie.imageBytes() << " bytes, "
+         << static_cast<double>(trie.imageBytes()) / trie.nameCount() << " bytes per name" << endl;
+
+    vector<string> placeNames = readPlaceNames(fileName);
+    mt19937 random(1043);
+    uniform_int_distribution<size_t> anyName(0, placeNames.size() - 1);
+
+    BenchmarkHarness harness(warmupRuns, repetitions);
+    harness.run("open", 1, [&]() {
+        PlaceTrie opened(fileName);
+        doNotOptimize(opened.open());
+    });
+
+    for (size_t length = 1; length <= 4; length++) {
+        vector<string> prefixes;
+        for (int q = 0; q < queryCount; q++) {
+            prefixes.push_back(placeNames[anyName(random)].substr(0, length));
+        }
+        harness.run("complete/" + to_string(length), queryCount, [&]() {
+            size_t completions = 0;
+            for (const string& prefix : prefixes) {
+                completions += trie.complete(prefix, count).size();
+            }
+            doNotOptimize(completions);
+        });
+    }
+
+    vector<string> names;
+    for (int q = 0; q < queryCount; q++) {
+        names.push_back(placeNames[anyName(random)]);
+    }
+    harness.run("lookup", queryCount, [&]() {
+        size_t found = 0;
+        vector<int> zipCodes;
+        for (const string& name : names) {
+            found += trie.lookup(name, zipCodes);
+        }
+        doNotOptimize(found);
+    });
+
+    if (format == "json") {
+        harness.writeJSON(cout);
+    } else {
+        harness.writeCSV(cout);
+    }
+    return 0;
+}
@@ -0,0 +1,201 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file RecordTableBenchmark.cpp
+ * @brief Compares the memory and speed of a RecordTable and a std::vector<ZipCodeRecord>.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Loads the records of --file, --copies times over, into a RecordTable
+ *    and into a std::vector<ZipCodeRecord>, then reports to standard error,
+ *    for each:
+ * \n  -- counted bytes: the RecordTable's memoryBytes, and for the vector
+ *       its capacity plus the heap blocks of strings too long for their
+ *       inline buffers
+ * \n  -- resident bytes: the growth of the process's resident memory, from
+ *       /proc/self/statm, while it was loaded
+ * \n Then it times:
+ * \n  -- table/load and vector/load: adding every record string
+ * \n  -- table/scan and vector/scan: counting the records of one state
+ * \n  -- table/find: finding a random ZIP code's record view
+ * \n
+ * \n Usage: RecordTableBenchmark.exe [--file <file>] [--copies n]
+ *    [--queries n] [--warmup n] [--reps n] [--format csv|json]
+ * \n --file defaults to us_postal_codes.csv, --copies to 1 and --queries,
+ *    per repetition, to 10000. Run from the repository root. Results are
+ *    per record, or per query for table/find.
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdlib>
+#include "BenchmarkHarness.h"
+#include "RecordTable.h"
+#include "ZipCodeBuffer.h"
+#include "HeaderBuffer.h"
+
+using namespace std;
+
+/// @brief Every record string of a file.
+static vector<string> readRecords(const string& fileName) {
+    ifstream file(fileName, ios::binary);
+    HeaderBuffer headerBuffer(fileName);
+    char fileType = 'C';
+    if (fileName.find(".csv") == string::npos) {
+        headerBuffer.readHeader();
+        fileType = (headerBuffer.getBlockSize() == 0) ? 'L' : 'B';
+    }
+    ZipCodeBuffer buffer(file, fileType, headerBuffer);
+    vector<string> records;
+    string record;
+    while (!(record = buffer.readNextRecordString()).empty()) {
+        records.push_back(record);
+    }
+    return records;
+}
+
+/// @brief Current resident memory in bytes, from /proc/self/statm.
+static long long residentBytes() {
+    ifstream statm("/proc/self/statm");
+    long long pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return resident * 4096;
+}
+
+/// @brief The bytes a string owns beyond its own object.
+static size_t heapBytes(const string& text) {
+    static const size_t inlineCapacity = string().capacity();
+    return text.capacity() > inlineCapacity ? text.capacity() + 1 : 0;
+}
+
+/// @brief The vector's capacity and every string's heap block.
+static size_t countedBytes(const vector<ZipCodeRecord>& records) {
+    size_t bytes = sizeof(records) + records.capacity() * sizeof(ZipCodeRecord);
+    for (const ZipCodeRecord& record : records) {
+        bytes += heapBytes(record.zipCode) + heapBytes(record.placeName) + heapBytes(record.state)
+               + heapBytes(record.county);
+    }
+    return bytes;
+}
+
+int main(int argc, char* argv[]) {
+    string fileName = "us_postal_codes.csv";
+    int copies = 1;
+    int queryCount = 10000;
+    int warmupRuns = 2;
+    int repetitions = 20;
+    string format = "csv";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        if (flag == "--file") { fileName = argv[i + 1]; }
+        else if (flag == "--copies") { copies = max(1, atoi(argv[i + 1])); }
+        else if (flag == "--queries") { queryCount = max(1, atoi(argv[i + 1])); }
+        else if (flag == "--warmup") { warmupRuns = atoi(argv[i + 1]); }
+        else if (flag == "--reps") { repetitions = atoi(argv[i + 1]); }
+        else if (flag == "--format") { format = argv[i + 1]; }
+        else {
+            cerr << "Error: Unknown option " << flag << endl;
+            return 1;
+        }
+    }
+
+    vector<string> fileRecords = readRecords(fileName);
+    if (fileRecords.empty()) {
+        cerr << "Error: No records in " << fileName << endl;
+        return 1;
+    }
+    vector<string> records;
+    for (int copy = 0; copy < copies; copy++) {
+        records.insert(records.end(), fileRecords.begin(), fileRecords.end());
+    }
+    ifstream unused;
+    ZipCodeBuffer parser(unused, 'C', HeaderBuffer(fileName));
+
+    // The table first, so the vector cannot reuse pages the table freed
+    long long before = residentBytes();
+    RecordTable table;
+    for (const string& record : records) {
+        table.addRecord(record);
+    }
+    long long tableResident = residentBytes() - before;
+
+    before = residentBytes();
+    vector<ZipCodeRecord> recordVector;
+    for (const string& record : records) {
+        recordVector.push_back(parser.parseRecord(record));
+    }
+    long long vectorResident = residentBytes() - before;
+
+    size_t vectorBytes = countedBytes(recordVector);
+    cerr << records.size() << " records, " << table.placeCount() << " places, " << table.countyCount()
+         << " counties, " << table.stateCount() << " states, " << table.arenaBytes() << " arena bytes" << endl;
+    cerr << "vector<ZipCodeRecord>: " << vectorBytes << " bytes counted, " << vectorResident << " bytes resident, "
+         << static_cast<double>(vectorBytes) / records.size() << " bytes per record" << endl;
+    cerr << "RecordTable: " << table.memoryBytes() << " bytes counted, " << tableResident << " bytes resident, "
+         << static_cast<double>(table.memoryBytes()) / records.size() << " bytes per record" << endl;
+
+    int recordCount = static_cast<int>(records.size());
+    BenchmarkHarness harness(warmupRuns, repetitions);
+    harness.run("table/load", recordCount, [&]() {
+        RecordTable loaded;
+        for (const string& record : records) {
+            loaded.addRecord(record);
+        }
+        doNotOptimize(loaded.size());
+    });
+    harness.run("vector/load", recordCount, [&]() {
+        vector<ZipCodeRecord> loaded;
+        for (const string& record : records) {
+            loaded.push_back(parser.parseRecord(record));
+        }
+        doNotOptimize(loaded.size());
+    });
+
+    const string state = "MN";
+    harness.run("table/scan", recordCount, [&]() {
+        // Compare ids, as the name is interned once
+        uint32_t wanted = static_cast<uint32_t>(table.stateId(state));
+        size_t count = 0;
+        for (RecordTable::RecordView record : table) {
+            count += (record.stateId() == wanted);
+        }
+        doNotOptimize(count);
+    });
+    harness.run("vector/scan", recordCount, [&]() {
+        size_t count = 0;
+        for (const ZipCodeRecord& record : recordVector) {
+            count += (record.state == state);
+        }
+        doNotOptimize(count);
+    });
+
+    mt19937 random(1048);
+    uniform_int_distribution<size_t> anyRecord(0, fileRecords.size() - 1);
+    vector<uint32_t> zipCodes;
+    for (int q = 0; q < queryCount; q++) {
+        zipCodes.push_back(static_cast<uint32_t>(atoi(fileRecords[anyRecord(random)].c_str())));
+    }
+    harness.run("table/find", queryCount, [&]() {
+        size_t found = 0;
+        for (uint32_t zipCode : zipCodes) {
+            RecordTable::Iterator record = table.find(zipCode);
+            found += (record != table.end()) ? (*record).placeName().size : 0;
+        }
+        doNotOptimize(found);
+    });
+
+    if (format == "json") {
+        harness.writeJSON(cout);
+    } else {
+        harness.writeCSV(cout);
+    }
+    return 0;
+}
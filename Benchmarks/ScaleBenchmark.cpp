@@ -0,0 +1,212 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file ScaleBenchmark.cpp
+ * @brief Measures ingest, index build, lookups and memory on synthetic datasets.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n For each dataset size, a synthetic dataset is generated with
+ *    RecordGenerator as a length-indicated file and as a blocked file, and
+ *    these stages are timed:
+ * \n  -- ingest: generating and writing the file
+ * \n  -- scan: reading every record with ZipCodeBuffer
+ * \n  -- index build: ZipCodeIndexer::createIndex and writeIndexToFile for
+ *       length-indicated files, or rebuilding the block index by reading
+ *       every block with BlockBuffer for blocked files
+ * \n  -- index load: ZipCodeIndexer::loadIndexFromRAM (blocked files search
+ *       the index file directly, so they have no load step)
+ * \n  -- lookup: average latency of ZipCodeIndexer plus ZipCodeBuffer, or of
+ *       BlockSearch::searchForRecord
+ * \n
+ * \n Resident memory is sampled after the index is loaded, along with the
+ *    peak for the whole process so far. Results are printed as CSV.
+ * \n
+ * \n Usage: ScaleBenchmark.exe [--sizes 1000000,10000000,100000000] [--lookups <count>]
+ *    [--keys dense|sparse|skewed] [--types LB] [--keep]
+ * \n Sizes default to 1000000. The 100M-record files take about 5 GB each.
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <sys/resource.h>
+#include "HeaderBuffer.h"
+#include "ZipCodeBuffer.h"
+#include "ZipCodeIndexer.h"
+#include "BlockBuffer.h"
+#include "BlockSearch.h"
+#include "RecordGenerator.h"
+
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+/// @brief Milliseconds elapsed since the given start time.
+static double millisecondsSince(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+/// @brief Size of a file in bytes.
+static long long fileSize(const string& fileName) {
+    ifstream file(fileName, ios::binary | ios::ate);
+    return file.is_open() ? static_cast<long long>(file.tellg()) : -1;
+}
+
+/// @brief Current resident memory in MiB, from /proc/self/statm.
+static double residentMiB() {
+    ifstream statm("/proc/self/statm");
+    long long pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return resident * 4096.0 / 1048576.0;
+}
+
+/// @brief Peak resident memory of the process in MiB.
+static double peakResidentMiB() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;
+}
+
+int main(int argc, char* argv[]) {
+    vector<long long> sizes;
+    size_t numLookups = 100;
+    string types = "LB";
+    bool keepFiles = false;
+    RecordGenerator::Settings settings;
+
+    for (int i = 1; i < argc; i++) {
+        string flag = argv[i];
+        if (flag == "--keep") {
+            keepFiles = true;
+        } else if (i + 1 < argc && flag == "--sizes") {
+            stringstream list(argv[++i]);
+            string size;
+            while (getline(list, size, ',')) {
+                sizes.push_back(stoll(size));
+            }
+        } else if (i + 1 < argc && flag == "--lookups") {
+            numLookups = stoul(argv[++i]);
+        } else if (i + 1 < argc && flag == "--keys") {
+            if (!RecordGenerator::parseKeyDistribution(argv[++i], settings.keyDistribution)) {
+                cerr << "Error: Unknown key distribution " << argv[i] << endl;
+                return 1;
+            }
+        } else if (i + 1 < argc && flag == "--types") {
+            types = argv[++i];
+        } else {
+            cerr << "Error: Unknown option " << flag << endl;
+            return 1;
+        }
+    }
+    if (sizes.empty()) {
+        sizes.push_back(1000000);
+    }
+
+    cout << "records,type,file_bytes,ingest_ms,scan_ms,index_build_ms,index_load_ms,lookup_us_avg,rss_mib,peak_rss_mib" << endl;
+
+    for (long long size : sizes) {
+        for (char fileType : types) {
+            settings.recordCount = size;
+            string dataFile = "scale_" + to_string(size) + "_" + fileType + ".txt";
+            string indexFile = dataFile + "_index.txt";
+
+            // Ingest: generate and write the dataset
+            Clock::time_point start = Clock::now();
+            RecordGenerator generator(settings);
+            if (generator.writeFile(dataFile, fileType, indexFile) < 0) {
+                return 1;
+            }
+            double ingestMs = millisecondsSince(start);
+            HeaderBuffer headerBuffer(dataFile);
+
+            // Scan every record, keeping an evenly spaced sample of keys to look up
+            vector<string> lookupKeys;
+            long long stride = max(1LL, size / static_cast<long long>(numLookups));
+            long long recordNumber = 0;
+            start = Clock::now();
+            {
+                ifstream file(dataFile, ios::binary);
+                ZipCodeBuffer buffer(file, fileType, headerBuffer);
+                ZipCodeRecord record;
+                while (!(record = buffer.readNextRecord()).zipCode.empty()) {
+                    if (recordNumber++ % stride == 0 && lookupKeys.size() < numLookups) {
+                        lookupKeys.push_back(record.zipCode);
+                    }
+                }
+            }
+            double scanMs = millisecondsSince(start);
+
+            double buildMs = 0, loadMs = 0, lookupUs = 0, rss = 0;
+            if (fileType == 'B') {
+                // Rebuild the block index the way block_idx_gen does
+                start = Clock::now();
+                {
+                    ifstream file(dataFile, ios::binary);
+                    ofstream index(indexFile);
+                    BlockBuffer blockBuffer(file, headerBuffer);
+                    vector<string> records;
+                    while (!(records = blockBuffer.readNextBlock()).empty()) {
+                        index << blockBuffer.getCurrentRBN() << "," << records.back().substr(0, records.back().find(',')) << "\n";
+                    }
+                }
+                buildMs = millisecondsSince(start);
+
+                BlockSearch searcher(indexFile, dataFile);
+                rss = residentMiB();
+                start = Clock::now();
+                for (const string& key : lookupKeys) {
+                    if (searcher.searchForRecord(stoi(key)) == "-1") {
+                        cerr << "Warning: key " << key << " was not found" << endl;
+                    }
+                }
+                lookupUs = millisecondsSince(start) * 1000.0 / max<size_t>(1, lookupKeys.size());
+            }
+            else {
+                ifstream file(dataFile, ios::binary);
+                ZipCodeIndexer indexer(file, fileType, indexFile, headerBuffer);
+                start = Clock::now();
+                indexer.createIndex();
+                indexer.writeIndexToFile();
+                buildMs = millisecondsSince(start);
+                file.close();
+
+                // Load the index fresh, as a search would
+                ifstream searchFile(dataFile, ios::binary);
+                ZipCodeIndexer loaded(searchFile, fileType, indexFile, headerBuffer);
+                start = Clock::now();
+                loaded.loadIndexFromRAM();
+                loadMs = millisecondsSince(start);
+                rss = residentMiB();
+
+                ZipCodeBuffer buffer(searchFile, fileType, headerBuffer);
+                start = Clock::now();
+                for (const string& key : lookupKeys) {
+                    buffer.setCurrentPosition(loaded.getRecordPosition(key));
+                    if (buffer.readNextRecord().zipCode != key) {
+                        cerr << "Warning: key " << key << " was not found" << endl;
+                    }
+                }
+                lookupUs = millisecondsSince(start) * 1000.0 / max<size_t>(1, lookupKeys.size());
+            }
+
+            cout << size << "," << fileType << "," << fileSize(dataFile) << "," << ingestMs << "," << scanMs << ","
+                 << buildMs << "," << loadMs << "," << lookupUs << "," << rss << "," << peakResidentMiB() << endl;
+
+            if (!keepFiles) {
+                remove(dataFile.c_str());
+                remove(indexFile.c_str());
+            }
+        }
+    }
+
+    return 0;
+}
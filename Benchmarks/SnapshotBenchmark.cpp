@@ -0,0 +1,175 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file SnapshotBenchmark.cpp
+ * @brief Measures the time to a first ZIP code lookup, from a Snapshot image and by building the index.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n For --file, and for length-indicated files of each of --sizes records
+ *    generated by RecordGenerator, times what the viewer does before it
+ *    prints the record of one ZIP code:
+ * \n  -- index/first: creating and writing the index with ZipCodeIndexer,
+ *       then opening a ZipCodeStore on it and looking the ZIP code up
+ * \n  -- snapshot/first: opening a Snapshot, which maps the image, and
+ *       looking the ZIP code up
+ * \n and, once per size:
+ * \n  -- snapshot/build: reading the file and writing its image
+ * \n  -- snapshot/verify: the content checksum open leaves out
+ * \n Each repetition looks up a different ZIP code. The files are in the
+ *    page cache after the first repetition, so this is the cost of starting
+ *    up, not of reading the disk. Generated files and the images and index
+ *    files written are removed at the end.
+ * \n
+ * \n Usage: SnapshotBenchmark.exe [--file <file>] [--sizes n,n,...]
+ *    [--warmup n] [--reps n] [--format csv|json]
+ * \n --file defaults to us_postal_codes.csv and --sizes to 1000000; 0 skips
+ *    the generated files. Run from the repository root. Results are per
+ *    lookup, or per record for snapshot/build and snapshot/verify.
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include "BenchmarkHarness.h"
+#include "Snapshot.h"
+#include "ZipCodeIndexer.h"
+#include "ZipCodeStore.h"
+#include "ZipCodeBuffer.h"
+#include "HeaderBuffer.h"
+#include "RecordGenerator.h"
+
+using namespace std;
+
+/// @brief The type of a file, found the same way ZipCodeTableViewer does.
+static char fileTypeOf(const string& fileName, HeaderBuffer& headerBuffer) {
+    if (fileName.find(".csv") != string::npos) {
+        return 'C';
+    }
+    headerBuffer.readHeader();
+    return (headerBuffer.getBlockSize() == 0) ? 'L' : 'B';
+}
+
+/// @brief Every ZIP code of a file, in file order.
+static vector<int> readZipCodes(const string& fileName) {
+    HeaderBuffer headerBuffer(fileName);
+    char fileType = fileTypeOf(fileName, headerBuffer);
+    ifstream file(fileName, ios::binary);
+    ZipCodeBuffer buffer(file, fileType, headerBuffer);
+    vector<int> zipCodes;
+    string record;
+    while (!(record = buffer.readNextRecordString()).empty()) {
+        zipCodes.push_back(atoi(record.c_str()));
+    }
+    return zipCodes;
+}
+
+/// @brief Runs every benchmark of one file. Returns false if a lookup failed.
+static bool benchmarkFile(BenchmarkHarness& harness, const string& fileName, const string& label) {
+    vector<int> zipCodes = readZipCodes(fileName);
+    if (zipCodes.empty()) {
+        cerr << "Error: No records in " << fileName << endl;
+        return false;
+    }
+    HeaderBuffer headerBuffer(fileName);
+    char fileType = fileTypeOf(fileName, headerBuffer);
+    string indexFile = fileName + "_index.txt";
+    bool allFound = true;
+    size_t next = 0;
+
+    harness.run("index/first " + label, 1, [&]() {
+        ifstream searchFile(fileName);
+        ZipCodeIndexer index(searchFile, fileType, indexFile, headerBuffer);
+        index.createIndex();
+        index.writeIndexToFile();
+        ZipCodeStore store(fileName);
+        string record;
+        allFound = allFound && store.open(&index.getIndex())
+                && store.lookup(zipCodes[next++ * 7919 % zipCodes.size()], record);
+        doNotOptimize(record.size());
+    });
+
+    harness.run("snapshot/build " + label, static_cast<long long>(zipCodes.size()), [&]() {
+        allFound = allFound && Snapshot::build(fileName);
+    });
+
+    Snapshot image(fileName);
+    allFound = allFound && image.open();
+    cerr << label << ": " << zipCodes.size() << " records, " << image.imageBytes() << " image bytes" << endl;
+    harness.run("snapshot/first " + label, 1, [&]() {
+        Snapshot snapshot(fileName);
+        string record;
+        allFound = allFound && snapshot.open() && snapshot.lookup(zipCodes[next++ * 7919 % zipCodes.size()], record);
+        doNotOptimize(record.size());
+    });
+
+    harness.run("snapshot/verify " + label, static_cast<long long>(zipCodes.size()), [&]() {
+        allFound = allFound && image.verify();
+    });
+
+    remove(indexFile.c_str());
+    remove(Snapshot::fileName(fileName).c_str());
+    if (!allFound) {
+        cerr << "Error: A lookup of " << fileName << " failed" << endl;
+    }
+    return allFound;
+}
+
+int main(int argc, char* argv[]) {
+    string fileName = "us_postal_codes.csv";
+    vector<long long> sizes = { 1000000 };
+    int warmupRuns = 2;
+    int repetitions = 20;
+    string format = "csv";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        if (flag == "--file") { fileName = argv[i + 1]; }
+        else if (flag == "--sizes") {
+            sizes.clear();
+            stringstream list(argv[i + 1]);
+            string size;
+            while (getline(list, size, ',')) {
+                if (atoll(size.c_str()) > 0) {
+                    sizes.push_back(atoll(size.c_str()));
+                }
+            }
+        }
+        else if (flag == "--warmup") { warmupRuns = atoi(argv[i + 1]); }
+        else if (flag == "--reps") { repetitions = atoi(argv[i + 1]); }
+        else if (flag == "--format") { format = argv[i + 1]; }
+        else {
+            cerr << "Error: Unknown option " << flag << endl;
+            return 1;
+        }
+    }
+
+    BenchmarkHarness harness(warmupRuns, repetitions);
+    bool passed = benchmarkFile(harness, fileName, fileName);
+    for (long long size : sizes) {
+        RecordGenerator::Settings settings;
+        settings.recordCount = size;
+        string dataFile = "snapshot_bench_" + to_string(size) + ".txt";
+        RecordGenerator generator(settings);
+        if (generator.writeFile(dataFile, 'L') < 0) {
+            return 1;
+        }
+        passed = benchmarkFile(harness, dataFile, to_string(size)) && passed;
+        remove(dataFile.c_str());
+    }
+
+    if (format == "json") {
+        harness.writeJSON(cout);
+    } else {
+        harness.writeCSV(cout);
+    }
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file SpatialOrderBenchmark.cpp
+ * @brief Compares the blocks a bounding box query touches in ZIP code order and in Hilbert curve order.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Writes the records of --file twice, with BlockWriter in ZIP code order
+ *    and with SpatialOrder along a Hilbert curve, each with its ZoneMap.
+ *    Then, for square bounding boxes of 0.5, 2 and 8 degrees centred on
+ *    random records, it counts per query:
+ * \n  -- blocks: the blocks whose zones overlap the box, which must be read
+ * \n  -- runs: the runs of consecutive RBNs among them, each a seek
+ * \n These go to standard error, one line per box size and ordering. The
+ *    scans, reading the candidate blocks through a ZipCodeStore of each
+ *    file as zoneScan does, are timed as "zip/<degrees>" and
+ *    "hilbert/<degrees>", per query.
+ * \n
+ * \n Usage: SpatialOrderBenchmark.exe [--file <file>] [--queries n]
+ *    [--warmup n] [--reps n] [--format csv|json]
+ * \n --file defaults to us_postal_codes.txt and --queries, per repetition,
+ *    to 200. Run from the repository root. The files written are removed
+ *    at the end.
+ */
+// ----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include "BenchmarkHarness.h"
+#include "BlockWriter.h"
+#include "SpatialOrder.h"
+#include "ZoneMap.h"
+#include "ZipCodeStore.h"
+#include "ZipCodeBuffer.h"
+#include "HeaderBuffer.h"
+
+using namespace std;
+
+/// @brief Every record string of a file.
+static vector<string> readRecords(const string& fileName) {
+    ifstream file(fileName, ios::binary);
+    HeaderBuffer headerBuffer(fileName);
+    char fileType = 'C';
+    if (fileName.find(".csv") == string::npos) {
+        headerBuffer.readHeader();
+        fileType = (headerBuffer.getBlockSize() == 0) ? 'L' : 'B';
+    }
+    ZipCodeBuffer buffer(file, fileType, headerBuffer);
+    vector<string> records;
+    string record;
+    while (!(record = buffer.readNextRecordString()).empty()) {
+        records.push_back(record);
+    }
+    return records;
+}
+
+/// @brief Removes a blocked file and everything written beside it.
+static void removeBlockedFile(const string& dataFile, const string& indexFile) {
+    remove(dataFile.c_str());
+    remove(indexFile.c_str());
+    remove(ZoneMap::fileName(dataFile).c_str());
+    remove(SpatialOrder::zipMapFileName(dataFile).c_str());
+}
+
+int main(int argc, char* argv[]) {
+    string fileName = "us_postal_codes.txt";
+    int queryCount = 200;
+    int warmupRuns = 2;
+    int repetitions = 20;
+    string format = "csv";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        if (flag == "--file") { fileName = argv[i + 1]; }
+        else if (flag == "--queries") { queryCount = max(1, atoi(argv[i + 1])); }
+        else if (flag == "--warmup") { warmupRuns = atoi(argv[i + 1]); }
+        else if (flag == "--reps") { repetitions = atoi(argv[i + 1]); }
+        else if (flag == "--format") { format = argv[i + 1]; }
+        else {
+            cerr << "Error: Unknown option " << flag << endl;
+            return 1;
+        }
+    }
+
+    vector<string> records = readRecords(fileName);
+    if (records.empty()) {
+        cerr << "Error: No records in " << fileName << endl;
+        return 1;
+    }
+
+    const string names[] = { "zip", "hilbert" };
+    const string dataFiles[] = { "bench_zip_order.txt", "bench_hilbert_order.txt" };
+    const string indexFiles[] = { "bench_zip_order_index.txt", "bench_hilbert_order_index.txt" };
+    {
+        BlockWriter writer(dataFiles[0], indexFiles[0]);
+        writer.setZoneMapFileName(ZoneMap::fileName(dataFiles[0]));
+        for (const string& record : records) {
+            writer.addRecord(record);
+        }
+        writer.close();
+    }
+    SpatialOrder::write(records, dataFiles[1], indexFiles[1], BlockWriter::DEFAULT_BLOCK_SIZE,
+                        BlockWriter::DEFAULT_FILL_PERCENT);
+
+    ZoneMap zoneMaps[] = { ZoneMap(dataFiles[0]), ZoneMap(dataFiles[1]) };
+    ZipCodeStore zipStore(dataFiles[0]);
+    ZipCodeStore hilbertStore(dataFiles[1]);
+    const ZipCodeStore* stores[] = { &zipStore, &hilbertStore };
+    if (!zoneMaps[0].open() || !zoneMaps[1].open() || !zipStore.open() || !hilbertStore.open()) {
+        removeBlockedFile(dataFiles[0], indexFiles[0]);
+        removeBlockedFile(dataFiles[1], indexFiles[1]);
+        return 1;
+    }
+
+    mt19937 random(1046);
+    uniform_int_distribution<size_t> anyRecord(0, records.size() - 1);
+    BenchmarkHarness harness(warmupRuns, repetitions);
+    const double sizes[] = { 0.5, 2, 8 };
+    for (double size : sizes) {
+        // Boxes centred on records, so every box holds some
+        vector<ZoneMap::Predicate> boxes;
+        for (int q = 0; q < queryCount; q++) {
+            const string& center = records[anyRecord(random)];
+            size_t latitudeStart = center.find(',', center.find(',', center.find(',', center.find(',') + 1) + 1) + 1) + 1;
+            double latitude = atof(center.c_str() + latitudeStart);
+            double longitude = atof(center.c_str() + center.find(',', latitudeStart) + 1);
+            ZoneMap::Predicate box;
+            box.hasBox = true;
+            box.minLatitude = latitude - size / 2;
+            box.maxLatitude = latitude + size / 2;
+            box.minLongitude = longitude - size / 2;
+            box.maxLongitude = longitude + size / 2;
+            boxes.push_back(box);
+        }
+
+        string sizeName = to_string(size);
+        sizeName.erase(sizeName.find_last_not_of('0') + 1);
+        if (sizeName.back() == '.') {
+            sizeName.pop_back();
+        }
+        for (int order = 0; order < 2; order++) {
+            size_t blocks = 0;
+            size_t runs = 0;
+            for (const ZoneMap::Predicate& box : boxes) {
+                size_t skipped = 0;
+                vector<long long> candidates = zoneMaps[order].candidates(box, skipped);
+                sort(candidates.begin(), candidates.end());
+                blocks += candidates.size();
+                for (size_t c = 0; c < candidates.size(); c++) {
+                    runs += (c == 0 || candidates[c] != candidates[c - 1] + 1);
+                }
+            }
+            cerr << sizeName << " degree boxes, " << names[order] << " order: "
+                 << static_cast<double>(blocks) / queryCount << " blocks in "
+                 << static_cast<double>(runs) / queryCount << " runs per query, of "
+                 << zoneMaps[order].getZones().size() << endl;
+
+            harness.run(names[order] + "/" + sizeName, queryCount, [&]() {
+                size_t found = 0;
+                vector<string> blockRecords;
+                for (const ZoneMap::Predicate& box : boxes) {
+                    size_t skipped = 0;
+                    for (long long rbn : zoneMaps[order].candidates(box, skipped)) {
+                        blockRecords.clear();
+                        stores[order]->readLocation(rbn, blockRecords);
+                        for (const string& record : blockRecords) {
+                            found += box.matches(record);
+                        }
+                    }
+                }
+                doNotOptimize(found);
+            });
+        }
+    }
+
+    if (format == "json") {
+        harness.writeJSON(cout);
+    } else {
+        harness.writeCSV(cout);
+    }
+    removeBlockedFile(dataFiles[0], indexFiles[0]);
+    removeBlockedFile(dataFiles[1], indexFiles[1]);
+    return 0;
+}
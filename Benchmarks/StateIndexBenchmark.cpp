@@ -0,0 +1,135 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file StateIndexBenchmark.cpp
+ * @brief Compares counting and listing the records of a state by scanning the file and through StateIndex.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n For each --states state, times:
+ * \n  -- scan: reading and parsing every record of the file with
+ *       ZipCodeBuffer and keeping those of the state
+ * \n  -- count: the cardinality of the state's bitmap
+ * \n  -- list: reading the state's records with StateIndex::readRecords
+ *       from a ZipCodeStore whose block cache is already warm
+ * \n and, once, opening the index. Every count and list is first checked
+ *    against the scan. The bitmap memory goes to standard error.
+ * \n
+ * \n Usage: StateIndexBenchmark.exe [--file <file>] [--states a,b,c]
+ *    [--warmup n] [--reps n] [--format csv|json]
+ * \n --file defaults to us_postal_codes_blocked.txt and --states to
+ *    MN,CA,RI. Run from the repository root. The index file is built if
+ *    it does not exist.
+ * \n Results are named "<method>/<state>" and "open", per call.
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "BenchmarkHarness.h"
+#include "StateIndex.h"
+#include "ZipCodeStore.h"
+#include "ZipCodeBuffer.h"
+#include "HeaderBuffer.h"
+
+using namespace std;
+
+/// @brief The records of a state, found by parsing the whole file.
+static vector<string> scanState(const string& fileName, char fileType, const string& state) {
+    ifstream file(fileName, ios::binary);
+    HeaderBuffer headerBuffer(fileName);
+    if (fileType != 'C') {
+        headerBuffer.readHeader();
+    }
+    ZipCodeBuffer buffer(file, fileType, headerBuffer);
+    vector<string> records;
+    string record;
+    while (!(record = buffer.readNextRecordString()).empty()) {
+        if (buffer.parseRecord(record).state == state) {
+            records.push_back(record);
+        }
+    }
+    return records;
+}
+
+int main(int argc, char* argv[]) {
+    string fileName = "us_postal_codes_blocked.txt";
+    vector<string> states = { "MN", "CA", "RI" };
+    int warmupRuns = 2;
+    int repetitions = 20;
+    string format = "csv";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        if (flag == "--file") { fileName = argv[i + 1]; }
+        else if (flag == "--states") {
+            states.clear();
+            stringstream list(argv[i + 1]);
+            string state;
+            while (getline(list, state, ',')) {
+                states.push_back(state);
+            }
+        }
+        else if (flag == "--warmup") { warmupRuns = atoi(argv[i + 1]); }
+        else if (flag == "--reps") { repetitions = atoi(argv[i + 1]); }
+        else if (flag == "--format") { format = argv[i + 1]; }
+        else {
+            cerr << "Error: Unknown option " << flag << endl;
+            return 1;
+        }
+    }
+
+    ZipCodeStore store(fileName);
+    StateIndex index(fileName);
+    if (!store.open() || !index.open()) {
+        return 1;
+    }
+    cerr << index.states().size() << " states, " << index.bitmapBytes() << " bytes of bitmaps" << endl;
+
+    BenchmarkHarness harness(warmupRuns, repetitions);
+    harness.run("open", 1, [&]() {
+        StateIndex opened(fileName);
+        doNotOptimize(opened.open());
+    });
+
+    bool correct = true;
+    for (const string& state : states) {
+        vector<string> expected = scanState(fileName, store.getFileType(), state);
+        vector<string> listed;
+        index.readRecords(store, index.records(state), listed);
+        // A B file's ids follow RBNs, which need not be the sequence set order of the scan
+        sort(expected.begin(), expected.end());
+        sort(listed.begin(), listed.end());
+        if (index.count(state) != expected.size() || listed != expected) {
+            cerr << "Error: The index does not give the records a scan finds for " << state << "." << endl;
+            correct = false;
+            continue;
+        }
+
+        harness.run("scan/" + state, 1, [&]() {
+            doNotOptimize(scanState(fileName, store.getFileType(), state).size());
+        });
+        harness.run("count/" + state, 1, [&]() {
+            doNotOptimize(index.count(state));
+        });
+        harness.run("list/" + state, 1, [&]() {
+            vector<string> records;
+            index.readRecords(store, index.records(state), records);
+            doNotOptimize(records.size());
+        });
+    }
+
+    if (format == "json") {
+        harness.writeJSON(cout);
+    } else {
+        harness.writeCSV(cout);
+    }
+    return correct ? 0 : 1;
+}
@@ -8,6 +8,7 @@
 #include <vector>
 #include "BlockBuffer.h"
 #include "HeaderBuffer.h"
+#include "Stats.h"
 #include <sstream>
 
 
@@ -20,74 +21,92 @@ BlockBuffer::BlockBuffer(std::ifstream &file, HeaderBuffer headerBuffer) : file(
 }
 
 
-vector<string> BlockBuffer::unpackBlockRecords() {
-    // This will convert a block to a vector of records
-    size_t idx = 0;
-    vector<string> records;
+namespace {
+    /// @brief Reads the 5 metadata fields at the start of a block.
+    void readMetadataFields(std::istream &blockStream, BlockBuffer::BlockMetadata &metadata) {
+        blockStream >> metadata.metadataLength;
+        blockStream.ignore(1); // Ignore the commas separating the fields
+        blockStream >> metadata.rbn;
+        blockStream.ignore(1);
+        blockStream >> metadata.numRecords;
+        blockStream.ignore(1);
+        blockStream >> metadata.prevRBN;
+        blockStream.ignore(1);
+        blockStream >> metadata.nextRBN;
+        blockStream.ignore(1); // Skip the comma after the last metadata field
+    }
 
-    for (size_t i = 0; i < getNumRecordsInBlock(); i++)
-    {
-        // Reads the length and retrieves that many characters for the record
-        std::string recordString;
-        int numCharactersToRead = 0;
-        file >> numCharactersToRead;   // Read the length indicator, the first field in each record
-        file.ignore(1);                // Skip the comma after the length field
-        recordString.resize(numCharactersToRead);
-        file.read(&recordString[0], numCharactersToRead);
-        records.push_back(recordString);
+    /// @brief Reads the given number of length-indicated records after the metadata.
+    vector<string> unpackRecords(std::istream &blockStream, int numRecords) {
+        vector<string> records;
+
+        for (int i = 0; i < numRecords; i++)
+        {
+            // Reads the length and retrieves that many characters for the record
+            std::string recordString;
+            int numCharactersToRead = 0;
+            blockStream >> numCharactersToRead;   // Read the length indicator, the first field in each record
+            blockStream.ignore(1);                // Skip the comma after the length field
+            recordString.resize(numCharactersToRead);
+            blockStream.read(&recordString[0], numCharactersToRead);
+            records.push_back(recordString);
+            ZIPCODE_STAT(ALLOCATIONS, 1);
+        }
+
+        return records;
     }
-    
-    return records;
+}
+
+
+vector<string> BlockBuffer::unpackBlockRecords(std::istream &blockStream) {
+    // This will convert a block to a vector of records
+    return unpackRecords(blockStream, getNumRecordsInBlock());
 }
 
 
 
 /// @brief Reads the block metadata for the current block.
-void BlockBuffer::readBlockMetadata() {
-    int metadataRecordLength = -1;
-    int newRelativeBlockNumber = -1;
-    int newNumRecordsInBlock = -1;
-    int newPrevRBN = -1;
-    int newNextRBN = -1;
-    
-    file >> metadataRecordLength;
-    file.ignore(1); // Ignore the commas separating the fields
-    file >> newRelativeBlockNumber;
-    file.ignore(1);
-    file >> newNumRecordsInBlock;
-    file.ignore(1);
-    file >> newPrevRBN;
-    file.ignore(1);
-    file >> newNextRBN;
-    file.ignore(1); // Skip the comma after the last metadata field
+void BlockBuffer::readBlockMetadata(std::istream &blockStream) {
+    BlockMetadata metadata;
+    readMetadataFields(blockStream, metadata);
 
     // TODO throw exception if any of these reads failed or the values are invalid
 
-    currentRBN = newRelativeBlockNumber;
-    numRecordsInBlock = newNumRecordsInBlock;
-    prevRBN = newPrevRBN;
-    nextRBN = newNextRBN;
+    currentRBN = metadata.rbn;
+    numRecordsInBlock = metadata.numRecords;
+    prevRBN = metadata.prevRBN;
+    nextRBN = metadata.nextRBN;
+}
+
+
+
+/// @brief Parses a whole block without a file.
+vector<string> BlockBuffer::parseBlock(const std::string &blockData, BlockMetadata &metadata) {
+    std::istringstream blockStream(blockData);
+    readMetadataFields(blockStream, metadata);
+    return unpackRecords(blockStream, metadata.numRecords);
 }
 
 
 
 /// @brief Calculates the address of a Relative Block Number (RBN) within the file.
-int BlockBuffer::calculateBlockAddress(int relativeBlockNumber) {
-    return headerSize + relativeBlockNumber*blockSize;
+long long BlockBuffer::calculateBlockAddress(long long relativeBlockNumber) {
+    return headerSize + relativeBlockNumber*static_cast<long long>(blockSize);
 }
 
 
 
 /// @brief Moves the file pointer to the address of the block at the given Relative Block Number (RBN).
-void BlockBuffer::moveToBlock(int relativeBlockNumber) {
-    int address = calculateBlockAddress(relativeBlockNumber);
-    file.seekg(address);
+void BlockBuffer::moveToBlock(long long relativeBlockNumber) {
+    long long address = calculateBlockAddress(relativeBlockNumber);
+    file.seekg(static_cast<std::streamoff>(address));
+    ZIPCODE_STAT(SEEKS, 1);
 }
 
 
 
 /// @brief Reads the block at the given Relative Block Number (RBN) and returns it as a vector of records in string form.
-vector<string> BlockBuffer::readBlock(int relativeBlockNumber) {
+vector<string> BlockBuffer::readBlock(long long relativeBlockNumber) {
     vector<string> recordStrings;
     std::string line;
 
@@ -106,8 +125,27 @@ vector<string> BlockBuffer::readBlock(int relativeBlockNumber) {
 
 /// @brief Reads the current block and returns it as a vector of records in string form.
 vector<string> BlockBuffer::readCurrentBlock() {
-    readBlockMetadata();                // Read the metadata for the block
-    return unpackBlockRecords();        // Read the length-indicated records into strings and return them
+    // Read the whole block with one read of the block size given in the header
+    std::string blockData(blockSize, '\0');
+    file.read(&blockData[0], blockSize);
+    blockData.resize(file.gcount());
+    file.clear(); // A short final block sets eof, which would make later seeks fail
+    ZIPCODE_STAT(ALLOCATIONS, 1);
+    ZIPCODE_STAT(BYTES_READ, blockData.size());
+
+    if (blockData.empty())
+    {
+        // Read past the end of the file, so there is no block here
+        currentRBN = -1;
+        numRecordsInBlock = 0;
+        nextRBN = -1;
+        return vector<string>();
+    }
+
+    ZIPCODE_STAT(BLOCKS_READ, 1);
+    std::istringstream blockStream(blockData);
+    readBlockMetadata(blockStream);                // Read the metadata for the block
+    return unpackBlockRecords(blockStream);        // Read the length-indicated records into strings and return them
 }
 
 
@@ -16,10 +16,10 @@
  * \n
  * \n  Each block starts with these five metadata fields:
  * \n  -- Length of metadata record (int)
- * \n  -- Relative Block Number (int)
+ * \n  -- Relative Block Number (64-bit int)
  * \n  -- Number of records in the block (int)
- * \n  -- Previous Relative Block Number (int)
- * \n  -- Next Relative Block Number (int)
+ * \n  -- Previous Relative Block Number (64-bit int)
+ * \n  -- Next Relative Block Number (64-bit int)
  * \n
  * \n The Relative Block Number (RBN) is used to navigate the file and starts
  *    at 0 for the first block. The Previous RBN and Next RBN are used to
@@ -29,6 +29,10 @@
  * \n The records within each block are length-indicated and have no other
  *    delimiters. The length field is separated from the rest of the record
  *    by a comma delimiter.
+ * \n
+ * \n Every block is exactly Block Size bytes as recorded in the file header,
+ *    including its '~' padding and the newline that ends it, so each block is
+ *    read from the file with a single read of that size.
  */
 // ----------------------------------------------------------------------------
 
@@ -45,14 +49,24 @@
 using namespace std;
 
 class BlockBuffer {
+public:
+    /// @brief The five metadata fields at the start of every block.
+    struct BlockMetadata {
+        int metadataLength = -1;
+        long long rbn = -1;
+        int numRecords = 0;
+        long long prevRBN = -1;
+        long long nextRBN = -1;
+    };
+
 private: 
     std::ifstream &file;        // The ifstream to read blocks from.
     int numRecordsInBlock = 0;  // Number of records in the current block (read from metadata)
-    int currentRBN = 0;         // Relative Block Number (RBN) of the current block
-    int prevRBN = -1;           // RBN of the previous block in the linked list
-    int nextRBN = 0;            // RBN of the next block in the linked list 
+    long long currentRBN = 0;   // Relative Block Number (RBN) of the current block
+    long long prevRBN = -1;     // RBN of the previous block in the linked list
+    long long nextRBN = 0;      // RBN of the next block in the linked list 
     int blockSize = 512;        // Number of bytes in every block, which will be read from the metadata
-    int headerSize = 53;        // Number of bytes in the metadata header record, which will be read from the metadata
+    long long headerSize = 53;  // Number of bytes in the metadata header record, which will be read from the metadata
 
 public:
     /**
@@ -68,25 +82,38 @@ public:
 
     /**
      * @brief Unpacks the length-indicated records from the block into a string vector.
+     * @param blockStream The contents of the block.
      * @return A vector of strings, the records within a block.
-     * @pre: The file pointer is at the start of the records within the block after the block metadata was read.
+     * @pre: The stream is at the start of the records within the block after the block metadata was read.
      * @post: The block is unpacked into individual strings for each record in the block, returned as a vector.
      */
-    vector<string> unpackBlockRecords();
+    vector<string> unpackBlockRecords(std::istream &blockStream);
     
 
     /**
      * @brief Reads the block metadata for the current block.
-     * @pre The file pointer is at the start of the block before the 5 metadata fields.
-     * @post The 5 metadata fields have been read into the member variables and the file pointer is after the metadata.
+     * @param blockStream The contents of the block.
+     * @pre The stream is at the start of the block before the 5 metadata fields.
+     * @post The 5 metadata fields have been read into the member variables and the stream is after the metadata.
     */
-    void readBlockMetadata();
+    void readBlockMetadata(std::istream &blockStream);
+
+    /**
+     * @brief Parses a whole block without a file, for readers that read blocks themselves.
+     * @param blockData The bytes of one block.
+     * @param metadata Receives the metadata of the block.
+     * @return The records within the block.
+     * @pre blockData starts at the start of a block.
+     * @post Nothing in any BlockBuffer is changed, so any thread may call this.
+     */
+    static vector<string> parseBlock(const std::string &blockData, BlockMetadata &metadata);
 
     // Metadata getters
-    int getCurrentRBN() const { return currentRBN; }
-    int getPrevRBN() const { return prevRBN; }
-    int getNextRBN() const { return nextRBN; }
+    long long getCurrentRBN() const { return currentRBN; }
+    long long getPrevRBN() const { return prevRBN; }
+    long long getNextRBN() const { return nextRBN; }
     int getNumRecordsInBlock() const { return numRecordsInBlock; }
+    int getBlockSize() const { return blockSize; }
 
 
     /**
@@ -96,7 +123,7 @@ public:
      * @pre: The file is open and in a blocked length-indicated file format.
      * @post: The block is broken down into records and the file pointer is after the records in the block.
      */
-    vector<string> readBlock(int relativeBlockNumber);
+    vector<string> readBlock(long long relativeBlockNumber);
 
     /**
      * @brief Reads the current block after the file pointer and returns it as a vector of records in string form.
@@ -120,11 +147,11 @@ public:
 
     /**
      * @brief Calculates the address of a Relative Block Number (RBN) within the file.
-     * @return The address of the RBN.
+     * @return The address of the RBN as a 64-bit offset, so files past 2 GiB can be addressed.
      * @pre The file metadata has been read.
      * @post The calculation results have been returned.
     */
-    int calculateBlockAddress(int relativeBlockNumber);
+    long long calculateBlockAddress(long long relativeBlockNumber);
 
 
     /**
@@ -132,7 +159,7 @@ public:
      * @pre The file is open.
      * @post The file pointer is moved to the start of the block at the given RBN.
     */
-    void moveToBlock(int relativeBlockNumber);
+    void moveToBlock(long long relativeBlockNumber);
 
 };
 
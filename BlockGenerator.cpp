@@ -4,151 +4,148 @@
  * @brief File for generating a blocked sequence set
  * @author Andrew Clayton
  * @date 11/13/2023
- * @version 1.5
+ * @version 2.0
  */
  // ----------------------------------------------------------------------------
  /**
   * @details
   *
   * \n The BlockGenerator class converts the length-indicated data into blocked data.
-  * \n Block size is 512 bytes, and the minimum block capacity is 50%. Block capacity is currently set to 75%. All records in blocks are complete.
-  * \n Blocks are separated on different lines (end of line character), and records within a block are only distinct via length indication. 
+  * \n Block size defaults to 512 bytes and block capacity defaults to 75%. Both can be set on the command line
+  *    and are recorded in the header of the blocked file. All records in blocks are complete.
+  * \n Blocks are separated on different lines (end of line character), and records within a block are only distinct via length indication.
   * \n This file includes metadata: relative block number (RBN), number of records in the block, RBN of previous block, and RBN of next block.
   * \n An avail list is also created, and this is indicated in the metadata.
+  * \n The simple index of the blocks (RBN and greatest key) is written at the same time, as are the
+  *    ZoneMap of the blocks' latitude, longitude and states and the PlaceTrie of the place names
+  *    for prefix completion. The ColumnStore for analytical scans is then built from the blocked file.
+  * \n
+  * \n With --order hilbert, the records are written along a Hilbert curve of their coordinates instead of in ZIP
+  *    code order, with a ZIP map for lookups. See SpatialOrder.h.
+  * \n
+  * \n Usage: BlockGenerator <output name> [--input <file>] [--index <file>] [--block-size <bytes>] [--fill <percent>]
+  *    [--order zip|hilbert]
+  * \n The blocked file is written to "<output name>.txt".
   *
   *///----------------------------------------------------------------------------
 
-    
+
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <vector>
+#include <stdexcept>
 #include "HeaderBuffer.h"
+#include "ZipCodeBuffer.h"
+#include "BlockWriter.h"
+#include "PlaceTrie.h"
+#include "ZoneMap.h"
+#include "SpatialOrder.h"
+#include "ColumnStore.h"
+#include "DataFingerprint.h"
 
 using namespace std;
 
 int main(int argc, char* argv[]) {
-    const int BLOCK_SIZE = 510;
-    const int BLOCK_CAPACITY = 0.75 * BLOCK_SIZE; // 75% of the block size
-
-
-    // We need to first read and write the header of the file
-    HeaderBuffer header = HeaderBuffer("us_postal_codes_blocked.txt");
-    header.readHeader();
-    header.writeHeaderToFile("us_postal_codes_blocked.txt");
-
-    // Now we can proceed with the blocked data generation, but we have to make sure the file opens up where we left off
-
-
-
     // Check if the correct number of command line arguments were given
     if (argc < 2) {
         cerr << "Error: No file name given.\n";
+        cerr << "Usage: " << argv[0] << " <output name> [--input <file>] [--index <file>] [--block-size <bytes>] [--fill <percent>] [--order zip|hilbert]\n";
         return 1;
     }
 
     // File to write data out to
-    string blockedDataFile = argv[1]; // Assumes the first command line argument is the file name
-    ofstream writeFile;
-    // we need to append to the file, not overwrite it
-    writeFile.open(blockedDataFile + ".txt", ios::app);
-    if (!writeFile.is_open()) {
-        cerr << "Error: Could not open file " << blockedDataFile << " for writing.\n";
-        return 1;
-    }  
-    
+    string blockedDataFile = string(argv[1]) + ".txt"; // Assumes the first command line argument is the file name
+    string inputFile = "uspostal_codes.txt";
+    string indexFile = "blocked_Index.txt";
+    int blockSize = BlockWriter::DEFAULT_BLOCK_SIZE;
+    int fillPercent = BlockWriter::DEFAULT_FILL_PERCENT;
+    string order = "zip";
+
+    for (int i = 2; i < argc; i += 2) {
+        string flag = argv[i];
+        if (i + 1 == argc) {
+            cerr << "Error: No value given for " << flag << "\n";
+            return 1;
+        }
+        try {
+            if (flag == "--input") {
+                inputFile = argv[i + 1];
+            } else if (flag == "--index") {
+                indexFile = argv[i + 1];
+            } else if (flag == "--block-size") {
+                blockSize = stoi(argv[i + 1]);
+            } else if (flag == "--fill") {
+                fillPercent = stoi(argv[i + 1]);
+            } else if (flag == "--order") {
+                order = argv[i + 1];
+                if (order != "zip" && order != "hilbert") {
+                    throw invalid_argument(order);
+                }
+            } else {
+                cerr << "Error: Unknown option " << flag << "\n";
+                return 1;
+            }
+        } catch (const logic_error& e) {
+            cerr << "Error: Invalid value for " << flag << ": " << argv[i + 1] << "\n";
+            return 1;
+        }
+    }
+
     // File to read information from
-    ifstream readFile("uspostal_codes.txt");
+    ifstream readFile(inputFile);
     if (!readFile.is_open()) {
-        cerr << "Error: Could not open file uspostal_codes.txt for reading.\n";
+        cerr << "Error: Could not open file " << inputFile << " for reading.\n";
         return 1;
     }
 
-    // We need to have the file open to the actual content, past the metadata. 
-
-    // Now we go through the file and convert the length-indicated data to blocked data, ensuring that
-    // records stay complete within the BLOCK_CAPACITY
-
-    // Initialize variables for looping
-    string currentLine;
-    getline(readFile, currentLine); // Skipping metadata
-    int currentBlockSize = 0;
-    int currentBlock = 0;
-    int numRecords = 0;
-    vector<string> recordsInBlock;
-    bool isLastBlock = false;
-
-    /*
-    As we process through records, we store all of them in a vector. When the vector cannot add another record without reaching block capacity, then we 
-    write the (length-indicated) metadata to the file, followed by all of the vectors. Then we proceeding with checking more records.
-        - First block will have its previous block number as -1
-        - Last block (when we reach the end of the file for records) will have its next block number as -1           */
-
-    while (getline(readFile, currentLine)) {
-        int currentLineLength = stoi(currentLine.substr(0, 2)) + 3; // Including LI and comma
-        recordsInBlock.push_back(currentLine);
-        numRecords++;
-        currentBlockSize += currentLineLength;
-
-        if (currentBlockSize > BLOCK_CAPACITY || readFile.eof()) {
-            isLastBlock = readFile.eof();
-
-            // Metadata calculation
-            string metadata = to_string(currentBlock) + "," + to_string(numRecords) + "," + (currentBlock == 0 ? "-1" : to_string(currentBlock - 1)) + "," + (isLastBlock ? "-1" : to_string(currentBlock + 1)) + ",";
-            int metadataLength = metadata.length() + 3; // Including LI and comma and ending comma
-
-            // Write metadata and records
-            // Metadata format: LI,RBN,#ofRecords,prevBlock,nextBlock,
-            writeFile << metadataLength << "," << metadata;
-            for (const string& record : recordsInBlock) {
-                writeFile << record;
-            }
-
-            // Pad the block with '~'
-            for (int i = 0; i < BLOCK_SIZE - currentBlockSize - metadataLength; i++) {
-                writeFile << "~";
-            }
-            writeFile << "\n"; // New block
-
-            // Reset for the next block
-            recordsInBlock.clear();
-            currentBlockSize = 0;
-            numRecords = 0;
-            currentBlock++;
+    // The buffer skips the column header or metadata of the length-indicated file
+    ZipCodeBuffer recordBuffer(readFile, 'L', HeaderBuffer(inputFile));
+    PlaceTrie::Builder placeTrie;
+
+    if (order == "hilbert") {
+        // Every record must be read before the first can be placed on the curve
+        vector<string> records;
+        string record;
+        while (!(record = recordBuffer.readNextRecordString()).empty()) {
+            records.push_back(record);
+            placeTrie.addRecord(record);
+        }
+        DataFingerprint fingerprint;
+        if (!SpatialOrder::write(records, blockedDataFile, indexFile, blockSize, fillPercent)
+            || !fingerprint.read(blockedDataFile)
+            || !placeTrie.write(PlaceTrie::indexFileName(blockedDataFile), fingerprint)
+            || !ColumnStore::build(blockedDataFile)) {
+            return 1;
         }
+        cout << "Wrote " << records.size() << " records in Hilbert curve order to " << blockedDataFile << ".\n";
+        return 0;
     }
 
-    // Anything left in the vector now will be the last block
-    isLastBlock = true;
+    BlockWriter writer(blockedDataFile, indexFile, blockSize, fillPercent);
+    writer.setZoneMapFileName(ZoneMap::fileName(blockedDataFile));
 
-    // We need to print out everything left in the vector
-    string metadata = to_string(currentBlock) + "," + to_string(numRecords) + "," + (currentBlock == 0 ? "-1" : to_string(currentBlock - 1)) + "," + (isLastBlock ? "-1" : to_string(currentBlock + 1)) + ",";
-    int metadataLength = metadata.length() + 3; // Including LI and comma and ending comma
-
-    // Write metadata and records
-    // Metadata format: LI,RBN,#ofRecords,prevBlock,nextBlock,
-    writeFile << metadataLength << "," << metadata;
-    for (const string& record : recordsInBlock) {
-        writeFile << record;
+    // Go through the file and convert the length-indicated data to blocked data, ensuring that
+    // records stay complete within the block capacity
+    string record;
+    while (!(record = recordBuffer.readNextRecordString()).empty()) {
+        if (!writer.addRecord(record)) {
+            return 1;
+        }
+        placeTrie.addRecord(record);
     }
 
-    // Pad the block with '~'
-    for (int i = 0; i < BLOCK_SIZE - currentBlockSize - metadataLength; i++) {
-        writeFile << "~";
+    // The trie is written once the blocked file is whole, so it holds the file's final fingerprint
+    DataFingerprint fingerprint;
+    if (!writer.close() || !fingerprint.read(blockedDataFile)
+        || !placeTrie.write(PlaceTrie::indexFileName(blockedDataFile), fingerprint)
+        || !ColumnStore::build(blockedDataFile)) {
+        return 1;
     }
 
-
-    // Once all of this is done, we need to create an empty avail list. The next and previous RBNs will be -1
-    // The avail list will be at the end of the file, and will be the last block
-    // The metadata will be: LI,RBN,#ofRecords,prevBlock,nextBlock,
-    string availListMetadata = to_string(currentBlock+1) + ",0,-1,-1,";
-    int availListMetadataLength = availListMetadata.length() + 3; // Including LI and comma and ending comma
-    writeFile << "\n" << availListMetadataLength << "," << availListMetadata;
-    for (int i = 0; i < BLOCK_SIZE - availListMetadataLength; i++) {
-        writeFile << "~";
-    }
+    cout << "Wrote " << writer.getRecordCount() << " records in " << writer.getBlockCount() << " blocks of "
+         << writer.getBlockSize() << " bytes (" << writer.getFillPercent() << "% fill) to " << blockedDataFile << ".\n";
 
     readFile.close();
-    writeFile.close();
     return 0;
 }
@@ -0,0 +1,351 @@
+/// @file BlockIndex.cpp
+/// @class BlockIndex
+/// See BlockIndex.h for full documentation.
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <limits>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include "BlockIndex.h"
+#include "Stats.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+    /// @brief Counts the keys of a static B-tree node that are less than key.
+    inline size_t countLessInNode(const int* node, int key) {
+#if defined(__SSE2__)
+        // Compare four keys at a time and gather one bit per key
+        const __m128i target = _mm_set1_epi32(key);
+        const __m128i* keys = reinterpret_cast<const __m128i*>(node);
+        unsigned mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(target, _mm_load_si128(keys))))
+            | (_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(target, _mm_load_si128(keys + 1)))) << 4)
+            | (_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(target, _mm_load_si128(keys + 2)))) << 8)
+            | (_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(target, _mm_load_si128(keys + 3)))) << 12);
+        return static_cast<size_t>(__builtin_popcount(mask));
+#else
+        size_t count = 0;
+        for (size_t i = 0; i < BlockIndex::NODE_KEYS; i++) {
+            count += (node[i] < key);
+        }
+        return count;
+#endif
+    }
+}
+
+
+/// @brief Loads an index file, replacing anything already loaded.
+bool BlockIndex::load(const std::string& indexFileName) {
+    greatestKeys.clear();
+    rbns.clear();
+
+    std::ifstream indexFile(indexFileName);
+    if (!indexFile.is_open()) {
+        std::cerr << "Error: Could not open index file " << indexFileName << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(indexFile, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        ZIPCODE_STAT(INDEX_LINES_SCANNED, 1);
+        size_t commaIdx = line.find(',');
+        try {
+            rbns.push_back(std::stoll(line.substr(0, commaIdx)));
+            greatestKeys.push_back(std::stoi(line.substr(commaIdx + 1)));
+        } catch (const std::logic_error& e) {
+            std::cerr << "Error parsing block index line: " << line << std::endl;
+            greatestKeys.clear();
+            rbns.clear();
+            setLayout(layout);
+            return false;
+        }
+    }
+    setLayout(layout);
+    return true;
+}
+
+
+/// @brief Replaces the index with keys and RBNs already in memory.
+bool BlockIndex::assign(const std::vector<int>& keys, const std::vector<long long>& blockRBNs) {
+    if (keys.size() != blockRBNs.size() || !std::is_sorted(keys.begin(), keys.end())) {
+        return false;
+    }
+    greatestKeys = keys;
+    rbns = blockRBNs;
+    setLayout(layout);
+    return true;
+}
+
+
+/// @brief Chooses how findBlock searches, building the search structure it needs.
+void BlockIndex::setLayout(Layout newLayout) {
+    layout = newLayout;
+    eytzingerKeys.clear();
+    eytzingerKeys.shrink_to_fit();
+    eytzingerPositions.clear();
+    eytzingerPositions.shrink_to_fit();
+    treeKeys.clear();
+    treeKeys.shrink_to_fit();
+    treePositions.clear();
+    treePositions.shrink_to_fit();
+    treeNodeCount = 0;
+    learnedLevels.clear();
+    learnedLevels.shrink_to_fit();
+
+    size_t next = 0;
+    if (layout == EYTZINGER) {
+        eytzingerKeys.resize(size() + 1);
+        eytzingerPositions.resize(size() + 1);
+        buildEytzinger(1, next);
+    }
+    else if (layout == STATIC_BTREE) {
+        treeNodeCount = (size() + NODE_KEYS - 1) / NODE_KEYS;
+        treeKeys.resize(treeNodeCount * NODE_KEYS);
+        treePositions.resize(treeNodeCount * NODE_KEYS);
+        buildStaticBTree(0, next);
+    }
+    else if (layout == LEARNED) {
+        buildLearned();
+    }
+}
+
+
+/// @brief The name of a layout, as used in benchmark output.
+const char* BlockIndex::layoutName(Layout layout) {
+    switch (layout) {
+    case EYTZINGER:
+        return "eytzinger";
+    case STATIC_BTREE:
+        return "static_btree";
+    case LEARNED:
+        return "learned";
+    default:
+        return "sorted";
+    }
+}
+
+
+/// @brief Fills the Eytzinger tree at position k and below, in order, from the sorted keys.
+void BlockIndex::buildEytzinger(size_t k, size_t& next) {
+    if (k <= size()) {
+        buildEytzinger(2 * k, next);
+        eytzingerKeys[k] = greatestKeys[next];
+        eytzingerPositions[k] = static_cast<int>(next);
+        next++;
+        buildEytzinger(2 * k + 1, next);
+    }
+}
+
+
+/// @brief Fills static B-tree node k and its children, in order, from the sorted keys.
+void BlockIndex::buildStaticBTree(size_t k, size_t& next) {
+    if (k >= treeNodeCount) {
+        return;
+    }
+    for (size_t i = 0; i < NODE_KEYS; i++) {
+        buildStaticBTree(k * (NODE_KEYS + 1) + i + 1, next);
+        size_t slot = k * NODE_KEYS + i;
+        if (next < size()) {
+            treeKeys[slot] = greatestKeys[next];
+            treePositions[slot] = static_cast<int>(next);
+            next++;
+        }
+        else {
+            treeKeys[slot] = INT_MAX; // Padding sorts after every key
+            treePositions[slot] = static_cast<int>(size());
+        }
+    }
+    buildStaticBTree(k * (NODE_KEYS + 1) + NODE_KEYS + 1, next);
+}
+
+
+/// @brief Fits segments predicting each key's position to within epsilon.
+void BlockIndex::fitLevel(const std::vector<int>& keys, int epsilon, LearnedLevel& level) {
+    // Greedy shrinking cone: extend the segment while some slope through its
+    // first point still passes within epsilon of every point added
+    size_t start = 0;
+    while (start < keys.size()) {
+        double lowSlope = 0;
+        double highSlope = std::numeric_limits<double>::infinity();
+        size_t end = start + 1;
+        for (; end < keys.size(); end++) {
+            double keyDistance = static_cast<double>(keys[end]) - keys[start];
+            if (keyDistance == 0) {
+                continue; // A repeat of the first key. lowerBoundLearned checks its answers
+            }
+            double positionDistance = static_cast<double>(end - start);
+            double low = (positionDistance - epsilon) / keyDistance;
+            double high = (positionDistance + epsilon) / keyDistance;
+            if (low > highSlope || high < lowSlope) {
+                break;
+            }
+            lowSlope = std::max(lowSlope, low);
+            highSlope = std::min(highSlope, high);
+        }
+
+        Segment segment;
+        segment.slope = std::isinf(highSlope) ? 0 : (lowSlope + highSlope) / 2;
+        segment.position = static_cast<long long>(start);
+        level.firstKeys.push_back(keys[start]);
+        level.segments.push_back(segment);
+        start = end;
+    }
+}
+
+
+/// @brief Builds the levels of the learned index, from the keys up to a single segment.
+void BlockIndex::buildLearned() {
+    if (empty()) {
+        return;
+    }
+    learnedLevels.push_back(LearnedLevel());
+    fitLevel(greatestKeys, LEARNED_EPSILON, learnedLevels.back());
+    while (learnedLevels.back().segments.size() > 1) {
+        LearnedLevel upper;
+        fitLevel(learnedLevels.back().firstKeys, LEARNED_LEVEL_EPSILON, upper);
+        learnedLevels.push_back(upper);
+    }
+}
+
+
+/// @brief The number of segments in each level of the learned index, from the keys up.
+std::vector<size_t> BlockIndex::getLearnedLevelSizes() const {
+    std::vector<size_t> sizes;
+    for (const LearnedLevel& level : learnedLevels) {
+        sizes.push_back(level.segments.size());
+    }
+    return sizes;
+}
+
+
+/// @brief Finds the first block whose greatest key is at least key.
+long long BlockIndex::findBlock(int key) const {
+    size_t position = lowerBound(key);
+    if (position == size()) {
+        return -1;
+    }
+    return rbns[position];
+}
+
+
+/// @brief Finds the position of the first greatest key that is at least key, with the current layout.
+size_t BlockIndex::lowerBound(int key) const {
+    switch (layout) {
+    case EYTZINGER:
+        return lowerBoundEytzinger(key);
+    case STATIC_BTREE:
+        return lowerBoundStaticBTree(key);
+    case LEARNED:
+        return lowerBoundLearned(key);
+    default:
+        return std::lower_bound(greatestKeys.begin(), greatestKeys.end(), key) - greatestKeys.begin();
+    }
+}
+
+
+/// @brief Searches the Eytzinger layout.
+size_t BlockIndex::lowerBoundEytzinger(int key) const {
+    const int* keys = eytzingerKeys.data();
+    size_t k = 1;
+    while (k <= size()) {
+        // The 16 descendants four levels down share one cache line. Prefetching
+        // past the end of the array is harmless.
+        __builtin_prefetch(keys + k * 16);
+        k = 2 * k + (keys[k] < key);
+    }
+    // Undo the right turns taken after the last left turn, which was at the answer
+    k >>= __builtin_ffsll(static_cast<long long>(~k));
+    return (k == 0) ? size() : static_cast<size_t>(eytzingerPositions[k]);
+}
+
+
+/// @brief Searches the static B-tree layout.
+size_t BlockIndex::lowerBoundStaticBTree(int key) const {
+    const int* keys = treeKeys.data();
+    size_t answerSlot = treeKeys.size(); // None yet
+    size_t k = 0;
+    while (k < treeNodeCount) {
+        size_t i = countLessInNode(keys + k * NODE_KEYS, key);
+        if (i < NODE_KEYS) {
+            answerSlot = k * NODE_KEYS + i; // Deeper nodes can only find a smaller key
+        }
+        k = k * (NODE_KEYS + 1) + i + 1;
+    }
+    return (answerSlot == treeKeys.size()) ? size() : static_cast<size_t>(treePositions[answerSlot]);
+}
+
+
+namespace {
+    /// @brief Branchless count of the keys in [first, first + count) that are less than key,
+    ///        or with orEqual, at most key. The keys must be sorted.
+    inline size_t countBelow(const int* first, size_t count, int key, bool orEqual) {
+        if (count == 0) {
+            return 0;
+        }
+        const int* base = first;
+        while (count > 1) {
+            size_t half = count / 2;
+            base = (base[half] < key || (orEqual && base[half] == key)) ? base + half : base;
+            count -= half;
+        }
+        return (base - first) + (*base < key || (orEqual && *base == key));
+    }
+
+    /// @brief A segment's predicted position for key, clamped to the positions the segment covers.
+    inline size_t predictPosition(double slope, long long position, int firstKey, int key, size_t last) {
+        double predicted = position + slope * (static_cast<double>(key) - firstKey);
+        if (predicted <= position) {
+            return static_cast<size_t>(position);
+        }
+        return (predicted >= last) ? last : static_cast<size_t>(predicted);
+    }
+}
+
+
+/// @brief Searches the learned index.
+size_t BlockIndex::lowerBoundLearned(int key) const {
+    if (learnedLevels.empty()) {
+        return 0;
+    }
+
+    // Go down the levels, finding the last segment whose first key is at most key
+    size_t segment = 0;
+    for (size_t levelNumber = learnedLevels.size() - 1; levelNumber > 0; levelNumber--) {
+        const LearnedLevel& level = learnedLevels[levelNumber];
+        const std::vector<int>& below = learnedLevels[levelNumber - 1].firstKeys;
+        const Segment& model = level.segments[segment];
+        size_t end = (segment + 1 < level.segments.size()) ? level.segments[segment + 1].position : below.size();
+        size_t predicted = predictPosition(model.slope, model.position, level.firstKeys[segment], key, end - 1);
+
+        // Correct the prediction within its error bound, plus one for rounding
+        size_t low = (predicted > static_cast<size_t>(LEARNED_LEVEL_EPSILON) + 1) ? predicted - LEARNED_LEVEL_EPSILON - 1 : 0;
+        size_t high = std::min(below.size(), predicted + LEARNED_LEVEL_EPSILON + 2);
+        size_t count = low + countBelow(below.data() + low, high - low, key, true);
+        if ((count == low && low > 0 && below[low - 1] > key) || (count == high && high < below.size() && below[high] <= key)) {
+            count = std::upper_bound(below.begin(), below.end(), key) - below.begin(); // Outside the bound
+        }
+        segment = (count == 0) ? 0 : count - 1;
+    }
+
+    // Then predict the position among the keys and correct it the same way
+    const LearnedLevel& level = learnedLevels[0];
+    const Segment& model = level.segments[segment];
+    size_t end = (segment + 1 < level.segments.size()) ? level.segments[segment + 1].position : size();
+    size_t predicted = predictPosition(model.slope, model.position, level.firstKeys[segment], key, end);
+
+    size_t low = (predicted > static_cast<size_t>(LEARNED_EPSILON) + 1) ? predicted - LEARNED_EPSILON - 1 : 0;
+    size_t high = std::min(size(), predicted + LEARNED_EPSILON + 2);
+    size_t position = low + countBelow(greatestKeys.data() + low, high - low, key, false);
+    if ((position == low && low > 0 && greatestKeys[low - 1] >= key) || (position == high && high < size() && greatestKeys[high] < key)) {
+        position = std::lower_bound(greatestKeys.begin(), greatestKeys.end(), key) - greatestKeys.begin();
+    }
+    return position;
+}
\ No newline at end of file
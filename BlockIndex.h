@@ -0,0 +1,200 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file BlockIndex.h
+ * @class BlockIndex
+ * @brief The simple block index of a blocked file, loaded into memory once.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.2
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Loads an index file of "RBN,Greatest Key" lines, as written by
+ *    BlockWriter, into two parallel arrays sorted by key. findBlock then
+ *    answers "the first block whose greatest key is at least the target"
+ *    with a binary search, instead of reading the index file line by line
+ *    for every lookup as BlockSearch does without a loaded index.
+ * \n
+ * \n A binary search over the sorted array misses the cache on nearly
+ *    every step once the index is larger than the cache. setLayout can
+ *    also lay the keys out in a static search structure, kept alongside
+ *    the sorted arrays:
+ * \n  -- EYTZINGER: the keys in breadth-first order of a complete binary
+ *       tree. The search is branchless and prefetches the cache line holding
+ *       the 16 descendants four levels down while it compares.
+ * \n  -- STATIC_BTREE: nodes of NODE_KEYS keys, one 64-byte cache line
+ *       each, with NODE_KEYS + 1 children. Each node is compared with SSE2
+ *       where available, so a search touches one cache line per level of a
+ *       tree about four times shallower than a binary search.
+ * \n  -- LEARNED: a PGM-style learned index. The keys are split into
+ *       segments, each a line predicting the position of its keys to
+ *       within LEARNED_EPSILON, and the first keys of the segments are
+ *       modeled the same way, to within LEARNED_LEVEL_EPSILON, level by
+ *       level until one segment remains. A search follows one prediction
+ *       per level and corrects each with a binary search of a few entries,
+ *       so it touches a few cache lines per level, and ZIP codes, which grow
+ *       almost linearly with the RBN, need very few levels.
+ * \n All are built once from the sorted keys and give the same answers as
+ *    SORTED. BlockIndexBenchmark compares them. No layout was fastest at
+ *    every size: on blocked_Index.txt (5519 blocks) STATIC_BTREE took 34 ns
+ *    a lookup, EYTZINGER 39 and LEARNED 43, while at 1 million blocks
+ *    LEARNED (131 ns) edged out EYTZINGER (133) and at 10 million was well
+ *    ahead (263 against 386). A file of five-digit ZIP codes never comes
+ *    near a million blocks, and at the sizes it does reach EYTZINGER is
+ *    within a few nanoseconds of the fastest, needs no SIMD, and has no
+ *    fallback search for repeated keys, so BlockSearch and ZipCodeStore
+ *    use it. STATIC_BTREE falls behind it once the index outgrows the L2
+ *    cache, since each level must wait for the one before it.
+ * \n
+ * \n The index is immutable once loaded, so any number of threads can
+ *    search it at the same time.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef BLOCKINDEX_H
+#define BLOCKINDEX_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+/// @brief Allocates arrays starting on a 64-byte cache line, for the search structures.
+template <class T>
+struct CacheLineAllocator {
+    typedef T value_type;
+
+    CacheLineAllocator() {}
+    template <class U> CacheLineAllocator(const CacheLineAllocator<U>&) {}
+
+    T* allocate(std::size_t count) {
+        void* memory = nullptr;
+        if (posix_memalign(&memory, 64, count * sizeof(T)) != 0) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(memory);
+    }
+    void deallocate(T* memory, std::size_t) { std::free(memory); }
+
+    template <class U> bool operator==(const CacheLineAllocator<U>&) const { return true; }
+    template <class U> bool operator!=(const CacheLineAllocator<U>&) const { return false; }
+};
+
+class BlockIndex {
+public:
+    /// @brief How findBlock searches the keys.
+    enum Layout {
+        SORTED,         // std::lower_bound over the sorted keys
+        EYTZINGER,      // Breadth-first binary tree with prefetching
+        STATIC_BTREE,   // Cache-line nodes compared with SIMD
+        LEARNED         // Piecewise linear model with bounded error
+    };
+
+    /// @brief Keys per node of the static B-tree, one 64-byte cache line of ints.
+    static const size_t NODE_KEYS = 16;
+
+    /// @brief Greatest distance between a key's predicted and actual position in the learned index.
+    static const int LEARNED_EPSILON = 16;
+
+    /// @brief The same, for the levels of the learned index above the keys.
+    static const int LEARNED_LEVEL_EPSILON = 4;
+
+    BlockIndex() : layout(SORTED), treeNodeCount(0) {}
+
+    /**
+     * @brief Loads an index file, replacing anything already loaded.
+     * @param indexFileName The index file, one "RBN,Greatest Key" line per block.
+     * @return false if the file could not be opened or a line could not be parsed.
+     * @post The layout is kept, and its search structure rebuilt.
+     */
+    bool load(const std::string& indexFileName);
+
+    /**
+     * @brief Replaces the index with keys and RBNs already in memory.
+     * @param keys The greatest key of each block, in ascending order.
+     * @param blockRBNs The RBN of each block, in the same order.
+     * @return false if the arrays differ in size or the keys are not in order.
+     */
+    bool assign(const std::vector<int>& keys, const std::vector<long long>& blockRBNs);
+
+    /**
+     * @brief Chooses how findBlock searches, building the search structure it needs.
+     * @param newLayout SORTED frees any search structure already built.
+     */
+    void setLayout(Layout newLayout);
+
+    Layout getLayout() const { return layout; }
+
+    /// @brief The name of a layout, as used in benchmark output.
+    static const char* layoutName(Layout layout);
+
+    /**
+     * @brief Finds the block that would hold a key.
+     * @param key The key to search for.
+     * @return The RBN of the first block whose greatest key is at least key,
+     *      or -1 if the key is greater than every key in the file.
+     */
+    long long findBlock(int key) const;
+
+    /**
+     * @brief Finds the position of the first greatest key that is at least key, with the current layout.
+     * @return An index into getGreatestKeys and getRBNs, or size() if there is none.
+     */
+    size_t lowerBound(int key) const;
+
+    /// @brief The number of segments in each level of the learned index, from the keys up.
+    std::vector<size_t> getLearnedLevelSizes() const;
+
+    /// @brief The number of blocks in the index.
+    size_t size() const { return greatestKeys.size(); }
+
+    bool empty() const { return greatestKeys.empty(); }
+
+    /// @brief The greatest keys of the blocks, in ascending order.
+    const std::vector<int>& getGreatestKeys() const { return greatestKeys; }
+
+    /// @brief The RBNs of the blocks, in the same order as the keys.
+    const std::vector<long long>& getRBNs() const { return rbns; }
+
+private:
+    std::vector<int> greatestKeys;
+    std::vector<long long> rbns;
+    Layout layout;
+
+    // EYTZINGER: keys and their sorted positions at tree positions 1..size(), 0 unused
+    std::vector<int, CacheLineAllocator<int> > eytzingerKeys;
+    std::vector<int> eytzingerPositions;
+
+    // STATIC_BTREE: treeNodeCount nodes of NODE_KEYS keys, padded with INT_MAX,
+    // and the sorted position of each slot
+    std::vector<int, CacheLineAllocator<int> > treeKeys;
+    std::vector<int> treePositions;
+    size_t treeNodeCount;
+
+    /// @brief One line of the learned index: position = position + slope * (key - first key).
+    struct Segment {
+        double slope;
+        long long position;     // Position of the segment's first key in the level below
+    };
+
+    /// @brief One level of the learned index, modeling the keys or the level below.
+    struct LearnedLevel {
+        std::vector<int> firstKeys;     // First key of each segment, in order
+        std::vector<Segment> segments;
+    };
+
+    // LEARNED: levels[0] models greatestKeys, each later one the first keys of the one before
+    std::vector<LearnedLevel> learnedLevels;
+
+    void buildEytzinger(size_t k, size_t& next);
+    void buildStaticBTree(size_t k, size_t& next);
+    void buildLearned();
+    static void fitLevel(const std::vector<int>& keys, int epsilon, LearnedLevel& level);
+    size_t lowerBoundEytzinger(int key) const;
+    size_t lowerBoundStaticBTree(int key) const;
+    size_t lowerBoundLearned(int key) const;
+};
+
+#endif // BLOCKINDEX_H
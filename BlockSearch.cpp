@@ -10,6 +10,8 @@
 #include <vector>
 #include "BlockBuffer.h"
 #include "HeaderBuffer.h"
+#include "Stats.h"
+#include "LatencyHistogram.h"
 
 using namespace std;
 
@@ -17,6 +19,12 @@ using namespace std;
 // Default constructor
 BlockSearch::BlockSearch(string idxFile) {
     indexFile = idxFile;
+    dataFile = "us_postal_codes_blocked.txt";
+}
+
+BlockSearch::BlockSearch(string idxFile, string blockedFile) {
+    indexFile = idxFile;
+    dataFile = blockedFile;
 }
 
 
@@ -31,8 +39,19 @@ int findZipcode(const string& record) {
     return stoi(record.substr(firstComma + 1, secondComma - firstComma - 1));
 }
 
-// Searches for a record in the blocked index file by key (zipcode)
-string BlockSearch::searchForRecord(int target) {
+// Loads the index file into memory
+bool BlockSearch::loadIndex(BlockIndex::Layout layout) {
+    blockIndex.setLayout(layout);
+    indexLoaded = blockIndex.load(indexFile);
+    return indexLoaded;
+}
+
+// Finds the first block whose greatest key is at least target
+long long BlockSearch::findBlock(int target) {
+    if (indexLoaded) {
+        return blockIndex.findBlock(target);
+    }
+
     // Open the index file
     ifstream readFile(indexFile);
     string line;
@@ -41,10 +60,11 @@ string BlockSearch::searchForRecord(int target) {
 
     // Iterate through each line of the file
     while (getline(readFile, line)) {
-        int commaIdx = line.find(',');
-        int rbn = 0;
+        ZIPCODE_STAT(INDEX_LINES_SCANNED, 1);
+        size_t commaIdx = line.find(',');
+        long long rbn = 0;
         try {
-            rbn = stoi(line.substr(0, commaIdx));
+            rbn = stoll(line.substr(0, commaIdx));
         } catch (invalid_argument& e) {
             cerr << "Error parsing RBN: " << e.what() << endl;
             // return "-1";
@@ -60,29 +80,69 @@ string BlockSearch::searchForRecord(int target) {
         
         if (target <= greatestKeyInBlock) {
             // We have found the block that contains the record we are looking for
-            // now we need to actually access the block itself, which we should be able to do with BlockBuffer
+            return rbn;
+        }    
+    }
+    // We could not find the block that contains the record we are looking for
+    return -1;
+}
 
-            ifstream dataFile("us_postal_codes_blocked.txt", std::ios::app);
-            HeaderBuffer headerBuffer2("us_postal_codes_blocked.txt");
-            BlockBuffer blockbuffer(dataFile, headerBuffer2);
+// Searches for a record in the blocked index file by key (zipcode)
+string BlockSearch::searchForRecord(int target) {
+    ZIPCODE_LATENCY_TIMER(BLOCK_SEARCH);
 
-            // We break down all the block into a vector of records
+    long long rbn = findBlock(target);
+    if (rbn == -1) {
+        return "-1";
+    }
+
+    // now we need to actually access the block itself, which we should be able to do with BlockBuffer
+    ifstream dataStream(dataFile, std::ios::binary);
+    HeaderBuffer headerBuffer2(dataFile);
+    BlockBuffer blockbuffer(dataStream, headerBuffer2);
+
+    // We break down all the block into a vector of records
+
+    vector<string> records = blockbuffer.readBlock(rbn);
+
+    for (string record : records) { // Check if each record is the target record
+        int commaIdx = record.find(',');
+        int zipcode = stoi(record.substr(0, commaIdx));
+
+        if (zipcode == target) {
+            return record;
+        }
+    }
+    // not found in this block, and next blocks have greater keys
+    return "-1";
+}
 
-            vector<string> records = blockbuffer.readBlock(rbn);
+// Finds every record with a key in [low, high], reading blocks in sequence set order
+vector<string> BlockSearch::searchRange(int low, int high) {
+    ZIPCODE_LATENCY_TIMER(RANGE_SCAN);
+    vector<string> matches;
 
-            for (string record : records) { // Check if each record is the target record
-                int commaIdx = record.find(',');
-                int zipcode = stoi(record.substr(0, commaIdx));
+    // Find the first block whose greatest key is at least the low end of the range
+    long long firstRBN = (low > high) ? -1 : findBlock(low);
+    if (firstRBN == -1) {
+        return matches;
+    }
 
-                if (zipcode == target) {
-                    return record;
-                }
+    // Follow the next RBN links until a key is past the high end of the range
+    ifstream dataStream(dataFile, std::ios::binary);
+    BlockBuffer blockbuffer(dataStream, HeaderBuffer(dataFile));
+    for (vector<string> records = blockbuffer.readBlock(firstRBN); !records.empty(); records = blockbuffer.readNextBlock()) {
+        for (const string& record : records) {
+            int zipcode = stoi(record.substr(0, record.find(',')));
+            if (zipcode > high) {
+                return matches;
             }
-            break; // not  found in this block, and next blocks have greater keys
-        }    
+            if (zipcode >= low) {
+                matches.push_back(record);
+            }
+        }
     }
-    // We could not find the block that contains the record we are looking for
-    return "-1";   
+    return matches;
 }
 
 void BlockSearch::displayRecord(string record) {
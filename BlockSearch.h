@@ -12,6 +12,10 @@
  * @details
  * \n Opens in the index file, and reads through the indices, locating the block where the target should be, and
  * \n finding the specific record if it exists. If it does not, it will return a -1.
+ * \n
+ * \n After loadIndex, the index is kept in memory as a BlockIndex and searched in the layout chosen,
+ * \n by default its Eytzinger layout,
+ * \n instead of being read again for every search.
  * 
  *
  */
@@ -21,6 +25,8 @@
 #define BLOCKSEARCH_H
 
 #include <string>
+#include <vector>
+#include "BlockIndex.h"
 using namespace std;
 
 class BlockSearch {
@@ -29,6 +35,20 @@ private:
     // The index file to open
     string indexFile;
 
+    // The blocked data file the index refers to
+    string dataFile;
+
+    // The index in memory, once loadIndex has been called
+    BlockIndex blockIndex;
+    bool indexLoaded = false;
+
+    /**
+     * @brief Finds the block that would hold a key, from the loaded index or else the index file
+     * @param target: The zipcode to search for
+     * @return: The RBN of the first block whose greatest key is at least target, or -1 if there is none
+    */
+    long long findBlock(int target);
+
 
 public:
     /**
@@ -36,7 +56,7 @@ public:
      * @pre: none
      * @post: A new BlockSearch object is created
     */
-    BlockSearch() { indexFile = "blocked_Index.txt"; }
+    BlockSearch() { indexFile = "blocked_Index.txt"; dataFile = "us_postal_codes_blocked.txt"; }
 
     /**
      * @brief Constructor that takes in a blocked index file
@@ -46,6 +66,24 @@ public:
     */
     BlockSearch(string idxFile);
 
+    /**
+     * @brief Constructor that takes in a blocked index file and the blocked file it indexes
+     * @param idxFile: The index file to open
+     * @param blockedFile: The blocked data file to read records from
+     * @pre: Both files exist
+     * @post: A new BlockSearch object is created
+    */
+    BlockSearch(string idxFile, string blockedFile);
+
+    /**
+     * @brief Loads the index file into memory, so later searches do not read it again
+     * @param layout: How to search the index in memory. See BlockIndex.h
+     * @pre: A blocked index file exists
+     * @post: Searches use the index in memory, if it loaded
+     * @return: Whether the index loaded
+    */
+    bool loadIndex(BlockIndex::Layout layout = BlockIndex::EYTZINGER);
+
 
     /**
      * @brief Searches for a record in the blocked index file by key (zipcode).
@@ -56,13 +94,23 @@ public:
     */
     string searchForRecord(int target);
 
+    /**
+     * @brief Finds every record whose key (zipcode) is in a range, following the sequence set from the first block that can hold it.
+     * @param low: The smallest zipcode to include
+     * @param high: The largest zipcode to include
+     * @pre: A blocked index file exists
+     * @post: The range is scanned
+     * @return: The records in key order, empty if there are none
+    */
+    vector<string> searchRange(int low, int high);
+
     /**
      * @brief Displays the record to the console
      * @param record: The record to display, in its raw data form
      * @pre: A record exists
      * @post: The record is displayed to the console
     */
-    void displayRecord(string record); 
+    static void displayRecord(string record); 
 
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,228 @@
+/// @file BlockWriter.cpp
+/// @class BlockWriter
+/// See BlockWriter.h for full documentation.
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <algorithm>
+#include "BlockWriter.h"
+#include "HeaderBuffer.h"
+
+
+BlockWriter::BlockWriter(const std::string& fileName, const std::string& indexFileName,
+                         int blockSize, int fillPercent, int keyFieldIndex)
+    : fileName(fileName), tempFileName(fileName + ".tmp"), indexFileName(indexFileName),
+      blockSize(blockSize), fillPercent(fillPercent), keyFieldIndex(keyFieldIndex) {
+
+    if (this->blockSize < MINIMUM_BLOCK_SIZE) {
+        std::cerr << "Block size " << blockSize << " is too small, using " << MINIMUM_BLOCK_SIZE << " bytes.\n";
+        this->blockSize = MINIMUM_BLOCK_SIZE;
+    }
+    if (this->fillPercent < 1 || this->fillPercent > 100) {
+        std::cerr << "Fill factor " << fillPercent << "% is out of range, using " << DEFAULT_FILL_PERCENT << "%.\n";
+        this->fillPercent = DEFAULT_FILL_PERCENT;
+    }
+
+    blockFile.open(tempFileName, std::ios::binary | std::ios::trunc);
+    if (!blockFile.is_open()) {
+        std::cerr << "Error: Could not open file " << tempFileName << " for writing.\n";
+    }
+    if (!indexFileName.empty()) {
+        indexFile.open(indexFileName, std::ios::binary | std::ios::trunc);
+        if (!indexFile.is_open()) {
+            std::cerr << "Error: Could not open file " << indexFileName << " for writing.\n";
+        }
+    }
+}
+
+
+BlockWriter::~BlockWriter() {
+    if (!closed) {
+        blockFile.close();
+        std::remove(tempFileName.c_str());
+    }
+}
+
+
+/// @brief Builds the length-indicated metadata record for a block.
+std::string BlockWriter::makeMetadata(long long relativeBlockNumber, int numRecords, long long prevRBN, long long nextRBN) {
+    // Metadata format: LI,RBN,#ofRecords,prevBlock,nextBlock,
+    std::string metadata = std::to_string(relativeBlockNumber) + "," + std::to_string(numRecords) + ","
+        + std::to_string(prevRBN) + "," + std::to_string(nextRBN) + ",";
+
+    // The length indicator counts itself and its comma, so settle its number of digits
+    size_t metadataLength = metadata.length() + 3;
+    while (std::to_string(metadataLength).length() + 1 + metadata.length() != metadataLength) {
+        metadataLength = std::to_string(metadataLength).length() + 1 + metadata.length();
+    }
+    return std::to_string(metadataLength) + "," + metadata;
+}
+
+
+/// @brief Whether a block with the given records fits within the given number of bytes.
+bool BlockWriter::fits(int numRecords, int recordBytes, int limitBytes) const {
+    // The next RBN is not known until the following record arrives, so allow for the longer of the two
+    long long rbn = blockCount;
+    long long prevRBN = (rbn == 0) ? -1 : rbn - 1;
+    size_t metadataLength = std::max(makeMetadata(rbn, numRecords, prevRBN, rbn + 1).length(),
+                                     makeMetadata(rbn, numRecords, prevRBN, -1).length());
+    return static_cast<int>(metadataLength) + recordBytes <= limitBytes;
+}
+
+
+/// @brief Adds a record to the current block, starting a new block if it does not fit.
+bool BlockWriter::addRecord(const std::string& record) {
+    return addRecord(record, keyOf(record));
+}
+
+
+/// @brief Adds a record with the given index key.
+bool BlockWriter::addRecord(const std::string& record, const std::string& key) {
+    std::string lengthIndicated = std::to_string(record.length()) + "," + record;
+    int recordLength = static_cast<int>(lengthIndicated.length());
+
+    int usableBytes = blockSize - 1;                        // The last byte ends the block with a newline
+    int targetBytes = usableBytes * fillPercent / 100;
+
+    if (!blockRecords.empty() && !fits(blockRecords.size() + 1, blockRecordBytes + recordLength, targetBytes)) {
+        // The current block is as full as it should be, so the record starts the next block
+        flushBlock(blockCount + 1);
+    }
+
+    if (blockRecords.empty() && !fits(1, recordLength, usableBytes)) {
+        std::cerr << "Error: Record does not fit in a " << blockSize << " byte block: " << record << "\n";
+        return false;
+    }
+
+    blockRecords.push_back(lengthIndicated);
+    blockRecordBytes += recordLength;
+    blockGreatestKey = key;
+    if (!zoneMapFileName.empty()) {
+        blockZone.addRecord(record);
+    }
+    recordCount++;
+    return true;
+}
+
+
+/// @brief Writes one padded block to the temporary file.
+void BlockWriter::writeBlock(const std::string& metadata, const std::vector<std::string>& records, int recordBytes) {
+    blockFile << metadata;
+    for (const std::string& record : records) {
+        blockFile << record;
+    }
+
+    // Pad the block with '~' so it ends exactly at the block size
+    int padding = blockSize - 1 - static_cast<int>(metadata.length()) - recordBytes;
+    blockFile << std::string(padding, '~') << "\n";
+}
+
+
+/// @brief Writes the current block with the given next RBN and starts a new one.
+void BlockWriter::flushBlock(long long nextRBN) {
+    long long rbn = blockCount;
+    long long prevRBN = (rbn == 0) ? -1 : rbn - 1;
+    writeBlock(makeMetadata(rbn, blockRecords.size(), prevRBN, nextRBN), blockRecords, blockRecordBytes);
+
+    if (indexFile.is_open()) {
+        indexFile << rbn << "," << blockGreatestKey << "\n";
+    }
+    if (!zoneMapFileName.empty()) {
+        blockZone.rbn = rbn;
+        zones.push_back(blockZone);
+        blockZone = ZoneMap::Zone();
+    }
+
+    // Reset for the next block
+    blockRecords.clear();
+    blockRecordBytes = 0;
+    blockCount++;
+}
+
+
+/// @brief Writes the last block, the avail list and the header to the blocked file.
+bool BlockWriter::close() {
+    if (closed) {
+        return true;
+    }
+    closed = true;
+
+    // Anything left in the current block is the last block
+    if (!blockRecords.empty()) {
+        flushBlock(-1);
+    }
+
+    // Create an empty avail list after the last data block. The next and previous RBNs are -1
+    writeBlock(makeMetadata(blockCount, 0, -1, -1), std::vector<std::string>(), 0);
+    blockFile.close();
+    if (indexFile.is_open()) {
+        indexFile.close();
+    }
+
+    // Now that the counts are known, write the header
+    HeaderBuffer header(fileName);
+    header.setFileStructureType("3.0");
+    header.setFileStructureVersion("2.0");
+    header.setRecordSizeBytes(0);
+    header.setSizeFormatType("ASCII");
+    header.setBlockSize(blockSize);
+    header.setBlockFillPercent(fillPercent);
+    header.setPrimaryKeyIndexFileName(indexFileName);
+    header.setprimaryKeyIndexFileSchema(indexFileName.empty() ? "none" : indexSchema);
+    header.setRecordCount(recordCount);
+    header.setBlockCount(blockCount + 1);               // Data blocks and the avail list block
+    header.setFieldCount(fieldCount);
+    header.setPrimaryKeyFieldIndex(keyFieldIndex);
+    header.setRBNA(blockCount);
+    header.setRBNS(blockCount > 0 ? 0 : -1);
+    header.setstaleFlag(0);
+
+    HeaderBuffer::Field field;
+    field.zipCode = "string";
+    field.placeName = "string";
+    field.state = "string";
+    field.county = "string";
+    field.latitude = "double";
+    field.longitude = "double";
+    header.addField(field);
+
+    header.setHeaderSizeBytes(header.calculateHeaderSize());
+    header.writeHeaderToFile(fileName);
+
+    // Append the blocks after the header
+    std::ifstream blockReader(tempFileName, std::ios::binary);
+    std::ofstream fileWriter(fileName, std::ios::binary | std::ios::app);
+    if (!blockReader.is_open() || !fileWriter.is_open()) {
+        std::cerr << "Error: Could not write the blocks to " << fileName << ".\n";
+        return false;
+    }
+    fileWriter << blockReader.rdbuf();
+    blockReader.close();
+    fileWriter.close();
+    std::remove(tempFileName.c_str());
+
+    // Written last, so it holds the fingerprint of the whole blocked file
+    DataFingerprint fingerprint;
+    if (!zoneMapFileName.empty()
+        && (!fingerprint.read(fileName) || !ZoneMap::write(zoneMapFileName, zones, fingerprint))) {
+        return false;
+    }
+    return true;
+}
+
+
+/// @brief Returns the key field of a record.
+std::string BlockWriter::keyOf(const std::string& record) const {
+    size_t start = 0;
+    for (int i = 0; i < keyFieldIndex; i++) {
+        start = record.find(',', start);
+        if (start == std::string::npos) {
+            return "";
+        }
+        start++;
+    }
+    return record.substr(start, record.find(',', start) - start);
+}
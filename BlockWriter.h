@@ -0,0 +1,148 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file BlockWriter.h
+ * @class BlockWriter
+ * @brief Writes records into a blocked sequence set file and its simple index.
+ * @author Kent Biernath
+ * @author Andrew Clayton
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Records are added one at a time in key order and packed into blocks of
+ *    the block size given to the constructor. A block is closed once adding
+ *    the next record would fill it past the target fill factor, so every
+ *    block holds only complete records. See BlockBuffer.h for the layout of
+ *    each block.
+ * \n
+ * \n The block size and fill factor are recorded in the file header so that
+ *    BlockBuffer and every other reader use the same values.
+ * \n
+ * \n For every data block, a line "RBN,Greatest Key" is written to the index
+ *    file. The key is the field at keyFieldIndex in each record, or the key
+ *    given with it to addRecord.
+ * \n
+ * \n When given a zone map file name, the latitude, longitude and state
+ *    summary of every data block is written to it as a ZoneMap, so filtered
+ *    scans can skip blocks without reading them.
+ * \n
+ * \n An empty avail list block is written after the last data block.
+ * \n
+ * \n The blocks are written to a temporary file first, since the header
+ *    records the block and record counts, and then the header and the blocks
+ *    are combined into the blocked file when close is called.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef BLOCKWRITER_H
+#define BLOCKWRITER_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include "ZoneMap.h"
+
+class BlockWriter {
+public:
+    static const int DEFAULT_BLOCK_SIZE = 512;   // Bytes per block, including padding and newline
+    static const int DEFAULT_FILL_PERCENT = 75;  // Target percentage of each block to fill
+    static const int MINIMUM_BLOCK_SIZE = 64;    // Smallest block that fits the metadata and a record
+
+    /**
+     * @brief Construct a new Block Writer object.
+     * @param fileName The name of the blocked file to create.
+     * @param indexFileName The name of the block index file to create, or "" for no index.
+     * @param blockSize The size of every block in bytes.
+     * @param fillPercent The target percentage of each block to fill, from 1 to 100.
+     * @param keyFieldIndex The field in each record that holds its key.
+     * @pre The records will be added in ascending key order.
+     * @post The temporary block file is open and ready for records.
+     */
+    BlockWriter(const std::string& fileName, const std::string& indexFileName,
+                int blockSize = DEFAULT_BLOCK_SIZE, int fillPercent = DEFAULT_FILL_PERCENT,
+                int keyFieldIndex = 0);
+
+    /// @brief Removes the temporary file if close was never called.
+    ~BlockWriter();
+
+    /**
+     * @brief Adds a record to the current block, starting a new block if it does not fit.
+     * @param record The record without a length indicator.
+     * @return false if the record cannot fit in an empty block.
+     * @pre The writer is open.
+     * @post The record is stored in the current block.
+     */
+    bool addRecord(const std::string& record);
+
+    /**
+     * @brief Adds a record whose index key is not one of its fields, such as a SpatialOrder curve position.
+     * @param key The key recorded in the index if the record is the last of its block.
+     * @return false if the record cannot fit in an empty block.
+     */
+    bool addRecord(const std::string& record, const std::string& key);
+
+    /**
+     * @brief Writes the last block, the avail list and the header to the blocked file.
+     * @return false if the blocked file could not be written.
+     * @post The blocked file and the index file are complete and closed.
+     */
+    bool close();
+
+    /// @brief Sets the number of fields per record recorded in the header (6 for ZIP code records).
+    void setFieldCount(int count) { fieldCount = count; }
+
+    /// @brief Writes the zone of every data block to a zone map file on close, such as ZoneMap::fileName of the blocked file.
+    void setZoneMapFileName(const std::string& name) { zoneMapFileName = name; }
+
+    /// @brief Sets the index schema recorded in the header, "RBN,Greatest Key" unless set.
+    void setIndexSchema(const std::string& schema) { indexSchema = schema; }
+
+    int getBlockSize() const { return blockSize; }
+    int getFillPercent() const { return fillPercent; }
+    long long getBlockCount() const { return blockCount; }
+    long long getRecordCount() const { return recordCount; }
+
+private:
+    std::string fileName;           // The blocked file to create
+    std::string tempFileName;       // Holds the blocks until the header can be written
+    std::string indexFileName;      // The simple index to create, "" for none
+    std::string zoneMapFileName;    // The zone map to create, "" for none
+    std::string indexSchema = "RBN,Greatest Key";
+    int blockSize;                  // Bytes per block
+    int fillPercent;                // Target percentage of each block to fill
+    int keyFieldIndex;              // The field in each record that holds its key
+    int fieldCount = 6;             // Number of fields per record
+    std::ofstream blockFile;        // The temporary file the blocks are written to
+    std::ofstream indexFile;        // The index file
+
+    std::vector<std::string> blockRecords;  // Length-indicated records in the current block
+    int blockRecordBytes = 0;               // Bytes used by the records in the current block
+    std::string blockGreatestKey;           // Key of the last record added to the current block
+    ZoneMap::Zone blockZone;                // Summary of the records in the current block
+    std::vector<ZoneMap::Zone> zones;       // Summaries of the blocks written
+    long long blockCount = 0;               // Number of data blocks written
+    long long recordCount = 0;              // Number of records added
+    bool closed = false;
+
+    /**
+     * @brief Builds the length-indicated metadata record for a block.
+     * @return "LI,RBN,#ofRecords,prevBlock,nextBlock," where LI counts the whole record.
+     */
+    static std::string makeMetadata(long long relativeBlockNumber, int numRecords, long long prevRBN, long long nextRBN);
+
+    /// @brief Whether a block with the given records fits within the given number of bytes.
+    bool fits(int numRecords, int recordBytes, int limitBytes) const;
+
+    /// @brief Writes one padded block to the temporary file.
+    void writeBlock(const std::string& metadata, const std::vector<std::string>& records, int recordBytes);
+
+    /// @brief Writes the current block with the given next RBN and starts a new one.
+    void flushBlock(long long nextRBN);
+
+    /// @brief Returns the key field of a record.
+    std::string keyOf(const std::string& record) const;
+};
+
+#endif // BLOCKWRITER_H
@@ -0,0 +1,317 @@
+/// @file ColumnStore.cpp
+/// @class ColumnStore
+/// See ColumnStore.h for full documentation.
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ColumnStore.h"
+#include "ZipCodeBuffer.h"
+#include "HeaderBuffer.h"
+#include "Stats.h"
+
+const uint32_t ColumnStore::MAX_STATES;
+const uint32_t ColumnStore::MAX_COUNTIES;
+
+namespace {
+    const char MAGIC[8] = { 'C', 'O', 'L', 'U', 'M', 'N', '0', '2' };
+
+    /// @brief Appends the bytes of an array to the image.
+    template <typename T>
+    void appendArray(std::string& image, const std::vector<T>& values) {
+        image.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+
+    /// @brief The number of a name, numbering it next if it is new.
+    uint32_t numberOf(std::map<std::string, uint32_t>& numbers, const std::string& name) {
+        return numbers.insert(std::make_pair(name, static_cast<uint32_t>(numbers.size()))).first->second;
+    }
+
+    /**
+     * @brief Appends a dictionary's names in sorted order and renumbers its column to match.
+     * @param column Numbers in the order first seen.
+     * @return The column renumbered in sorted order.
+     */
+    template <typename T>
+    std::vector<T> sortDictionary(const std::map<std::string, uint32_t>& numbers, const std::vector<uint32_t>& column,
+                                  std::vector<uint32_t>& nameOffsets, std::string& text) {
+        std::vector<uint32_t> sortedNumber(numbers.size());
+        uint32_t next = 0;
+        for (const auto& entry : numbers) {
+            sortedNumber[entry.second] = next++;
+            nameOffsets.push_back(static_cast<uint32_t>(text.size()));
+            text += entry.first;
+        }
+        std::vector<T> sorted;
+        sorted.reserve(column.size());
+        for (uint32_t number : column) {
+            sorted.push_back(static_cast<T>(sortedNumber[number]));
+        }
+        return sorted;
+    }
+}
+
+
+std::string ColumnStore::fileName(const std::string& dataFileName) {
+    return dataFileName + "_columns.idx";
+}
+
+
+int32_t ColumnStore::toMicrodegrees(double degrees) {
+    return static_cast<int32_t>(std::llround(degrees * 1e6));
+}
+
+
+void ColumnStore::Builder::addRecord(const std::string& record) {
+    std::vector<std::string> fields;
+    std::istringstream recordStream(record);
+    std::string field;
+    while (std::getline(recordStream, field, ',')) {
+        fields.push_back(field);
+    }
+    if (fields.size() != 6) {
+        return;
+    }
+    zipCodes.push_back(static_cast<uint32_t>(std::strtoul(fields[0].c_str(), nullptr, 10)));
+    places.push_back(numberOf(placeNumbers, fields[1]));
+    states.push_back(numberOf(stateNumbers, fields[2]));
+    counties.push_back(numberOf(countyNumbers, fields[3]));
+    latitudes.push_back(toMicrodegrees(std::atof(fields[4].c_str())));
+    longitudes.push_back(toMicrodegrees(std::atof(fields[5].c_str())));
+}
+
+
+/// @brief Sorts the dictionaries, renumbers the columns to match, then writes the image.
+bool ColumnStore::Builder::write(const std::string& columnFileName, const DataFingerprint& data) const {
+    if (stateNumbers.size() > MAX_STATES || countyNumbers.size() > MAX_COUNTIES) {
+        std::cerr << "Error: Too many distinct states or counties for " << columnFileName << "." << std::endl;
+        return false;
+    }
+
+    std::vector<uint32_t> nameOffsets;
+    std::string text;
+    std::vector<uint8_t> stateTable = sortDictionary<uint8_t>(stateNumbers, states, nameOffsets, text);
+    std::vector<uint16_t> countyTable = sortDictionary<uint16_t>(countyNumbers, counties, nameOffsets, text);
+    std::vector<uint32_t> placeTable = sortDictionary<uint32_t>(placeNumbers, places, nameOffsets, text);
+    nameOffsets.push_back(static_cast<uint32_t>(text.size()));
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.rowCount = static_cast<uint32_t>(zipCodes.size());
+    header.stateCount = static_cast<uint32_t>(stateNumbers.size());
+    header.countyCount = static_cast<uint32_t>(countyNumbers.size());
+    header.placeCount = static_cast<uint32_t>(placeNumbers.size());
+    header.textBytes = static_cast<uint32_t>(text.size());
+    header.data = data;
+
+    // The widest columns first, so every array starts aligned for its type
+    std::string image(reinterpret_cast<const char*>(&header), sizeof(header));
+    appendArray(image, zipCodes);
+    appendArray(image, latitudes);
+    appendArray(image, longitudes);
+    appendArray(image, placeTable);
+    appendArray(image, nameOffsets);
+    appendArray(image, countyTable);
+    appendArray(image, stateTable);
+    image += text;
+
+    std::ofstream columnFile(columnFileName, std::ios::binary | std::ios::trunc);
+    columnFile.write(image.data(), image.size());
+    if (!columnFile) {
+        std::cerr << "Error: Could not write " << columnFileName << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+ColumnStore::ColumnStore(const std::string& dataFileName)
+    : dataFileName(dataFileName), mapped(nullptr), mappedBytes(0), header(nullptr), zipColumn(nullptr),
+      latitudeColumn(nullptr), longitudeColumn(nullptr), placeColumn(nullptr), nameOffsets(nullptr),
+      countyColumn(nullptr), stateColumn(nullptr), text(nullptr) {
+}
+
+
+ColumnStore::~ColumnStore() {
+    unmap();
+}
+
+
+void ColumnStore::unmap() {
+    if (mapped != nullptr) {
+        ::munmap(mapped, mappedBytes);
+    }
+    mapped = nullptr;
+    mappedBytes = 0;
+    header = nullptr;
+}
+
+
+/// @brief Reads the data file once, in the order the viewer reads it, adding every record to a Builder.
+bool ColumnStore::build(const std::string& dataFileName) {
+    DataFingerprint fingerprint;
+    std::ifstream file(dataFileName, std::ios::binary);
+    if (!file.is_open() || !fingerprint.read(dataFileName)) {
+        std::cerr << "Error: Could not open " << dataFileName << " to index." << std::endl;
+        return false;
+    }
+
+    // Find the file type the same way ZipCodeTableViewer does
+    HeaderBuffer headerBuffer(dataFileName);
+    char fileType = 'C';
+    if (dataFileName.find(".csv") == std::string::npos) {
+        headerBuffer.readHeader();
+        fileType = (headerBuffer.getBlockSize() == 0) ? 'L' : 'B';
+    }
+
+    Builder builder;
+    ZipCodeBuffer buffer(file, fileType, headerBuffer);
+    std::string record;
+    while (!(record = buffer.readNextRecordString()).empty()) {
+        builder.addRecord(record);
+    }
+    return builder.write(fileName(dataFileName), fingerprint);
+}
+
+
+/// @brief Maps the column file, or builds it and maps it again if it is missing, damaged or stale.
+bool ColumnStore::open() {
+    unmap();
+    return mapColumns(false) || (build(dataFileName) && mapColumns(true));
+}
+
+
+/// @brief Maps the column file and checks that its arrays fill it exactly and its data file is unchanged.
+/// @param report Whether to report why it cannot be used, as for PlaceTrie::mapIndex.
+bool ColumnStore::mapColumns(bool report) {
+    std::string columnName = fileName(dataFileName);
+    int fd = ::open(columnName.c_str(), O_RDONLY);
+    struct stat status;
+    if (fd < 0 || ::fstat(fd, &status) != 0) {
+        if (report) {
+            std::cerr << "Error: Could not open " << columnName << ": " << std::strerror(errno) << std::endl;
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return false;
+    }
+
+    size_t bytes = static_cast<size_t>(status.st_size);
+    void* image = (bytes >= sizeof(Header)) ? ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);    // The mapping keeps the file open
+    if (image == MAP_FAILED) {
+        if (report) {
+            std::cerr << "Error: Could not map " << columnName << "." << std::endl;
+        }
+        return false;
+    }
+    mapped = image;
+    mappedBytes = bytes;
+
+    const Header* candidate = static_cast<const Header*>(image);
+    unsigned long long names = 1ULL * candidate->stateCount + candidate->countyCount + candidate->placeCount;
+    unsigned long long expected = sizeof(Header) + (4ULL + 4 + 4 + 4 + 2 + 1) * candidate->rowCount
+        + 4ULL * (names + 1) + candidate->textBytes;
+    if (std::memcmp(candidate->magic, MAGIC, sizeof(MAGIC)) != 0 || candidate->stateCount > MAX_STATES
+        || candidate->countyCount > MAX_COUNTIES || expected != bytes) {
+        if (report) {
+            std::cerr << "Error: " << columnName << " is not a column file." << std::endl;
+        }
+        unmap();
+        return false;
+    }
+    if (!candidate->data.matches(dataFileName)) {
+        if (report) {
+            std::cerr << "Error: " << dataFileName << " changed while " << columnName << " was built." << std::endl;
+        }
+        unmap();
+        return false;
+    }
+    ZIPCODE_STAT(HEADER_PARSES, 1);
+
+    header = candidate;
+    const char* position = static_cast<const char*>(image) + sizeof(Header);
+    zipColumn = reinterpret_cast<const uint32_t*>(position);
+    position += header->rowCount * sizeof(uint32_t);
+    latitudeColumn = reinterpret_cast<const int32_t*>(position);
+    position += header->rowCount * sizeof(int32_t);
+    longitudeColumn = reinterpret_cast<const int32_t*>(position);
+    position += header->rowCount * sizeof(int32_t);
+    placeColumn = reinterpret_cast<const uint32_t*>(position);
+    position += header->rowCount * sizeof(uint32_t);
+    nameOffsets = reinterpret_cast<const uint32_t*>(position);
+    position += (names + 1) * sizeof(uint32_t);
+    countyColumn = reinterpret_cast<const uint16_t*>(position);
+    position += header->rowCount * sizeof(uint16_t);
+    stateColumn = reinterpret_cast<const uint8_t*>(position);
+    text = position + header->rowCount;
+    return true;
+}
+
+
+int ColumnStore::stateNumber(const std::string& stateCode) const {
+    // State names are sorted, so search them in place
+    uint32_t low = 0;
+    uint32_t high = static_cast<uint32_t>(stateCount());
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if (name(middle) < stateCode) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    return (low < stateCount() && name(low) == stateCode) ? static_cast<int>(low) : -1;
+}
+
+
+/// @brief One pass over the ZIP code, state, latitude and longitude columns, keeping the extrema by state number.
+std::vector<ColumnStore::Extrema> ColumnStore::stateExtrema() const {
+    std::vector<Extrema> byState(stateCount());
+    std::vector<bool> seen(stateCount(), false);
+    for (size_t row = 0; row < rowCount(); row++) {
+        uint32_t state = stateColumn[row];
+        int32_t longitude = longitudeColumn[row];
+        int32_t latitude = latitudeColumn[row];
+        Extrema& extrema = byState[state];
+        if (!seen[state]) {
+            seen[state] = true;
+            extrema.state = state;
+            for (int i = 0; i < 4; i++) {
+                extrema.zipCodes[i] = zipColumn[row];
+            }
+            extrema.coordinates[0] = extrema.coordinates[1] = longitude;
+            extrema.coordinates[2] = extrema.coordinates[3] = latitude;
+            continue;
+        }
+        if (longitude < extrema.coordinates[0]) {
+            extrema.coordinates[0] = longitude;
+            extrema.zipCodes[0] = zipColumn[row];
+        }
+        else if (longitude > extrema.coordinates[1]) {
+            extrema.coordinates[1] = longitude;
+            extrema.zipCodes[1] = zipColumn[row];
+        }
+        if (latitude > extrema.coordinates[2]) {
+            extrema.coordinates[2] = latitude;
+            extrema.zipCodes[2] = zipColumn[row];
+        }
+        else if (latitude < extrema.coordinates[3]) {
+            extrema.coordinates[3] = latitude;
+            extrema.zipCodes[3] = zipColumn[row];
+        }
+    }
+    // Every state in the dictionary has a record, so every entry was seen
+    return byState;
+}
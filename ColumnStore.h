@@ -0,0 +1,185 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file ColumnStore.h
+ * @class ColumnStore
+ * @brief Memory-mapped columnar copy of a data file's records for analytical scans.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n A scan of the data file parses every field of every record from text,
+ *    though an aggregation such as the state extrema table reads only the
+ *    ZIP code, state and coordinates. The column file holds each field as
+ *    an array of its own, in the order the records are read from the data
+ *    file:
+ * \n  -- ZIP codes as uint32_t
+ * \n  -- latitudes and longitudes as int32_t microdegrees, which hold the
+ *       data's four decimal places exactly
+ * \n  -- states as uint8_t, counties as uint16_t and places as uint32_t
+ *       numbers into dictionaries of the distinct names, sorted, so
+ *       comparing two numbers compares their names
+ * \n A scan reads only the arrays it needs, a few bytes a record, with no
+ *    parsing.
+ * \n
+ * \n The file, named by fileName, is mapped with mmap like PlaceTrie. It
+ *    holds a Header, then the ZIP code, latitude, longitude and place
+ *    arrays, the offsets of the dictionary names, then the county and
+ *    state arrays and the name text. The names of every dictionary share
+ *    one offset array, the states first, then the counties and places, and
+ *    one extra offset ends the last name. Numbers are in host byte order.
+ * \n
+ * \n BlockGenerator writes the columns of every blocked file it makes, and
+ *    open builds them from the data file when they do not exist, are
+ *    damaged, or the data file no longer matches the DataFingerprint in
+ *    the Header.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef COLUMNSTORE_H
+#define COLUMNSTORE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "DataFingerprint.h"
+
+class ColumnStore {
+public:
+    static const uint32_t MAX_STATES = 256;      // Numbers must fit the uint8_t state column
+    static const uint32_t MAX_COUNTIES = 65536;  // Numbers must fit the uint16_t county column
+
+    /// @brief The easternmost, westernmost, northernmost and southernmost ZIP codes of a state.
+    struct Extrema {
+        uint32_t state;             // Dictionary number
+        uint32_t zipCodes[4];       // East, west, north, south
+        int32_t coordinates[4];     // Their longitude or latitude, in microdegrees
+    };
+
+    /// @brief Collects records, then writes the column file.
+    class Builder {
+    public:
+        /// @brief Adds a record string. Records without six fields are ignored.
+        void addRecord(const std::string& record);
+
+        /**
+         * @brief Writes the column file. Returns false if a dictionary is too large or the file could not be written.
+         * @param data The fingerprint of the data file the records were read from, taken before they were.
+         */
+        bool write(const std::string& columnFileName, const DataFingerprint& data) const;
+
+        size_t rowCount() const { return zipCodes.size(); }
+
+    private:
+        std::vector<uint32_t> zipCodes;
+        std::vector<int32_t> latitudes;
+        std::vector<int32_t> longitudes;
+        std::vector<uint32_t> states;       // Numbered in the order first seen, renumbered by write
+        std::vector<uint32_t> counties;
+        std::vector<uint32_t> places;
+        std::map<std::string, uint32_t> stateNumbers;
+        std::map<std::string, uint32_t> countyNumbers;
+        std::map<std::string, uint32_t> placeNumbers;
+    };
+
+    /**
+     * @brief Construct a new Column Store object for a data file.
+     * @param dataFileName The C, L or B file the columns are of.
+     */
+    explicit ColumnStore(const std::string& dataFileName);
+    ~ColumnStore();
+
+    ColumnStore(const ColumnStore&) = delete;
+    ColumnStore& operator=(const ColumnStore&) = delete;
+
+    /**
+     * @brief Reads a data file once and writes its columns.
+     * @param dataFileName The C, L or B file to read. Files ending in ".csv" are C files.
+     * @return false if the data file could not be read or the column file written.
+     */
+    static bool build(const std::string& dataFileName);
+
+    /**
+     * @brief Maps the column file, building it first if it does not exist, is damaged or its data file has changed.
+     * @return false if the columns could not be built, mapped, or are damaged.
+     */
+    bool open();
+
+    size_t rowCount() const { return header ? header->rowCount : 0; }
+
+    /// @name Columns
+    /// @brief Arrays of rowCount values, in data file order. Valid while the store is open.
+    /// @{
+    const uint32_t* zipCodes() const { return zipColumn; }
+    const int32_t* latitudes() const { return latitudeColumn; }
+    const int32_t* longitudes() const { return longitudeColumn; }
+    const uint8_t* states() const { return stateColumn; }
+    const uint16_t* counties() const { return countyColumn; }
+    const uint32_t* places() const { return placeColumn; }
+    /// @}
+
+    size_t stateCount() const { return header ? header->stateCount : 0; }
+    size_t countyCount() const { return header ? header->countyCount : 0; }
+    size_t placeCount() const { return header ? header->placeCount : 0; }
+
+    std::string stateName(uint32_t state) const { return name(state); }
+    std::string countyName(uint32_t county) const { return name(header->stateCount + county); }
+    std::string placeName(uint32_t place) const { return name(header->stateCount + header->countyCount + place); }
+
+    /// @brief The dictionary number of a state code as written in the data file, or -1 if no record has it.
+    int stateNumber(const std::string& stateCode) const;
+
+    /**
+     * @brief The extrema of every state, as the viewer's table shows them.
+     * @details East is the least longitude and west the greatest, as in the
+     *    table. A tie keeps the record read first.
+     * @return One entry per state, in state code order.
+     */
+    std::vector<Extrema> stateExtrema() const;
+
+    /// @brief The bytes of the column file, all of which are mapped.
+    size_t imageBytes() const { return mappedBytes; }
+
+    static int32_t toMicrodegrees(double degrees);
+    static double toDegrees(int32_t microdegrees) { return microdegrees / 1e6; }
+
+    /// @brief The column file of a data file.
+    static std::string fileName(const std::string& dataFileName);
+
+private:
+    /// @brief The start of the column file. The dictionaries hold stateCount + countyCount + placeCount names.
+    struct Header {
+        char magic[8];
+        uint32_t rowCount;
+        uint32_t stateCount;
+        uint32_t countyCount;
+        uint32_t placeCount;
+        uint32_t textBytes;
+        uint32_t reserved;
+        DataFingerprint data;       // Of the data file the columns were built from
+    };
+
+    std::string dataFileName;
+    void* mapped;
+    size_t mappedBytes;
+    const Header* header;
+    const uint32_t* zipColumn;
+    const int32_t* latitudeColumn;
+    const int32_t* longitudeColumn;
+    const uint32_t* placeColumn;
+    const uint32_t* nameOffsets;
+    const uint16_t* countyColumn;
+    const uint8_t* stateColumn;
+    const char* text;
+
+    void unmap();
+    bool mapColumns(bool report);
+    std::string name(uint32_t entry) const {
+        return std::string(text + nameOffsets[entry], nameOffsets[entry + 1] - nameOffsets[entry]);
+    }
+};
+
+#endif // COLUMNSTORE_H
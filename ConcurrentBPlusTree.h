@@ -0,0 +1,545 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file ConcurrentBPlusTree.h
+ * @class ConcurrentBPlusTree
+ * @brief B+ tree that any number of threads can search and change at once.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n The concurrent counterpart of BPlusTree, using optimistic lock
+ *    coupling. Every node has a version counter with a lock bit and an
+ *    obsolete bit. Readers take no locks: they read a node's version, read
+ *    the node, and check the version is unchanged before trusting what they
+ *    read or moving to a child, starting the operation again if a writer got
+ *    in between. Writers go down the tree the same way and only lock the
+ *    nodes they change, by moving the version they read to the locked state,
+ *    so an operation locks at most two nodes and never waits on a lock.
+ * \n
+ * \n A full node is split on the way down, before it is needed, so a split
+ *    only ever adds a key to a parent with room for it. A remove that
+ *    empties a leaf takes it out of its parent, unless it is the parent's
+ *    only child; nodes are not merged otherwise. The leaf is marked
+ *    obsolete, so readers that reach it start again, and is deleted by an
+ *    EpochManager once no thread can still be reading it.
+ * \n
+ * \n Readers copy keys and values while a writer may be changing them, and
+ *    throw the copy away when the version check fails, so keys and values
+ *    must be trivially copyable.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef CONCURRENTBPLUSTREE_H
+#define CONCURRENTBPLUSTREE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include "EpochManager.h"
+#include "NodeSearch.h"
+
+/*!
+ * @brief Concurrent B+ Tree implementation.
+ *
+ * @tparam KeyType Type of the keys in the tree. Must be trivially copyable.
+ * @tparam ValueType Type of the values associated with the keys. Must be trivially copyable.
+ * @tparam ORDER Maximum children of an internal node. At least 3.
+ */
+template <typename KeyType, typename ValueType, int ORDER = 32>
+class ConcurrentBPlusTree {
+    static_assert(ORDER >= 3, "A B+ tree node needs room for at least 3 children");
+    static_assert(std::is_trivially_copyable<KeyType>::value && std::is_trivially_copyable<ValueType>::value,
+                  "Readers copy keys and values without locks");
+
+public:
+    static const int MAX_KEYS = ORDER - 1;  /*!< Most keys in a node. */
+
+private:
+    static const unsigned long long LOCKED = 2; /*!< Version bit set while a writer holds the node. */
+    static const unsigned long long OBSOLETE = 1; /*!< Version bit set once the node is unlinked. */
+
+    /*!
+     * @brief The part shared by both kinds of node: the version and the keys.
+     */
+    struct Node {
+        std::atomic<unsigned long long> version; /*!< Changes every time the node is unlocked. */
+        const bool isLeaf; /*!< Indicates whether the node is a leaf node. */
+        int count; /*!< Number of keys in use. */
+        KeyType keys[MAX_KEYS]; /*!< Keys stored in the node, in order. */
+
+        explicit Node(bool isLeaf) : version(0), isLeaf(isLeaf), count(0) {}
+
+        /// @brief The version to check later, or needRestart if the node is locked or obsolete.
+        unsigned long long readLockOrRestart(bool& needRestart) const {
+            unsigned long long seen = version.load(std::memory_order_acquire);
+            if (seen & (LOCKED | OBSOLETE)) {
+                std::this_thread::yield(); // Let the writer finish
+                needRestart = true;
+            }
+            return seen;
+        }
+
+        /// @brief Sets needRestart if the node changed since seen was read.
+        void checkOrRestart(unsigned long long seen, bool& needRestart) const {
+            // Everything read from the node must be read before the version
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (version.load(std::memory_order_relaxed) != seen) {
+                needRestart = true;
+            }
+        }
+
+        /// @brief Locks the node if it has not changed since seen was read, or sets needRestart.
+        void upgradeToWriteLockOrRestart(unsigned long long seen, bool& needRestart) {
+            if (!version.compare_exchange_strong(seen, seen + LOCKED)) {
+                needRestart = true;
+            }
+        }
+
+        /// @brief Unlocks the node with a new version.
+        void writeUnlock() {
+            version.fetch_add(LOCKED);
+        }
+
+        /// @brief Unlocks the node and marks it obsolete, for a node unlinked from the tree.
+        void writeUnlockObsolete() {
+            version.fetch_add(LOCKED + OBSOLETE);
+        }
+    };
+
+    /*!
+     * @brief A node whose children hold keys below keys[0], from keys[0] to below keys[1], and so on.
+     */
+    struct InternalNode : Node {
+        Node* children[ORDER]; /*!< count + 1 children. */
+
+        InternalNode() : Node(false) {}
+    };
+
+    /*!
+     * @brief A node holding keys and their values.
+     */
+    struct LeafNode : Node {
+        ValueType values[MAX_KEYS]; /*!< Values associated with the keys. */
+
+        LeafNode() : Node(true) {}
+    };
+
+    std::atomic<Node*> root; /*!< Pointer to the root of the tree. Never null. */
+    std::atomic<long long> keyCount; /*!< Number of keys in the tree. */
+    mutable EpochManager epochs; /*!< Deletes unlinked leaves once no reader can hold them. */
+
+public:
+    /*!
+     * @brief Constructor for the Concurrent B+ Tree, which starts as one empty leaf.
+     */
+    ConcurrentBPlusTree() : root(new LeafNode()), keyCount(0) {}
+
+    /*!
+     * @brief Destructor for the Concurrent B+ Tree. No other thread may be using it.
+     */
+    ~ConcurrentBPlusTree() {
+        deleteTree(root.load());
+    }
+
+    ConcurrentBPlusTree(const ConcurrentBPlusTree&) = delete;
+    ConcurrentBPlusTree& operator=(const ConcurrentBPlusTree&) = delete;
+
+    /*!
+     * @brief Finds the value of a key without taking any lock.
+     *
+     * @param key The key to search for.
+     * @param value Set to the key's value if it is found.
+     * @return true if the key is in the tree.
+     */
+    bool find(const KeyType& key, ValueType& value) const {
+        EpochManager::Guard guard(epochs);
+        while (true) {
+            bool needRestart = false;
+            unsigned long long seen;
+            const Node* node = descend(key, seen, needRestart);
+            if (needRestart) {
+                continue;
+            }
+
+            const LeafNode* leaf = static_cast<const LeafNode*>(node);
+            int count = clampedCount(leaf);
+            int index = lowerBoundInNode(leaf->keys, count, key);
+            bool found = index < count && !(key < leaf->keys[index]);
+            if (found) {
+                value = leaf->values[index];
+            }
+            leaf->checkOrRestart(seen, needRestart);
+            if (!needRestart) {
+                return found;
+            }
+        }
+    }
+
+    /*!
+     * @brief Whether a key is in the tree.
+     */
+    bool contains(const KeyType& key) const {
+        ValueType value;
+        return find(key, value);
+    }
+
+    /*!
+     * @brief Inserts a key-value pair, splitting full nodes on the way down.
+     *
+     * @param key The key to insert.
+     * @param value The value associated with the key.
+     * @return false if the key was already in the tree, whose value is then unchanged.
+     */
+    bool insert(const KeyType& key, const ValueType& value) {
+        EpochManager::Guard guard(epochs);
+        while (true) {
+            bool needRestart = false;
+            Node* node = root.load(std::memory_order_acquire);
+            unsigned long long seen = node->readLockOrRestart(needRestart);
+            if (needRestart || node != root.load(std::memory_order_acquire)) {
+                continue;
+            }
+            InternalNode* parent = nullptr;
+            unsigned long long parentSeen = 0;
+
+            while (true) {
+                if (node->count == MAX_KEYS) {
+                    // Split now, while the parent is known to have room, then start again
+                    splitNode(parent, parentSeen, node, seen);
+                    break;
+                }
+                if (node->isLeaf) {
+                    int result = insertIntoLeaf(parent, parentSeen, static_cast<LeafNode*>(node), seen, key, value);
+                    if (result < 0) {
+                        break;
+                    }
+                    if (result > 0) {
+                        keyCount.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    return result > 0;
+                }
+
+                InternalNode* internal = static_cast<InternalNode*>(node);
+                if (parent) {
+                    parent->checkOrRestart(parentSeen, needRestart);
+                    if (needRestart) {
+                        break;
+                    }
+                }
+                parent = internal;
+                parentSeen = seen;
+                node = internal->children[findChildIndex(internal, key)];
+                internal->checkOrRestart(seen, needRestart);
+                if (needRestart) {
+                    break;
+                }
+                seen = node->readLockOrRestart(needRestart);
+                if (needRestart) {
+                    break;
+                }
+            }
+        }
+    }
+
+    /*!
+     * @brief Removes a key from the tree.
+     *
+     * @param key The key to remove.
+     * @return false if the key was not in the tree.
+     */
+    bool remove(const KeyType& key) {
+        EpochManager::Guard guard(epochs);
+        while (true) {
+            bool needRestart = false;
+            Node* node = root.load(std::memory_order_acquire);
+            unsigned long long seen = node->readLockOrRestart(needRestart);
+            if (needRestart || node != root.load(std::memory_order_acquire)) {
+                continue;
+            }
+            InternalNode* parent = nullptr;
+            unsigned long long parentSeen = 0;
+
+            while (!node->isLeaf) {
+                InternalNode* internal = static_cast<InternalNode*>(node);
+                if (parent) {
+                    parent->checkOrRestart(parentSeen, needRestart);
+                    if (needRestart) {
+                        break;
+                    }
+                }
+                parent = internal;
+                parentSeen = seen;
+                node = internal->children[findChildIndex(internal, key)];
+                internal->checkOrRestart(seen, needRestart);
+                if (needRestart) {
+                    break;
+                }
+                seen = node->readLockOrRestart(needRestart);
+                if (needRestart) {
+                    break;
+                }
+            }
+            if (needRestart) {
+                continue;
+            }
+
+            int result = removeFromLeaf(parent, parentSeen, static_cast<LeafNode*>(node), seen, key);
+            if (result < 0) {
+                continue;
+            }
+            if (result > 0) {
+                keyCount.fetch_sub(1, std::memory_order_relaxed);
+            }
+            return result > 0;
+        }
+    }
+
+    /*!
+     * @brief The number of keys in the tree, exact when no change is in progress.
+     */
+    size_t size() const { return static_cast<size_t>(keyCount.load(std::memory_order_relaxed)); }
+
+    bool empty() const { return size() == 0; }
+
+private:
+    /**
+     * @brief The count of a node read without a lock, which may be mid-change, kept within the arrays.
+     */
+    static int clampedCount(const Node* node) {
+        int count = node->count;
+        return (count < 0) ? 0 : (count > MAX_KEYS ? MAX_KEYS : count);
+    }
+
+    /**
+     * @brief The position of the first key in a node that is not less than key.
+     */
+    static int lowerBoundInNode(const KeyType* keys, int count, const KeyType& key) {
+        return NodeSearch<KeyType>::lowerBound(keys, count, key);
+    }
+
+    /**
+     * @brief The child of an internal node whose keys would include key.
+     */
+    static int findChildIndex(const InternalNode* node, const KeyType& key) {
+        return NodeSearch<KeyType>::upperBound(node->keys, clampedCount(node), key);
+    }
+
+    /**
+     * @brief Goes down from the root to the leaf whose keys would include key, without locking.
+     *
+     * @param seen Set to the version of the leaf read on the way.
+     * @param needRestart Set if a node changed on the way.
+     */
+    const Node* descend(const KeyType& key, unsigned long long& seen, bool& needRestart) const {
+        const Node* node = root.load(std::memory_order_acquire);
+        seen = node->readLockOrRestart(needRestart);
+        // A root that has just been split only holds the lesser half of the keys
+        if (needRestart || node != root.load(std::memory_order_acquire)) {
+            needRestart = true;
+            return nullptr;
+        }
+
+        while (!node->isLeaf) {
+            const InternalNode* internal = static_cast<const InternalNode*>(node);
+            node = internal->children[findChildIndex(internal, key)];
+            // The child pointer is only safe to follow if the parent did not change while it was read
+            internal->checkOrRestart(seen, needRestart);
+            if (needRestart) {
+                return nullptr;
+            }
+            seen = node->readLockOrRestart(needRestart);
+            if (needRestart) {
+                return nullptr;
+            }
+        }
+        return node;
+    }
+
+    /**
+     * @brief Splits a full node, locking it and its parent. The caller starts again either way.
+     *
+     * @param parent The node's parent, or nullptr if the node was the root.
+     * @param parentSeen The version of the parent read on the way down.
+     * @param node The full node.
+     * @param seen The version of the node read on the way down.
+     */
+    void splitNode(InternalNode* parent, unsigned long long parentSeen, Node* node, unsigned long long seen) {
+        bool needRestart = false;
+        if (parent) {
+            parent->upgradeToWriteLockOrRestart(parentSeen, needRestart);
+            if (needRestart) {
+                return;
+            }
+        }
+        node->upgradeToWriteLockOrRestart(seen, needRestart);
+        if (needRestart) {
+            if (parent) {
+                parent->writeUnlock();
+            }
+            return;
+        }
+        if (!parent && node != root.load()) {
+            // Another thread grew the tree above this node
+            node->writeUnlock();
+            return;
+        }
+
+        KeyType splitKey;
+        Node* right;
+        if (node->isLeaf) {
+            LeafNode* leaf = static_cast<LeafNode*>(node);
+            LeafNode* rightLeaf = new LeafNode();
+            int middle = leaf->count / 2;
+            rightLeaf->count = leaf->count - middle;
+            std::copy(leaf->keys + middle, leaf->keys + leaf->count, rightLeaf->keys);
+            std::copy(leaf->values + middle, leaf->values + leaf->count, rightLeaf->values);
+            leaf->count = middle;
+            splitKey = rightLeaf->keys[0];
+            right = rightLeaf;
+        } else {
+            InternalNode* internal = static_cast<InternalNode*>(node);
+            InternalNode* rightInternal = new InternalNode();
+            int middle = internal->count / 2;
+            rightInternal->count = internal->count - middle - 1;
+            std::copy(internal->keys + middle + 1, internal->keys + internal->count, rightInternal->keys);
+            std::copy(internal->children + middle + 1, internal->children + internal->count + 1,
+                      rightInternal->children);
+            splitKey = internal->keys[middle];
+            internal->count = middle;
+            right = rightInternal;
+        }
+
+        if (parent) {
+            int index = findChildIndex(parent, splitKey);
+            std::copy_backward(parent->keys + index, parent->keys + parent->count, parent->keys + parent->count + 1);
+            std::copy_backward(parent->children + index + 1, parent->children + parent->count + 1,
+                               parent->children + parent->count + 2);
+            parent->keys[index] = splitKey;
+            parent->children[index + 1] = right;
+            parent->count++;
+            node->writeUnlock();
+            parent->writeUnlock();
+        } else {
+            InternalNode* newRoot = new InternalNode();
+            newRoot->count = 1;
+            newRoot->keys[0] = splitKey;
+            newRoot->children[0] = node;
+            newRoot->children[1] = right;
+            root.store(newRoot, std::memory_order_release);
+            node->writeUnlock();
+        }
+    }
+
+    /**
+     * @brief Inserts into a leaf with room, locking only the leaf.
+     * @return 1 if inserted, 0 if the key was present, or -1 to start again.
+     */
+    int insertIntoLeaf(InternalNode* parent, unsigned long long parentSeen, LeafNode* leaf, unsigned long long seen,
+                       const KeyType& key, const ValueType& value) {
+        bool needRestart = false;
+        leaf->upgradeToWriteLockOrRestart(seen, needRestart);
+        if (needRestart) {
+            return -1;
+        }
+        if (parent) {
+            parent->checkOrRestart(parentSeen, needRestart);
+            if (needRestart) {
+                leaf->writeUnlock();
+                return -1;
+            }
+        }
+
+        int index = lowerBoundInNode(leaf->keys, leaf->count, key);
+        if (index < leaf->count && !(key < leaf->keys[index])) {
+            leaf->writeUnlock();
+            return 0;
+        }
+        std::copy_backward(leaf->keys + index, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+        std::copy_backward(leaf->values + index, leaf->values + leaf->count, leaf->values + leaf->count + 1);
+        leaf->keys[index] = key;
+        leaf->values[index] = value;
+        leaf->count++;
+        leaf->writeUnlock();
+        return 1;
+    }
+
+    /**
+     * @brief Removes from a leaf, taking the leaf out of its parent if it would be left empty.
+     * @return 1 if removed, 0 if the key was not present, or -1 to start again.
+     */
+    int removeFromLeaf(InternalNode* parent, unsigned long long parentSeen, LeafNode* leaf, unsigned long long seen,
+                       const KeyType& key) {
+        bool needRestart = false;
+        int count = clampedCount(leaf);
+        int index = lowerBoundInNode(leaf->keys, count, key);
+        bool found = index < count && !(key < leaf->keys[index]);
+        leaf->checkOrRestart(seen, needRestart);
+        if (needRestart) {
+            return -1;
+        }
+        if (!found) {
+            return 0;
+        }
+
+        bool unlink = count == 1 && parent && parent->count > 0;
+        if (unlink) {
+            parent->upgradeToWriteLockOrRestart(parentSeen, needRestart);
+            if (needRestart) {
+                return -1;
+            }
+        }
+        leaf->upgradeToWriteLockOrRestart(seen, needRestart);
+        if (needRestart) {
+            if (unlink) {
+                parent->writeUnlock();
+            }
+            return -1;
+        }
+        if (!unlink && parent) {
+            parent->checkOrRestart(parentSeen, needRestart);
+            if (needRestart) {
+                leaf->writeUnlock();
+                return -1;
+            }
+        }
+
+        if (unlink) {
+            // Take out the leaf and the key separating it from a sibling, which then covers its keys
+            int childIndex = findChildIndex(parent, key);
+            int keyIndex = (childIndex > 0) ? childIndex - 1 : 0;
+            std::copy(parent->keys + keyIndex + 1, parent->keys + parent->count, parent->keys + keyIndex);
+            std::copy(parent->children + childIndex + 1, parent->children + parent->count + 1,
+                      parent->children + childIndex);
+            parent->count--;
+            leaf->writeUnlockObsolete();
+            parent->writeUnlock();
+            epochs.retire(leaf);
+            return 1;
+        }
+
+        std::copy(leaf->keys + index + 1, leaf->keys + leaf->count, leaf->keys + index);
+        std::copy(leaf->values + index + 1, leaf->values + leaf->count, leaf->values + index);
+        leaf->count--;
+        leaf->writeUnlock();
+        return 1;
+    }
+
+    void deleteTree(Node* node) {
+        if (node->isLeaf) {
+            delete static_cast<LeafNode*>(node);
+            return;
+        }
+        InternalNode* internal = static_cast<InternalNode*>(node);
+        for (int i = 0; i <= internal->count; ++i) {
+            deleteTree(internal->children[i]);
+        }
+        delete internal;
+    }
+};
+
+#endif // CONCURRENTBPLUSTREE_H
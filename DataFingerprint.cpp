@@ -0,0 +1,94 @@
+/// @file DataFingerprint.cpp
+/// @class DataFingerprint
+/// See DataFingerprint.h for full documentation.
+
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <vector>
+#include "DataFingerprint.h"
+
+const uint64_t DataFingerprint::HASH_START;
+
+
+uint64_t DataFingerprint::hashBytes(const char* data, size_t size, uint64_t hash) {
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+
+bool DataFingerprint::stamp(const std::string& fileName, int64_t& bytes, int64_t& modified) {
+    struct stat status;
+    if (::stat(fileName.c_str(), &status) != 0) {
+        return false;
+    }
+    bytes = static_cast<int64_t>(status.st_size);
+    modified = static_cast<int64_t>(status.st_mtim.tv_sec) * 1000000000 + status.st_mtim.tv_nsec;
+    return true;
+}
+
+
+/// @brief Takes the stamp before reading, so a change while the file is hashed makes the fingerprint stale.
+bool DataFingerprint::read(const std::string& fileName, bool withHash) {
+    bytes = -1;
+    modified = -1;
+    hash = 0;
+    if (!stamp(fileName, bytes, modified)) {
+        return false;
+    }
+    if (!withHash) {
+        return true;
+    }
+
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    uint64_t contentHash = HASH_START;
+    std::vector<char> chunk(1 << 16);
+    while (file.read(chunk.data(), chunk.size()) || file.gcount() > 0) {
+        contentHash = hashBytes(chunk.data(), static_cast<size_t>(file.gcount()), contentHash);
+    }
+    hash = contentHash;
+    return true;
+}
+
+
+bool DataFingerprint::matches(const std::string& fileName, bool* sameModified) const {
+    if (sameModified != nullptr) {
+        *sameModified = false;
+    }
+    DataFingerprint current;
+    if (!current.read(fileName, false) || current.bytes != bytes) {
+        return false;
+    }
+    if (current.modified == modified) {
+        if (sameModified != nullptr) {
+            *sameModified = true;
+        }
+        return true;
+    }
+    return current.read(fileName, true) && current.bytes == bytes && current.hash == hash;
+}
+
+
+std::string DataFingerprint::text() const {
+    return std::to_string(bytes) + " " + std::to_string(modified) + " " + std::to_string(hash);
+}
+
+
+bool DataFingerprint::parse(const std::string& text) {
+    std::istringstream fields(text);
+    long long parsedBytes, parsedModified;
+    unsigned long long parsedHash;
+    std::string rest;
+    if (!(fields >> parsedBytes >> parsedModified >> parsedHash) || (fields >> rest)) {
+        return false;
+    }
+    bytes = parsedBytes;
+    modified = parsedModified;
+    hash = parsedHash;
+    return true;
+}
@@ -0,0 +1,71 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file DataFingerprint.h
+ * @class DataFingerprint
+ * @brief The size, modification time and content hash of a data file, kept by every file made from it.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n An index or other file made from a data file holds the data file's
+ *    fingerprint from when it was made, and is made again once matches
+ *    is false. matches compares:
+ * \n  -- the size, which differs after most changes
+ * \n  -- the modification time, in nanoseconds
+ * \n  -- only if the time differs, as after a copy or touch, the hash,
+ *       which reads the whole data file
+ * \n so a file whose size and time are unchanged is taken to be unchanged
+ *    without being read.
+ * \n
+ * \n The hash is 64-bit FNV-1a. The struct holds only numbers, so it can be
+ *    stored as is in the Header of a binary file, and text gives it as
+ *    "<bytes> <modified> <hash>" for text files.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef DATAFINGERPRINT_H
+#define DATAFINGERPRINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+struct DataFingerprint {
+    int64_t bytes;                  // Size of the data file
+    int64_t modified;               // Its modification time, in nanoseconds
+    uint64_t hash;                  // FNV-1a hash of its contents, 0 if not read
+
+    static const uint64_t HASH_START = 14695981039346656037ULL;
+
+    /**
+     * @brief Reads the fingerprint of a data file.
+     * @param fileName The data file.
+     * @param withHash Whether to read the whole file for its hash, which is left 0 otherwise.
+     * @return false if the file could not be read.
+     */
+    bool read(const std::string& fileName, bool withHash = true);
+
+    /**
+     * @brief Whether a data file is still the one this fingerprint was read from.
+     * @param sameModified If given, set to whether the modification time matched, so the hash was not read.
+     * @return false if the file could not be read or differs.
+     */
+    bool matches(const std::string& fileName, bool* sameModified = nullptr) const;
+
+    /// @brief "<bytes> <modified> <hash>".
+    std::string text() const;
+
+    /// @brief Parses what text gives. Returns false if it is not a fingerprint.
+    bool parse(const std::string& text);
+
+    /// @brief Continues a 64-bit FNV-1a hash over a range of bytes.
+    static uint64_t hashBytes(const char* data, size_t size, uint64_t hash = HASH_START);
+
+    /// @brief Reads the size and modification time of a file. Returns false if it cannot be read.
+    static bool stamp(const std::string& fileName, int64_t& bytes, int64_t& modified);
+};
+
+#endif // DATAFINGERPRINT_H
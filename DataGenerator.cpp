@@ -0,0 +1,114 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file DataGenerator.cpp
+ * @brief Console program for generating synthetic ZIP code data files.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Writes a deterministic synthetic dataset with RecordGenerator. The same
+ *    options and seed always produce the same file.
+ * \n
+ * \n Usage: DataGenerator <output file> [options]
+ * \n  --records <count>          Number of records (default 1000000)
+ * \n  --seed <number>            Random seed (default 331)
+ * \n  --keys dense|sparse|skewed Key distribution (default dense)
+ * \n  --gap <number>             Average key gap for sparse and skewed keys (default 10)
+ * \n  --lengths uniform|normal|fixed  Name length distribution (default uniform)
+ * \n  --name-length <min>:<max>  Shortest and longest names (default 4:16)
+ * \n  --places <count>           Distinct place names (default one per four records)
+ * \n  --counties <count>         Distinct county names (default 3000)
+ * \n  --type C|L|B               CSV, length-indicated or blocked (default L)
+ * \n  --block-size <bytes>       Block size for blocked files (default 512)
+ * \n  --fill <percent>           Block fill factor for blocked files (default 75)
+ * \n  --index <file>             Block index for blocked files (default <output file>_index.txt)
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <stdexcept>
+#include "RecordGenerator.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Error: No file name given.\n";
+        cerr << "Usage: " << argv[0] << " <output file> [--records <count>] [--seed <number>] [--keys dense|sparse|skewed]\n"
+             << "       [--gap <number>] [--lengths uniform|normal|fixed] [--name-length <min>:<max>] [--places <count>]\n"
+             << "       [--counties <count>] [--type C|L|B] [--block-size <bytes>] [--fill <percent>] [--index <file>]\n";
+        return 1;
+    }
+
+    string outputFile = argv[1];
+    string indexFile;
+    char fileType = 'L';
+    RecordGenerator::Settings settings;
+
+    for (int i = 2; i < argc; i += 2) {
+        string flag = argv[i];
+        if (i + 1 == argc) {
+            cerr << "Error: No value given for " << flag << "\n";
+            return 1;
+        }
+        string value = argv[i + 1];
+        try {
+            if (flag == "--records") {
+                settings.recordCount = stoll(value);
+            } else if (flag == "--seed") {
+                settings.seed = stoull(value);
+            } else if (flag == "--keys") {
+                if (!RecordGenerator::parseKeyDistribution(value, settings.keyDistribution)) {
+                    throw invalid_argument(value);
+                }
+            } else if (flag == "--gap") {
+                settings.keyGap = stoi(value);
+            } else if (flag == "--lengths") {
+                if (!RecordGenerator::parseLengthDistribution(value, settings.lengthDistribution)) {
+                    throw invalid_argument(value);
+                }
+            } else if (flag == "--name-length") {
+                size_t colon = value.find(':');
+                settings.minNameLength = stoi(value.substr(0, colon));
+                settings.maxNameLength = (colon == string::npos) ? settings.minNameLength : stoi(value.substr(colon + 1));
+            } else if (flag == "--places") {
+                settings.placeCount = stoi(value);
+            } else if (flag == "--counties") {
+                settings.countyCount = stoi(value);
+            } else if (flag == "--type") {
+                fileType = static_cast<char>(toupper(value[0]));
+                if (fileType != 'C' && fileType != 'L' && fileType != 'B') {
+                    throw invalid_argument(value);
+                }
+            } else if (flag == "--block-size") {
+                settings.blockSize = stoi(value);
+            } else if (flag == "--fill") {
+                settings.fillPercent = stoi(value);
+            } else if (flag == "--index") {
+                indexFile = value;
+            } else {
+                cerr << "Error: Unknown option " << flag << "\n";
+                return 1;
+            }
+        } catch (const logic_error& e) {
+            cerr << "Error: Invalid value for " << flag << ": " << value << "\n";
+            return 1;
+        }
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    RecordGenerator generator(settings);
+    long long written = generator.writeFile(outputFile, fileType, indexFile);
+    if (written < 0) {
+        return 1;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "Wrote " << written << " records to " << outputFile << " in " << seconds << " s." << endl;
+    return 0;
+}
@@ -50,8 +50,8 @@ void Dump::dumpPhysicalOrder() {
     std::cout << "List Head RBN: " << headerBuffer.getRBNS() << std::endl;
     std::cout << "Avail Head RBN: " << headerBuffer.getRBNA() << std::endl;
 
-    int i = 0;
-    int endpoint = headerBuffer.getBlockCount();
+    long long i = 0;
+    long long endpoint = headerBuffer.getBlockCount();
     while (i < endpoint)
     {
         // Read the number of blocks listed in the file metadata
@@ -0,0 +1,121 @@
+/// @file EpochManager.cpp
+/// @class EpochManager
+/// See EpochManager.h for full documentation.
+
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include "EpochManager.h"
+
+namespace {
+    std::mutex threadNumbersMutex;
+    std::vector<bool> threadNumbersUsed(EpochManager::MAX_THREADS, false);
+
+    /// @brief Holds a thread number for the lifetime of a thread.
+    struct ThreadNumber {
+        int number;
+
+        ThreadNumber() : number(-1) {
+            std::lock_guard<std::mutex> lock(threadNumbersMutex);
+            for (int i = 0; i < EpochManager::MAX_THREADS; i++) {
+                if (!threadNumbersUsed[i]) {
+                    threadNumbersUsed[i] = true;
+                    number = i;
+                    return;
+                }
+            }
+            std::cerr << "Error: More than " << EpochManager::MAX_THREADS
+                      << " threads are using an EpochManager." << std::endl;
+            std::abort();
+        }
+
+        ~ThreadNumber() {
+            std::lock_guard<std::mutex> lock(threadNumbersMutex);
+            threadNumbersUsed[number] = false;
+        }
+    };
+}
+
+
+EpochManager::EpochManager() : globalEpoch(1) {
+}
+
+
+EpochManager::~EpochManager() {
+    for (Slot& slot : slots) {
+        for (const Retired& retired : slot.retired) {
+            retired.deleter(retired.object);
+        }
+    }
+}
+
+
+int EpochManager::threadNumber() {
+    static thread_local ThreadNumber thread;
+    return thread.number;
+}
+
+
+EpochManager::Guard::Guard(EpochManager& manager) : manager(manager) {
+    Slot& slot = manager.slots[threadNumber()];
+    if (slot.depth++ == 0) {
+        // Sequentially consistent, so any thread deciding what to delete after
+        // this store sees this thread as active
+        slot.epoch.store(manager.globalEpoch.load());
+    }
+}
+
+
+EpochManager::Guard::~Guard() {
+    Slot& slot = manager.slots[threadNumber()];
+    if (--slot.depth == 0) {
+        slot.epoch.store(INACTIVE);
+    }
+}
+
+
+/// @brief Queues an object for deletion, and every RETIRE_BATCH objects deletes what it can.
+void EpochManager::retire(void* object, void (*deleter)(void*)) {
+    Slot& slot = slots[threadNumber()];
+    Retired retired = { object, deleter, globalEpoch.load() };
+    slot.retired.push_back(retired);
+    if (slot.retired.size() % RETIRE_BATCH == 0) {
+        tryAdvance();
+        collect(slot);
+    }
+}
+
+
+/// @brief Moves to the next epoch if every active thread entered in the current one.
+void EpochManager::tryAdvance() {
+    unsigned long long epoch = globalEpoch.load();
+    for (const Slot& slot : slots) {
+        unsigned long long entered = slot.epoch.load();
+        if (entered != INACTIVE && entered != epoch) {
+            return;
+        }
+    }
+    globalEpoch.compare_exchange_strong(epoch, epoch + 1);
+}
+
+
+/// @brief Deletes the objects of a slot retired before every active thread entered.
+void EpochManager::collect(Slot& slot) {
+    unsigned long long oldestActive = globalEpoch.load();
+    for (const Slot& other : slots) {
+        unsigned long long entered = other.epoch.load();
+        if (entered != INACTIVE && entered < oldestActive) {
+            oldestActive = entered;
+        }
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < slot.retired.size(); i++) {
+        if (slot.retired[i].epoch < oldestActive) {
+            slot.retired[i].deleter(slot.retired[i].object);
+        } else {
+            slot.retired[kept++] = slot.retired[i];
+        }
+    }
+    slot.retired.resize(kept);
+}
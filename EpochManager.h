@@ -0,0 +1,114 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file EpochManager.h
+ * @class EpochManager
+ * @brief Epoch-based reclamation of objects that other threads may still be reading.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n A lock-free reader may hold a pointer to a node just as a writer
+ *    unlinks it, so the writer cannot delete the node at once. Each
+ *    operation on the shared structure holds a Guard, which records the
+ *    global epoch the thread entered in. Unlinked objects are passed to
+ *    retire, tagged with the epoch they were retired in, and deleted once
+ *    every thread inside a Guard entered in a later epoch: no thread that
+ *    could have seen the object is still running.
+ * \n
+ * \n Each thread has its own slot, found by a process-wide thread number,
+ *    and only that thread touches its list of retired objects. Every
+ *    RETIRE_BATCH retirements the thread tries to advance the epoch and
+ *    deletes what it can. Objects still waiting are deleted by the
+ *    destructor, which must not run while any thread holds a Guard.
+ * \n
+ * \n At most MAX_THREADS threads may use EpochManagers at the same time.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef EPOCHMANAGER_H
+#define EPOCHMANAGER_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+class EpochManager {
+public:
+    /// @brief Threads that may hold a thread number at the same time.
+    static const int MAX_THREADS = 256;
+
+    /// @brief Retirements between attempts to advance the epoch and delete.
+    static const size_t RETIRE_BATCH = 64;
+
+    EpochManager();
+
+    /// @brief Deletes every retired object. No thread may hold a Guard.
+    ~EpochManager();
+
+    EpochManager(const EpochManager&) = delete;
+    EpochManager& operator=(const EpochManager&) = delete;
+
+    /// @brief Marks the calling thread as reading the shared structure for its lifetime. May be nested.
+    class Guard {
+    public:
+        explicit Guard(EpochManager& manager);
+        ~Guard();
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        EpochManager& manager;
+    };
+
+    /**
+     * @brief Deletes an object once no thread can still be reading it.
+     * @param object An object no longer reachable by threads entering from now on.
+     * @param deleter Called with the object to delete it.
+     * @pre The calling thread holds a Guard on this manager.
+     */
+    void retire(void* object, void (*deleter)(void*));
+
+    /// @brief Retires an object allocated with new.
+    template <class T>
+    void retire(T* object) {
+        retire(object, [](void* retired) { delete static_cast<T*>(retired); });
+    }
+
+    /// @brief The current global epoch.
+    unsigned long long getEpoch() const { return globalEpoch.load(); }
+
+private:
+    /// @brief Epoch of a slot whose thread holds no Guard.
+    static const unsigned long long INACTIVE = 0;
+
+    struct Retired {
+        void* object;
+        void (*deleter)(void*);
+        unsigned long long epoch;       // Global epoch when retired
+    };
+
+    /// @brief The state of one thread, padded so threads entering do not share a cache line.
+    struct Slot {
+        std::atomic<unsigned long long> epoch;
+        int depth;                      // Guards the thread holds
+        std::vector<Retired> retired;   // Only touched by the slot's thread
+        char padding[64];
+
+        Slot() : epoch(INACTIVE), depth(0) {}
+    };
+
+    std::atomic<unsigned long long> globalEpoch;
+    Slot slots[MAX_THREADS];
+
+    void tryAdvance();
+    void collect(Slot& slot);
+
+    /// @brief The calling thread's number, reserved until it exits.
+    static int threadNumber();
+};
+
+#endif // EPOCHMANAGER_H
@@ -4,6 +4,7 @@
 /// See HeaderBuffer.h for the class declaration and documentation.
 
 #include "HeaderBuffer.h"
+#include "Stats.h"
 #include <iostream>
 #include <fstream>
 #include <string>
@@ -21,6 +22,7 @@
         sizeFormatType_ = "ASCII";
         blockSize_ = 0;
         minimumBlockCapacity_ = 0;
+        blockFillPercent_ = 0;
         primaryKeyIndexFileName_ = "default_index.txt";
         primaryKeyIndexFileSchema_ = "default_schema";
         recordCount_ = 0;
@@ -45,7 +47,10 @@
 
     /// @brief Constructor to initialize HeaderBuffer with a filename.
     /// @param filename The name of the header file to be opened as a string.
-    HeaderBuffer::HeaderBuffer(const std::string& filename) : filename_(filename) {
+    HeaderBuffer::HeaderBuffer(const std::string& filename) : filename_(filename),
+        headerSizeBytes_(0), recordSizeBytes_(0), blockSize_(0), minimumBlockCapacity_(0),
+        blockFillPercent_(0), recordCount_(0), blockCount_(0), fieldCount_(0),
+        primaryKeyFieldIndex_(0), RBNA_(0), RBNS_(0), staleFlag_(0) {
     }
 
     /// @brief Write the header data to a file. Used for updating the file in the object 
@@ -114,7 +119,8 @@
     /// @brief Write the header data to a file. Used for writing to a file different than the one in the object 
     /// @pre filename the name of the file to be written to.
     void HeaderBuffer::writeHeaderToFile(const std::string& filename) {
-        std::ofstream file(filename);
+        // Binary mode so the header occupies exactly the bytes counted in its Header Size field
+        std::ofstream file(filename, std::ios::binary);
 
         if (!file.is_open()) {
             // Print an error mesage if the file cannot be opened
@@ -123,40 +129,38 @@
             return;
         }
 
-        //version for seeing all the stuff
-        file << "Header:" << std::endl;
-        file << " - File structure type: " << fileStructureType_ << std::endl;
-        file << " - File structure version: " << fileStructureVersion_ << std::endl;
-        file << " - Header Size (bytes): " << headerSizeBytes_ << std::endl;
-        file << " - Record Size (bytes): " << recordSizeBytes_ << std::endl;
-        file << " - Size Format Type: " << sizeFormatType_ << std::endl;
-        file << " - Block Size: " << blockSize_ << std::endl;
-        file << " - Minimum Block Capacity: " << minimumBlockCapacity_ << std::endl;
-        file << " - Primary Key Index File: " << primaryKeyIndexFileName_ << std::endl;
-        file << " - Primary Key Index File Schema: " << primaryKeyIndexFileSchema_ << std::endl;
-        file << " - Record Count: " << recordCount_ << std::endl;
-        file << " - Block Count: " << blockCount_ << std::endl;
-        file << " - Field Count: " << fieldCount_ << std::endl;
-        file << " - Primary Key: " << primaryKeyFieldIndex_ << std::endl;
-        file << " - RBN link for Avail List: " << RBNA_ << std::endl;
-        file << " - RBN link for active sequence set List: " << RBNS_ << std::endl;
-        file << " - Stale Flag: " << staleFlag_ << std::endl;
+        file << formatHeader(headerSizeBytes_);
 
-        for (const Field& field : fields_) {
-            file << std::endl;
-            file << "Fields:" << std::endl;
-            file << "   - Zip Code: " << field.zipCode << std::endl;
-            file << "   - Place Name: " << field.placeName << std::endl;
-            file << "   - State: " << field.state << std::endl;
-            file << "   - County: " << field.county << std::endl;
-            file << "   - Latitude: " << field.latitude << std::endl;
-            file << "   - Longitude: " << field.longitude << std::endl;
-        }
+        file.close();
+    }
 
-        file << std::endl;
-        file << "Data:" << std::endl;
+    /// @brief Write the Stale Flag over its value in the file, right-aligned in the same width.
+    /// @pre The file must be successfully opened for reading and writing.
+    bool HeaderBuffer::writeStaleFlag() {
+        std::fstream file(filename_, std::ios::in | std::ios::out | std::ios::binary);
 
-        file.close();
+        if (!file.is_open()) {
+            std::cerr << "Error opening the file(writeStaleFlag)." << std::endl;
+            return false;
+        }
+
+        const std::string label = " - Stale Flag: ";
+        std::string line;
+        std::streampos lineStart = file.tellg();
+        while (std::getline(file, line) && line.find("Data:") != 0) {
+            if (line.compare(0, label.size(), label) == 0) {
+                size_t width = line.size() - label.size() - (line.back() == '\r' ? 1 : 0);
+                std::string value = std::to_string(staleFlag_);
+                if (value.size() > width) {
+                    return false;
+                }
+                file.seekp(lineStart + std::streamoff(label.size()));
+                file << std::string(width - value.size(), ' ') << value;
+                return static_cast<bool>(file.flush());
+            }
+            lineStart = file.tellg();
+        }
+        return false;
     }
 
     /// @brief Reader header data from a file.
@@ -171,9 +175,22 @@
         }
 
         std::string line;
+
+        ZIPCODE_STAT(HEADER_PARSES, 1);
+
+        // A file without a header (such as a CSV file) has nothing to read
+        if (!std::getline(file, line) || line.find("Header:") == std::string::npos) {
+            file.close();
+            return;
+        }
         
-        while (std::getline(file, line)) {
-            if (line.find(" - File structure type: ") != std::string::npos) {
+        // Stop at the "Data:" line so the records are never read, however large the file is
+        bool endOfHeader = false;
+        while (!endOfHeader && std::getline(file, line)) {
+            if (line.find("Data:") == 0) {
+                break;
+            }
+            else if (line.find(" - File structure type: ") != std::string::npos) {
                 fileStructureType_ = line.substr(line.find(": ") + 2);
                 
             }
@@ -200,6 +217,10 @@
             else if (line.find(" - Minimum Block Capacity: ") != std::string::npos) {
                 minimumBlockCapacity_ = std::stoi(line.substr(line.find(": ") + 2));
                 
+            }
+            else if (line.find(" - Block Fill Factor (%): ") != std::string::npos) {
+                blockFillPercent_ = std::stoi(line.substr(line.find(": ") + 2));
+                
             }
             else if (line.find(" - Primary Key Index File: ") != std::string::npos) {
                 primaryKeyIndexFileName_ = line.substr(line.find(": ") + 2);
@@ -210,11 +231,11 @@
                 
             }
             else if (line.find(" - Record Count: ") != std::string::npos) {
-                recordCount_ = std::stoi(line.substr(line.find(": ") + 2));
+                recordCount_ = std::stoll(line.substr(line.find(": ") + 2));
                 
             }
             else if (line.find(" - Block Count: ") != std::string::npos) {
-                blockCount_ = std::stoi(line.substr(line.find(": ") + 2));
+                blockCount_ = std::stoll(line.substr(line.find(": ") + 2));
                 
             }
             else if (line.find(" - Field Count: ") != std::string::npos) {
@@ -226,11 +247,11 @@
                 
             }
             else if (line.find(" - RBN link for Avail List: ") != std::string::npos) {
-                RBNA_ = std::stoi(line.substr(line.find(": ") + 2));
+                RBNA_ = std::stoll(line.substr(line.find(": ") + 2));
                 
             }
             else if (line.find(" - RBN link for active sequence set List: ") != std::string::npos) {
-                RBNS_ = std::stoi(line.substr(line.find(": ") + 2));
+                RBNS_ = std::stoll(line.substr(line.find(": ") + 2));
                 
             }
             else if (line.find(" - Stale Flag: ") != std::string::npos) {
@@ -242,7 +263,11 @@
                 
                 Field field;
                 while (std::getline(file, line)) {
-                    if (line.find("   - Zip Code: ") != std::string::npos) {
+                    if (line.find("Data:") == 0) {
+                        endOfHeader = true;
+                        break;
+                    }
+                    else if (line.find("   - Zip Code: ") != std::string::npos) {
                         field.zipCode = line.substr(line.find(": ") + 2);
                     }
                     else if (line.find("   - Place Name: ") != std::string::npos) {
@@ -268,20 +293,21 @@
         file.close();
     }
 
-    /// @brief calculates the total bytes the header will take up based on its static structure and variables
-    /// @pre the header object must have data to work with 
-    int HeaderBuffer::calculateHeaderSize() const {
+    /// @brief Formats the header exactly as writeHeaderToFile writes it.
+    /// @param headerSizeBytes The value to write in the Header Size field.
+    std::string HeaderBuffer::formatHeader(int headerSizeBytes) const {
         std::stringstream headerStream;
 
         // Write header data to a stringstream
         headerStream << "Header:\n";
         headerStream << " - File structure type: " << fileStructureType_ << "\n";
         headerStream << " - File structure version: " << fileStructureVersion_ << "\n";
-        headerStream << " - Header Size (bytes): " << headerSizeBytes_ << "\n";
+        headerStream << " - Header Size (bytes): " << headerSizeBytes << "\n";
         headerStream << " - Record Size (bytes): " << recordSizeBytes_ << "\n";
         headerStream << " - Size Format Type: " << sizeFormatType_ << "\n";
         headerStream << " - Block Size: " << blockSize_ << "\n";
         headerStream << " - Minimum Block Capacity: " << minimumBlockCapacity_ << "\n";
+        headerStream << " - Block Fill Factor (%): " << blockFillPercent_ << "\n";
         headerStream << " - Primary Key Index File: " << primaryKeyIndexFileName_ << "\n";
         headerStream << " - Primary Key Index File Schema: " << primaryKeyIndexFileSchema_ << "\n";
         headerStream << " - Record Count: " << recordCount_ << "\n";
@@ -292,8 +318,8 @@
         headerStream << " - RBN link for active sequence set List: " << RBNS_ << "\n";
         headerStream << " - Stale Flag: " << staleFlag_ << "\n";
 
-        headerStream << "\nFields:\n";
         for (const Field& field : fields_) {
+            headerStream << "\nFields:\n";
             headerStream << "   - Zip Code: " << field.zipCode << "\n";
             headerStream << "   - Place Name: " << field.placeName << "\n";
             headerStream << "   - State: " << field.state << "\n";
@@ -303,10 +329,23 @@
         }
 
         headerStream << "\nData:\n";
+        return headerStream.str();
+    }
 
-        // Calculate total size including the newline characters
-        return static_cast<int>(headerStream.str().size());
-}
+    /// @brief calculates the total bytes the header will take up based on its static structure and variables
+    /// @pre the header object must have data to work with 
+    int HeaderBuffer::calculateHeaderSize() const {
+        // The size is written inside the header itself, so repeat until the number of digits settles
+        int size = headerSizeBytes_;
+        for (int i = 0; i < 4; i++) {
+            int newSize = static_cast<int>(formatHeader(size).size());
+            if (newSize == size) {
+                break;
+            }
+            size = newSize;
+        }
+        return size;
+    }
 
     /// @brief Setters for various header fields.
     /// @param fileStructureType The file structure type as a string.
@@ -344,6 +383,11 @@
         minimumBlockCapacity_ = minimumBlockCapacity;
     }
 
+    /// @param blockFillPercent The percentage of each block filled when the file was generated.
+    void HeaderBuffer::setBlockFillPercent(int blockFillPercent) {
+        blockFillPercent_ = blockFillPercent;
+    }
+
     /// @param primaryKeyIndexFileName The primary key index file name as a string.
     void HeaderBuffer::setPrimaryKeyIndexFileName(const std::string& primaryKeyIndexFileName) {
         primaryKeyIndexFileName_ = primaryKeyIndexFileName;
@@ -354,13 +398,13 @@
         primaryKeyIndexFileSchema_ = primaryKeyIndexFileSchema;
     }
 
-    /// @param recordCount The record count as an integer.
-    void HeaderBuffer::setRecordCount(int recordCount) {
+    /// @param recordCount The record count as a 64-bit integer.
+    void HeaderBuffer::setRecordCount(long long recordCount) {
         recordCount_ = recordCount;
     }
 
-    /// @param blockCount The block count as an integer.
-    void HeaderBuffer::setBlockCount(int blockCount) {
+    /// @param blockCount The block count as a 64-bit integer.
+    void HeaderBuffer::setBlockCount(long long blockCount) {
         blockCount_ = blockCount;
     }
 
@@ -374,13 +418,13 @@
         primaryKeyFieldIndex_ = primaryKeyFieldIndex;
     }
 
-    /// @param RBNA The RBNA as an integer.
-    void HeaderBuffer::setRBNA(int RBNA) {
+    /// @param RBNA The RBNA as a 64-bit integer.
+    void HeaderBuffer::setRBNA(long long RBNA) {
         RBNA_ = RBNA;
     }
 
-    /// @param RBNS The RBNA as an integer.
-    void HeaderBuffer::setRBNS(int RBNS) {
+    /// @param RBNS The RBNS as a 64-bit integer.
+    void HeaderBuffer::setRBNS(long long RBNS) {
         RBNS_ = RBNS;
     }
 
@@ -424,14 +468,22 @@
         return minimumBlockCapacity_;
     }
 
-    int HeaderBuffer::getBlockCount() const {
+    int HeaderBuffer::getBlockFillPercent() const {
+        return blockFillPercent_;
+    }
+
+    long long HeaderBuffer::getBlockCount() const {
         return blockCount_;
     }
     std::string HeaderBuffer::getPrimaryKeyIndexFileName() const {
         return primaryKeyIndexFileName_;
     }
 
-    int HeaderBuffer::getRecordCount() const {
+    std::string HeaderBuffer::getPrimaryKeyIndexFileSchema() const {
+        return primaryKeyIndexFileSchema_;
+    }
+
+    long long HeaderBuffer::getRecordCount() const {
         return recordCount_;
     }
 
@@ -443,11 +495,11 @@
         return primaryKeyFieldIndex_;
     }
 
-    int HeaderBuffer::getRBNA() const {
+    long long HeaderBuffer::getRBNA() const {
         return RBNA_;
     }
 
-    int HeaderBuffer::getRBNS() const {
+    long long HeaderBuffer::getRBNS() const {
         return RBNS_;
     }
 
@@ -20,8 +20,11 @@
  * \n  -- Header Size (bytes) (int)
  * \n  -- Record Size (bytes) (int)
  * \n  -- Size Format Type (string)
+ * \n  -- Block Size (bytes) (int)
+ * \n  -- Minimum Block Capacity (int)
+ * \n  -- Block Fill Factor (percent of each block filled at generation) (int)
  * \n  -- Primary Key Index File (string)
- * \n  -- Record Count (int)
+ * \n  -- Record Count (64-bit int)
  * \n  -- Field Count (int)
  * \n  -- Primary Key Field Index (int)
  * \n  -- Fields
@@ -78,12 +81,18 @@ public:
     /// @pre The file must be successfully opened for writing.
     void writeHeaderToFile(const std::string& filename);
 
+    /// @brief Write the Stale Flag into the file held by the object, over the value already there.
+    /// The new value is padded with spaces to the old one's width, so no other byte of the file moves.
+    /// @return false if the file has no Stale Flag line, or the value is wider than the one there.
+    bool writeStaleFlag();
+
     /// @brief Read header data from a file.
     /// @pre The file must be successfully opened for reading.
     void readHeader();
 
     /// @brief calculates the size of the header in bytes
     /// @pre values must be in the istance of headerBuffer's variables to count
+    /// @return The size the header will have once written with that size in its own Header Size field.
     int calculateHeaderSize() const;
 
     void setFileStructureType(const std::string& fileStructureType);
@@ -93,14 +102,15 @@ public:
     void setSizeFormatType(const std::string& sizeFormatType);
     void setBlockSize(int blockSize);
     void setminimumBlockCapacity(int minimumBlockCapacity);
+    void setBlockFillPercent(int blockFillPercent);
     void setPrimaryKeyIndexFileName(const std::string& primaryKeyIndexFileName);
     void setprimaryKeyIndexFileSchema(const std::string& primaryKeyIndexFileSchema);
-    void setRecordCount(int recordCount);
-    void setBlockCount(int blockCount);
+    void setRecordCount(long long recordCount);
+    void setBlockCount(long long blockCount);
     void setFieldCount(int fieldCount);
     void setPrimaryKeyFieldIndex(int primaryKeyFieldIndex);
-    void setRBNA(int RBNA);
-    void setRBNS(int RBNS);
+    void setRBNA(long long RBNA);
+    void setRBNS(long long RBNS);
     void setstaleFlag(int staleFlag);
     void addField(const Field& field);
 
@@ -111,13 +121,15 @@ public:
     std::string getSizeFormatType() const;
     int getBlockSize() const;
     int getMinimumBlockCapacity() const;
+    int getBlockFillPercent() const;
     std::string getPrimaryKeyIndexFileName() const;
-    int getRecordCount() const;
-    int getBlockCount() const;
+    std::string getPrimaryKeyIndexFileSchema() const;
+    long long getRecordCount() const;
+    long long getBlockCount() const;
     int getFieldCount() const;
     int getPrimaryKeyFieldIndex() const;
-    int getRBNA() const;
-    int getRBNS() const;
+    long long getRBNA() const;
+    long long getRBNS() const;
     int getStaleFlag() const;
     const std::vector<Field>& getFields() const;
 
@@ -130,16 +142,21 @@ private:
     std::string sizeFormatType_;
     int blockSize_;
     int minimumBlockCapacity_;
+    int blockFillPercent_;
     std::string primaryKeyIndexFileName_;
     std::string primaryKeyIndexFileSchema_;
-    int recordCount_;
-    int blockCount_;
+    long long recordCount_;
+    long long blockCount_;
     int fieldCount_;
     int primaryKeyFieldIndex_;
-    int RBNA_;
-    int RBNS_;
+    long long RBNA_;
+    long long RBNS_;
     int staleFlag_;
     std::vector<Field> fields_;
+
+    /// @brief Formats the header exactly as it is written to the file.
+    /// @param headerSizeBytes The value to write in the Header Size field.
+    std::string formatHeader(int headerSizeBytes) const;
 };
 // #include "HeaderBuffer.cpp"
 #endif // HEADERBUFFER_H
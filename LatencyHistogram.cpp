@@ -0,0 +1,230 @@
+/// @file LatencyHistogram.cpp
+/// @class LatencyHistogram
+/// See LatencyHistogram.h for full documentation.
+
+#include <mutex>
+#include <vector>
+#include "LatencyHistogram.h"
+
+namespace {
+    // Every thread's histograms, by path. The registry is never destroyed, so
+    // the histograms can still be reported from an atexit handler.
+    std::vector<LatencyHistogram*>& registeredHistograms(LatencyHistogram::Path path) {
+        static std::vector<LatencyHistogram*>* histograms = new std::vector<LatencyHistogram*>[LatencyHistogram::PATH_COUNT];
+        return histograms[path];
+    }
+
+    std::mutex& registryMutex() {
+        static std::mutex* mutex = new std::mutex();
+        return *mutex;
+    }
+
+    /// @brief Position of the highest set bit.
+    int highestBit(unsigned long long value) {
+        return 63 - __builtin_clzll(value);
+    }
+}
+
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+
+/// @brief Clears every count.
+void LatencyHistogram::reset() {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        counts[i].store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    total.store(0, std::memory_order_relaxed);
+    min.store(~0ULL, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+
+/// @brief The bucket a value falls in.
+int LatencyHistogram::bucketIndex(unsigned long long value) {
+    if (value < static_cast<unsigned long long>(SUB_BUCKET_COUNT)) {
+        return static_cast<int>(value); // Exact below 32 ns
+    }
+    int exponent = highestBit(value) - SUB_BUCKET_BITS;
+    int index = (exponent + 1) * SUB_BUCKET_COUNT + static_cast<int>((value >> exponent) - SUB_BUCKET_COUNT);
+    return index < BUCKET_COUNT ? index : BUCKET_COUNT - 1;
+}
+
+
+/// @brief The lowest value of a bucket.
+unsigned long long LatencyHistogram::bucketLowest(int index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return static_cast<unsigned long long>(index);
+    }
+    int exponent = index / SUB_BUCKET_COUNT - 1;
+    return static_cast<unsigned long long>(SUB_BUCKET_COUNT + index % SUB_BUCKET_COUNT) << exponent;
+}
+
+
+/// @brief The highest value of a bucket.
+unsigned long long LatencyHistogram::bucketHighest(int index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return static_cast<unsigned long long>(index);
+    }
+    int exponent = index / SUB_BUCKET_COUNT - 1;
+    return bucketLowest(index) + (1ULL << exponent) - 1;
+}
+
+
+/// @brief Records one latency in nanoseconds.
+void LatencyHistogram::record(unsigned long long nanoseconds) {
+    counts[bucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+    unsigned long long current = min.load(std::memory_order_relaxed);
+    while (nanoseconds < current && !min.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed)) {
+    }
+    current = max.load(std::memory_order_relaxed);
+    while (nanoseconds > current && !max.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+
+/// @brief Adds the counts of another histogram to this one.
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.getCount() == 0) {
+        return;
+    }
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        unsigned long long bucketCount = other.counts[i].load(std::memory_order_relaxed);
+        if (bucketCount != 0) {
+            counts[i].fetch_add(bucketCount, std::memory_order_relaxed);
+        }
+    }
+    count.fetch_add(other.getCount(), std::memory_order_relaxed);
+    total.fetch_add(other.total.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    if (other.getMin() < getMin()) {
+        min.store(other.getMin(), std::memory_order_relaxed);
+    }
+    if (other.getMax() > getMax()) {
+        max.store(other.getMax(), std::memory_order_relaxed);
+    }
+}
+
+
+unsigned long long LatencyHistogram::getCount() const {
+    return count.load(std::memory_order_relaxed);
+}
+
+
+unsigned long long LatencyHistogram::getMin() const {
+    return getCount() == 0 ? 0 : min.load(std::memory_order_relaxed);
+}
+
+
+unsigned long long LatencyHistogram::getMax() const {
+    return max.load(std::memory_order_relaxed);
+}
+
+
+double LatencyHistogram::getMean() const {
+    unsigned long long recorded = getCount();
+    return recorded == 0 ? 0.0 : static_cast<double>(total.load(std::memory_order_relaxed)) / recorded;
+}
+
+
+/// @brief The latency at or below which the given fraction of recordings fall.
+unsigned long long LatencyHistogram::percentile(double fraction) const {
+    unsigned long long recorded = getCount();
+    if (recorded == 0) {
+        return 0;
+    }
+    // The rank of the recording at the percentile, counting from 1
+    unsigned long long rank = static_cast<unsigned long long>(fraction * recorded + 0.5);
+    rank = rank < 1 ? 1 : (rank > recorded ? recorded : rank);
+
+    unsigned long long seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += counts[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            unsigned long long highest = bucketHighest(i);
+            return highest < getMax() ? highest : getMax();
+        }
+    }
+    return getMax();
+}
+
+
+/// @brief Prints the summary on one line.
+void LatencyHistogram::print(std::ostream& out, const std::string& name) const {
+    out << name << ": count " << getCount() << ", mean " << getMean() << " ns, min " << getMin()
+        << " ns, p50 " << percentile(0.50) << " ns, p90 " << percentile(0.90) << " ns, p99 " << percentile(0.99)
+        << " ns, p99.9 " << percentile(0.999) << " ns, max " << getMax() << " ns" << std::endl;
+}
+
+
+/// @brief Writes the summary as a JSON object.
+void LatencyHistogram::writeJSON(std::ostream& out, const std::string& name) const {
+    out << "{\"name\": \"" << name << "\", \"count\": " << getCount() << ", \"mean_ns\": " << getMean()
+        << ", \"min_ns\": " << getMin() << ", \"p50_ns\": " << percentile(0.50) << ", \"p90_ns\": " << percentile(0.90)
+        << ", \"p99_ns\": " << percentile(0.99) << ", \"p999_ns\": " << percentile(0.999)
+        << ", \"max_ns\": " << getMax() << "}";
+}
+
+
+/// @brief This thread's histogram for a path.
+LatencyHistogram& LatencyHistogram::local(Path path) {
+    thread_local LatencyHistogram* histograms[PATH_COUNT] = {};
+    if (histograms[path] == nullptr) {
+        histograms[path] = new LatencyHistogram();
+        std::lock_guard<std::mutex> lock(registryMutex());
+        registeredHistograms(path).push_back(histograms[path]);
+    }
+    return *histograms[path];
+}
+
+
+/// @brief Merges every thread's histogram for a path.
+void LatencyHistogram::collect(Path path, LatencyHistogram& into) {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    for (const LatencyHistogram* histogram : registeredHistograms(path)) {
+        into.merge(*histogram);
+    }
+}
+
+
+/// @brief The snake_case name of a path.
+const char* LatencyHistogram::pathName(Path path) {
+    switch (path) {
+    case BLOCK_SEARCH:  return "block_search";
+    case SEARCH_HELPER: return "search_helper";
+    case RANGE_SCAN:    return "range_scan";
+    default:            return "unknown";
+    }
+}
+
+
+/// @brief Prints the merged histogram of every path that recorded anything.
+void LatencyHistogram::printAll(std::ostream& out) {
+    out << "Latency:" << std::endl;
+    for (int i = 0; i < PATH_COUNT; i++) {
+        LatencyHistogram merged;
+        collect(static_cast<Path>(i), merged);
+        if (merged.getCount() > 0) {
+            out << " - ";
+            merged.print(out, pathName(static_cast<Path>(i)));
+        }
+    }
+}
+
+
+/// @brief Writes the merged histograms of every path as one JSON object.
+void LatencyHistogram::writeAllJSON(std::ostream& out) {
+    out << "{\"latency\": [";
+    for (int i = 0; i < PATH_COUNT; i++) {
+        LatencyHistogram merged;
+        collect(static_cast<Path>(i), merged);
+        out << (i == 0 ? "" : ", ");
+        merged.writeJSON(out, pathName(static_cast<Path>(i)));
+    }
+    out << "]}" << std::endl;
+}
@@ -0,0 +1,132 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file LatencyHistogram.h
+ * @class LatencyHistogram
+ * @brief Log-bucketed latency histogram for the lookup paths, mergeable across threads.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Records latencies in nanoseconds into buckets in the style of an HDR
+ *    histogram: every power of two is split into 32 linear sub-buckets, so
+ *    any recorded value is known to within about 3%, from 1 ns up to about
+ *    4.8 hours, in a fixed 10 KiB of counters. Recording is one relaxed
+ *    atomic add, and percentiles such as p50, p99 and p99.9 are read from
+ *    the bucket counts.
+ * \n
+ * \n Each lookup path has one histogram per thread, created on the thread's
+ *    first recording and kept until exit. collect merges every thread's
+ *    histogram for a path, so threads never contend while recording:
+ * \n  -- BLOCK_SEARCH: BlockSearch::searchForRecord, and lookups of blocked
+ *       files in lookupConcurrently
+ * \n  -- SEARCH_HELPER: lookups of C and L files in lookupConcurrently
+ * \n  -- RANGE_SCAN: BlockSearch::searchRange, and the -R ranges of blocked
+ *       files in ZipCodeTableViewer
+ * \n
+ * \n The paths time themselves with the ZIPCODE_LATENCY_TIMER macro, which,
+ *    like ZIPCODE_STAT, is compiled out by -DZIPCODE_DISABLE_STATS.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <string>
+
+class LatencyHistogram {
+public:
+    enum Path { BLOCK_SEARCH, SEARCH_HELPER, RANGE_SCAN, PATH_COUNT };
+
+    static const int SUB_BUCKET_BITS = 5;                          // 32 sub-buckets per power of two
+    static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static const int MAX_VALUE_BITS = 44;                          // Values up to 2^44 ns
+    static const int BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    LatencyHistogram();
+
+    /// @brief Records one latency in nanoseconds. Larger values than the range are clamped.
+    void record(unsigned long long nanoseconds);
+
+    /// @brief Adds the counts of another histogram to this one.
+    void merge(const LatencyHistogram& other);
+
+    /// @brief Clears every count.
+    void reset();
+
+    unsigned long long getCount() const;
+    unsigned long long getMin() const;
+    unsigned long long getMax() const;
+    double getMean() const;
+
+    /**
+     * @brief The latency at or below which the given fraction of recordings fall.
+     * @param fraction The percentile as a fraction, such as 0.999 for p99.9.
+     * @return The highest value in the bucket holding that percentile, at most getMax().
+     */
+    unsigned long long percentile(double fraction) const;
+
+    /// @brief Prints the count, mean, min, p50, p90, p99, p99.9 and max on one line.
+    void print(std::ostream& out, const std::string& name) const;
+
+    /// @brief Writes the same summary as a JSON object.
+    void writeJSON(std::ostream& out, const std::string& name) const;
+
+    /// @brief The bucket a value falls in.
+    static int bucketIndex(unsigned long long value);
+
+    /// @brief The lowest and highest values of a bucket.
+    static unsigned long long bucketLowest(int index);
+    static unsigned long long bucketHighest(int index);
+
+    /// @brief This thread's histogram for a path.
+    static LatencyHistogram& local(Path path);
+
+    /// @brief Merges every thread's histogram for a path into the given histogram.
+    static void collect(Path path, LatencyHistogram& into);
+
+    /// @brief The snake_case name of a path, such as "block_search".
+    static const char* pathName(Path path);
+
+    /// @brief Prints the merged histogram of every path that recorded anything.
+    static void printAll(std::ostream& out);
+
+    /// @brief Writes the merged histograms of every path as one JSON object.
+    static void writeAllJSON(std::ostream& out);
+
+    /// @brief Records the time from its construction to its destruction into this thread's histogram for a path.
+    class Timer {
+    public:
+        explicit Timer(Path path) : path(path), start(std::chrono::steady_clock::now()) {}
+        ~Timer() {
+            local(path).record(static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count()));
+        }
+    private:
+        Path path;
+        std::chrono::steady_clock::time_point start;
+    };
+
+private:
+    std::atomic<unsigned long long> counts[BUCKET_COUNT];
+    std::atomic<unsigned long long> count;
+    std::atomic<unsigned long long> total;
+    std::atomic<unsigned long long> min;
+    std::atomic<unsigned long long> max;
+
+    LatencyHistogram(const LatencyHistogram&);              // Not copyable
+    LatencyHistogram& operator=(const LatencyHistogram&);
+};
+
+#ifdef ZIPCODE_DISABLE_STATS
+#define ZIPCODE_LATENCY_TIMER(path) ((void)0)
+#else
+#define ZIPCODE_LATENCY_TIMER(path) LatencyHistogram::Timer latencyTimer(LatencyHistogram::path)
+#endif
+
+#endif // LATENCYHISTOGRAM_H
@@ -0,0 +1,449 @@
+/// @file NGramIndex.cpp
+/// @class NGramIndex
+/// See NGramIndex.h for full documentation.
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "NGramIndex.h"
+#include "ZipCodeBuffer.h"
+#include "HeaderBuffer.h"
+#include "Stats.h"
+
+const size_t NGramIndex::GRAM_LENGTH;
+
+namespace {
+    const char MAGIC[8] = { 'N', 'G', 'R', 'A', 'M', 'X', '0', '2' };
+    const char PAD = '$';       // Marks the ends of a key; normalized keys never hold it
+
+    /// @brief The distinct trigrams of a normalized key with a pad at each end, ascending.
+    void cutGrams(const std::string& key, std::vector<uint32_t>& grams) {
+        std::string padded = PAD + key + PAD;
+        grams.clear();
+        for (size_t i = 0; i + NGramIndex::GRAM_LENGTH <= padded.size(); i++) {
+            grams.push_back((static_cast<uint32_t>(static_cast<unsigned char>(padded[i])) << 16)
+                            | (static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 1])) << 8)
+                            | static_cast<unsigned char>(padded[i + 2]));
+        }
+        std::sort(grams.begin(), grams.end());
+        grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    }
+
+    /// @brief A pattern of at most 64 characters as one bit mask per character, for Myers' algorithm.
+    struct Pattern {
+        uint64_t masks[256];        // Bit i set where the pattern holds the character at position i
+        size_t length;
+
+        explicit Pattern(const std::string& pattern) : length(pattern.size()) {
+            std::memset(masks, 0, sizeof(masks));
+            for (size_t i = 0; i < length; i++) {
+                masks[static_cast<unsigned char>(pattern[i])] |= 1ULL << i;
+            }
+        }
+    };
+
+    /**
+     * @brief The edit distance from a pattern to a text, one column of the dynamic programming table per step.
+     * @details The column's vertical differences, each +1, 0 or -1, are kept as the bit vectors
+     *    plusVertical and minusVertical, so a step is a few word operations (Hyyro's form of Myers'
+     *    algorithm). The last row is the distance so far and changes by at most one a column.
+     * @return The distance, or bound + 1 once the distance must exceed bound.
+     */
+    int boundedDistance(const Pattern& pattern, const char* text, size_t textLength, int bound) {
+        if (pattern.length == 0) {
+            return static_cast<int>(std::min<size_t>(textLength, static_cast<size_t>(bound) + 1));
+        }
+        uint64_t plusVertical = ~0ULL;
+        uint64_t minusVertical = 0;
+        const uint64_t lastRow = 1ULL << (pattern.length - 1);
+        int score = static_cast<int>(pattern.length);
+        for (size_t j = 0; j < textLength; j++) {
+            uint64_t equal = pattern.masks[static_cast<unsigned char>(text[j])];
+            uint64_t crossVertical = equal | minusVertical;
+            uint64_t crossHorizontal = (((equal & plusVertical) + plusVertical) ^ plusVertical) | equal;
+            uint64_t plusHorizontal = minusVertical | ~(crossHorizontal | plusVertical);
+            uint64_t minusHorizontal = plusVertical & crossHorizontal;
+            if (plusHorizontal & lastRow) {
+                score++;
+            }
+            else if (minusHorizontal & lastRow) {
+                score--;
+            }
+            // The first row grows by one a column, so a +1 is shifted in
+            plusHorizontal = (plusHorizontal << 1) | 1;
+            minusHorizontal <<= 1;
+            plusVertical = minusHorizontal | ~(crossVertical | plusHorizontal);
+            minusVertical = plusHorizontal & crossVertical;
+            if (score - static_cast<int>(textLength - j - 1) > bound) {
+                return bound + 1;
+            }
+        }
+        return score;
+    }
+
+    /// @brief The edit distance by the full table, two rows at a time, for patterns too long for one word.
+    int tableDistance(const std::string& a, const char* b, size_t bLength) {
+        std::vector<int> previous(bLength + 1), current(bLength + 1);
+        for (size_t j = 0; j <= bLength; j++) {
+            previous[j] = static_cast<int>(j);
+        }
+        for (size_t i = 1; i <= a.size(); i++) {
+            current[0] = static_cast<int>(i);
+            for (size_t j = 1; j <= bLength; j++) {
+                int substitution = previous[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1);
+                current[j] = std::min(substitution, std::min(previous[j], current[j - 1]) + 1);
+            }
+            previous.swap(current);
+        }
+        return previous[bLength];
+    }
+
+    /// @brief Appends the bytes of an array to the image.
+    template <typename T>
+    void appendArray(std::string& image, const std::vector<T>& values) {
+        image.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+}
+
+
+std::string NGramIndex::indexFileName(const std::string& dataFileName) {
+    return dataFileName + "_ngram_index.idx";
+}
+
+
+int NGramIndex::defaultDistance(size_t length) {
+    if (length < 4) {
+        return 0;
+    }
+    return static_cast<int>(std::min<size_t>(3, length / 4));
+}
+
+
+int NGramIndex::editDistance(const std::string& a, const std::string& b) {
+    if (a.size() > 64) {
+        return tableDistance(a, b.data(), b.size());
+    }
+    return boundedDistance(Pattern(a), b.data(), b.size(), static_cast<int>(a.size() + b.size()));
+}
+
+
+void NGramIndex::Builder::addTerm(SecondaryIndex::Field field, const std::string& term, const std::string& key,
+                                  const std::string& name, int zipCode) {
+    if (key.empty()) {
+        return;
+    }
+    Entry& entry = terms[std::string(1, static_cast<char>('0' + field)) + term];
+    if (entry.key.empty()) {
+        entry.field = field;
+        entry.key = key;
+        entry.name = name;
+    }
+    entry.zipCodes.push_back(zipCode);
+}
+
+
+void NGramIndex::Builder::add(const std::string& placeName, const std::string& state, const std::string& county,
+                              int zipCode) {
+    std::string placeTerm = SecondaryIndex::placeTerm(placeName);
+    addTerm(SecondaryIndex::PLACE, placeTerm, placeTerm, placeName, zipCode);
+
+    // Counties are told apart by state but matched on their name alone
+    std::string countyTerm = SecondaryIndex::countyTerm(state, county);
+    std::string stateCode = countyTerm.substr(0, countyTerm.find('/'));
+    addTerm(SecondaryIndex::COUNTY, countyTerm, SecondaryIndex::normalize(county), county + ", " + stateCode, zipCode);
+}
+
+
+void NGramIndex::Builder::addRecord(const std::string& record) {
+    std::vector<std::string> fields;
+    std::istringstream recordStream(record);
+    std::string field;
+    while (std::getline(recordStream, field, ',')) {
+        fields.push_back(field);
+    }
+    if (fields.size() == 6) {
+        add(fields[1], fields[2], fields[3], std::atoi(fields[0].c_str()));
+    }
+}
+
+
+/// @brief Numbers the terms in map order, lists the terms of every trigram, then writes the image.
+bool NGramIndex::Builder::write(const std::string& indexFileName, const DataFingerprint& data) const {
+    std::vector<Term> termTable;
+    std::vector<int32_t> zipTable;
+    std::string keyText;
+    std::string text;
+    std::map<uint32_t, std::vector<uint32_t> > gramTerms;
+    std::vector<uint32_t> termGrams;
+    for (const auto& entry : terms) {
+        std::vector<int> zipCodes = entry.second.zipCodes;
+        std::sort(zipCodes.begin(), zipCodes.end());
+        zipCodes.erase(std::unique(zipCodes.begin(), zipCodes.end()), zipCodes.end());
+
+        uint32_t id = static_cast<uint32_t>(termTable.size());
+        Term term;
+        term.keyOffset = static_cast<uint32_t>(keyText.size());
+        term.textOffset = static_cast<uint32_t>(text.size());
+        term.zipOffset = static_cast<uint32_t>(zipTable.size());
+        term.field = static_cast<uint32_t>(entry.second.field);
+        termTable.push_back(term);
+        zipTable.insert(zipTable.end(), zipCodes.begin(), zipCodes.end());
+        keyText += entry.second.key;
+        text += entry.second.name;
+
+        cutGrams(entry.second.key, termGrams);
+        for (uint32_t gram : termGrams) {
+            gramTerms[gram].push_back(id);
+        }
+    }
+    // The extra term ends the last term's key, name and ZIP codes
+    Term endTerm;
+    endTerm.keyOffset = static_cast<uint32_t>(keyText.size());
+    endTerm.textOffset = static_cast<uint32_t>(text.size());
+    endTerm.zipOffset = static_cast<uint32_t>(zipTable.size());
+    endTerm.field = 0;
+    termTable.push_back(endTerm);
+
+    std::vector<Gram> gramTable;
+    std::vector<uint32_t> postingTable;
+    for (const auto& entry : gramTerms) {
+        Gram gram;
+        gram.gram = entry.first;
+        gram.postingOffset = static_cast<uint32_t>(postingTable.size());
+        gramTable.push_back(gram);
+        postingTable.insert(postingTable.end(), entry.second.begin(), entry.second.end());
+    }
+    Gram endGram;
+    endGram.gram = 0xFFFFFFFF;
+    endGram.postingOffset = static_cast<uint32_t>(postingTable.size());
+    gramTable.push_back(endGram);
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.termCount = static_cast<uint32_t>(terms.size());
+    header.zipCount = static_cast<uint32_t>(zipTable.size());
+    header.gramCount = static_cast<uint32_t>(gramTerms.size());
+    header.postingCount = static_cast<uint32_t>(postingTable.size());
+    header.keyBytes = static_cast<uint32_t>(keyText.size());
+    header.textBytes = static_cast<uint32_t>(text.size());
+    header.data = data;
+
+    std::string image(reinterpret_cast<const char*>(&header), sizeof(header));
+    appendArray(image, termTable);
+    appendArray(image, zipTable);
+    appendArray(image, gramTable);
+    appendArray(image, postingTable);
+    image += keyText;
+    image += text;
+
+    std::ofstream indexFile(indexFileName, std::ios::binary | std::ios::trunc);
+    indexFile.write(image.data(), image.size());
+    if (!indexFile) {
+        std::cerr << "Error: Could not write " << indexFileName << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+NGramIndex::NGramIndex(const std::string& dataFileName)
+    : dataFileName(dataFileName), mapped(nullptr), mappedBytes(0), header(nullptr), terms(nullptr), zips(nullptr),
+      grams(nullptr), postings(nullptr), keys(nullptr), text(nullptr) {
+}
+
+
+NGramIndex::~NGramIndex() {
+    unmap();
+}
+
+
+void NGramIndex::unmap() {
+    if (mapped != nullptr) {
+        ::munmap(mapped, mappedBytes);
+    }
+    mapped = nullptr;
+    mappedBytes = 0;
+    header = nullptr;
+}
+
+
+/// @brief Reads the data file once, adding every record to a Builder, then writes the index.
+bool NGramIndex::build(const std::string& dataFileName) {
+    DataFingerprint fingerprint;
+    std::ifstream file(dataFileName, std::ios::binary);
+    if (!file.is_open() || !fingerprint.read(dataFileName)) {
+        std::cerr << "Error: Could not open " << dataFileName << " to index." << std::endl;
+        return false;
+    }
+
+    // Find the file type the same way ZipCodeTableViewer does
+    HeaderBuffer headerBuffer(dataFileName);
+    char fileType = 'C';
+    if (dataFileName.find(".csv") == std::string::npos) {
+        headerBuffer.readHeader();
+        fileType = (headerBuffer.getBlockSize() == 0) ? 'L' : 'B';
+    }
+
+    Builder builder;
+    ZipCodeBuffer buffer(file, fileType, headerBuffer);
+    std::string record;
+    while (!(record = buffer.readNextRecordString()).empty()) {
+        builder.addRecord(record);
+    }
+    return builder.write(indexFileName(dataFileName), fingerprint);
+}
+
+
+/// @brief Maps the index file, or builds it and maps it again if it is missing, damaged or stale.
+bool NGramIndex::open() {
+    unmap();
+    return mapIndex(false) || (build(dataFileName) && mapIndex(true));
+}
+
+
+/// @brief Maps the index file and checks that its arrays fill it exactly and its data file is unchanged.
+/// @param report Whether to report why it cannot be used, as for PlaceTrie::mapIndex.
+bool NGramIndex::mapIndex(bool report) {
+    std::string indexName = indexFileName(dataFileName);
+    int fd = ::open(indexName.c_str(), O_RDONLY);
+    struct stat status;
+    if (fd < 0 || ::fstat(fd, &status) != 0) {
+        if (report) {
+            std::cerr << "Error: Could not open " << indexName << ": " << std::strerror(errno) << std::endl;
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return false;
+    }
+
+    size_t bytes = static_cast<size_t>(status.st_size);
+    void* image = (bytes >= sizeof(Header)) ? ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);    // The mapping keeps the file open
+    if (image == MAP_FAILED) {
+        if (report) {
+            std::cerr << "Error: Could not map " << indexName << "." << std::endl;
+        }
+        return false;
+    }
+    mapped = image;
+    mappedBytes = bytes;
+
+    const Header* candidate = static_cast<const Header*>(image);
+    unsigned long long expected = sizeof(Header) + (candidate->termCount + 1ULL) * sizeof(Term)
+        + 4ULL * candidate->zipCount + (candidate->gramCount + 1ULL) * sizeof(Gram) + 4ULL * candidate->postingCount
+        + candidate->keyBytes + candidate->textBytes;
+    if (std::memcmp(candidate->magic, MAGIC, sizeof(MAGIC)) != 0 || expected != bytes) {
+        if (report) {
+            std::cerr << "Error: " << indexName << " is not an n-gram index." << std::endl;
+        }
+        unmap();
+        return false;
+    }
+    if (!candidate->data.matches(dataFileName)) {
+        if (report) {
+            std::cerr << "Error: " << dataFileName << " changed while " << indexName << " was built." << std::endl;
+        }
+        unmap();
+        return false;
+    }
+    ZIPCODE_STAT(HEADER_PARSES, 1);
+
+    header = candidate;
+    const char* position = static_cast<const char*>(image) + sizeof(Header);
+    terms = reinterpret_cast<const Term*>(position);
+    position += (header->termCount + 1) * sizeof(Term);
+    zips = reinterpret_cast<const int32_t*>(position);
+    position += header->zipCount * sizeof(int32_t);
+    grams = reinterpret_cast<const Gram*>(position);
+    position += (header->gramCount + 1) * sizeof(Gram);
+    postings = reinterpret_cast<const uint32_t*>(position);
+    position += header->postingCount * sizeof(uint32_t);
+    keys = position;
+    text = position + header->keyBytes;
+    return true;
+}
+
+
+NGramIndex::Match NGramIndex::match(uint32_t term, int distance) const {
+    Match result;
+    result.field = static_cast<SecondaryIndex::Field>(terms[term].field);
+    result.name.assign(text + terms[term].textOffset, terms[term + 1].textOffset - terms[term].textOffset);
+    result.distance = distance;
+    result.zipCodes.assign(zips + terms[term].zipOffset, zips + terms[term + 1].zipOffset);
+    return result;
+}
+
+
+/// @brief Counts the trigrams each term shares with the query, then verifies the terms with enough of them.
+std::vector<NGramIndex::Match> NGramIndex::search(const std::string& text, size_t count, int maxDistance) const {
+    std::vector<Match> matches;
+    std::string key = SecondaryIndex::normalize(text);
+    if (header == nullptr || key.empty() || count == 0) {
+        return matches;
+    }
+    int bound = (maxDistance < 0) ? defaultDistance(key.size()) : maxDistance;
+
+    std::vector<uint32_t> queryGrams;
+    cutGrams(key, queryGrams);
+    size_t lost = GRAM_LENGTH * static_cast<size_t>(bound);
+    size_t required = (queryGrams.size() > lost) ? queryGrams.size() - lost : 1;
+
+    std::vector<uint32_t> shared(header->termCount, 0);
+    std::vector<uint32_t> candidates;
+    const Gram* gramsEnd = grams + header->gramCount;
+    for (uint32_t gram : queryGrams) {
+        const Gram* found = std::lower_bound(grams, gramsEnd, gram,
+                                             [](const Gram& candidate, uint32_t wanted) { return candidate.gram < wanted; });
+        if (found == gramsEnd || found->gram != gram) {
+            continue;
+        }
+        for (uint32_t p = found->postingOffset; p < found[1].postingOffset; p++) {
+            if (shared[postings[p]]++ == 0) {
+                candidates.push_back(postings[p]);
+            }
+        }
+    }
+
+    // Only candidates with enough trigrams and a close enough length pay for the edit distance
+    Pattern pattern(key.size() <= 64 ? key : std::string());
+    std::vector<std::pair<int, uint32_t> > ranked;     // Distance and term
+    for (uint32_t term : candidates) {
+        size_t length = keyLength(term);
+        size_t lengthGap = (length > key.size()) ? length - key.size() : key.size() - length;
+        if (shared[term] < required || lengthGap > static_cast<size_t>(bound)) {
+            continue;
+        }
+        const char* termKey = keys + terms[term].keyOffset;
+        int distance = (key.size() <= 64) ? boundedDistance(pattern, termKey, length, bound)
+                                          : tableDistance(key, termKey, length);
+        if (distance <= bound) {
+            ranked.push_back(std::make_pair(distance, term));
+        }
+    }
+
+    // Fewest edits, then most ZIP codes, then term order, which is alphabetical within a field
+    auto ranksBefore = [this](const std::pair<int, uint32_t>& a, const std::pair<int, uint32_t>& b) {
+        if (a.first != b.first) {
+            return a.first < b.first;
+        }
+        uint32_t zipsA = zipCount(a.second);
+        uint32_t zipsB = zipCount(b.second);
+        return zipsA != zipsB ? zipsA > zipsB : a.second < b.second;
+    };
+    size_t kept = std::min(count, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + kept, ranked.end(), ranksBefore);
+    for (size_t i = 0; i < kept; i++) {
+        matches.push_back(match(ranked[i].second, ranked[i].first));
+    }
+    return matches;
+}
@@ -0,0 +1,189 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file NGramIndex.h
+ * @class NGramIndex
+ * @brief Memory-mapped trigram index of place and county names for misspelling-tolerant search.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Finds the place names and counties within a few edits of what was
+ *    typed, e.g. "Holtsvile" finds Holtsville, with their ZIP codes. A term
+ *    is a distinct place name, as in SecondaryIndex::placeTerm, or a
+ *    distinct county of a state, matched on the county name alone. Matches
+ *    are ranked by edit distance, then by number of ZIP codes, then
+ *    alphabetically.
+ * \n
+ * \n Every term's normalized name, with a '$' added at each end, is cut
+ *    into its trigrams, and each trigram lists the terms holding it. A
+ *    search counts, for every term, how many of the query's trigrams it
+ *    shares. One edit changes at most GRAM_LENGTH trigrams, so a term
+ *    within k edits of a query of n trigrams shares at least n - 3k of them,
+ *    and only terms passing that count, and within k of the query's length,
+ *    are candidates. Only the candidates are checked with the real edit
+ *    distance, computed 64 characters at a time with Myers' bit-parallel
+ *    algorithm and abandoned once it cannot come back within k.
+ * \n
+ * \n A candidate must share at least one trigram, so when n <= 3k the count
+ *    filter is no longer exact and a match sharing no trigram with the
+ *    query is missed. defaultDistance never allows that.
+ * \n
+ * \n The index file, named by indexFileName, is laid out like PlaceTrie's
+ *    and mapped with mmap: a Header, then arrays of Term, ZIP codes,
+ *    Gram, postings, keys and display names. A Term or Gram is only
+ *    offsets; its lengths are the differences to the next one, and one
+ *    extra entry ends each array. Numbers are in host byte order.
+ * \n
+ * \n open builds the index from the data file when it does not exist, is
+ *    damaged, or the data file no longer matches the DataFingerprint in
+ *    its Header.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef NGRAMINDEX_H
+#define NGRAMINDEX_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "SecondaryIndex.h"
+#include "DataFingerprint.h"
+
+class NGramIndex {
+public:
+    static const size_t GRAM_LENGTH = 3;
+
+    /// @brief One term within the edit distance of a query.
+    struct Match {
+        SecondaryIndex::Field field;    // PLACE or COUNTY
+        std::string name;               // A place name, or "County, ST"
+        int distance;                   // Edits between the normalized query and name
+        std::vector<int> zipCodes;      // Ascending
+    };
+
+    /// @brief Collects terms and their ZIP codes, then writes the index file.
+    class Builder {
+    public:
+        /// @brief Adds one record's place name, state, county and ZIP code.
+        void add(const std::string& placeName, const std::string& state, const std::string& county, int zipCode);
+
+        /// @brief Adds the terms of a record string. Records without six fields are ignored.
+        void addRecord(const std::string& record);
+
+        /**
+         * @brief Writes the index file. Returns false if it could not be written.
+         * @param data The fingerprint of the data file the terms were read from, taken before they were.
+         */
+        bool write(const std::string& indexFileName, const DataFingerprint& data) const;
+
+        size_t termCount() const { return terms.size(); }
+
+    private:
+        struct Entry {
+            SecondaryIndex::Field field;
+            std::string key;            // Normalized name the trigrams are cut from
+            std::string name;
+            std::vector<int> zipCodes;
+        };
+        std::map<std::string, Entry> terms;     // By field, then SecondaryIndex term
+        void addTerm(SecondaryIndex::Field field, const std::string& term, const std::string& key,
+                     const std::string& name, int zipCode);
+    };
+
+    /**
+     * @brief Construct a new NGram Index object for a data file.
+     * @param dataFileName The C, L or B file the index is of.
+     */
+    explicit NGramIndex(const std::string& dataFileName);
+    ~NGramIndex();
+
+    NGramIndex(const NGramIndex&) = delete;
+    NGramIndex& operator=(const NGramIndex&) = delete;
+
+    /**
+     * @brief Reads a data file once and writes its index.
+     * @param dataFileName The C, L or B file to index. Files ending in ".csv" are C files.
+     * @return false if the data file could not be read or the index file written.
+     */
+    static bool build(const std::string& dataFileName);
+
+    /**
+     * @brief Maps the index file, building it first if it does not exist, is damaged or its data file has changed.
+     * @return false if the index could not be built, mapped, or is damaged.
+     */
+    bool open();
+
+    /**
+     * @brief The terms closest to typed text.
+     * @param text Typed text, matched ignoring case and punctuation.
+     * @param count The most matches to return.
+     * @param maxDistance The most edits allowed, or -1 for defaultDistance of the normalized text.
+     * @return Up to count matches, the fewest edits first.
+     */
+    std::vector<Match> search(const std::string& text, size_t count, int maxDistance = -1) const;
+
+    /// @brief The edits allowed for a normalized query: none below 4 characters, then one more every 4 up to 3.
+    static int defaultDistance(size_t length);
+
+    /// @brief The Levenshtein distance between two strings, bit-parallel when the first has at most 64 characters.
+    static int editDistance(const std::string& a, const std::string& b);
+
+    size_t termCount() const { return header ? header->termCount : 0; }
+    size_t gramCount() const { return header ? header->gramCount : 0; }
+
+    /// @brief The bytes of the index file, all of which are mapped.
+    size_t imageBytes() const { return mappedBytes; }
+
+    /// @brief The index file of a data file.
+    static std::string indexFileName(const std::string& dataFileName);
+
+private:
+    /// @brief The start of the index file. Every count is of the array it names.
+    struct Header {
+        char magic[8];
+        uint32_t termCount;
+        uint32_t zipCount;
+        uint32_t gramCount;
+        uint32_t postingCount;
+        uint32_t keyBytes;
+        uint32_t textBytes;
+        DataFingerprint data;       // Of the data file the index was built from
+    };
+
+    /// @brief The key, name and ZIP code lengths of a term are the differences to the next term.
+    struct Term {
+        uint32_t keyOffset;
+        uint32_t textOffset;        // Of the display name
+        uint32_t zipOffset;
+        uint32_t field;
+    };
+
+    /// @brief The posting count of a trigram is the difference to the next trigram.
+    struct Gram {
+        uint32_t gram;              // Three characters, the first in the high byte
+        uint32_t postingOffset;     // Of the ids of the terms holding it, ascending
+    };
+
+    std::string dataFileName;
+    void* mapped;
+    size_t mappedBytes;
+    const Header* header;
+    const Term* terms;
+    const int32_t* zips;
+    const Gram* grams;
+    const uint32_t* postings;
+    const char* keys;
+    const char* text;
+
+    void unmap();
+    bool mapIndex(bool report);
+    uint32_t keyLength(uint32_t term) const { return terms[term + 1].keyOffset - terms[term].keyOffset; }
+    uint32_t zipCount(uint32_t term) const { return terms[term + 1].zipOffset - terms[term].zipOffset; }
+    Match match(uint32_t term, int distance) const;
+};
+
+#endif // NGRAMINDEX_H
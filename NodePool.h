@@ -0,0 +1,146 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file NodePool.h
+ * @class NodePool
+ * @brief Arena of fixed-size objects allocated in cache-line aligned chunks.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Hands out objects of one type from chunks of CHUNK_OBJECTS objects,
+ *    so a tree of many small nodes does not make one heap allocation per
+ *    node, and nodes made one after another sit next to each other in
+ *    memory. Released objects are destroyed and kept on a free list for
+ *    the next allocation. Chunks are only returned to the heap by clear or
+ *    the destructor, which destroy any objects still allocated.
+ * \n
+ * \n Every object starts on a 64-byte boundary when its size is a multiple
+ *    of 64, as it is for types declared alignas(64).
+ * \n
+ * \n Not thread-safe.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
+
+template <typename T, size_t CHUNK_OBJECTS = 256>
+class NodePool {
+public:
+    NodePool() : nextInChunk(CHUNK_OBJECTS), freeList(nullptr), liveCount(0) {}
+
+    ~NodePool() { clear(); }
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    /**
+     * @brief Constructs an object in the pool.
+     * @param arguments Passed to the constructor of T.
+     * @return The new object, owned by the pool until release or clear.
+     */
+    template <typename... Arguments>
+    T* allocate(Arguments&&... arguments) {
+        void* memory;
+        if (freeList != nullptr) {
+            memory = freeList;
+            freeList = freeList->next;
+        }
+        else {
+            if (nextInChunk == CHUNK_OBJECTS) {
+                void* chunk = nullptr;
+                if (posix_memalign(&chunk, 64, sizeof(Slot) * CHUNK_OBJECTS) != 0) {
+                    throw std::bad_alloc();
+                }
+                chunks.push_back(static_cast<Slot*>(chunk));
+                nextInChunk = 0;
+            }
+            memory = &chunks.back()[nextInChunk++];
+        }
+        T* object = new (memory) T(std::forward<Arguments>(arguments)...);
+        liveCount++;
+        return object;
+    }
+
+    /// @brief Destroys an object from this pool and keeps its memory for reuse.
+    void release(T* object) {
+        object->~T();
+        FreeSlot* slot = reinterpret_cast<FreeSlot*>(object);
+        slot->next = freeList;
+        freeList = slot;
+        liveCount--;
+    }
+
+    /**
+     * @brief Destroys every object still allocated and frees the chunks.
+     * @details Objects are found by address, so this works without knowing which
+     *    were released: released slots are on the free list and are skipped.
+     */
+    void clear() {
+        if (liveCount > 0) {
+            std::vector<std::pair<Slot*, size_t> > chunksByAddress;
+            for (size_t c = 0; c < chunks.size(); c++) {
+                chunksByAddress.push_back(std::make_pair(chunks[c], c));
+            }
+            std::sort(chunksByAddress.begin(), chunksByAddress.end());
+
+            std::vector<bool> isFree(chunks.size() * CHUNK_OBJECTS, false);
+            for (FreeSlot* slot = freeList; slot != nullptr; slot = slot->next) {
+                Slot* freeSlot = reinterpret_cast<Slot*>(slot);
+                // The chunk holding the slot is the last one starting at or before it
+                auto chunk = std::upper_bound(chunksByAddress.begin(), chunksByAddress.end(),
+                                              std::make_pair(freeSlot, chunks.size())) - 1;
+                isFree[chunk->second * CHUNK_OBJECTS + static_cast<size_t>(freeSlot - chunk->first)] = true;
+            }
+            for (size_t c = 0; c < chunks.size(); c++) {
+                size_t used = (c + 1 == chunks.size()) ? nextInChunk : CHUNK_OBJECTS;
+                for (size_t i = 0; i < used; i++) {
+                    if (!isFree[c * CHUNK_OBJECTS + i]) {
+                        reinterpret_cast<T*>(&chunks[c][i])->~T();
+                    }
+                }
+            }
+        }
+        for (Slot* chunk : chunks) {
+            std::free(chunk);
+        }
+        chunks.clear();
+        nextInChunk = CHUNK_OBJECTS;
+        freeList = nullptr;
+        liveCount = 0;
+    }
+
+    /// @brief The number of objects allocated and not released.
+    size_t size() const { return liveCount; }
+
+    /// @brief Bytes held in chunks, including free slots.
+    size_t capacityBytes() const { return chunks.size() * CHUNK_OBJECTS * sizeof(Slot); }
+
+private:
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    /// @brief Storage for one object, or for a free list link once released.
+    union Slot {
+        alignas(T) unsigned char object[sizeof(T)];
+        FreeSlot free;
+    };
+
+    std::vector<Slot*> chunks;
+    size_t nextInChunk;         // Next never-used slot of the last chunk
+    FreeSlot* freeList;
+    size_t liveCount;
+};
+
+#endif // NODEPOOL_H
@@ -0,0 +1,415 @@
+/// @file PlaceTrie.cpp
+/// @class PlaceTrie
+/// See PlaceTrie.h for full documentation.
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "PlaceTrie.h"
+#include "SecondaryIndex.h"
+#include "ZipCodeBuffer.h"
+#include "HeaderBuffer.h"
+#include "Stats.h"
+
+const uint32_t PlaceTrie::TOP_COMPLETIONS;
+const uint32_t PlaceTrie::NO_NAME;
+
+namespace {
+    const char MAGIC[8] = { 'P', 'L', 'T', 'R', 'I', 'E', '0', '2' };
+
+    /// @brief A node of the trie while it is built.
+    struct BuildNode {
+        std::string label;
+        uint32_t name = PlaceTrie::NO_NAME;
+        std::vector<BuildNode> children;
+        std::vector<uint32_t> top;
+    };
+
+    /// @brief Appends the bytes of an array to the image.
+    template <typename T>
+    void appendArray(std::string& image, const std::vector<T>& values) {
+        image.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+}
+
+
+std::string PlaceTrie::indexFileName(const std::string& dataFileName) {
+    return dataFileName + "_place_trie.idx";
+}
+
+
+void PlaceTrie::Builder::add(const std::string& placeName, int zipCode) {
+    std::string key = SecondaryIndex::placeTerm(placeName);
+    if (key.empty()) {
+        return;
+    }
+    Entry& entry = names[key];
+    if (entry.placeName.empty()) {
+        entry.placeName = placeName;
+    }
+    entry.zipCodes.push_back(zipCode);
+}
+
+
+void PlaceTrie::Builder::addRecord(const std::string& record) {
+    std::vector<std::string> fields;
+    std::istringstream recordStream(record);
+    std::string field;
+    while (std::getline(recordStream, field, ',')) {
+        fields.push_back(field);
+    }
+    if (fields.size() == 6) {
+        add(fields[1], std::atoi(fields[0].c_str()));
+    }
+}
+
+
+/// @brief Lays the names out as a radix trie with the best names of every node, then writes the image.
+bool PlaceTrie::Builder::write(const std::string& indexFileName, const DataFingerprint& data) const {
+    // Name ids follow the sorted keys, so alphabetical order is id order
+    std::vector<std::string> keys;
+    std::vector<Name> nameTable;
+    std::vector<int32_t> zipTable;
+    std::string text;
+    for (const auto& entry : names) {
+        std::vector<int> zipCodes = entry.second.zipCodes;
+        std::sort(zipCodes.begin(), zipCodes.end());
+        zipCodes.erase(std::unique(zipCodes.begin(), zipCodes.end()), zipCodes.end());
+
+        Name name;
+        name.textOffset = static_cast<uint32_t>(text.size());
+        name.textLength = static_cast<uint32_t>(entry.second.placeName.size());
+        name.zipOffset = static_cast<uint32_t>(zipTable.size());
+        name.zipCount = static_cast<uint32_t>(zipCodes.size());
+        nameTable.push_back(name);
+        zipTable.insert(zipTable.end(), zipCodes.begin(), zipCodes.end());
+        text += entry.second.placeName;
+        keys.push_back(entry.first);
+    }
+
+    auto ranksBefore = [&nameTable](uint32_t a, uint32_t b) {
+        return nameTable[a].zipCount != nameTable[b].zipCount ? nameTable[a].zipCount > nameTable[b].zipCount : a < b;
+    };
+
+    // Builds the node for the sorted keys [low, high), which share their first depth characters
+    std::function<void(size_t, size_t, size_t, BuildNode&)> buildNode =
+        [&](size_t low, size_t high, size_t depth, BuildNode& node) {
+        if (low < high && keys[low].size() == depth) {
+            node.name = static_cast<uint32_t>(low++);
+            node.top.push_back(node.name);
+        }
+        while (low < high) {
+            size_t groupEnd = low;
+            while (groupEnd < high && keys[groupEnd][depth] == keys[low][depth]) {
+                groupEnd++;
+            }
+            // The first and last keys of a sorted group share what every key in it shares
+            const std::string& first = keys[low];
+            const std::string& last = keys[groupEnd - 1];
+            size_t shared = depth + 1;
+            while (shared < first.size() && shared < last.size() && first[shared] == last[shared]) {
+                shared++;
+            }
+            node.children.push_back(BuildNode());
+            BuildNode& child = node.children.back();
+            child.label = first.substr(depth, shared - depth);
+            buildNode(low, groupEnd, shared, child);
+            node.top.insert(node.top.end(), child.top.begin(), child.top.end());
+            low = groupEnd;
+        }
+        std::sort(node.top.begin(), node.top.end(), ranksBefore);
+        if (node.top.size() > TOP_COMPLETIONS) {
+            node.top.resize(TOP_COMPLETIONS);
+        }
+    };
+    BuildNode root;
+    buildNode(0, keys.size(), 0, root);
+
+    // Number the nodes breadth first, so the children of every node are contiguous
+    std::vector<const BuildNode*> order(1, &root);
+    std::vector<Node> nodeTable;
+    std::vector<uint32_t> topTable;
+    std::string labels;
+    for (size_t i = 0; i < order.size(); i++) {
+        const BuildNode& built = *order[i];
+        Node node;
+        node.labelOffset = static_cast<uint32_t>(labels.size());
+        node.firstChild = static_cast<uint32_t>(order.size());
+        node.name = built.name;
+        node.topOffset = static_cast<uint32_t>(topTable.size());
+        nodeTable.push_back(node);
+        labels += built.label;
+        topTable.insert(topTable.end(), built.top.begin(), built.top.end());
+        for (const BuildNode& child : built.children) {
+            order.push_back(&child);
+        }
+    }
+    // The extra node ends the last node's label, children and top list
+    Node end;
+    end.labelOffset = static_cast<uint32_t>(labels.size());
+    end.firstChild = static_cast<uint32_t>(order.size());
+    end.name = NO_NAME;
+    end.topOffset = static_cast<uint32_t>(topTable.size());
+    nodeTable.push_back(end);
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.nodeCount = static_cast<uint32_t>(order.size());
+    header.nameCount = static_cast<uint32_t>(nameTable.size());
+    header.zipCount = static_cast<uint32_t>(zipTable.size());
+    header.topCount = static_cast<uint32_t>(topTable.size());
+    header.labelBytes = static_cast<uint32_t>(labels.size());
+    header.textBytes = static_cast<uint32_t>(text.size());
+    header.topCompletions = TOP_COMPLETIONS;
+    header.data = data;
+
+    std::string image(reinterpret_cast<const char*>(&header), sizeof(header));
+    appendArray(image, nodeTable);
+    appendArray(image, nameTable);
+    appendArray(image, zipTable);
+    appendArray(image, topTable);
+    image += labels;
+    image += text;
+
+    std::ofstream indexFile(indexFileName, std::ios::binary | std::ios::trunc);
+    indexFile.write(image.data(), image.size());
+    if (!indexFile) {
+        std::cerr << "Error: Could not write " << indexFileName << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+PlaceTrie::PlaceTrie(const std::string& dataFileName)
+    : dataFileName(dataFileName), mapped(nullptr), mappedBytes(0), header(nullptr), nodes(nullptr), names(nullptr),
+      zips(nullptr), tops(nullptr), labels(nullptr), text(nullptr) {
+}
+
+
+PlaceTrie::~PlaceTrie() {
+    unmap();
+}
+
+
+void PlaceTrie::unmap() {
+    if (mapped != nullptr) {
+        ::munmap(mapped, mappedBytes);
+    }
+    mapped = nullptr;
+    mappedBytes = 0;
+    header = nullptr;
+}
+
+
+/// @brief Reads the data file once, adding every record to a Builder, then writes the trie.
+bool PlaceTrie::build(const std::string& dataFileName) {
+    DataFingerprint fingerprint;
+    std::ifstream file(dataFileName, std::ios::binary);
+    if (!file.is_open() || !fingerprint.read(dataFileName)) {
+        std::cerr << "Error: Could not open " << dataFileName << " to index." << std::endl;
+        return false;
+    }
+
+    // Find the file type the same way ZipCodeTableViewer does
+    HeaderBuffer headerBuffer(dataFileName);
+    char fileType = 'C';
+    if (dataFileName.find(".csv") == std::string::npos) {
+        headerBuffer.readHeader();
+        fileType = (headerBuffer.getBlockSize() == 0) ? 'L' : 'B';
+    }
+
+    Builder builder;
+    ZipCodeBuffer buffer(file, fileType, headerBuffer);
+    std::string record;
+    while (!(record = buffer.readNextRecordString()).empty()) {
+        builder.addRecord(record);
+    }
+    return builder.write(indexFileName(dataFileName), fingerprint);
+}
+
+
+/// @brief Maps the index file, or builds it and maps it again if it is missing, damaged or stale.
+bool PlaceTrie::open() {
+    unmap();
+    return mapIndex(false) || (build(dataFileName) && mapIndex(true));
+}
+
+
+/// @brief Maps the index file and checks that its arrays fill it exactly and its data file is unchanged.
+/// @param report Whether to report why it cannot be used, which is only worth doing once it was just built.
+bool PlaceTrie::mapIndex(bool report) {
+    std::string indexName = indexFileName(dataFileName);
+    int fd = ::open(indexName.c_str(), O_RDONLY);
+    struct stat status;
+    if (fd < 0 || ::fstat(fd, &status) != 0) {
+        if (report) {
+            std::cerr << "Error: Could not open " << indexName << ": " << std::strerror(errno) << std::endl;
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return false;
+    }
+
+    size_t bytes = static_cast<size_t>(status.st_size);
+    void* image = (bytes >= sizeof(Header)) ? ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);    // The mapping keeps the file open
+    if (image == MAP_FAILED) {
+        if (report) {
+            std::cerr << "Error: Could not map " << indexName << "." << std::endl;
+        }
+        return false;
+    }
+    mapped = image;
+    mappedBytes = bytes;
+
+    const Header* candidate = static_cast<const Header*>(image);
+    unsigned long long expected = sizeof(Header) + (candidate->nodeCount + 1ULL) * sizeof(Node)
+        + 1ULL * candidate->nameCount * sizeof(Name) + 4ULL * candidate->zipCount + 4ULL * candidate->topCount
+        + candidate->labelBytes + candidate->textBytes;
+    if (std::memcmp(candidate->magic, MAGIC, sizeof(MAGIC)) != 0 || candidate->nodeCount == 0 || expected != bytes) {
+        if (report) {
+            std::cerr << "Error: " << indexName << " is not a place trie." << std::endl;
+        }
+        unmap();
+        return false;
+    }
+    if (!candidate->data.matches(dataFileName)) {
+        if (report) {
+            std::cerr << "Error: " << dataFileName << " changed while " << indexName << " was built." << std::endl;
+        }
+        unmap();
+        return false;
+    }
+    ZIPCODE_STAT(HEADER_PARSES, 1);
+
+    header = candidate;
+    const char* position = static_cast<const char*>(image) + sizeof(Header);
+    nodes = reinterpret_cast<const Node*>(position);
+    position += (header->nodeCount + 1) * sizeof(Node);
+    names = reinterpret_cast<const Name*>(position);
+    position += header->nameCount * sizeof(Name);
+    zips = reinterpret_cast<const int32_t*>(position);
+    position += header->zipCount * sizeof(int32_t);
+    tops = reinterpret_cast<const uint32_t*>(position);
+    position += header->topCount * sizeof(uint32_t);
+    labels = position;
+    text = position + header->labelBytes;
+    return true;
+}
+
+
+/**
+ * @brief Walks down the edges matching a normalized key.
+ * @param prefix Whether the key may end inside an edge label.
+ * @return The node the key ends at or inside, or NO_NAME if no name continues the key.
+ */
+uint32_t PlaceTrie::findNode(const std::string& key, bool prefix) const {
+    uint32_t node = 0;
+    size_t position = 0;
+    while (position < key.size()) {
+        // Children are sorted by the first character of their label
+        const Node* first = nodes + nodes[node].firstChild;
+        const Node* last = first + childCount(node);
+        unsigned char wanted = static_cast<unsigned char>(key[position]);
+        const Node* child = std::lower_bound(first, last, wanted, [this](const Node& candidate, unsigned char c) {
+            return static_cast<unsigned char>(labels[candidate.labelOffset]) < c;
+        });
+        if (child == last || static_cast<unsigned char>(labels[child->labelOffset]) != wanted) {
+            return NO_NAME;
+        }
+
+        node = static_cast<uint32_t>(child - nodes);
+        size_t length = labelLength(node);
+        size_t matched = std::min(length, key.size() - position);
+        if (key.compare(position, matched, labels + child->labelOffset, matched) != 0) {
+            return NO_NAME;
+        }
+        position += matched;
+        if (matched < length) {
+            return prefix ? node : NO_NAME;
+        }
+    }
+    return node;
+}
+
+
+PlaceTrie::Completion PlaceTrie::completion(uint32_t name) const {
+    const Name& entry = names[name];
+    Completion result;
+    result.placeName.assign(text + entry.textOffset, entry.textLength);
+    result.zipCodes.assign(zips + entry.zipOffset, zips + entry.zipOffset + entry.zipCount);
+    return result;
+}
+
+
+/// @brief More ZIP codes first, then alphabetical, which is id order.
+bool PlaceTrie::ranksBefore(uint32_t a, uint32_t b) const {
+    return names[a].zipCount != names[b].zipCount ? names[a].zipCount > names[b].zipCount : a < b;
+}
+
+
+void PlaceTrie::collectNames(uint32_t node, std::vector<uint32_t>& found) const {
+    if (nodes[node].name != NO_NAME) {
+        found.push_back(nodes[node].name);
+    }
+    for (uint32_t child = nodes[node].firstChild; child < nodes[node].firstChild + childCount(node); child++) {
+        collectNames(child, found);
+    }
+}
+
+
+std::vector<PlaceTrie::Completion> PlaceTrie::complete(const std::string& prefix, size_t count) const {
+    std::vector<Completion> completions;
+    if (header == nullptr || count == 0) {
+        return completions;
+    }
+    uint32_t node = findNode(SecondaryIndex::placeTerm(prefix), true);
+    if (node == NO_NAME) {
+        return completions;
+    }
+
+    // A full top list may not hold every name of the subtree, so asking for more walks it
+    size_t listed = topCount(node);
+    std::vector<uint32_t> ranked;
+    if (count <= listed || listed < header->topCompletions) {
+        const uint32_t* top = tops + nodes[node].topOffset;
+        ranked.assign(top, top + std::min(count, listed));
+    }
+    else {
+        collectNames(node, ranked);
+        size_t kept = std::min(count, ranked.size());
+        std::partial_sort(ranked.begin(), ranked.begin() + kept, ranked.end(),
+                          [this](uint32_t a, uint32_t b) { return ranksBefore(a, b); });
+        ranked.resize(kept);
+    }
+    for (uint32_t name : ranked) {
+        completions.push_back(completion(name));
+    }
+    return completions;
+}
+
+
+bool PlaceTrie::lookup(const std::string& placeName, std::vector<int>& zipCodes) const {
+    if (header == nullptr) {
+        return false;
+    }
+    uint32_t node = findNode(SecondaryIndex::placeTerm(placeName), false);
+    if (node == NO_NAME || nodes[node].name == NO_NAME) {
+        return false;
+    }
+    const Name& entry = names[nodes[node].name];
+    zipCodes.assign(zips + entry.zipOffset, zips + entry.zipOffset + entry.zipCount);
+    return true;
+}
@@ -0,0 +1,184 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file PlaceTrie.h
+ * @class PlaceTrie
+ * @brief Memory-mapped radix trie of place names for ranked prefix completion.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Maps each distinct place name, normalized as by
+ *    SecondaryIndex::placeTerm, to its ZIP codes, and completes a typed
+ *    prefix to the names starting with it. Completions are ranked by the
+ *    number of ZIP codes of a name, a stand-in for its size, then
+ *    alphabetically.
+ * \n
+ * \n The trie is a radix trie: a node with one child is merged into it, so
+ *    an edge is labelled with a string and every node either ends a name or
+ *    branches. Each node also keeps the TOP_COMPLETIONS best names below
+ *    it, so completing a prefix is a walk down as many nodes as the prefix
+ *    has branches, then copying a list. Only asking for more completions
+ *    than that visits the whole subtree.
+ * \n
+ * \n The index file, named by indexFileName, is the image the lookups read,
+ *    so open maps it with mmap and reads nothing until a lookup touches
+ *    it; pages are shared between processes serving the same file. It
+ *    holds a Header, then arrays of Node, Name, ZIP codes, top lists, edge
+ *    labels and display names. Nodes are numbered breadth first, so the
+ *    children of a node are contiguous, sorted by the first character of
+ *    their label, and the labels, children and top lists of the nodes are
+ *    laid out in node order. A Node is then just four offsets: the lengths
+ *    are the differences to the next node, and one extra node ends the
+ *    array. Numbers are in host byte order.
+ * \n
+ * \n A Builder collects names as records are read. BlockGenerator writes
+ *    the trie of every blocked file it makes, and open builds it from the
+ *    data file when it does not exist, is damaged, or the data file no
+ *    longer matches the DataFingerprint in its Header.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef PLACETRIE_H
+#define PLACETRIE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "DataFingerprint.h"
+
+class PlaceTrie {
+public:
+    static const uint32_t TOP_COMPLETIONS = 10;    // Best names kept at every node
+    static const uint32_t NO_NAME = 0xFFFFFFFF;
+
+    /// @brief One completion of a prefix.
+    struct Completion {
+        std::string placeName;          // As first written in the data file
+        std::vector<int> zipCodes;      // Ascending
+    };
+
+    /// @brief Collects place names and their ZIP codes, then writes the index file.
+    class Builder {
+    public:
+        /// @brief Adds one record's place name and ZIP code.
+        void add(const std::string& placeName, int zipCode);
+
+        /// @brief Adds the place name and ZIP code of a record string. Records without six fields are ignored.
+        void addRecord(const std::string& record);
+
+        /**
+         * @brief Writes the index file. Returns false if it could not be written.
+         * @param data The fingerprint of the data file the names were read from, taken before they were.
+         */
+        bool write(const std::string& indexFileName, const DataFingerprint& data) const;
+
+        size_t nameCount() const { return names.size(); }
+
+    private:
+        struct Entry {
+            std::string placeName;
+            std::vector<int> zipCodes;
+        };
+        std::map<std::string, Entry> names;     // By normalized name
+    };
+
+    /**
+     * @brief Construct a new Place Trie object for a data file.
+     * @param dataFileName The C, L or B file the trie is of.
+     */
+    explicit PlaceTrie(const std::string& dataFileName);
+    ~PlaceTrie();
+
+    PlaceTrie(const PlaceTrie&) = delete;
+    PlaceTrie& operator=(const PlaceTrie&) = delete;
+
+    /**
+     * @brief Reads a data file once and writes its trie.
+     * @param dataFileName The C, L or B file to index. Files ending in ".csv" are C files.
+     * @return false if the data file could not be read or the index file written.
+     */
+    static bool build(const std::string& dataFileName);
+
+    /**
+     * @brief Maps the index file, building it first if it does not exist, is damaged or its data file has changed.
+     * @return false if the index could not be built, mapped, or is damaged.
+     */
+    bool open();
+
+    /**
+     * @brief The best completions of a prefix.
+     * @param prefix Typed text, matched ignoring case and punctuation. An empty prefix completes to every name.
+     * @param count The most completions to return.
+     * @return Up to count names starting with the prefix, the most ZIP codes first.
+     */
+    std::vector<Completion> complete(const std::string& prefix, size_t count) const;
+
+    /// @brief The ZIP codes of one place name. Returns false if there is no such name.
+    bool lookup(const std::string& placeName, std::vector<int>& zipCodes) const;
+
+    size_t nameCount() const { return header ? header->nameCount : 0; }
+    size_t nodeCount() const { return header ? header->nodeCount : 0; }
+
+    /// @brief The bytes of the index file, all of which are mapped.
+    size_t imageBytes() const { return mappedBytes; }
+
+    /// @brief The trie file of a data file.
+    static std::string indexFileName(const std::string& dataFileName);
+
+private:
+    /// @brief The start of the index file. Every count is of the array it names.
+    struct Header {
+        char magic[8];
+        uint32_t nodeCount;
+        uint32_t nameCount;
+        uint32_t zipCount;
+        uint32_t topCount;
+        uint32_t labelBytes;
+        uint32_t textBytes;
+        uint32_t topCompletions;
+        uint32_t reserved;
+        DataFingerprint data;       // Of the data file the trie was built from
+    };
+
+    /// @brief The label length, child count and top list length of a node are the differences to the next node.
+    struct Node {
+        uint32_t labelOffset;       // Of the edge label into this node
+        uint32_t firstChild;
+        uint32_t name;              // The name ending here, or NO_NAME
+        uint32_t topOffset;         // Of the best names in this subtree
+    };
+
+    struct Name {
+        uint32_t textOffset;        // Of the display name
+        uint32_t textLength;
+        uint32_t zipOffset;
+        uint32_t zipCount;
+    };
+
+    std::string dataFileName;
+    void* mapped;
+    size_t mappedBytes;
+    const Header* header;
+    const Node* nodes;
+    const Name* names;
+    const int32_t* zips;
+    const uint32_t* tops;
+    const char* labels;
+    const char* text;
+
+    void unmap();
+    bool mapIndex(bool report);
+    uint32_t labelLength(uint32_t node) const { return nodes[node + 1].labelOffset - nodes[node].labelOffset; }
+    uint32_t childCount(uint32_t node) const { return nodes[node + 1].firstChild - nodes[node].firstChild; }
+    uint32_t topCount(uint32_t node) const { return nodes[node + 1].topOffset - nodes[node].topOffset; }
+    uint32_t findNode(const std::string& key, bool prefix) const;
+    Completion completion(uint32_t name) const;
+    bool ranksBefore(uint32_t a, uint32_t b) const;
+    void collectNames(uint32_t node, std::vector<uint32_t>& found) const;
+};
+
+#endif // PLACETRIE_H
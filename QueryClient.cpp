@@ -0,0 +1,117 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file QueryClient.cpp
+ * @brief Command line client for the query server started with ZipCode.exe --serve.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Sends each query given on the command line to the server, in order, on
+ *    one connection, and prints the records returned.
+ * \n
+ * \n Usage: QueryClient.exe [--socket <path>] <query> ...
+ * \n Queries:
+ * \n  -- -Z<zip>: look up one ZIP code
+ * \n  -- -R<low>-<high>: every ZIP code in a range
+ * \n  -- -B<zip>,<zip>,...: look up several ZIP codes in one request
+ * \n  -- --ping: check that the server answers
+ * \n  -- --stop: stop the server
+ * \n The socket defaults to zipcode.sock.
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "QueryProtocol.h"
+
+using namespace std;
+
+/// @brief Turns a command line query into a request payload, or "" if it is not a query.
+static string makeRequest(const string& arg) {
+    if (arg == "--ping") {
+        return "P";
+    }
+    if (arg == "--stop") {
+        return "S";
+    }
+    if (arg.size() > 2 && arg[0] == '-' && (arg[1] == 'Z' || arg[1] == 'z')) {
+        return "Z " + arg.substr(2);
+    }
+    if (arg.size() > 2 && arg[0] == '-' && (arg[1] == 'R' || arg[1] == 'r')) {
+        string range = arg.substr(2);
+        size_t dash = range.find('-');
+        return (dash == string::npos) ? "R " + range + " " + range
+                                      : "R " + range.substr(0, dash) + " " + range.substr(dash + 1);
+    }
+    if (arg.size() > 2 && arg[0] == '-' && (arg[1] == 'B' || arg[1] == 'b')) {
+        string request = "B " + arg.substr(2);
+        for (char& c : request) {
+            if (c == ',') {
+                c = ' ';
+            }
+        }
+        return request;
+    }
+    return "";
+}
+
+int main(int argc, char* argv[]) {
+    string socketPath = QueryProtocol::DEFAULT_SOCKET_PATH;
+    vector<string> requests;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) {
+            socketPath = argv[++i];
+            continue;
+        }
+        string request = makeRequest(arg);
+        if (request.empty()) {
+            cerr << "Invalid argument: " << arg << endl;
+            cerr << "Usage: " << argv[0] << " [--socket <path>] -Z<zip> | -R<low>-<high> | -B<zip>,<zip>,... | --ping | --stop ..." << endl;
+            return 1;
+        }
+        requests.push_back(request);
+    }
+
+    int fd = QueryProtocol::connectToServer(socketPath);
+    if (fd < 0) {
+        return 1;
+    }
+
+    int status = 0;
+    for (const string& request : requests) {
+        string response;
+        vector<string> lines;
+        if (!QueryProtocol::writeFrame(fd, request) || !QueryProtocol::readFrame(fd, response)) {
+            cerr << "Error: The server closed the connection." << endl;
+            status = 1;
+            break;
+        }
+        if (!QueryProtocol::parseResponse(response, lines)) {
+            cerr << request << ": " << response << endl;
+            status = 1;
+            continue;
+        }
+
+        if (request[0] == 'P' || request[0] == 'S') {
+            cout << (request[0] == 'P' ? "Server is running." : "Server is stopping.") << endl;
+        }
+        else if (request[0] == 'Z' && lines.empty()) {
+            cout << "No record of " << request.substr(2) << endl;
+        }
+        else {
+            for (const string& line : lines) {
+                cout << line << endl;
+            }
+        }
+    }
+
+    ::close(fd);
+    return status;
+}
@@ -0,0 +1,141 @@
+/// @file QueryProtocol.cpp
+/// See QueryProtocol.h for full documentation.
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "QueryProtocol.h"
+
+namespace {
+    /// @brief Writes every byte, retrying short writes.
+    bool writeAll(int fd, const char* data, size_t length) {
+        while (length > 0) {
+            ssize_t written = ::write(fd, data, length);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            if (written <= 0) {
+                return false;
+            }
+            data += written;
+            length -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    /// @brief Reads exactly length bytes, retrying short reads.
+    bool readAll(int fd, char* data, size_t length) {
+        while (length > 0) {
+            ssize_t bytesRead = ::read(fd, data, length);
+            if (bytesRead < 0 && errno == EINTR) {
+                continue;
+            }
+            if (bytesRead <= 0) {
+                return false;
+            }
+            data += bytesRead;
+            length -= static_cast<size_t>(bytesRead);
+        }
+        return true;
+    }
+}
+
+
+/// @brief Writes one frame to a file descriptor.
+bool QueryProtocol::writeFrame(int fd, const std::string& payload) {
+    if (payload.size() > MAX_FRAME_BYTES) {
+        return false;
+    }
+    unsigned int length = static_cast<unsigned int>(payload.size());
+    char header[4] = {
+        static_cast<char>(length >> 24), static_cast<char>(length >> 16),
+        static_cast<char>(length >> 8), static_cast<char>(length)
+    };
+
+    // Send the length and payload together, so small frames go out in one write
+    std::string frame(header, 4);
+    frame += payload;
+    return writeAll(fd, frame.data(), frame.size());
+}
+
+
+/// @brief Reads one frame from a file descriptor.
+bool QueryProtocol::readFrame(int fd, std::string& payload) {
+    unsigned char header[4];
+    if (!readAll(fd, reinterpret_cast<char*>(header), 4)) {
+        return false;
+    }
+    unsigned int length = (static_cast<unsigned int>(header[0]) << 24) | (static_cast<unsigned int>(header[1]) << 16)
+                        | (static_cast<unsigned int>(header[2]) << 8) | static_cast<unsigned int>(header[3]);
+    if (length > MAX_FRAME_BYTES) {
+        std::cerr << "Error: Frame of " << length << " bytes is too large." << std::endl;
+        return false;
+    }
+    payload.resize(length);
+    return length == 0 || readAll(fd, &payload[0], length);
+}
+
+
+/// @brief Builds an "OK" response from its lines.
+std::string QueryProtocol::okResponse(const std::vector<std::string>& lines) {
+    std::string response = "OK " + std::to_string(lines.size());
+    for (const std::string& line : lines) {
+        response += '\n';
+        response += line;
+    }
+    return response;
+}
+
+
+/// @brief Builds an "ERR" response.
+std::string QueryProtocol::errorResponse(const std::string& message) {
+    return "ERR " + message;
+}
+
+
+/// @brief Splits a response into its lines, after checking its status.
+bool QueryProtocol::parseResponse(const std::string& response, std::vector<std::string>& lines) {
+    lines.clear();
+    std::istringstream stream(response);
+    std::string status;
+    size_t count = 0;
+    if (!(stream >> status) || status != "OK" || !(stream >> count)) {
+        return false;
+    }
+    stream.ignore(1); // The newline after the status line
+
+    std::string line;
+    while (lines.size() < count && std::getline(stream, line)) {
+        lines.push_back(line);
+    }
+    return lines.size() == count;
+}
+
+
+/// @brief Connects to a server listening on a Unix domain socket.
+int QueryProtocol::connectToServer(const std::string& socketPath) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Error: Socket path " << socketPath << " is too long." << std::endl;
+        return -1;
+    }
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::cerr << "Error: Could not create a socket: " << std::strerror(errno) << std::endl;
+        return -1;
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        std::cerr << "Error: Could not connect to " << socketPath << ": " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
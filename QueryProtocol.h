@@ -0,0 +1,77 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file QueryProtocol.h
+ * @brief Framing and message format shared by the query server and its clients.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Every message is one frame: a 4-byte big-endian payload length followed
+ *    by that many bytes of payload. Frames larger than MAX_FRAME_BYTES are
+ *    refused, so a bad length can not make either side allocate without
+ *    bound.
+ * \n
+ * \n Request payloads are one command letter and its arguments, separated
+ *    by spaces:
+ * \n  -- "Z <zip>": look up one ZIP code
+ * \n  -- "R <low> <high>": every record with a ZIP code from low to high
+ * \n  -- "B <zip> <zip> ...": look up many ZIP codes at once
+ * \n  -- "P": ping
+ * \n  -- "S": stop the server after answering
+ * \n
+ * \n Response payloads start with a status line, "OK <count>" or
+ *    "ERR <message>", followed by count lines. For Z and R the lines are the
+ *    records found, as "zip,place,state,county,latitude,longitude". For B
+ *    there is one line per requested ZIP code, in request order, holding the
+ *    record or "-" if there is none.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef QUERYPROTOCOL_H
+#define QUERYPROTOCOL_H
+
+#include <string>
+#include <vector>
+
+namespace QueryProtocol {
+    const unsigned int MAX_FRAME_BYTES = 64u * 1024 * 1024;
+    const char* const DEFAULT_SOCKET_PATH = "zipcode.sock";
+    const char* const NOT_FOUND = "-";
+
+    /**
+     * @brief Writes one frame to a file descriptor.
+     * @return false if the descriptor was closed or the payload is too large.
+     */
+    bool writeFrame(int fd, const std::string& payload);
+
+    /**
+     * @brief Reads one frame from a file descriptor.
+     * @return false at the end of the stream, on an error or on an oversized frame.
+     */
+    bool readFrame(int fd, std::string& payload);
+
+    /// @brief Builds an "OK" response from its lines.
+    std::string okResponse(const std::vector<std::string>& lines);
+
+    /// @brief Builds an "ERR" response.
+    std::string errorResponse(const std::string& message);
+
+    /**
+     * @brief Splits a response into its lines, after checking its status.
+     * @param response The response payload.
+     * @param lines The lines after the status line.
+     * @return false if the status is "ERR" or the response is malformed.
+     */
+    bool parseResponse(const std::string& response, std::vector<std::string>& lines);
+
+    /**
+     * @brief Connects to a server listening on a Unix domain socket.
+     * @return The connected descriptor, or -1 if the connection failed.
+     */
+    int connectToServer(const std::string& socketPath);
+}
+
+#endif // QUERYPROTOCOL_H
@@ -0,0 +1,170 @@
+/// @file QueryServer.cpp
+/// @class QueryServer
+/// See QueryServer.h for full documentation.
+
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "QueryServer.h"
+#include "QueryProtocol.h"
+
+QueryServer::QueryServer(const std::string& fileName)
+    : fileName(fileName), store(fileName), stopping(false) {
+}
+
+
+/// @brief Opens the file and loads its header and index.
+bool QueryServer::load() {
+    return store.open();
+}
+
+
+/// @brief Answers one request payload.
+std::string QueryServer::handleRequest(const std::string& request) {
+    std::istringstream stream(request);
+    char command = 0;
+    stream >> command;
+    std::vector<std::string> lines;
+
+    switch (command) {
+    case 'P':
+        return QueryProtocol::okResponse(lines);
+
+    case 'S':
+        stopping = true;
+        return QueryProtocol::okResponse(lines);
+
+    case 'Z': {
+        int zipCode = 0;
+        if (!(stream >> zipCode)) {
+            return QueryProtocol::errorResponse("usage: Z <zip>");
+        }
+        std::string record;
+        if (store.lookup(zipCode, record)) {
+            lines.push_back(record);
+        }
+        return QueryProtocol::okResponse(lines);
+    }
+
+    case 'R': {
+        int low = 0, high = 0;
+        if (!(stream >> low >> high)) {
+            return QueryProtocol::errorResponse("usage: R <low> <high>");
+        }
+        store.range(low, high, lines);
+        return QueryProtocol::okResponse(lines);
+    }
+
+    case 'B': {
+        std::vector<int> zipCodes;
+        int zipCode = 0;
+        while (stream >> zipCode) {
+            zipCodes.push_back(zipCode);
+        }
+        if (!stream.eof()) {
+            return QueryProtocol::errorResponse("usage: B <zip> <zip> ...");
+        }
+        for (int key : zipCodes) {
+            std::string record;
+            lines.push_back(store.lookup(key, record) ? record : QueryProtocol::NOT_FOUND);
+        }
+        return QueryProtocol::okResponse(lines);
+    }
+
+    default:
+        return QueryProtocol::errorResponse("unknown command");
+    }
+}
+
+
+/// @brief Answers framed requests from one stream until it ends or a stop request.
+void QueryServer::serveStream(int inputFd, int outputFd) {
+    std::string request;
+    while (!stopping && QueryProtocol::readFrame(inputFd, request)) {
+        if (!QueryProtocol::writeFrame(outputFd, handleRequest(request))) {
+            break;
+        }
+    }
+}
+
+
+/// @brief Listens on a Unix domain socket until a client sends a stop request.
+bool QueryServer::serveSocket(const std::string& socketPath) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Error: Socket path " << socketPath << " is too long." << std::endl;
+        return false;
+    }
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ::unlink(socketPath.c_str());
+    if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0
+        || ::listen(listenFd, 64) < 0) {
+        std::cerr << "Error: Could not listen on " << socketPath << ": " << std::strerror(errno) << std::endl;
+        if (listenFd >= 0) {
+            ::close(listenFd);
+        }
+        return false;
+    }
+    std::signal(SIGPIPE, SIG_IGN); // A client that disconnects early must not end the server
+    std::cerr << "Serving " << fileName << " on " << socketPath << std::endl;
+
+    // Client threads are detached, so a long-running server does not keep
+    // finished ones around. They share the set of open client sockets, which
+    // lives until the last of them is done with it.
+    struct Clients {
+        std::set<int> fds;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+    std::shared_ptr<Clients> clients = std::make_shared<Clients>();
+
+    while (!stopping) {
+        int clientFd = ::accept(listenFd, nullptr, nullptr);
+        if (clientFd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            break; // The listening socket was shut down by a stop request
+        }
+
+        std::lock_guard<std::mutex> lock(clients->mutex);
+        clients->fds.insert(clientFd);
+        std::thread([this, clientFd, listenFd, clients]() {
+            serveStream(clientFd, clientFd);
+            if (stopping) {
+                ::shutdown(listenFd, SHUT_RDWR); // Wakes the accept loop
+            }
+            std::lock_guard<std::mutex> lock(clients->mutex);
+            clients->fds.erase(clientFd);
+            ::close(clientFd);
+            clients->done.notify_all();
+        }).detach();
+    }
+
+    // Disconnect the remaining clients and wait for their threads to finish
+    {
+        std::unique_lock<std::mutex> lock(clients->mutex);
+        for (int clientFd : clients->fds) {
+            ::shutdown(clientFd, SHUT_RDWR);
+        }
+        clients->done.wait(lock, [&clients]() { return clients->fds.empty(); });
+    }
+    ::close(listenFd);
+    ::unlink(socketPath.c_str());
+    return true;
+}
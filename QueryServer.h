@@ -0,0 +1,75 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file QueryServer.h
+ * @class QueryServer
+ * @brief Long-running server answering ZIP code queries over a Unix socket or stdin/stdout.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Loads a C, L or B file once into a ZipCodeStore and then answers
+ *    lookups, range queries and batches of lookups until it is told to stop,
+ *    so the header, the index and recently read blocks are not read again
+ *    for every query as they are by separate ZipCodeTableViewer runs. See
+ *    QueryProtocol.h for the framed protocol and ZipCodeStore.h for how the
+ *    index and block cache are kept.
+ * \n
+ * \n serveSocket accepts any number of clients, each on its own thread.
+ *    The store is safe to share between threads, so requests from different
+ *    clients are answered at the same time.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef QUERYSERVER_H
+#define QUERYSERVER_H
+
+#include <atomic>
+#include <string>
+#include "ZipCodeStore.h"
+
+class QueryServer {
+public:
+    /**
+     * @brief Construct a new Query Server object for a data file.
+     * @param fileName The C, L or B file to serve. Files ending in ".csv" are C files.
+     */
+    explicit QueryServer(const std::string& fileName);
+
+    /**
+     * @brief Opens the file and loads its header and index.
+     * @return false if the file or its index could not be loaded.
+     */
+    bool load();
+
+    /**
+     * @brief Answers one request payload.
+     * @return The response payload. See QueryProtocol.h.
+     */
+    std::string handleRequest(const std::string& request);
+
+    /**
+     * @brief Answers framed requests from one stream until it ends or a stop request.
+     * @param inputFd The descriptor to read requests from, such as 0 for stdin.
+     * @param outputFd The descriptor to write responses to, such as 1 for stdout.
+     */
+    void serveStream(int inputFd, int outputFd);
+
+    /**
+     * @brief Listens on a Unix domain socket until a client sends a stop request.
+     * @param socketPath The socket to create. An existing socket file at the path is replaced.
+     * @return false if the socket could not be created.
+     */
+    bool serveSocket(const std::string& socketPath);
+
+    const ZipCodeStore& getStore() const { return store; }
+
+private:
+    std::string fileName;
+    ZipCodeStore store;
+    std::atomic<bool> stopping;
+};
+
+#endif // QUERYSERVER_H
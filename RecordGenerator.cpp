@@ -0,0 +1,268 @@
+/// @file RecordGenerator.cpp
+/// @class RecordGenerator
+/// See RecordGenerator.h for full documentation.
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cmath>
+#include <cstdio>
+#include <climits>
+#include <cctype>
+#include <algorithm>
+#include "RecordGenerator.h"
+#include "HeaderBuffer.h"
+#include "BlockWriter.h"
+
+namespace {
+    // State codes in ZIP code order, as they appear in the real data
+    const char* const STATE_CODES[] = {
+        "PR", "VI", "MA", "RI", "NH", "ME", "VT", "CT", "NJ", "AE", "NY", "PA", "DE", "DC", "VA",
+        "MD", "WV", "NC", "SC", "GA", "FL", "AA", "AL", "TN", "MS", "KY", "OH", "IN", "MI", "IA",
+        "WI", "MN", "SD", "ND", "MT", "IL", "MO", "KS", "NE", "LA", "AR", "OK", "TX", "CO", "WY",
+        "ID", "UT", "AZ", "NM", "NV", "CA", "AP", "HI", "AS", "GU", "PW", "FM", "MP", "MH", "OR",
+        "WA", "AK"
+    };
+    const int STATE_COUNT = sizeof(STATE_CODES) / sizeof(STATE_CODES[0]);
+
+    const char CONSONANTS[] = "bcdfghjklmnprstvwz";
+    const char VOWELS[] = "aeiouy";
+
+    /// @brief Mixes a 64-bit value (SplitMix64), used to derive names from their ids.
+    unsigned long long mix(unsigned long long value) {
+        value += 0x9E3779B97F4A7C15ULL;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+        return value ^ (value >> 31);
+    }
+}
+
+
+RecordGenerator::RecordGenerator(const Settings& settings) : settings(settings), random(settings.seed) {
+    if (this->settings.placeCount <= 0) {
+        this->settings.placeCount = static_cast<int>(std::max(1LL, std::min(settings.recordCount / 4, 10000000LL)));
+    }
+    if (this->settings.countyCount < STATE_COUNT) {
+        this->settings.countyCount = STATE_COUNT;
+    }
+    if (this->settings.minNameLength < 1) {
+        this->settings.minNameLength = 1;
+    }
+    if (this->settings.maxNameLength < this->settings.minNameLength) {
+        this->settings.maxNameLength = this->settings.minNameLength;
+    }
+    if (this->settings.keyGap < 1) {
+        this->settings.keyGap = 1;
+    }
+}
+
+
+/// @brief Uniform in [0, 1), from the top 53 bits of the generator.
+double RecordGenerator::nextUnit() {
+    return (random() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+
+/// @brief Uniform in [0, bound).
+long long RecordGenerator::nextBelow(long long bound) {
+    return static_cast<long long>(random() % static_cast<unsigned long long>(bound));
+}
+
+
+/// @brief Rank in [0, count) where rank r is picked about 1/(r+1) as often as rank 0.
+long long RecordGenerator::nextZipfRank(long long count) {
+    long long rank = static_cast<long long>(std::pow(static_cast<double>(count), nextUnit())) - 1;
+    return std::min(std::max(rank, 0LL), count - 1);
+}
+
+
+/// @brief The gap to the next key for the chosen key distribution.
+long long RecordGenerator::nextKeyGap() {
+    switch (settings.keyDistribution) {
+    case SPARSE:
+        return 1 + nextBelow(2LL * settings.keyGap - 1);
+    case SKEWED: {
+        // Runs of consecutive keys end 1 time in 32 with a Pareto-distributed jump,
+        // scaled so the average gap is still keyGap
+        if (nextBelow(32) != 0) {
+            return 1;
+        }
+        double minimumJump = std::max(1.0, (settings.keyGap - 31.0 / 32.0) * 32.0 / 3.0);
+        double jump = minimumJump / std::pow(1.0 - nextUnit(), 1.0 / 1.5);
+        return static_cast<long long>(std::min(jump, 1000.0 * settings.keyGap));
+    }
+    case DENSE:
+    default:
+        return 1;
+    }
+}
+
+
+/// @brief Builds a pronounceable name whose length follows the length distribution.
+std::string RecordGenerator::makeName(unsigned long long id, unsigned long long salt) const {
+    unsigned long long hash = mix(id * 2654435761ULL ^ salt);
+    int range = settings.maxNameLength - settings.minNameLength + 1;
+    int length = settings.maxNameLength;
+
+    if (settings.lengthDistribution == UNIFORM) {
+        length = settings.minNameLength + static_cast<int>(hash % range);
+    }
+    else if (settings.lengthDistribution == NORMAL) {
+        // The average of four uniform values is close to normal around the middle
+        int sum = 0;
+        for (int i = 0; i < 4; i++) {
+            sum += static_cast<int>((hash >> (i * 16)) % range);
+        }
+        length = settings.minNameLength + sum / 4;
+    }
+
+    std::string name(length, ' ');
+    bool vowel = (hash >> 63) != 0;
+    for (int i = 0; i < length; i++) {
+        hash = mix(hash);
+        name[i] = vowel ? VOWELS[hash % (sizeof(VOWELS) - 1)] : CONSONANTS[hash % (sizeof(CONSONANTS) - 1)];
+        vowel = !vowel;
+    }
+    name[0] = static_cast<char>(std::toupper(name[0]));
+    return name;
+}
+
+
+/// @brief Generates the next record.
+bool RecordGenerator::nextRecord(ZipCodeRecord& record) {
+    if (generated >= settings.recordCount) {
+        return false;
+    }
+
+    long long nextKey = key + nextKeyGap();
+    if (nextKey > INT_MAX) {
+        std::cerr << "Keys exceed the range of an int after " << generated << " records. Use a smaller key gap.\n";
+        return false;
+    }
+    key = nextKey;
+
+    // States follow each other in contiguous runs of keys
+    int stateIndex = static_cast<int>(generated * STATE_COUNT / settings.recordCount);
+    int countiesPerState = settings.countyCount / STATE_COUNT;
+    long long countyId = static_cast<long long>(stateIndex) * countiesPerState + nextZipfRank(countiesPerState);
+    long long placeId = nextZipfRank(settings.placeCount);
+
+    // Each state is centered on its own point, with records spread up to 3 degrees around it
+    unsigned long long stateHash = mix(static_cast<unsigned long long>(stateIndex) ^ settings.seed);
+    double centerLatitude = 18.0 + (stateHash % 5000) / 100.0;                 // 18 to 68 degrees
+    double centerLongitude = -160.0 + ((stateHash >> 20) % 9500) / 100.0;      // -160 to -65 degrees
+
+    record.zipCode = std::to_string(key);
+    record.placeName = makeName(placeId, 0x706C616365ULL);
+    record.state = STATE_CODES[stateIndex];
+    record.county = makeName(countyId, 0x636F756E7479ULL);
+    record.latitude = centerLatitude + (nextUnit() * 6.0 - 3.0);
+    record.longitude = centerLongitude + (nextUnit() * 6.0 - 3.0);
+
+    generated++;
+    return true;
+}
+
+
+/// @brief Formats a record as it is stored in the files.
+std::string RecordGenerator::formatRecord(const ZipCodeRecord& record) {
+    char coordinates[64];
+    std::snprintf(coordinates, sizeof(coordinates), "%.4f,%.4f", record.latitude, record.longitude);
+    return record.zipCode + "," + record.placeName + "," + record.state + "," + record.county + "," + coordinates;
+}
+
+
+/// @brief Generates every record into a new file.
+long long RecordGenerator::writeFile(const std::string& fileName, char fileType, const std::string& indexFileName) {
+    ZipCodeRecord record;
+    long long written = 0;
+    fileType = static_cast<char>(std::toupper(fileType));
+
+    if (fileType == 'B') {
+        std::string blockIndexFileName = indexFileName.empty() ? fileName + "_index.txt" : indexFileName;
+        BlockWriter writer(fileName, blockIndexFileName, settings.blockSize, settings.fillPercent);
+        while (nextRecord(record)) {
+            if (!writer.addRecord(formatRecord(record))) {
+                return -1;
+            }
+            written++;
+        }
+        if (generated < settings.recordCount) {
+            // The keys ran out. Left unclosed, the writer removes its partial blocks
+            std::remove(blockIndexFileName.c_str());
+            return -1;
+        }
+        return writer.close() ? written : -1;
+    }
+
+    if (fileType == 'L') {
+        // Write the metadata header first, as in us_postal_codes.txt
+        HeaderBuffer header(fileName);
+        header.setFileStructureType("3.0");
+        header.setFileStructureVersion("2.0");
+        header.setSizeFormatType("ASCII");
+        header.setPrimaryKeyIndexFileName(fileName + "_index.txt");
+        header.setprimaryKeyIndexFileSchema("ZIP Code,Position");
+        header.setRecordCount(settings.recordCount);
+        header.setFieldCount(6);
+
+        HeaderBuffer::Field field;
+        field.zipCode = "string";
+        field.placeName = "string";
+        field.state = "string";
+        field.county = "string";
+        field.latitude = "double";
+        field.longitude = "double";
+        header.addField(field);
+
+        header.setHeaderSizeBytes(header.calculateHeaderSize());
+        header.writeHeaderToFile(fileName);
+    }
+
+    std::ofstream file(fileName, std::ios::binary | (fileType == 'L' ? std::ios::app : std::ios::trunc));
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file " << fileName << " for writing.\n";
+        return -1;
+    }
+
+    if (fileType == 'C') {
+        file << "Zip Code,Place Name,State,County,Lat,Long\n";
+    }
+
+    while (nextRecord(record)) {
+        std::string recordString = formatRecord(record);
+        if (fileType == 'L') {
+            file << recordString.length() << ",";
+        }
+        file << recordString << "\n";
+        written++;
+    }
+
+    // A file cut short by the keys running out would not hold the records its header counts
+    if (generated < settings.recordCount) {
+        file.close();
+        std::remove(fileName.c_str());
+        return -1;
+    }
+    return written;
+}
+
+
+/// @brief Parses "dense", "sparse" or "skewed".
+bool RecordGenerator::parseKeyDistribution(const std::string& name, KeyDistribution& distribution) {
+    if (name == "dense") { distribution = DENSE; }
+    else if (name == "sparse") { distribution = SPARSE; }
+    else if (name == "skewed") { distribution = SKEWED; }
+    else { return false; }
+    return true;
+}
+
+
+/// @brief Parses "uniform", "normal" or "fixed".
+bool RecordGenerator::parseLengthDistribution(const std::string& name, LengthDistribution& distribution) {
+    if (name == "uniform") { distribution = UNIFORM; }
+    else if (name == "normal") { distribution = NORMAL; }
+    else if (name == "fixed") { distribution = FIXED; }
+    else { return false; }
+    return true;
+}
@@ -0,0 +1,116 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file RecordGenerator.h
+ * @class RecordGenerator
+ * @brief Generates deterministic synthetic ZIP code records for testing at scale.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Produces records with the same six fields as ZipCodeRecord in ascending
+ *    key order, so they can be written as any of the three file types:
+ * \n  -- 'C' = CSV with a column header line
+ * \n  -- 'L' = Length-indicated records after a metadata header
+ * \n  -- 'B' = Blocked length-indicated records written with BlockWriter
+ * \n
+ * \n The same seed and settings always produce the same file, on any
+ *    platform, because every random value is derived directly from the
+ *    64-bit Mersenne Twister output rather than from the library's
+ *    distributions.
+ * \n
+ * \n Key distributions:
+ * \n  -- Dense: consecutive keys starting at 1
+ * \n  -- Sparse: uniformly random gaps averaging keyGap
+ * \n  -- Skewed: runs of consecutive keys separated by heavy-tailed gaps
+ * \n
+ * \n States are assigned in contiguous runs of keys as real ZIP codes are.
+ *    Place names and counties are drawn from fixed vocabularies with a
+ *    Zipf-like skew, so popular names repeat many times. Their lengths
+ *    follow the chosen length distribution between the minimum and maximum.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef RECORDGENERATOR_H
+#define RECORDGENERATOR_H
+
+#include <random>
+#include <string>
+#include "ZipCodeBuffer.h"
+
+class RecordGenerator {
+public:
+    enum KeyDistribution { DENSE, SPARSE, SKEWED };
+    enum LengthDistribution { UNIFORM, NORMAL, FIXED };
+
+    /// @brief Settings for a generated dataset.
+    struct Settings {
+        long long recordCount = 1000000;
+        unsigned long long seed = 331;
+        KeyDistribution keyDistribution = DENSE;
+        int keyGap = 10;                          // Average gap between keys for sparse and skewed keys
+        LengthDistribution lengthDistribution = UNIFORM;
+        int minNameLength = 4;                    // Shortest place or county name
+        int maxNameLength = 16;                   // Longest place or county name
+        int placeCount = 0;                       // Distinct place names, 0 for one per four records
+        int countyCount = 3000;                   // Distinct county names
+        int blockSize = 512;                      // Block size for 'B' files
+        int fillPercent = 75;                     // Block fill factor for 'B' files
+    };
+
+    /**
+     * @brief Construct a new Record Generator object.
+     * @param settings The settings of the dataset.
+     * @post The generator is ready to return the first record.
+     */
+    explicit RecordGenerator(const Settings& settings);
+
+    /**
+     * @brief Generates the next record.
+     * @param record The record to fill.
+     * @return false once recordCount records have been generated, or if the
+     *      next key would not fit in an int.
+     */
+    bool nextRecord(ZipCodeRecord& record);
+
+    /**
+     * @brief Formats a record as it is stored in the files.
+     * @return "zip,place,state,county,latitude,longitude" with 4 decimal places.
+     */
+    static std::string formatRecord(const ZipCodeRecord& record);
+
+    /**
+     * @brief Generates every record into a new file.
+     * @param fileName The file to create.
+     * @param fileType 'C', 'L' or 'B'.
+     * @param indexFileName The block index to create for 'B' files.
+     * @return The number of records written, or -1 if the file could not be written
+     *      or the keys left the range of an int before recordCount records, in which
+     *      case no file is left behind.
+     */
+    long long writeFile(const std::string& fileName, char fileType, const std::string& indexFileName = "");
+
+    /// @brief Parses "dense", "sparse" or "skewed". Returns false if unknown.
+    static bool parseKeyDistribution(const std::string& name, KeyDistribution& distribution);
+
+    /// @brief Parses "uniform", "normal" or "fixed". Returns false if unknown.
+    static bool parseLengthDistribution(const std::string& name, LengthDistribution& distribution);
+
+    const Settings& getSettings() const { return settings; }
+
+private:
+    Settings settings;
+    std::mt19937_64 random;
+    long long generated = 0;    // Records generated so far
+    long long key = 0;          // Key of the last record
+
+    double nextUnit();                               // Uniform in [0, 1)
+    long long nextBelow(long long bound);            // Uniform in [0, bound)
+    long long nextZipfRank(long long count);         // Skewed toward rank 0
+    long long nextKeyGap();
+    std::string makeName(unsigned long long id, unsigned long long salt) const;
+};
+
+#endif // RECORDGENERATOR_H
@@ -0,0 +1,184 @@
+/// @file RecordTable.cpp
+/// @class RecordTable
+/// See RecordTable.h for full documentation.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "RecordTable.h"
+#include "HeaderBuffer.h"
+
+const uint32_t RecordTable::MAX_SMALL_IDS;
+
+namespace {
+    /// @brief FNV-1a hash of a name.
+    uint32_t hashName(const char* data, size_t size) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ static_cast<unsigned char>(data[i])) * 16777619u;
+        }
+        return hash;
+    }
+
+    int32_t toMicrodegrees(const char* text) {
+        return static_cast<int32_t>(std::llround(std::atof(text) * 1e6));
+    }
+}
+
+
+/// @brief Probes from the name's hash to the slot holding it or the first empty slot.
+size_t RecordTable::Dictionary::slotOf(const char* data, size_t size, const std::string& arena) const {
+    size_t mask = slots.size() - 1;
+    size_t slot = hashName(data, size) & mask;
+    while (slots[slot] != 0) {
+        uint32_t id = slots[slot] - 1;
+        if (names[id].length == size && std::memcmp(arena.data() + names[id].offset, data, size) == 0) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+
+/// @brief Doubles the slots, rehashing every name, so they stay at most half full.
+void RecordTable::Dictionary::grow(const std::string& arena) {
+    slots.assign(std::max<size_t>(16, slots.size() * 2), 0);
+    for (uint32_t id = 0; id < size(); id++) {
+        slots[slotOf(arena.data() + names[id].offset, names[id].length, arena)] = id + 1;
+    }
+}
+
+
+uint32_t RecordTable::Dictionary::intern(const char* data, size_t size, std::string& arena) {
+    if ((this->size() + 1) * 2 > slots.size()) {
+        grow(arena);
+    }
+    size_t slot = slotOf(data, size, arena);
+    if (slots[slot] == 0) {
+        Name name = { static_cast<uint32_t>(arena.size()), static_cast<uint32_t>(size) };
+        names.push_back(name);
+        arena.append(data, size);
+        slots[slot] = static_cast<uint32_t>(names.size());
+    }
+    return slots[slot] - 1;
+}
+
+
+int RecordTable::Dictionary::find(const char* data, size_t size, const std::string& arena) const {
+    if (slots.empty()) {
+        return -1;
+    }
+    return static_cast<int>(slots[slotOf(data, size, arena)]) - 1;
+}
+
+
+ZipCodeRecord RecordTable::RecordView::toRecord() const {
+    ZipCodeRecord record;
+    record.zipCode = std::to_string(zipCode());
+    record.placeName = placeName().str();
+    record.state = state().str();
+    record.county = county().str();
+    record.latitude = latitude();
+    record.longitude = longitude();
+    return record;
+}
+
+
+/// @brief Reads the records in file order, then stably sorts the rows, so records of one ZIP code keep their order.
+bool RecordTable::load(const std::string& dataFileName) {
+    std::ifstream file(dataFileName, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open " << dataFileName << " to load." << std::endl;
+        return false;
+    }
+
+    // Find the file type the same way ZipCodeTableViewer does
+    HeaderBuffer headerBuffer(dataFileName);
+    char fileType = 'C';
+    if (dataFileName.find(".csv") == std::string::npos) {
+        headerBuffer.readHeader();
+        fileType = (headerBuffer.getBlockSize() == 0) ? 'L' : 'B';
+    }
+
+    ZipCodeBuffer buffer(file, fileType, headerBuffer);
+    std::string record;
+    while (!(record = buffer.readNextRecordString()).empty()) {
+        // Records without six fields are skipped, as every index does
+        if (!addRecord(record) && (stateCount() >= MAX_SMALL_IDS || countyCount() >= MAX_SMALL_IDS)) {
+            std::cerr << "Error: " << dataFileName << " has too many states or counties to load." << std::endl;
+            return false;
+        }
+    }
+    std::stable_sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+        return a.zipCode < b.zipCode;
+    });
+    inZipOrder = true;
+    return true;
+}
+
+
+/// @brief Splits the six fields in place and interns the three names, without a std::string per field.
+bool RecordTable::addRecord(const std::string& record) {
+    size_t starts[7];
+    size_t fieldCount = 0;
+    size_t start = 0;
+    while (fieldCount < 6) {
+        starts[fieldCount++] = start;
+        size_t comma = record.find(',', start);
+        if (comma == std::string::npos) {
+            break;
+        }
+        start = comma + 1;
+    }
+    if (fieldCount != 6 || record.find(',', starts[5]) != std::string::npos) {
+        return false;
+    }
+    starts[6] = record.size() + 1;
+
+    const char* text = record.c_str();
+    // A new state or county must still fit its uint16_t id
+    if ((states.find(text + starts[2], starts[3] - starts[2] - 1, arena) < 0 && stateCount() >= MAX_SMALL_IDS)
+        || (counties.find(text + starts[3], starts[4] - starts[3] - 1, arena) < 0 && countyCount() >= MAX_SMALL_IDS)) {
+        return false;
+    }
+
+    Row row;
+    row.zipCode = static_cast<uint32_t>(std::strtoul(text, nullptr, 10));
+    row.place = places.intern(text + starts[1], starts[2] - starts[1] - 1, arena);
+    row.state = static_cast<uint16_t>(states.intern(text + starts[2], starts[3] - starts[2] - 1, arena));
+    row.county = static_cast<uint16_t>(counties.intern(text + starts[3], starts[4] - starts[3] - 1, arena));
+    row.latitude = toMicrodegrees(text + starts[4]);
+    row.longitude = toMicrodegrees(text + starts[5]);
+    if (!rows.empty() && row.zipCode < rows.back().zipCode) {
+        inZipOrder = false;
+    }
+    rows.push_back(row);
+    return true;
+}
+
+
+RecordTable::Iterator RecordTable::find(uint32_t zipCode) const {
+    if (inZipOrder) {
+        auto found = std::lower_bound(rows.begin(), rows.end(), zipCode, [](const Row& row, uint32_t wanted) {
+            return row.zipCode < wanted;
+        });
+        size_t row = static_cast<size_t>(found - rows.begin());
+        return Iterator(this, (found != rows.end() && found->zipCode == zipCode) ? row : rows.size());
+    }
+    for (size_t row = 0; row < rows.size(); row++) {
+        if (rows[row].zipCode == zipCode) {
+            return Iterator(this, row);
+        }
+    }
+    return end();
+}
+
+
+size_t RecordTable::memoryBytes() const {
+    return sizeof(*this) + rows.capacity() * sizeof(Row) + arena.capacity() + places.memoryBytes()
+         + states.memoryBytes() + counties.memoryBytes();
+}
@@ -0,0 +1,188 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file RecordTable.h
+ * @class RecordTable
+ * @brief In-memory table of records as small integer ids into interned string dictionaries.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n A ZipCodeRecord holds four std::strings, 144 bytes with their inline
+ *    buffers and a heap block for every place name too long for one, though
+ *    the data has under 60 states, under 2000 counties and many repeated
+ *    place names. A RecordTable keeps each record as a 20 byte Row: the ZIP
+ *    code, ids of its place, state and county, and its coordinates in
+ *    microdegrees, which hold the data's four decimal places exactly.
+ * \n
+ * \n Every distinct name is stored once, in one arena of characters shared
+ *    by the three dictionaries. A dictionary numbers its names in the order
+ *    first seen and keeps the offset and length of each. Names are interned
+ *    through an open addressing table of ids, hashed with FNV-1a, so
+ *    interning needs no std::string per name either.
+ * \n
+ * \n Lookups and iteration return a RecordView, which reads the Row and the
+ *    arena in place, and a Text for every name, a pointer and a length into
+ *    the arena. Views stay valid until the next addRecord. toRecord copies
+ *    a view out as a ZipCodeRecord.
+ * \n
+ * \n load reads a C, L or B file, then sorts the rows by ZIP code, so
+ *    find is a binary search. Records added out of ZIP code order by
+ *    addRecord alone are found by a linear scan instead.
+ * \n
+ * \n memoryBytes counts every byte the table owns, including the capacity
+ *    its vectors hold in reserve.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef RECORDTABLE_H
+#define RECORDTABLE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ZipCodeBuffer.h"
+
+class RecordTable {
+public:
+    /// @brief A name in the arena. Not null terminated.
+    struct Text {
+        const char* data;
+        size_t size;
+
+        std::string str() const { return std::string(data, size); }
+        bool operator==(const std::string& other) const { return other.compare(0, other.size(), data, size) == 0; }
+        bool operator!=(const std::string& other) const { return !(*this == other); }
+    };
+
+private:
+    // Declared before the views, which read them
+    struct Row {
+        uint32_t zipCode;
+        uint32_t place;
+        uint16_t state;
+        uint16_t county;
+        int32_t latitude;       // Microdegrees
+        int32_t longitude;
+    };
+
+    /// @brief Numbers distinct names, whose characters are in the arena.
+    class Dictionary {
+    public:
+        /// @brief The id of a name, appending it to the arena if it is new.
+        uint32_t intern(const char* data, size_t size, std::string& arena);
+
+        /// @brief The id of a name, or -1 if it is not in the dictionary.
+        int find(const char* data, size_t size, const std::string& arena) const;
+
+        Text text(uint32_t id, const std::string& arena) const {
+            Text name = { arena.data() + names[id].offset, names[id].length };
+            return name;
+        }
+        size_t size() const { return names.size(); }
+        size_t memoryBytes() const { return names.capacity() * sizeof(Name) + slots.capacity() * sizeof(uint32_t); }
+
+    private:
+        struct Name {
+            uint32_t offset;            // Into the arena
+            uint32_t length;
+        };
+        std::vector<Name> names;
+        std::vector<uint32_t> slots;    // Open addressing table of id + 1, or 0 when empty
+
+        size_t slotOf(const char* data, size_t size, const std::string& arena) const;
+        void grow(const std::string& arena);
+    };
+
+public:
+    static const uint32_t MAX_SMALL_IDS = 65536;    // States and counties, whose ids are uint16_t
+
+    /// @brief One record of the table, read in place.
+    class RecordView {
+    public:
+        uint32_t zipCode() const { return row->zipCode; }
+        Text placeName() const { return table->places.text(row->place, table->arena); }
+        Text state() const { return table->states.text(row->state, table->arena); }
+        Text county() const { return table->counties.text(row->county, table->arena); }
+        double latitude() const { return row->latitude / 1e6; }
+        double longitude() const { return row->longitude / 1e6; }
+
+        uint32_t placeId() const { return row->place; }
+        uint32_t stateId() const { return row->state; }
+        uint32_t countyId() const { return row->county; }
+
+        /// @brief A copy with its own strings, as ZipCodeBuffer::parseRecord returns it.
+        ZipCodeRecord toRecord() const;
+
+    private:
+        friend class RecordTable;
+        RecordView(const RecordTable* table, size_t row) : table(table), row(&table->rows[row]) {}
+
+        const RecordTable* table;
+        const Row* row;
+    };
+
+    /// @brief Walks the rows in table order.
+    class Iterator {
+    public:
+        RecordView operator*() const { return RecordView(table, row); }
+        Iterator& operator++() { row++; return *this; }
+        bool operator==(const Iterator& other) const { return row == other.row; }
+        bool operator!=(const Iterator& other) const { return row != other.row; }
+
+    private:
+        friend class RecordTable;
+        Iterator(const RecordTable* table, size_t row) : table(table), row(row) {}
+
+        const RecordTable* table;
+        size_t row;
+    };
+
+    RecordTable() : inZipOrder(true) {}
+
+    /**
+     * @brief Reads every record of a data file, then sorts the table by ZIP code.
+     * @param dataFileName A C, L or B file. Files ending in ".csv" are C files.
+     * @return false if the file could not be read or has too many states or counties.
+     */
+    bool load(const std::string& dataFileName);
+
+    /**
+     * @brief Adds a record string at the end of the table.
+     * @return false if it does not have six fields, or its state or county would need an id past MAX_SMALL_IDS.
+     */
+    bool addRecord(const std::string& record);
+
+    /// @brief The first record of a ZIP code, or end() if there is no such ZIP code.
+    Iterator find(uint32_t zipCode) const;
+
+    size_t size() const { return rows.size(); }
+    RecordView operator[](size_t row) const { return RecordView(this, row); }
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, rows.size()); }
+
+    size_t placeCount() const { return places.size(); }
+    size_t stateCount() const { return states.size(); }
+    size_t countyCount() const { return counties.size(); }
+
+    /// @brief The id of a state code as written in the data file, or -1 if no record has it.
+    int stateId(const std::string& state) const { return states.find(state.data(), state.size(), arena); }
+
+    /// @brief Every byte the table owns, counting reserved capacity.
+    size_t memoryBytes() const;
+
+    /// @brief The bytes of distinct names in the arena.
+    size_t arenaBytes() const { return arena.size(); }
+
+private:
+    std::vector<Row> rows;
+    std::string arena;
+    Dictionary places;
+    Dictionary states;
+    Dictionary counties;
+    bool inZipOrder;            // Whether find can search the rows by halves
+};
+
+#endif // RECORDTABLE_H
@@ -0,0 +1,334 @@
+/// @file RoaringBitmap.cpp
+/// @class RoaringBitmap
+/// See RoaringBitmap.h for full documentation.
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include "RoaringBitmap.h"
+
+const size_t RoaringBitmap::ARRAY_LIMIT;
+const size_t RoaringBitmap::BITMAP_WORDS;
+
+
+bool RoaringBitmap::Container::contains(uint16_t low) const {
+    if (isBitmap()) {
+        return (bits[low >> 6] >> (low & 63)) & 1;
+    }
+    return std::binary_search(array.begin(), array.end(), low);
+}
+
+
+/// @brief Adds the low bits of a value. Returns false if it was already there.
+bool RoaringBitmap::Container::add(uint16_t low) {
+    if (isBitmap()) {
+        uint64_t mask = 1ULL << (low & 63);
+        if (bits[low >> 6] & mask) {
+            return false;
+        }
+        bits[low >> 6] |= mask;
+        count++;
+        return true;
+    }
+
+    // Values usually arrive in order, so check the end before searching
+    if (array.empty() || array.back() < low) {
+        array.push_back(low);
+    }
+    else {
+        std::vector<uint16_t>::iterator position = std::lower_bound(array.begin(), array.end(), low);
+        if (*position == low) {
+            return false;
+        }
+        array.insert(position, low);
+    }
+    count++;
+    if (array.size() > ARRAY_LIMIT) {
+        toBitmap();
+    }
+    return true;
+}
+
+
+void RoaringBitmap::Container::toBitmap() {
+    bits.assign(BITMAP_WORDS, 0);
+    for (uint16_t low : array) {
+        bits[low >> 6] |= 1ULL << (low & 63);
+    }
+    std::vector<uint16_t>().swap(array);
+}
+
+
+/// @brief Turns a bitmap container back into an array once it holds few enough values.
+void RoaringBitmap::Container::toArrayIfSmall() {
+    if (!isBitmap() || count > ARRAY_LIMIT) {
+        return;
+    }
+    array.clear();
+    array.reserve(count);
+    for (size_t word = 0; word < BITMAP_WORDS; word++) {
+        uint64_t wordBits = bits[word];
+        while (wordBits != 0) {
+            array.push_back(static_cast<uint16_t>(word * 64 + __builtin_ctzll(wordBits)));
+            wordBits &= wordBits - 1;
+        }
+    }
+    std::vector<uint64_t>().swap(bits);
+}
+
+
+RoaringBitmap::Container& RoaringBitmap::containerFor(uint16_t key) {
+    if (containers.empty() || containers.back().key < key) {
+        containers.push_back(Container());
+        containers.back().key = key;
+        containers.back().count = 0;
+        return containers.back();
+    }
+    std::vector<Container>::iterator position = std::lower_bound(containers.begin(), containers.end(), key,
+        [](const Container& container, uint16_t k) { return container.key < k; });
+    if (position->key != key) {
+        position = containers.insert(position, Container());
+        position->key = key;
+        position->count = 0;
+    }
+    return *position;
+}
+
+
+const RoaringBitmap::Container* RoaringBitmap::findContainer(uint16_t key) const {
+    std::vector<Container>::const_iterator position = std::lower_bound(containers.begin(), containers.end(), key,
+        [](const Container& container, uint16_t k) { return container.key < k; });
+    return (position == containers.end() || position->key != key) ? nullptr : &*position;
+}
+
+
+void RoaringBitmap::add(uint32_t value) {
+    if (containerFor(static_cast<uint16_t>(value >> 16)).add(static_cast<uint16_t>(value & 0xFFFF))) {
+        valueCount++;
+    }
+}
+
+
+void RoaringBitmap::addRange(uint32_t low, uint32_t high) {
+    for (uint64_t value = low; value <= high; value++) {
+        add(static_cast<uint32_t>(value));
+    }
+}
+
+
+bool RoaringBitmap::contains(uint32_t value) const {
+    const Container* container = findContainer(static_cast<uint16_t>(value >> 16));
+    return container != nullptr && container->contains(static_cast<uint16_t>(value & 0xFFFF));
+}
+
+
+/// @brief The values of two containers with the same key that are in both.
+RoaringBitmap::Container RoaringBitmap::intersect(const Container& a, const Container& b) {
+    Container result;
+    result.key = a.key;
+    if (a.isBitmap() && b.isBitmap()) {
+        result.bits.resize(BITMAP_WORDS);
+        uint32_t count = 0;
+        for (size_t word = 0; word < BITMAP_WORDS; word++) {
+            result.bits[word] = a.bits[word] & b.bits[word];
+            count += static_cast<uint32_t>(__builtin_popcountll(result.bits[word]));
+        }
+        result.count = count;
+        result.toArrayIfSmall();
+    }
+    else if (a.isBitmap() || b.isBitmap()) {
+        // Probe the bitmap with each value of the array
+        const Container& array = a.isBitmap() ? b : a;
+        const Container& bitmap = a.isBitmap() ? a : b;
+        for (uint16_t low : array.array) {
+            if (bitmap.contains(low)) {
+                result.array.push_back(low);
+            }
+        }
+        result.count = static_cast<uint32_t>(result.array.size());
+    }
+    else {
+        std::set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                              std::back_inserter(result.array));
+        result.count = static_cast<uint32_t>(result.array.size());
+    }
+    return result;
+}
+
+
+/// @brief The values of two containers with the same key that are in either.
+RoaringBitmap::Container RoaringBitmap::unite(const Container& a, const Container& b) {
+    Container result;
+    result.key = a.key;
+    if (!a.isBitmap() && !b.isBitmap() && a.count + b.count <= ARRAY_LIMIT) {
+        std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                       std::back_inserter(result.array));
+        result.count = static_cast<uint32_t>(result.array.size());
+        return result;
+    }
+
+    result.bits.assign(BITMAP_WORDS, 0);
+    const Container* sides[] = { &a, &b };
+    for (const Container* side : sides) {
+        if (side->isBitmap()) {
+            for (size_t word = 0; word < BITMAP_WORDS; word++) {
+                result.bits[word] |= side->bits[word];
+            }
+        }
+        else {
+            for (uint16_t low : side->array) {
+                result.bits[low >> 6] |= 1ULL << (low & 63);
+            }
+        }
+    }
+    uint32_t count = 0;
+    for (uint64_t word : result.bits) {
+        count += static_cast<uint32_t>(__builtin_popcountll(word));
+    }
+    result.count = count;
+    result.toArrayIfSmall();
+    return result;
+}
+
+
+RoaringBitmap RoaringBitmap::operator&(const RoaringBitmap& other) const {
+    RoaringBitmap result;
+    size_t i = 0, j = 0;
+    while (i < containers.size() && j < other.containers.size()) {
+        if (containers[i].key < other.containers[j].key) {
+            i++;
+        }
+        else if (other.containers[j].key < containers[i].key) {
+            j++;
+        }
+        else {
+            Container both = intersect(containers[i++], other.containers[j++]);
+            if (both.count > 0) {
+                result.valueCount += both.count;
+                result.containers.push_back(std::move(both));
+            }
+        }
+    }
+    return result;
+}
+
+
+RoaringBitmap RoaringBitmap::operator|(const RoaringBitmap& other) const {
+    RoaringBitmap result;
+    size_t i = 0, j = 0;
+    while (i < containers.size() || j < other.containers.size()) {
+        if (j == other.containers.size() || (i < containers.size() && containers[i].key < other.containers[j].key)) {
+            result.containers.push_back(containers[i++]);
+        }
+        else if (i == containers.size() || other.containers[j].key < containers[i].key) {
+            result.containers.push_back(other.containers[j++]);
+        }
+        else {
+            result.containers.push_back(unite(containers[i++], other.containers[j++]));
+        }
+        result.valueCount += result.containers.back().count;
+    }
+    return result;
+}
+
+
+bool RoaringBitmap::operator==(const RoaringBitmap& other) const {
+    if (valueCount != other.valueCount || containers.size() != other.containers.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < containers.size(); i++) {
+        const Container& a = containers[i];
+        const Container& b = other.containers[i];
+        // A container's kind follows from its count, so equal sets have equal containers
+        if (a.key != b.key || a.count != b.count || a.array != b.array || a.bits != b.bits) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+std::vector<uint32_t> RoaringBitmap::toVector() const {
+    std::vector<uint32_t> values;
+    values.reserve(valueCount);
+    forEach([&values](uint32_t value) { values.push_back(value); });
+    return values;
+}
+
+
+size_t RoaringBitmap::memoryBytes() const {
+    size_t bytes = sizeof(*this) + containers.capacity() * sizeof(Container);
+    for (const Container& container : containers) {
+        bytes += container.array.capacity() * sizeof(uint16_t) + container.bits.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+}
+
+
+/// @brief Writes the container count, then each container's key, count and values.
+void RoaringBitmap::serialize(std::string& image) const {
+    uint32_t containerCount = static_cast<uint32_t>(containers.size());
+    image.append(reinterpret_cast<const char*>(&containerCount), sizeof(containerCount));
+    for (const Container& container : containers) {
+        image.append(reinterpret_cast<const char*>(&container.key), sizeof(container.key));
+        image.append(reinterpret_cast<const char*>(&container.count), sizeof(container.count));
+        if (container.isBitmap()) {
+            image.append(reinterpret_cast<const char*>(container.bits.data()), BITMAP_WORDS * sizeof(uint64_t));
+        }
+        else {
+            image.append(reinterpret_cast<const char*>(container.array.data()), container.array.size() * sizeof(uint16_t));
+        }
+    }
+}
+
+
+bool RoaringBitmap::deserialize(const char* data, size_t length, size_t& used) {
+    containers.clear();
+    valueCount = 0;
+    size_t position = 0;
+    uint32_t containerCount;
+    if (length < sizeof(containerCount)) {
+        return false;
+    }
+    std::memcpy(&containerCount, data, sizeof(containerCount));
+    position += sizeof(containerCount);
+
+    for (uint32_t i = 0; i < containerCount; i++) {
+        Container container;
+        if (length - position < sizeof(container.key) + sizeof(container.count)) {
+            return false;
+        }
+        std::memcpy(&container.key, data + position, sizeof(container.key));
+        position += sizeof(container.key);
+        std::memcpy(&container.count, data + position, sizeof(container.count));
+        position += sizeof(container.count);
+        if (container.count == 0 || container.count > 65536
+            || (!containers.empty() && containers.back().key >= container.key)) {
+            return false;
+        }
+
+        // The count says which kind of container follows
+        if (container.count > ARRAY_LIMIT) {
+            size_t bytes = BITMAP_WORDS * sizeof(uint64_t);
+            if (length - position < bytes) {
+                return false;
+            }
+            container.bits.resize(BITMAP_WORDS);
+            std::memcpy(container.bits.data(), data + position, bytes);
+            position += bytes;
+        }
+        else {
+            size_t bytes = container.count * sizeof(uint16_t);
+            if (length - position < bytes) {
+                return false;
+            }
+            container.array.resize(container.count);
+            std::memcpy(container.array.data(), data + position, bytes);
+            position += bytes;
+        }
+        valueCount += container.count;
+        containers.push_back(std::move(container));
+    }
+    used = position;
+    return true;
+}
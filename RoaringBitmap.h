@@ -0,0 +1,137 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file RoaringBitmap.h
+ * @class RoaringBitmap
+ * @brief Compressed set of 32-bit integers in the style of Roaring bitmaps.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n The values are split by their high 16 bits into containers of at most
+ *    65536 values, each holding the low 16 bits of its values in one of two
+ *    ways:
+ * \n  -- an array container, a sorted array of 2 bytes per value, while it
+ *       holds at most ARRAY_LIMIT values
+ * \n  -- a bitmap container, 65536 bits in 8 kB, once it holds more
+ * \n so a set never takes much more than 2 bytes per value or 1 bit per
+ *    possible value, whichever is smaller. A container switches kind as
+ *    values are added or as the result of an operation.
+ * \n
+ * \n cardinality adds up the container counts, which bitmap containers keep
+ *    with popcounts. Intersections and unions work container by container:
+ *    merging two arrays, probing a bitmap with an array's values, or
+ *    combining two bitmaps 64 bits at a time.
+ * \n
+ * \n serialize writes the containers in host byte order; an image is only
+ *    read back on a machine of the same byte order. Run containers, for long
+ *    runs of consecutive values, are left out.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef ROARINGBITMAP_H
+#define ROARINGBITMAP_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class RoaringBitmap {
+public:
+    static const size_t ARRAY_LIMIT = 4096;     // Values an array container holds before becoming a bitmap
+    static const size_t BITMAP_WORDS = 1024;    // 64-bit words of a bitmap container
+
+    RoaringBitmap() : valueCount(0) {}
+
+    /// @brief Adds a value. Adding values in ascending order is fastest.
+    void add(uint32_t value);
+
+    /// @brief Adds every value from low to high, inclusive.
+    void addRange(uint32_t low, uint32_t high);
+
+    bool contains(uint32_t value) const;
+
+    /// @brief The number of values in the set.
+    size_t cardinality() const { return valueCount; }
+    bool empty() const { return valueCount == 0; }
+
+    /// @brief The values in both sets.
+    RoaringBitmap operator&(const RoaringBitmap& other) const;
+
+    /// @brief The values in either set.
+    RoaringBitmap operator|(const RoaringBitmap& other) const;
+
+    bool operator==(const RoaringBitmap& other) const;
+    bool operator!=(const RoaringBitmap& other) const { return !(*this == other); }
+
+    /// @brief Calls visit with every value in ascending order.
+    template <typename Visitor>
+    void forEach(Visitor visit) const;
+
+    /// @brief Every value in ascending order.
+    std::vector<uint32_t> toVector() const;
+
+    /// @brief The bytes the containers take in memory.
+    size_t memoryBytes() const;
+
+    /// @brief Appends the set to image.
+    void serialize(std::string& image) const;
+
+    /**
+     * @brief Reads a set written by serialize.
+     * @param data The image.
+     * @param length Bytes available at data.
+     * @param used Receives the bytes the set took.
+     * @return false if the image is cut short or malformed.
+     */
+    bool deserialize(const char* data, size_t length, size_t& used);
+
+private:
+    /// @brief The values sharing one high 16 bits.
+    struct Container {
+        uint16_t key;                   // High 16 bits of every value
+        uint32_t count;                 // Values held
+        std::vector<uint16_t> array;    // Sorted low bits, while an array container
+        std::vector<uint64_t> bits;     // BITMAP_WORDS words, once a bitmap container
+
+        bool isBitmap() const { return !bits.empty(); }
+        bool contains(uint16_t low) const;
+        bool add(uint16_t low);
+        void toBitmap();
+        void toArrayIfSmall();
+    };
+
+    std::vector<Container> containers;  // Sorted by key
+    size_t valueCount;
+
+    Container& containerFor(uint16_t key);
+    const Container* findContainer(uint16_t key) const;
+    static Container intersect(const Container& a, const Container& b);
+    static Container unite(const Container& a, const Container& b);
+};
+
+
+template <typename Visitor>
+void RoaringBitmap::forEach(Visitor visit) const {
+    for (const Container& container : containers) {
+        uint32_t high = static_cast<uint32_t>(container.key) << 16;
+        if (!container.isBitmap()) {
+            for (uint16_t low : container.array) {
+                visit(high | low);
+            }
+            continue;
+        }
+        for (size_t word = 0; word < BITMAP_WORDS; word++) {
+            // Visit the set bits lowest first, clearing each one
+            uint64_t bits = container.bits[word];
+            while (bits != 0) {
+                visit(high | static_cast<uint32_t>(word * 64 + __builtin_ctzll(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+}
+
+#endif // ROARINGBITMAP_H
@@ -0,0 +1,299 @@
+/// @file SecondaryIndex.cpp
+/// @class SecondaryIndex
+/// See SecondaryIndex.h for full documentation.
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <unistd.h>
+#include "SecondaryIndex.h"
+#include "DataFingerprint.h"
+#include "ZipCodeBuffer.h"
+#include "HeaderBuffer.h"
+#include "Stats.h"
+
+namespace {
+    const char* const FIELD_NAMES[] = { "place", "county" };
+    const int FIELD_COUNT = 2;
+
+    /// @brief Splits a record string into its comma-separated fields.
+    std::vector<std::string> splitFields(const std::string& record) {
+        std::vector<std::string> fields;
+        std::istringstream recordStream(record);
+        std::string field;
+        while (std::getline(recordStream, field, ',')) {
+            fields.push_back(field);
+        }
+        return fields;
+    }
+}
+
+
+SecondaryIndex::SecondaryIndex(const std::string& dataFileName, Field field)
+    : dataFileName(dataFileName), field(field), postingsStart(0), fd(-1) {
+}
+
+
+SecondaryIndex::~SecondaryIndex() {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+
+std::string SecondaryIndex::indexFileName(const std::string& dataFileName, Field field) {
+    return dataFileName + "_" + FIELD_NAMES[field] + "_index.idx";
+}
+
+
+std::string SecondaryIndex::normalize(const std::string& text) {
+    std::string normalized;
+    bool pendingSpace = false;
+    for (char c : text) {
+        unsigned char character = static_cast<unsigned char>(c);
+        if (std::isalnum(character)) {
+            if (pendingSpace && !normalized.empty()) {
+                normalized += ' ';
+            }
+            pendingSpace = false;
+            normalized += static_cast<char>(std::tolower(character));
+        }
+        else {
+            pendingSpace = true;
+        }
+    }
+    return normalized;
+}
+
+
+std::string SecondaryIndex::placeTerm(const std::string& placeName) {
+    return normalize(placeName);
+}
+
+
+std::string SecondaryIndex::countyTerm(const std::string& state, const std::string& county) {
+    std::string stateCode = normalize(state);
+    std::transform(stateCode.begin(), stateCode.end(), stateCode.begin(), ::toupper);
+    return stateCode + "/" + normalize(county);
+}
+
+
+std::string SecondaryIndex::recordTerm(Field field, const std::string& record) {
+    std::vector<std::string> fields = splitFields(record);
+    if (fields.size() != 6) {
+        return "";
+    }
+    return (field == PLACE) ? placeTerm(fields[1]) : countyTerm(fields[2], fields[3]);
+}
+
+
+void SecondaryIndex::encodePostings(const std::vector<long long>& locations, std::string& encoded) {
+    unsigned long long previous = 0;
+    for (long long location : locations) {
+        unsigned long long delta = static_cast<unsigned long long>(location) - previous;
+        previous = static_cast<unsigned long long>(location);
+        // Seven bits per byte, low bits first, the high bit set on every byte but the last
+        while (delta >= 0x80) {
+            encoded += static_cast<char>((delta & 0x7F) | 0x80);
+            delta >>= 7;
+        }
+        encoded += static_cast<char>(delta);
+    }
+}
+
+
+bool SecondaryIndex::decodePostings(const char* data, size_t length, size_t count, std::vector<long long>& locations) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    size_t position = 0;
+    unsigned long long location = 0;
+    for (size_t i = 0; i < count; i++) {
+        unsigned long long delta = 0;
+        int shift = 0;
+        while (true) {
+            if (position >= length || shift > 63) {
+                return false;
+            }
+            unsigned char byte = bytes[position++];
+            delta |= static_cast<unsigned long long>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                break;
+            }
+            shift += 7;
+        }
+        location += delta;
+        locations.push_back(static_cast<long long>(location));
+    }
+    return true;
+}
+
+
+/// @brief Reads the data file once, collecting the locations of every term of every field, then writes the index files.
+bool SecondaryIndex::build(const std::string& dataFileName) {
+    // Taken before the records are read, so a change while they are is seen as one
+    DataFingerprint fingerprint;
+    std::ifstream file(dataFileName, std::ios::binary);
+    if (!file.is_open() || !fingerprint.read(dataFileName)) {
+        std::cerr << "Error: Could not open " << dataFileName << " to index." << std::endl;
+        return false;
+    }
+
+    // Find the file type the same way ZipCodeTableViewer does
+    HeaderBuffer headerBuffer(dataFileName);
+    char fileType = 'C';
+    if (dataFileName.find(".csv") == std::string::npos) {
+        headerBuffer.readHeader();
+        fileType = (headerBuffer.getBlockSize() == 0) ? 'L' : 'B';
+    }
+
+    std::map<std::string, std::vector<long long> > postings[FIELD_COUNT];
+    ZipCodeBuffer buffer(file, fileType, headerBuffer);
+    while (true) {
+        long long position = static_cast<long long>(std::streamoff(buffer.getCurrentPosition()));
+        std::string record = buffer.readNextRecordString();
+        if (record.empty()) {
+            break;
+        }
+        long long location = (fileType == 'B') ? buffer.blockBuffer.getCurrentRBN() : position;
+        for (int f = 0; f < FIELD_COUNT; f++) {
+            std::string term = recordTerm(static_cast<Field>(f), record);
+            if (term.empty()) {
+                continue;
+            }
+            std::vector<long long>& locations = postings[f][term];
+            // Records of one block share a location
+            if (locations.empty() || locations.back() != location) {
+                locations.push_back(location);
+            }
+        }
+    }
+
+    for (int f = 0; f < FIELD_COUNT; f++) {
+        std::string dictionary;
+        std::string encoded;
+        for (auto& entry : postings[f]) {
+            std::vector<long long>& locations = entry.second;
+            // Blocks of a B file are read in sequence set order, which need not be RBN order
+            std::sort(locations.begin(), locations.end());
+            locations.erase(std::unique(locations.begin(), locations.end()), locations.end());
+            size_t offset = encoded.size();
+            encodePostings(locations, encoded);
+            dictionary += entry.first + "\t" + std::to_string(locations.size()) + "\t" + std::to_string(offset)
+                        + "\t" + std::to_string(encoded.size() - offset) + "\n";
+        }
+
+        std::string indexName = indexFileName(dataFileName, static_cast<Field>(f));
+        std::ofstream indexFile(indexName, std::ios::binary | std::ios::trunc);
+        indexFile << "SecondaryIndex," << FIELD_NAMES[f] << "," << fileType << "," << postings[f].size() << ","
+                  << fingerprint.text() << "\n" << dictionary;
+        indexFile.write(encoded.data(), encoded.size());
+        if (!indexFile) {
+            std::cerr << "Error: Could not write " << indexName << "." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/// @brief Loads the dictionary, building the index files first if this one is missing or stale.
+bool SecondaryIndex::open() {
+    std::string indexName = indexFileName(dataFileName, field);
+    std::ifstream indexFile(indexName, std::ios::binary);
+    std::string header;
+    std::getline(indexFile, header);
+    std::vector<std::string> headerFields = splitFields(header);
+
+    // Postings of the data file as it was before, or from before fingerprints, would point at other records
+    DataFingerprint fingerprint;
+    if (headerFields.size() != 5 || !fingerprint.parse(headerFields[4]) || !fingerprint.matches(dataFileName)) {
+        indexFile.close();
+        if (!build(dataFileName)) {
+            return false;
+        }
+        indexFile.open(indexName, std::ios::binary);
+        std::getline(indexFile, header);
+        headerFields = splitFields(header);
+    }
+    if (headerFields.size() != 5 || headerFields[0] != "SecondaryIndex" || headerFields[1] != FIELD_NAMES[field]) {
+        std::cerr << "Error: " << indexName << " is not a " << FIELD_NAMES[field] << " index." << std::endl;
+        return false;
+    }
+    ZIPCODE_STAT(HEADER_PARSES, 1);
+
+    size_t termTotal = static_cast<size_t>(std::atoll(headerFields[3].c_str()));
+    terms.clear();
+    terms.reserve(termTotal);
+    std::string line;
+    for (size_t i = 0; i < termTotal && std::getline(indexFile, line); i++) {
+        std::istringstream lineStream(line);
+        Term term;
+        std::string count, offset, length;
+        std::getline(lineStream, term.term, '\t');
+        std::getline(lineStream, count, '\t');
+        std::getline(lineStream, offset, '\t');
+        std::getline(lineStream, length, '\t');
+        term.count = static_cast<size_t>(std::atoll(count.c_str()));
+        term.offset = std::atoll(offset.c_str());
+        term.length = static_cast<size_t>(std::atoll(length.c_str()));
+        terms.push_back(term);
+        ZIPCODE_STAT(INDEX_LINES_SCANNED, 1);
+    }
+    if (terms.size() != termTotal) {
+        std::cerr << "Error: " << indexName << " ends inside its dictionary." << std::endl;
+        return false;
+    }
+    postingsStart = static_cast<long long>(std::streamoff(indexFile.tellg()));
+
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    fd = ::open(indexName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Error: Could not open " << indexName << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+/// @brief Finds a term in the dictionary and reads and decodes its postings with one pread.
+bool SecondaryIndex::lookup(const std::string& term, std::vector<long long>& locations) const {
+    auto entry = std::lower_bound(terms.begin(), terms.end(), term,
+                                  [](const Term& candidate, const std::string& key) { return candidate.term < key; });
+    if (entry == terms.end() || entry->term != term || fd < 0) {
+        return false;
+    }
+
+    std::string encoded(entry->length, '\0');
+    size_t total = 0;
+    while (total < entry->length) {
+        ssize_t bytesRead = ::pread(fd, &encoded[total], entry->length - total,
+                                    static_cast<off_t>(postingsStart + entry->offset + total));
+        if (bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytesRead <= 0) {
+            break;
+        }
+        total += static_cast<size_t>(bytesRead);
+    }
+    ZIPCODE_STAT(SEEKS, 1);
+    ZIPCODE_STAT(BYTES_READ, total);
+    return decodePostings(encoded.data(), total, entry->count, locations);
+}
+
+
+long long SecondaryIndex::postingsBytes() const {
+    long long total = 0;
+    for (const Term& term : terms) {
+        total += static_cast<long long>(term.length);
+    }
+    return total;
+}
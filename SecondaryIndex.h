@@ -0,0 +1,133 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file SecondaryIndex.h
+ * @class SecondaryIndex
+ * @brief Persistent inverted index from a place name or a county to the locations of its records.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n The primary indexes only answer questions about ZIP codes. A
+ *    SecondaryIndex maps a term to the list of locations, its postings, of
+ *    every record with that term:
+ * \n  -- PLACE: the normalized place name, e.g. "springfield"
+ * \n  -- COUNTY: the state code and normalized county, e.g. "MA/hampden"
+ * \n A location is the byte offset of a record in a C or L file, as in the
+ *    primary index, or the RBN of the block holding it in a B file.
+ *    ZipCodeStore::readLocation reads the records at a location.
+ * \n
+ * \n build reads the data file once and writes one index file per field,
+ *    named by indexFileName. Each file is a text header line, ending with
+ *    the DataFingerprint of the data file it was built from, a dictionary
+ *    of one "term\\tcount\\toffset\\tlength" line per term in sorted order,
+ *    then the postings of every term one after another. Postings are sorted
+ *    locations stored as the difference from the location before, each
+ *    difference as a varint of 7 bits per byte, so the records of one
+ *    county, which sit near each other in the file, take about a byte each.
+ * \n
+ * \n open loads only the dictionary. lookup reads one term's postings with
+ *    a single pread, so a query reads its postings and then its records
+ *    instead of the whole file. Once opened, an index may be shared
+ *    between threads.
+ * \n
+ * \n open builds the index files again when the data file no longer
+ *    matches the fingerprint, so postings never point into a file that
+ *    was generated again or changed since.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef SECONDARYINDEX_H
+#define SECONDARYINDEX_H
+
+#include <string>
+#include <vector>
+
+class SecondaryIndex {
+public:
+    /// @brief The record fields an index can be built on.
+    enum Field {
+        PLACE,      // Place name
+        COUNTY      // State code and county
+    };
+
+    /**
+     * @brief Construct a new Secondary Index object for a data file.
+     * @param dataFileName The C, L or B file the index is of.
+     * @param field The field indexed.
+     */
+    SecondaryIndex(const std::string& dataFileName, Field field);
+    ~SecondaryIndex();
+
+    SecondaryIndex(const SecondaryIndex&) = delete;
+    SecondaryIndex& operator=(const SecondaryIndex&) = delete;
+
+    /**
+     * @brief Reads a data file once and writes the index file of every field.
+     * @param dataFileName The C, L or B file to index. Files ending in ".csv" are C files.
+     * @return false if the data file could not be read or an index file written.
+     */
+    static bool build(const std::string& dataFileName);
+
+    /**
+     * @brief Loads the dictionary of the index file, building the index files first if it does not exist or its data file has changed.
+     * @return false if the index could not be built or loaded.
+     */
+    bool open();
+
+    /**
+     * @brief Reads the postings of a term.
+     * @param term A term made by placeTerm or countyTerm.
+     * @param locations Receives the locations of the records with the term, in ascending order.
+     * @return false if no record has the term.
+     */
+    bool lookup(const std::string& term, std::vector<long long>& locations) const;
+
+    /// @brief The number of distinct terms in the index.
+    size_t termCount() const { return terms.size(); }
+
+    /// @brief The bytes of postings in the index file.
+    long long postingsBytes() const;
+
+    Field getField() const { return field; }
+
+    /// @brief The index file of a field of a data file.
+    static std::string indexFileName(const std::string& dataFileName, Field field);
+
+    /// @brief Lowercase letters and digits, with every other run of characters made one space and the ends trimmed.
+    static std::string normalize(const std::string& text);
+
+    /// @brief The PLACE term of a place name.
+    static std::string placeTerm(const std::string& placeName);
+
+    /// @brief The COUNTY term of a state code and county.
+    static std::string countyTerm(const std::string& state, const std::string& county);
+
+    /// @brief The term of a record string for a field, or "" if the record does not have six fields.
+    static std::string recordTerm(Field field, const std::string& record);
+
+    /// @brief Appends sorted, distinct locations as varint differences.
+    static void encodePostings(const std::vector<long long>& locations, std::string& encoded);
+
+    /// @brief Decodes count locations from encoded postings. Returns false if the bytes run out first.
+    static bool decodePostings(const char* data, size_t length, size_t count, std::vector<long long>& locations);
+
+private:
+    /// @brief One dictionary line.
+    struct Term {
+        std::string term;
+        size_t count;           // Locations in the postings
+        long long offset;       // Of the postings, from the start of the postings
+        size_t length;          // Of the postings in bytes
+    };
+
+    std::string dataFileName;
+    Field field;
+    std::vector<Term> terms;    // Sorted by term
+    long long postingsStart;    // Byte offset of the postings in the index file
+    int fd;
+};
+
+#endif // SECONDARYINDEX_H
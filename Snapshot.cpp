@@ -0,0 +1,387 @@
+/// @file Snapshot.cpp
+/// @class Snapshot
+/// See Snapshot.h for full documentation.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Snapshot.h"
+#include "DataFingerprint.h"
+#include "ZipCodeBuffer.h"
+#include "HeaderBuffer.h"
+#include "Stats.h"
+
+const uint32_t Snapshot::VERSION;
+
+namespace {
+    const char MAGIC[8] = { 'Z', 'I', 'P', 'S', 'N', 'A', 'P', '1' };
+
+    /// @brief Pads the image to a multiple of 8 bytes, so the next section is aligned for any number, and returns its offset.
+    uint64_t startSection(std::string& image) {
+        image.append((8 - image.size() % 8) % 8, '\0');
+        return image.size();
+    }
+
+    /// @brief Appends the bytes of an array to the image and returns its offset.
+    template <typename T>
+    uint64_t appendSection(std::string& image, const std::vector<T>& values) {
+        uint64_t offset = startSection(image);
+        image.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+        return offset;
+    }
+
+    /// @brief The number of a name, numbering it next if it is new.
+    uint32_t numberOf(std::map<std::string, uint32_t>& numbers, const std::string& name) {
+        return numbers.insert(std::make_pair(name, static_cast<uint32_t>(numbers.size()))).first->second;
+    }
+
+    /// @brief Appends a dictionary's names in sorted order and returns the sorted number of each first-seen number.
+    std::vector<uint32_t> sortDictionary(const std::map<std::string, uint32_t>& numbers,
+                                         std::vector<uint32_t>& nameOffsets, std::string& text) {
+        std::vector<uint32_t> sortedNumber(numbers.size());
+        uint32_t next = 0;
+        for (const auto& entry : numbers) {
+            sortedNumber[entry.second] = next++;
+            nameOffsets.push_back(static_cast<uint32_t>(text.size()));
+            text += entry.first;
+        }
+        return sortedNumber;
+    }
+}
+
+
+std::string Snapshot::fileName(const std::string& dataFileName) {
+    return dataFileName + "_snapshot.img";
+}
+
+
+Snapshot::Snapshot(const std::string& dataFileName)
+    : dataFileName(dataFileName), mapped(nullptr), mappedBytes(0), header(nullptr), image(nullptr), rows(nullptr) {
+}
+
+
+Snapshot::~Snapshot() {
+    unmap();
+}
+
+
+void Snapshot::unmap() {
+    if (mapped != nullptr) {
+        ::munmap(mapped, mappedBytes);
+    }
+    mapped = nullptr;
+    mappedBytes = 0;
+    header = nullptr;
+    image = nullptr;
+    rows = nullptr;
+}
+
+
+/// @brief Reads the header text and every record, sorts the records by ZIP code, then lays out and writes the image.
+bool Snapshot::build(const std::string& dataFileName) {
+    // The stamp is taken first, so a change while the file is read makes the image stale
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::ifstream file(dataFileName, std::ios::binary);
+    if (!file.is_open() || !DataFingerprint::stamp(dataFileName, header.dataBytes, header.dataModified)) {
+        std::cerr << "Error: Could not open " << dataFileName << " to snapshot." << std::endl;
+        return false;
+    }
+
+    // Find the file type the same way ZipCodeTableViewer does
+    HeaderBuffer headerBuffer(dataFileName);
+    char fileType = 'C';
+    if (dataFileName.find(".csv") == std::string::npos) {
+        headerBuffer.readHeader();
+        fileType = (headerBuffer.getBlockSize() == 0) ? 'L' : 'B';
+    }
+
+    std::string headerText;
+    {
+        std::ifstream headerFile(dataFileName, std::ios::binary);
+        std::string line;
+        while (std::getline(headerFile, line)) {
+            headerText += line + "\n";
+            if (fileType == 'C' || line.find("Data:") != std::string::npos) {
+                break;
+            }
+        }
+    }
+
+    struct Entry {
+        uint32_t zipCode;
+        uint32_t place;
+        uint32_t state;
+        uint32_t county;
+        int32_t latitude;
+        int32_t longitude;
+        std::string record;
+    };
+    std::vector<Entry> entries;
+    std::map<std::string, uint32_t> stateNumbers;
+    std::map<std::string, uint32_t> countyNumbers;
+    std::map<std::string, uint32_t> placeNumbers;
+    ZipCodeBuffer buffer(file, fileType, headerBuffer);
+    std::string record;
+    while (!(record = buffer.readNextRecordString()).empty()) {
+        std::vector<std::string> fields;
+        size_t start = 0;
+        for (size_t comma; (comma = record.find(',', start)) != std::string::npos; start = comma + 1) {
+            fields.push_back(record.substr(start, comma - start));
+        }
+        // A trailing comma ends the last field, as it does for ZipCodeBuffer::parseRecord
+        if (start < record.size()) {
+            fields.push_back(record.substr(start));
+        }
+        if (fields.size() != 6) {
+            continue;
+        }
+        Entry entry = { static_cast<uint32_t>(std::strtoul(fields[0].c_str(), nullptr, 10)),
+                        numberOf(placeNumbers, fields[1]), numberOf(stateNumbers, fields[2]),
+                        numberOf(countyNumbers, fields[3]),
+                        static_cast<int32_t>(std::llround(std::atof(fields[4].c_str()) * 1e6)),
+                        static_cast<int32_t>(std::llround(std::atof(fields[5].c_str()) * 1e6)), record };
+        entries.push_back(entry);
+    }
+    if (stateNumbers.size() > 65536 || countyNumbers.size() > 65536) {
+        std::cerr << "Error: " << dataFileName << " has too many states or counties to snapshot." << std::endl;
+        return false;
+    }
+    // Stable, so the first record of a repeated ZIP code is the one looked up
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.zipCode < b.zipCode;
+    });
+
+    std::vector<uint32_t> nameOffsets;
+    std::string nameText;
+    std::vector<uint32_t> stateNumber = sortDictionary(stateNumbers, nameOffsets, nameText);
+    std::vector<uint32_t> countyNumber = sortDictionary(countyNumbers, nameOffsets, nameText);
+    std::vector<uint32_t> placeNumber = sortDictionary(placeNumbers, nameOffsets, nameText);
+    nameOffsets.push_back(static_cast<uint32_t>(nameText.size()));
+
+    std::vector<Row> rowTable;
+    std::vector<uint32_t> stateStarts(stateNumbers.size() + 1, 0);
+    std::vector<uint64_t> recordOffsets;
+    std::string recordText;
+    rowTable.reserve(entries.size());
+    for (const Entry& entry : entries) {
+        Row row = { entry.zipCode, placeNumber[entry.place], static_cast<uint16_t>(stateNumber[entry.state]),
+                    static_cast<uint16_t>(countyNumber[entry.county]), entry.latitude, entry.longitude };
+        rowTable.push_back(row);
+        stateStarts[row.state + 1]++;
+        recordOffsets.push_back(recordText.size());
+        recordText += entry.record;
+    }
+    recordOffsets.push_back(recordText.size());
+
+    // The rows of every state, kept in ZIP code order by walking the rows in order
+    for (size_t state = 1; state < stateStarts.size(); state++) {
+        stateStarts[state] += stateStarts[state - 1];
+    }
+    std::vector<uint32_t> stateRows(rowTable.size());
+    std::vector<uint32_t> nextOfState(stateStarts.begin(), stateStarts.end() - 1);
+    for (uint32_t row = 0; row < rowTable.size(); row++) {
+        stateRows[nextOfState[rowTable[row].state]++] = row;
+    }
+
+    std::string image(sizeof(Header), '\0');
+    header.headerTextOffset = startSection(image);
+    header.headerTextBytes = headerText.size();
+    image += headerText;
+    header.rowOffset = appendSection(image, rowTable);
+    header.stateStartOffset = appendSection(image, stateStarts);
+    header.stateRowOffset = appendSection(image, stateRows);
+    header.nameOffset = appendSection(image, nameOffsets);
+    header.nameTextOffset = startSection(image);
+    image += nameText;
+    header.recordOffset = appendSection(image, recordOffsets);
+    header.recordTextOffset = startSection(image);
+    image += recordText;
+
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.recordCount = static_cast<uint32_t>(rowTable.size());
+    header.stateCount = static_cast<uint32_t>(stateNumbers.size());
+    header.countyCount = static_cast<uint32_t>(countyNumbers.size());
+    header.placeCount = static_cast<uint32_t>(placeNumbers.size());
+    header.imageBytes = image.size();
+    header.contentChecksum = DataFingerprint::hashBytes(image.data() + sizeof(Header), image.size() - sizeof(Header));
+    header.headerChecksum = DataFingerprint::hashBytes(reinterpret_cast<const char*>(&header), offsetof(Header, headerChecksum));
+    std::memcpy(&image[0], &header, sizeof(Header));
+
+    // Written aside and renamed, so a process mapping the old image never sees half of the new one
+    std::string imageName = fileName(dataFileName);
+    std::string partName = imageName + ".part";
+    std::ofstream imageFile(partName, std::ios::binary | std::ios::trunc);
+    imageFile.write(image.data(), image.size());
+    imageFile.close();
+    if (!imageFile || std::rename(partName.c_str(), imageName.c_str()) != 0) {
+        std::cerr << "Error: Could not write " << imageName << "." << std::endl;
+        std::remove(partName.c_str());
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ * @brief Maps the image and checks its Header, section bounds and data file stamp.
+ * @return false, with the image unmapped, if it is missing or fails a check.
+ */
+bool Snapshot::map() {
+    unmap();
+    std::string imageName = fileName(dataFileName);
+    int fd = ::open(imageName.c_str(), O_RDONLY);
+    struct stat status;
+    if (fd < 0 || ::fstat(fd, &status) != 0) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return false;
+    }
+    size_t bytes = static_cast<size_t>(status.st_size);
+    void* region = (bytes >= sizeof(Header)) ? ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);    // The mapping keeps the file open
+    if (region == MAP_FAILED) {
+        return false;
+    }
+    mapped = region;
+    mappedBytes = bytes;
+
+    const Header* candidate = static_cast<const Header*>(region);
+    if (std::memcmp(candidate->magic, MAGIC, sizeof(MAGIC)) != 0 || candidate->version != VERSION
+        || candidate->headerChecksum != DataFingerprint::hashBytes(static_cast<const char*>(region), offsetof(Header, headerChecksum))
+        || candidate->imageBytes != bytes) {
+        unmap();
+        return false;
+    }
+
+    // Every section must end before the next starts, and the last at the end of the image
+    unsigned long long names = 1ULL * candidate->stateCount + candidate->countyCount + candidate->placeCount;
+    const unsigned long long ends[][2] = {
+        { candidate->headerTextOffset + candidate->headerTextBytes, candidate->rowOffset },
+        { candidate->rowOffset + 1ULL * candidate->recordCount * sizeof(Row), candidate->stateStartOffset },
+        { candidate->stateStartOffset + 4ULL * (candidate->stateCount + 1), candidate->stateRowOffset },
+        { candidate->stateRowOffset + 4ULL * candidate->recordCount, candidate->nameOffset },
+        { candidate->nameOffset + 4ULL * (names + 1), candidate->nameTextOffset },
+        { candidate->recordOffset + 8ULL * (candidate->recordCount + 1ULL), candidate->recordTextOffset },
+        { candidate->recordTextOffset, bytes }
+    };
+    bool inBounds = candidate->headerTextOffset >= sizeof(Header);
+    for (const auto& end : ends) {
+        inBounds = inBounds && end[0] <= end[1];
+    }
+    const char* start = static_cast<const char*>(region);
+    inBounds = inBounds
+        && candidate->nameTextOffset + reinterpret_cast<const uint32_t*>(start + candidate->nameOffset)[names]
+               <= candidate->recordOffset
+        && candidate->recordTextOffset
+               + reinterpret_cast<const uint64_t*>(start + candidate->recordOffset)[candidate->recordCount] <= bytes;
+
+    int64_t dataBytes = 0;
+    int64_t dataModified = 0;
+    if (!inBounds || !DataFingerprint::stamp(dataFileName, dataBytes, dataModified) || dataBytes != candidate->dataBytes
+        || dataModified != candidate->dataModified) {
+        unmap();
+        return false;
+    }
+    ZIPCODE_STAT(HEADER_PARSES, 1);
+
+    header = candidate;
+    image = start;
+    rows = section<Row>(header->rowOffset);
+    return true;
+}
+
+
+bool Snapshot::open() {
+    if (map()) {
+        return true;
+    }
+    if (!build(dataFileName)) {
+        return false;
+    }
+    if (!map()) {
+        std::cerr << "Error: " << fileName(dataFileName) << " is not a snapshot of " << dataFileName << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+bool Snapshot::verify() const {
+    return header != nullptr
+        && DataFingerprint::hashBytes(image + sizeof(Header), mappedBytes - sizeof(Header)) == header->contentChecksum;
+}
+
+
+std::string Snapshot::name(uint32_t entry) const {
+    const uint32_t* offsets = section<uint32_t>(header->nameOffset);
+    return std::string(image + header->nameTextOffset + offsets[entry], offsets[entry + 1] - offsets[entry]);
+}
+
+
+std::string Snapshot::record(size_t row) const {
+    const uint64_t* offsets = section<uint64_t>(header->recordOffset);
+    return std::string(image + header->recordTextOffset + offsets[row], offsets[row + 1] - offsets[row]);
+}
+
+
+bool Snapshot::lookup(int zipCode, std::string& found) const {
+    if (header == nullptr || zipCode < 0) {
+        return false;
+    }
+    const Row* end = rows + header->recordCount;
+    const Row* row = std::lower_bound(rows, end, static_cast<uint32_t>(zipCode), [](const Row& candidate, uint32_t wanted) {
+        return candidate.zipCode < wanted;
+    });
+    if (row == end || row->zipCode != static_cast<uint32_t>(zipCode)) {
+        return false;
+    }
+    found = record(static_cast<size_t>(row - rows));
+    return true;
+}
+
+
+bool Snapshot::stateRecords(const std::string& state, std::vector<std::string>& records) const {
+    records.clear();
+    if (header == nullptr) {
+        return false;
+    }
+    // State names come first in the dictionaries, sorted
+    uint32_t low = 0;
+    uint32_t high = header->stateCount;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if (name(middle) < state) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    if (low == header->stateCount || name(low) != state) {
+        return false;
+    }
+    const uint32_t* starts = section<uint32_t>(header->stateStartOffset);
+    const uint32_t* stateRows = section<uint32_t>(header->stateRowOffset);
+    for (uint32_t i = starts[low]; i < starts[low + 1]; i++) {
+        records.push_back(record(stateRows[i]));
+    }
+    return true;
+}
+
+
+std::string Snapshot::headerText() const {
+    return header ? std::string(image + header->headerTextOffset, header->headerTextBytes) : "";
+}
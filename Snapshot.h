@@ -0,0 +1,150 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file Snapshot.h
+ * @class Snapshot
+ * @brief Memory-mapped binary image of a data file, ready for lookups without parsing.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Before its first lookup, the viewer reads the text header of a C or L
+ *    file and builds the primary key index by reading every record, so
+ *    startup grows with the file. A snapshot is all of that, done once and
+ *    written as one image that open maps with mmap:
+ * \n  -- the data file's header text, as written
+ * \n  -- one Row per record, sorted by ZIP code, which is the primary key
+ *       index: a lookup is a binary search touching a few pages
+ * \n  -- a state index: the rows of every state, in ZIP code order
+ * \n  -- dictionaries of the distinct state, county and place names, sorted,
+ *       which the rows number into
+ * \n  -- every record string, exactly as read from the data file, by row
+ * \n Every position in the image is an offset from its start, so it can be
+ *    mapped at any address, and numbers are in host byte order.
+ * \n
+ * \n open checks, without reading past the Header:
+ * \n  -- the magic and VERSION, so an image of another layout is not read
+ * \n  -- a checksum of the Header, and that its sections lie in the file
+ * \n  -- the size and modification time of the data file, recorded when the
+ *       image was built, so an image older than its data is not used
+ * \n and builds the image again if it is missing or fails any check.
+ *    verify checks the checksum of everything after the Header, which
+ *    reads the whole image, so open leaves it to callers that want it.
+ * \n
+ * \n The image is named by fileName.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Snapshot {
+public:
+    static const uint32_t VERSION = 1;     // Of the image layout. Images of other versions are rebuilt
+
+    /**
+     * @brief Construct a new Snapshot object for a data file.
+     * @param dataFileName The C, L or B file the image is of.
+     */
+    explicit Snapshot(const std::string& dataFileName);
+    ~Snapshot();
+
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    /**
+     * @brief Reads a data file once and writes its image.
+     * @param dataFileName The C, L or B file to read. Files ending in ".csv" are C files.
+     * @return false if the data file could not be read or the image written.
+     */
+    static bool build(const std::string& dataFileName);
+
+    /**
+     * @brief Maps the image, building it first if it is missing, of another version, damaged or stale.
+     * @return false if the image could not be built or mapped.
+     */
+    bool open();
+
+    /// @brief Whether the checksum of everything after the Header matches. Reads the whole image.
+    bool verify() const;
+
+    size_t recordCount() const { return header ? header->recordCount : 0; }
+
+    /// @brief The record string of a row, in ZIP code order.
+    std::string record(size_t row) const;
+
+    /// @brief The record string of a ZIP code. Returns false if there is no such ZIP code.
+    bool lookup(int zipCode, std::string& record) const;
+
+    /**
+     * @brief The record strings of one state, in ZIP code order.
+     * @return false if no record has the state.
+     */
+    bool stateRecords(const std::string& state, std::vector<std::string>& records) const;
+
+    /// @brief The header of the data file, from its start through its "Data:" line, or the column header line of a C file.
+    std::string headerText() const;
+
+    /// @brief The bytes of the image, all of which are mapped.
+    size_t imageBytes() const { return mappedBytes; }
+
+    /// @brief The image of a data file.
+    static std::string fileName(const std::string& dataFileName);
+
+private:
+    /// @brief The start of the image. Every offset is from the start of the image.
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t recordCount;
+        uint32_t stateCount;
+        uint32_t countyCount;
+        uint32_t placeCount;
+        uint32_t reserved;
+        int64_t dataBytes;              // Size of the data file when the image was built
+        int64_t dataModified;           // Its modification time, in nanoseconds
+        uint64_t headerTextOffset;
+        uint64_t headerTextBytes;
+        uint64_t rowOffset;             // recordCount Rows
+        uint64_t stateStartOffset;      // stateCount + 1 uint32_t, into the state rows
+        uint64_t stateRowOffset;        // recordCount uint32_t
+        uint64_t nameOffset;            // stateCount + countyCount + placeCount + 1 uint32_t, into the name text
+        uint64_t nameTextOffset;
+        uint64_t recordOffset;          // recordCount + 1 uint64_t, into the record text
+        uint64_t recordTextOffset;
+        uint64_t imageBytes;
+        uint64_t contentChecksum;       // Of every byte after the Header
+        uint64_t headerChecksum;        // Of every byte of the Header before it
+    };
+
+    /// @brief A record, sorted by ZIP code. Its number is its index among the Rows.
+    struct Row {
+        uint32_t zipCode;
+        uint32_t place;
+        uint16_t state;
+        uint16_t county;
+        int32_t latitude;               // Microdegrees
+        int32_t longitude;
+    };
+
+    std::string dataFileName;
+    void* mapped;
+    size_t mappedBytes;
+    const Header* header;
+    const char* image;
+    const Row* rows;
+
+    void unmap();
+    bool map();
+    std::string name(uint32_t entry) const;
+    template <typename T>
+    const T* section(uint64_t offset) const { return reinterpret_cast<const T*>(image + offset); }
+};
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,141 @@
+/// @file SpatialOrder.cpp
+/// @class SpatialOrder
+/// See SpatialOrder.h for full documentation.
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "SpatialOrder.h"
+#include "BlockWriter.h"
+#include "ZoneMap.h"
+#include "Stats.h"
+
+const int SpatialOrder::CURVE_ORDER;
+const char* const SpatialOrder::INDEX_SCHEMA = "RBN,Greatest Hilbert Key";
+
+namespace {
+    /// @brief The cell of a coordinate on a grid of cells cells over [low, high].
+    uint32_t gridCell(double value, double low, double high, uint32_t cells) {
+        double cell = (value - low) / (high - low) * cells;
+        if (cell < 0) {
+            return 0;
+        }
+        return std::min(cells - 1, static_cast<uint32_t>(cell));
+    }
+}
+
+
+/// @brief Walks the quadrants from the largest down, rotating and reflecting each so the curve stays continuous.
+uint32_t SpatialOrder::hilbertKey(double latitude, double longitude) {
+    const uint32_t cells = 1u << CURVE_ORDER;
+    uint32_t x = gridCell(longitude, -180, 180, cells);
+    uint32_t y = gridCell(latitude, -90, 90, cells);
+    uint32_t key = 0;
+    for (uint32_t half = cells / 2; half > 0; half /= 2) {
+        uint32_t right = (x & half) ? 1 : 0;
+        uint32_t upper = (y & half) ? 1 : 0;
+        key += half * half * ((3 * right) ^ upper);
+        if (upper == 0) {
+            if (right == 1) {
+                x = cells - 1 - x;
+                y = cells - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return key;
+}
+
+
+std::string SpatialOrder::zipMapFileName(const std::string& fileName) {
+    return fileName + "_zip_map.txt";
+}
+
+
+/// @brief Sorts the records by curve position, then ZIP code, and writes them, noting the block of every ZIP code.
+bool SpatialOrder::write(const std::vector<std::string>& records, const std::string& fileName,
+                         const std::string& indexFileName, int blockSize, int fillPercent) {
+    struct KeyedRecord {
+        uint32_t key;
+        int zipCode;
+        const std::string* record;
+    };
+    std::vector<KeyedRecord> keyed;
+    keyed.reserve(records.size());
+    for (const std::string& record : records) {
+        std::vector<std::string> fields;
+        std::istringstream recordStream(record);
+        std::string field;
+        while (std::getline(recordStream, field, ',')) {
+            fields.push_back(field);
+        }
+        if (fields.size() == 6) {
+            KeyedRecord entry = { hilbertKey(std::atof(fields[4].c_str()), std::atof(fields[5].c_str())),
+                                  std::atoi(fields[0].c_str()), &record };
+            keyed.push_back(entry);
+        }
+    }
+    std::sort(keyed.begin(), keyed.end(), [](const KeyedRecord& a, const KeyedRecord& b) {
+        return a.key != b.key ? a.key < b.key : a.zipCode < b.zipCode;
+    });
+
+    BlockWriter writer(fileName, indexFileName, blockSize, fillPercent);
+    writer.setIndexSchema(INDEX_SCHEMA);
+    writer.setZoneMapFileName(ZoneMap::fileName(fileName));
+    std::vector<std::pair<int, long long> > locations;
+    locations.reserve(keyed.size());
+    for (const KeyedRecord& entry : keyed) {
+        if (!writer.addRecord(*entry.record, std::to_string(entry.key))) {
+            return false;
+        }
+        // The record went into the block being filled, which is numbered after the blocks already written
+        locations.push_back(std::make_pair(entry.zipCode, writer.getBlockCount()));
+    }
+    if (!writer.close()) {
+        return false;
+    }
+
+    std::sort(locations.begin(), locations.end());
+    std::string zipMapName = zipMapFileName(fileName);
+    std::ofstream zipMap(zipMapName, std::ios::binary | std::ios::trunc);
+    zipMap << "ZipMap," << locations.size() << "\n";
+    for (const std::pair<int, long long>& location : locations) {
+        zipMap << location.first << "," << location.second << "\n";
+    }
+    if (!zipMap) {
+        std::cerr << "Error: Could not write " << zipMapName << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+bool SpatialOrder::loadZipMap(const std::string& zipMapFileName, std::vector<std::pair<int, long long> >& locations) {
+    std::ifstream zipMap(zipMapFileName, std::ios::binary);
+    std::string line;
+    if (!std::getline(zipMap, line) || line.compare(0, 7, "ZipMap,") != 0) {
+        std::cerr << "Error: " << zipMapFileName << " is not a ZIP map." << std::endl;
+        return false;
+    }
+    ZIPCODE_STAT(HEADER_PARSES, 1);
+
+    size_t locationTotal = static_cast<size_t>(std::atoll(line.c_str() + 7));
+    locations.clear();
+    locations.reserve(locationTotal);
+    while (locations.size() < locationTotal && std::getline(zipMap, line)) {
+        size_t comma = line.find(',');
+        if (comma == std::string::npos) {
+            break;
+        }
+        locations.push_back(std::make_pair(std::atoi(line.c_str()), std::atoll(line.c_str() + comma + 1)));
+        ZIPCODE_STAT(INDEX_LINES_SCANNED, 1);
+    }
+    if (locations.size() != locationTotal) {
+        std::cerr << "Error: " << zipMapFileName << " ends before its last ZIP code." << std::endl;
+        return false;
+    }
+    std::sort(locations.begin(), locations.end());
+    return true;
+}
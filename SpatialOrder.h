@@ -0,0 +1,73 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file SpatialOrder.h
+ * @class SpatialOrder
+ * @brief Writes a copy of the records as a blocked file ordered along a Hilbert curve of their coordinates.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n A blocked file in ZIP code order scatters the records of any region
+ *    over the whole file, so a bounding box touches blocks from end to end
+ *    even when ZoneMap skips the rest. write orders the records by
+ *    hilbertKey instead: the position of their latitude and longitude along
+ *    a Hilbert curve over a grid of 2^CURVE_ORDER cells a side. Points near
+ *    each other on the curve are near each other on the map, so the records
+ *    of a region fill a few runs of neighbouring blocks, whose zones are
+ *    small enough for ZoneMap to skip everything else.
+ * \n
+ * \n A spatially ordered file is an ordinary blocked file with:
+ * \n  -- a block index of "RBN,Greatest Hilbert Key" lines, named as
+ *       INDEX_SCHEMA in its header
+ * \n  -- a ZoneMap, written with the blocks
+ * \n  -- a ZIP map, named by zipMapFileName, of a "ZipMap,<records>" line
+ *       then one "ZIP Code,RBN" line per record in ZIP code order
+ * \n ZipCodeStore recognizes the schema and looks ZIP codes up through the
+ *    ZIP map, so lookups and ranges work on either ordering, and every
+ *    index built by scanning a blocked file works unchanged.
+ * \n
+ * \n BlockGenerator writes one with --order hilbert.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef SPATIALORDER_H
+#define SPATIALORDER_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+class SpatialOrder {
+public:
+    static const int CURVE_ORDER = 15;      // Grid cells a side are 2^CURVE_ORDER, so keys fit in an int
+    static const char* const INDEX_SCHEMA;  // The header's index schema for a spatially ordered file
+
+    /// @brief The distance along the Hilbert curve of the grid cell holding a point.
+    static uint32_t hilbertKey(double latitude, double longitude);
+
+    /**
+     * @brief Writes records as a blocked file in Hilbert curve order, with its block index, ZoneMap and ZIP map.
+     * @param records Record strings without length indicators. Records without six fields are left out.
+     * @param fileName The blocked file to create.
+     * @param indexFileName The block index to create.
+     * @return false if any of the files could not be written.
+     */
+    static bool write(const std::vector<std::string>& records, const std::string& fileName,
+                      const std::string& indexFileName, int blockSize, int fillPercent);
+
+    /// @brief The ZIP map of a spatially ordered file.
+    static std::string zipMapFileName(const std::string& fileName);
+
+    /**
+     * @brief Loads a ZIP map.
+     * @param locations Receives each ZIP code and the RBN of its block, sorted by ZIP code.
+     * @return false if the ZIP map could not be read.
+     */
+    static bool loadZipMap(const std::string& zipMapFileName, std::vector<std::pair<int, long long> >& locations);
+};
+
+#endif // SPATIALORDER_H
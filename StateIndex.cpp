@@ -0,0 +1,279 @@
+/// @file StateIndex.cpp
+/// @class StateIndex
+/// See StateIndex.h for full documentation.
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <iterator>
+#include "StateIndex.h"
+#include "DataFingerprint.h"
+#include "SecondaryIndex.h"
+#include "ZipCodeBuffer.h"
+#include "HeaderBuffer.h"
+#include "Stats.h"
+
+namespace {
+    /// @brief Splits a line into its fields.
+    std::vector<std::string> splitLine(const std::string& line, char separator) {
+        std::vector<std::string> fields;
+        std::istringstream lineStream(line);
+        std::string field;
+        while (std::getline(lineStream, field, separator)) {
+            fields.push_back(field);
+        }
+        return fields;
+    }
+
+    /// @brief The smallest power of two at least size.
+    long long slotsFor(int blockSize) {
+        long long slots = 1;
+        while (slots < blockSize) {
+            slots <<= 1;
+        }
+        return slots;
+    }
+}
+
+
+StateIndex::StateIndex(const std::string& dataFileName)
+    : dataFileName(dataFileName), fileType('C'), slotsPerBlock(0) {
+}
+
+
+std::string StateIndex::indexFileName(const std::string& dataFileName) {
+    return dataFileName + "_state_index.idx";
+}
+
+
+std::string StateIndex::recordState(const std::string& record) {
+    std::vector<std::string> fields = splitLine(record, ',');
+    if (fields.size() != 6) {
+        return "";
+    }
+    std::string state = fields[2];
+    std::transform(state.begin(), state.end(), state.begin(), ::toupper);
+    return state;
+}
+
+
+/// @brief Reads the data file once, adding each record's id to its state's bitmap, then writes the index file.
+bool StateIndex::build(const std::string& dataFileName) {
+    // Taken before the records are read, so a change while they are is seen as one
+    DataFingerprint fingerprint;
+    std::ifstream file(dataFileName, std::ios::binary);
+    if (!file.is_open() || !fingerprint.read(dataFileName)) {
+        std::cerr << "Error: Could not open " << dataFileName << " to index." << std::endl;
+        return false;
+    }
+
+    // Find the file type the same way ZipCodeTableViewer does
+    HeaderBuffer headerBuffer(dataFileName);
+    char fileType = 'C';
+    if (dataFileName.find(".csv") == std::string::npos) {
+        headerBuffer.readHeader();
+        fileType = (headerBuffer.getBlockSize() == 0) ? 'L' : 'B';
+    }
+    long long slots = (fileType == 'B') ? slotsFor(headerBuffer.getBlockSize()) : 0;
+
+    std::map<std::string, RoaringBitmap> bitmaps;
+    std::vector<long long> offsets;
+    ZipCodeBuffer buffer(file, fileType, headerBuffer);
+    long long blockRBN = -1;
+    long long slot = 0;
+    while (true) {
+        long long position = static_cast<long long>(std::streamoff(buffer.getCurrentPosition()));
+        std::string record = buffer.readNextRecordString();
+        if (record.empty()) {
+            break;
+        }
+
+        long long id;
+        if (fileType == 'B') {
+            long long rbn = buffer.blockBuffer.getCurrentRBN();
+            slot = (rbn == blockRBN) ? slot + 1 : 0;
+            blockRBN = rbn;
+            id = rbn * slots + slot;
+            if (id > 0xFFFFFFFFLL) {
+                std::cerr << "Error: " << dataFileName << " has too many blocks for 32-bit record ids." << std::endl;
+                return false;
+            }
+        }
+        else {
+            id = static_cast<long long>(offsets.size());
+            offsets.push_back(position);
+        }
+
+        std::string state = recordState(record);
+        if (!state.empty()) {
+            bitmaps[state].add(static_cast<uint32_t>(id));
+        }
+    }
+
+    std::string dictionary;
+    std::string image;
+    for (const auto& entry : bitmaps) {
+        size_t offset = image.size();
+        entry.second.serialize(image);
+        dictionary += entry.first + "\t" + std::to_string(entry.second.cardinality()) + "\t" + std::to_string(offset)
+                    + "\t" + std::to_string(image.size() - offset) + "\n";
+    }
+    SecondaryIndex::encodePostings(offsets, image);
+
+    std::string indexName = indexFileName(dataFileName);
+    std::ofstream indexFile(indexName, std::ios::binary | std::ios::trunc);
+    indexFile << "StateIndex," << fileType << "," << offsets.size() << "," << bitmaps.size() << "," << slots << ","
+              << fingerprint.text() << "\n" << dictionary;
+    indexFile.write(image.data(), image.size());
+    if (!indexFile) {
+        std::cerr << "Error: Could not write " << indexName << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+/// @brief Loads every bitmap and the record offsets, building the index file first if it is missing or stale.
+bool StateIndex::open() {
+    std::string indexName = indexFileName(dataFileName);
+    std::ifstream indexFile(indexName, std::ios::binary);
+    std::string header;
+    std::getline(indexFile, header);
+    std::vector<std::string> headerFields = splitLine(header, ',');
+
+    // An index of the data file as it was before, or from before fingerprints, is built again
+    DataFingerprint fingerprint;
+    if (headerFields.size() != 6 || !fingerprint.parse(headerFields[5]) || !fingerprint.matches(dataFileName)) {
+        indexFile.close();
+        if (!build(dataFileName)) {
+            return false;
+        }
+        indexFile.open(indexName, std::ios::binary);
+        std::getline(indexFile, header);
+        headerFields = splitLine(header, ',');
+    }
+    if (headerFields.size() != 6 || headerFields[0] != "StateIndex" || headerFields[1].size() != 1) {
+        std::cerr << "Error: " << indexName << " is not a state index." << std::endl;
+        return false;
+    }
+    ZIPCODE_STAT(HEADER_PARSES, 1);
+    fileType = headerFields[1][0];
+    size_t offsetCount = static_cast<size_t>(std::atoll(headerFields[2].c_str()));
+    size_t stateCount = static_cast<size_t>(std::atoll(headerFields[3].c_str()));
+    slotsPerBlock = std::atoll(headerFields[4].c_str());
+
+    std::vector<std::vector<std::string> > dictionary;
+    std::string line;
+    for (size_t i = 0; i < stateCount && std::getline(indexFile, line); i++) {
+        dictionary.push_back(splitLine(line, '\t'));
+        ZIPCODE_STAT(INDEX_LINES_SCANNED, 1);
+    }
+    std::string image((std::istreambuf_iterator<char>(indexFile)), std::istreambuf_iterator<char>());
+    ZIPCODE_STAT(BYTES_READ, image.size());
+
+    bitmaps.clear();
+    size_t end = 0;
+    for (const std::vector<std::string>& entry : dictionary) {
+        size_t offset = (entry.size() == 4) ? static_cast<size_t>(std::atoll(entry[2].c_str())) : image.size();
+        size_t used = 0;
+        RoaringBitmap& bitmap = bitmaps[entry.empty() ? "" : entry[0]];
+        if (offset > image.size() || !bitmap.deserialize(image.data() + offset, image.size() - offset, used)) {
+            std::cerr << "Error: " << indexName << " has a damaged bitmap." << std::endl;
+            return false;
+        }
+        end = std::max(end, offset + used);
+    }
+
+    // The record offsets follow the last bitmap
+    offsets.clear();
+    offsets.reserve(offsetCount);
+    if (dictionary.size() != stateCount
+        || !SecondaryIndex::decodePostings(image.data() + end, image.size() - end, offsetCount, offsets)) {
+        std::cerr << "Error: " << indexName << " ends early." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+const RoaringBitmap& StateIndex::records(const std::string& state) const {
+    std::string code = state;
+    std::transform(code.begin(), code.end(), code.begin(), ::toupper);
+    std::map<std::string, RoaringBitmap>::const_iterator entry = bitmaps.find(code);
+    return (entry == bitmaps.end()) ? none : entry->second;
+}
+
+
+RoaringBitmap StateIndex::anyOf(const std::vector<std::string>& states) const {
+    RoaringBitmap ids;
+    for (const std::string& state : states) {
+        ids = ids | records(state);
+    }
+    return ids;
+}
+
+
+/// @brief The ids at each location. A block of a B file gives every slot in it, including empty ones.
+RoaringBitmap StateIndex::recordsAt(const std::vector<long long>& locations) const {
+    RoaringBitmap ids;
+    for (long long location : locations) {
+        if (fileType == 'B') {
+            if (location >= 0 && (location + 1) * slotsPerBlock - 1 <= 0xFFFFFFFFLL) {
+                ids.addRange(static_cast<uint32_t>(location * slotsPerBlock),
+                             static_cast<uint32_t>((location + 1) * slotsPerBlock - 1));
+            }
+            continue;
+        }
+        std::vector<long long>::const_iterator position = std::lower_bound(offsets.begin(), offsets.end(), location);
+        if (position != offsets.end() && *position == location) {
+            ids.add(static_cast<uint32_t>(position - offsets.begin()));
+        }
+    }
+    return ids;
+}
+
+
+/// @brief Reads the records of a set of ids, each block of a B file once.
+void StateIndex::readRecords(const ZipCodeStore& store, const RoaringBitmap& ids, std::vector<std::string>& records) const {
+    long long blockRBN = -1;
+    std::vector<std::string> block;
+    ids.forEach([&](uint32_t id) {
+        if (fileType != 'B') {
+            if (id < offsets.size()) {
+                store.readLocation(offsets[id], records);
+            }
+            return;
+        }
+        long long rbn = static_cast<long long>(id) / slotsPerBlock;
+        if (rbn != blockRBN) {
+            block.clear();
+            store.readLocation(rbn, block);
+            blockRBN = rbn;
+        }
+        size_t slot = static_cast<size_t>(id % slotsPerBlock);
+        if (slot < block.size()) {
+            records.push_back(block[slot]);
+        }
+    });
+}
+
+
+std::vector<std::string> StateIndex::states() const {
+    std::vector<std::string> codes;
+    for (const auto& entry : bitmaps) {
+        codes.push_back(entry.first);
+    }
+    return codes;
+}
+
+
+size_t StateIndex::bitmapBytes() const {
+    size_t bytes = 0;
+    for (const auto& entry : bitmaps) {
+        bytes += entry.second.memoryBytes();
+    }
+    return bytes;
+}
@@ -0,0 +1,110 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file StateIndex.h
+ * @class StateIndex
+ * @brief Persistent bitmap index from each state code to the records of that state.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n A file holds only about 60 state codes, so the index keeps one
+ *    RoaringBitmap per state of the ids of its records:
+ * \n  -- in a C or L file, a record's id is its number in file order, and
+ *       the index keeps the byte offset of every record
+ * \n  -- in a B file, a record's id is its block's RBN times slotsPerBlock
+ *       plus its place in the block, so a block's ids are one range and no
+ *       table is needed. slotsPerBlock is the block size rounded up to a
+ *       power of two, which no block can hold more records than
+ * \n
+ * \n count is the cardinality of a bitmap, so counting the records of a
+ *    state reads nothing but the index. anyOf unites the bitmaps of several
+ *    states, and recordsAt turns the locations of a SecondaryIndex or the
+ *    primary index into ids, so a state filter is intersected with other
+ *    predicates with operator& before any record is read. A B file location
+ *    is a whole block, so those intersections hold every record of the
+ *    state in the block. readRecords then reads only the records, or the
+ *    blocks, of a set of ids.
+ * \n
+ * \n The index file, named by indexFileName, is a text header line, a
+ *    dictionary of one "state\\tcount\\toffset\\tlength" line per state in
+ *    sorted order, then the serialized bitmaps, then for C and L files the
+ *    record offsets encoded as SecondaryIndex postings. The header line
+ *    ends with the DataFingerprint of the data file it was built from. It
+ *    is loaded whole by open, building it first if it does not exist or the
+ *    data file no longer matches its fingerprint.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef STATEINDEX_H
+#define STATEINDEX_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include "RoaringBitmap.h"
+#include "ZipCodeStore.h"
+
+class StateIndex {
+public:
+    /**
+     * @brief Construct a new State Index object for a data file.
+     * @param dataFileName The C, L or B file the index is of.
+     */
+    explicit StateIndex(const std::string& dataFileName);
+
+    /**
+     * @brief Reads a data file once and writes its state index file.
+     * @param dataFileName The C, L or B file to index. Files ending in ".csv" are C files.
+     * @return false if the data file could not be read or the index file written.
+     */
+    static bool build(const std::string& dataFileName);
+
+    /**
+     * @brief Loads the index file, building it first if it does not exist or its data file has changed.
+     * @return false if the index could not be built or loaded.
+     */
+    bool open();
+
+    /// @brief The ids of the records of a state, or an empty set if there are none.
+    const RoaringBitmap& records(const std::string& state) const;
+
+    /// @brief The number of records of a state.
+    size_t count(const std::string& state) const { return records(state).cardinality(); }
+
+    /// @brief The ids of the records of any of the states.
+    RoaringBitmap anyOf(const std::vector<std::string>& states) const;
+
+    /// @brief The ids of the records at locations of a SecondaryIndex or the primary index.
+    RoaringBitmap recordsAt(const std::vector<long long>& locations) const;
+
+    /**
+     * @brief Appends the record strings of a set of ids to records, in id order.
+     * @param store The store of the file the index is of, already opened.
+     */
+    void readRecords(const ZipCodeStore& store, const RoaringBitmap& ids, std::vector<std::string>& records) const;
+
+    /// @brief Every state code in the index, in sorted order.
+    std::vector<std::string> states() const;
+
+    /// @brief The bytes the bitmaps take in memory.
+    size_t bitmapBytes() const;
+
+    /// @brief The state index file of a data file.
+    static std::string indexFileName(const std::string& dataFileName);
+
+    /// @brief The state code of a record string, upper case, or "" if the record does not have six fields.
+    static std::string recordState(const std::string& record);
+
+private:
+    std::string dataFileName;
+    char fileType;
+    long long slotsPerBlock;                    // For B files
+    std::map<std::string, RoaringBitmap> bitmaps;
+    std::vector<long long> offsets;             // For C and L files, the offset of each record id
+    RoaringBitmap none;
+};
+
+#endif // STATEINDEX_H
@@ -0,0 +1,66 @@
+/// @file Stats.cpp
+/// @class Stats
+/// See Stats.h for full documentation.
+
+#include <iomanip>
+#include "Stats.h"
+
+std::atomic<unsigned long long> Stats::counters[Stats::COUNTER_COUNT];
+
+
+/// @brief Sets every counter back to zero.
+void Stats::reset() {
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        counters[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+
+/// @brief The snake_case name of a counter.
+const char* Stats::name(Counter counter) {
+    switch (counter) {
+    case BLOCKS_READ:         return "blocks_read";
+    case BLOCKS_SKIPPED:      return "blocks_skipped";
+    case BYTES_READ:          return "bytes_read";
+    case SEEKS:               return "seeks";
+    case HEADER_PARSES:       return "header_parses";
+    case INDEX_LINES_SCANNED: return "index_lines_scanned";
+    case RECORDS_PARSED:      return "records_parsed";
+    case ALLOCATIONS:         return "allocations";
+    case CACHE_HITS:          return "cache_hits";
+    default:                  return "unknown";
+    }
+}
+
+
+/// @brief Whether the counters were compiled in.
+bool Stats::isEnabled() {
+#ifdef ZIPCODE_DISABLE_STATS
+    return false;
+#else
+    return true;
+#endif
+}
+
+
+/// @brief Prints every counter on its own line.
+void Stats::print(std::ostream& out) {
+    out << "Statistics:" << std::endl;
+    if (!isEnabled()) {
+        out << " - Counters were compiled out (ZIPCODE_DISABLE_STATS)" << std::endl;
+        return;
+    }
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        out << " - " << std::left << std::setw(20) << name(static_cast<Counter>(i)) << get(static_cast<Counter>(i)) << std::endl;
+    }
+}
+
+
+/// @brief Writes every counter as one JSON object.
+void Stats::writeJSON(std::ostream& out) {
+    out << "{\"enabled\": " << (isEnabled() ? "true" : "false");
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        out << ", \"" << name(static_cast<Counter>(i)) << "\": " << get(static_cast<Counter>(i));
+    }
+    out << "}" << std::endl;
+}
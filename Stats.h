@@ -0,0 +1,91 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file Stats.h
+ * @class Stats
+ * @brief Process-wide I/O and parse counters for diagnosing slow lookups.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n The buffers, the indexer and the block search count their work here:
+ * \n  -- Blocks read and bytes read from data files
+ * \n  -- Blocks a scan skipped because their ZoneMap zone could not match
+ * \n  -- Seeks within data files
+ * \n  -- Header parses
+ * \n  -- Index lines or entries scanned
+ * \n  -- Records parsed into ZipCodeRecord structs
+ * \n  -- Allocations of block, record and index entry storage
+ * \n  -- Cache hits, such as records served from a block already in memory
+ * \n
+ * \n Counters are relaxed atomics, so they are safe to update from several
+ *    threads and cost one relaxed atomic add each. They are shared by the
+ *    whole process, so the ThreadPool workers of lookupConcurrently contend
+ *    for them when they count at the same time. Code counts through the
+ *    ZIPCODE_STAT macro; building with -DZIPCODE_DISABLE_STATS turns every
+ *    use into nothing, so the instrumentation has no cost at all.
+ * \n
+ * \n The counters can be printed as a table or as JSON, for example at the
+ *    exit of ZipCodeTableViewer with --stats.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <atomic>
+#include <ostream>
+
+class Stats {
+public:
+    enum Counter {
+        BLOCKS_READ,
+        BLOCKS_SKIPPED,
+        BYTES_READ,
+        SEEKS,
+        HEADER_PARSES,
+        INDEX_LINES_SCANNED,
+        RECORDS_PARSED,
+        ALLOCATIONS,
+        CACHE_HITS,
+        COUNTER_COUNT
+    };
+
+    /// @brief Adds to a counter.
+    static void add(Counter counter, unsigned long long amount) {
+        counters[counter].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    /// @brief The current value of a counter.
+    static unsigned long long get(Counter counter) {
+        return counters[counter].load(std::memory_order_relaxed);
+    }
+
+    /// @brief Sets every counter back to zero.
+    static void reset();
+
+    /// @brief The snake_case name of a counter, such as "blocks_read".
+    static const char* name(Counter counter);
+
+    /// @brief Whether the counters were compiled in.
+    static bool isEnabled();
+
+    /// @brief Prints every counter on its own line.
+    static void print(std::ostream& out);
+
+    /// @brief Writes every counter as one JSON object.
+    static void writeJSON(std::ostream& out);
+
+private:
+    static std::atomic<unsigned long long> counters[COUNTER_COUNT];
+};
+
+#ifdef ZIPCODE_DISABLE_STATS
+#define ZIPCODE_STAT(counter, amount) ((void)0)
+#else
+#define ZIPCODE_STAT(counter, amount) Stats::add(Stats::counter, (amount))
+#endif
+
+#endif // STATS_H
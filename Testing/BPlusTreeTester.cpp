@@ -0,0 +1,205 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file BPlusTreeTester.cpp
+ * @brief Tests BPlusTree against std::map under random inserts and removes, bulk loads and ranges.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Compile from the Testing directory:
+ * \n g++ -std=c++11 -I.. -o BPlusTreeTester BPlusTreeTester.cpp
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "BPlusTree.h"
+
+using namespace std;
+
+int failures = 0;
+
+void check(bool passed, const string& testName) {
+    if (passed) {
+        cout << "Test passed for " << testName << endl;
+    } else {
+        cout << "\nTest failed for " << testName << endl;
+        failures++;
+    }
+}
+
+/// @brief Whether the tree iterates exactly the entries of the map.
+template <class Tree>
+bool sameEntries(const Tree& tree, const map<int, int>& expected) {
+    if (tree.size() != expected.size()) {
+        return false;
+    }
+    auto expectedIt = expected.begin();
+    for (auto it = tree.begin(); it != tree.end(); ++it, ++expectedIt) {
+        if (it.key() != expectedIt->first || it.value() != expectedIt->second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// @brief Random inserts and removes, checking find, lower_bound and iteration along the way.
+template <int ORDER>
+void testRandomOperations() {
+    const string name = "order " + to_string(ORDER);
+    BPlusTree<int, int, ORDER> tree;
+    map<int, int> expected;
+    mt19937 random(ORDER);
+    uniform_int_distribution<int> anyKey(0, 2000);
+
+    bool insertsAgree = true, removesAgree = true, entriesAgree = true, lookupsAgree = true;
+    for (int step = 0; step < 20000; step++) {
+        int key = anyKey(random);
+        if (random() % 3 != 0) {
+            bool inserted = expected.insert(make_pair(key, step)).second;
+            insertsAgree = insertsAgree && tree.insert(key, step) == inserted;
+        } else {
+            bool removed = expected.erase(key) == 1;
+            removesAgree = removesAgree && tree.remove(key) == removed;
+        }
+
+        if (step % 1000 == 0) {
+            entriesAgree = entriesAgree && sameEntries(tree, expected);
+        }
+        int target = anyKey(random);
+        auto found = tree.find(target);
+        auto expectedFound = expected.find(target);
+        lookupsAgree = lookupsAgree && (found == tree.end()) == (expectedFound == expected.end());
+        auto bound = tree.lower_bound(target);
+        auto expectedBound = expected.lower_bound(target);
+        lookupsAgree = lookupsAgree && (bound == tree.end() ? expectedBound == expected.end()
+                                        : expectedBound != expected.end() && bound.key() == expectedBound->first);
+    }
+    check(insertsAgree, name + " insert reports new keys");
+    check(removesAgree, name + " remove reports present keys");
+    check(entriesAgree && sameEntries(tree, expected), name + " iteration matches std::map");
+    check(lookupsAgree, name + " find and lower_bound match std::map");
+
+    // Remove everything, so every merge down to an empty tree runs
+    bool emptied = true;
+    for (const auto& entry : expected) {
+        emptied = tree.remove(entry.first) && emptied;
+    }
+    check(emptied && tree.empty() && tree.begin() == tree.end(), name + " removing every key empties the tree");
+
+    tree.insert(7, 70);
+    check(tree.size() == 1 && tree.find(7).value() == 70, name + " reuse after emptying");
+    tree.clear();
+    check(tree.empty() && !tree.contains(7), name + " clear");
+}
+
+/// @brief Bulk loads of every size up to a few levels, at several fill factors, then inserts and removes.
+template <int ORDER>
+void testBulkLoad() {
+    const string name = "order " + to_string(ORDER);
+    bool loaded = true, balanced = true, iterates = true, backward = true, updates = true;
+    const double fillFactors[] = { 0.5, 0.7, 1.0 };
+    for (double fillFactor : fillFactors) {
+        for (int count = 0; count < 600; count += (count < 100 ? 1 : 37)) {
+            vector<int> keys, values;
+            map<int, int> expected;
+            for (int i = 0; i < count; i++) {
+                keys.push_back(i * 3);
+                values.push_back(i);
+                expected[i * 3] = i;
+            }
+            BPlusTree<int, int, ORDER> tree;
+            loaded = loaded && tree.bulkLoad(keys, values, fillFactor);
+            balanced = balanced && tree.isBalanced();
+            iterates = iterates && sameEntries(tree, expected);
+
+            auto expectedIt = expected.rbegin();
+            for (auto it = tree.end(); it != tree.begin() && backward; ++expectedIt) {
+                --it;
+                backward = it.key() == expectedIt->first;
+            }
+
+            // The loaded tree must stay balanced through later changes
+            for (int i = 0; i < count; i += 2) {
+                tree.insert(i * 3 + 1, -i);
+                expected[i * 3 + 1] = -i;
+                tree.remove(i * 3);
+                expected.erase(i * 3);
+            }
+            updates = updates && sameEntries(tree, expected) && tree.isBalanced();
+        }
+    }
+    check(loaded, name + " bulk load accepts sorted keys");
+    check(balanced, name + " bulk load keeps every node at least MIN_KEYS full");
+    check(iterates, name + " bulk load iteration matches std::map");
+    check(backward, name + " bulk load backward iteration");
+    check(updates, name + " insert and remove after bulk load");
+
+    BPlusTree<int, int, ORDER> tree;
+    tree.insert(1, 1);
+    check(!tree.bulkLoad(vector<int>{ 1, 3, 2 }, vector<int>{ 1, 2, 3 }) && tree.empty(),
+          name + " bulk load rejects unsorted keys");
+}
+
+/// @brief Ranges in both directions, including empty and out of bounds ones.
+void testRanges() {
+    BPlusTree<int, int, 4> tree;
+    for (int key = 10; key <= 1000; key += 10) {
+        tree.insert(key, key / 10);
+    }
+
+    int sum = 0, visited = 0;
+    for (auto it = tree.range(95, 305).begin(); it != tree.range(95, 305).end(); ++it) {
+        sum += it.key();
+        visited++;
+    }
+    check(visited == 21 && sum == 100 * 21 + 10 * 210, "range 95 to 305");
+
+    BPlusTree<int, int, 4>::Range keys = tree.range(100, 300);
+    vector<int> reversed;
+    for (auto it = keys.end(); it != keys.begin(); ) {
+        --it;
+        reversed.push_back(it.key());
+    }
+    check(reversed.size() == 21 && reversed.front() == 300 && reversed.back() == 100, "range backward");
+
+    check(tree.range(1001, 5000).empty() && tree.range(0, 9).empty() && tree.range(300, 100).empty(),
+          "empty ranges");
+    const BPlusTree<int, int, 4>& constTree = tree;
+    BPlusTree<int, int, 4>::ConstRange all = constTree.range(0, 5000);
+    check(all.begin() == constTree.begin() && all.end() == constTree.end(), "range of every key");
+}
+
+/// @brief Values that own memory are destroyed when removed and when the tree is.
+void testStringValues() {
+    BPlusTree<int, string, 4> tree;
+    for (int key = 0; key < 1000; key++) {
+        tree.insert(key, "value " + to_string(key));
+    }
+    for (int key = 0; key < 1000; key += 2) {
+        tree.remove(key);
+    }
+    check(tree.size() == 500 && tree.find(501).value() == "value 501" && !tree.contains(500),
+          "string values");
+}
+
+int main() {
+    testRandomOperations<3>();
+    testRandomOperations<4>();
+    testRandomOperations<5>();
+    testRandomOperations<32>();
+    testRandomOperations<128>();
+    testBulkLoad<3>();
+    testBulkLoad<4>();
+    testBulkLoad<5>();
+    testBulkLoad<32>();
+    testRanges();
+    testStringValues();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file BlockIndexTester.cpp
+ * @brief Tests every BlockIndex layout against std::lower_bound over the same keys.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Builds indexes of many sizes, around the node and segment sizes of
+ *    the search structures, with distinct keys, repeated keys and keys at
+ *    the ends of the int range. For each layout, checks lowerBound and
+ *    findBlock for every key, its neighbours, keys before the first and
+ *    past the last, and random keys, against std::lower_bound.
+ * \n
+ * \n Compile from the Testing directory:
+ * \n g++ -std=c++11 -I.. -o BlockIndexTester BlockIndexTester.cpp ../BlockIndex.cpp ../Stats.cpp
+ */
+// ----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "BlockIndex.h"
+
+using namespace std;
+
+int failures = 0;
+
+void check(bool passed, const string& testName) {
+    if (passed) {
+        cout << "Test passed for " << testName << endl;
+    } else {
+        cout << "\nTest failed for " << testName << endl;
+        failures++;
+    }
+}
+
+const BlockIndex::Layout LAYOUTS[] = { BlockIndex::SORTED, BlockIndex::EYTZINGER, BlockIndex::STATIC_BTREE,
+                                       BlockIndex::LEARNED };
+
+/// @brief Every key, the keys next to it, the ends of the int range, and random keys.
+vector<int> targetsFor(const vector<int>& keys, mt19937& random) {
+    vector<int> targets = { INT_MIN, INT_MIN + 1, -1, 0, 1, INT_MAX - 1, INT_MAX };
+    for (int key : keys) {
+        targets.push_back(key);
+        if (key > INT_MIN) {
+            targets.push_back(key - 1);
+        }
+        if (key < INT_MAX) {
+            targets.push_back(key + 1);
+        }
+    }
+    if (!keys.empty()) {
+        uniform_int_distribution<int> anyKey(keys.front() - 1000, keys.back() < INT_MAX - 1000 ? keys.back() + 1000 : INT_MAX);
+        for (int i = 0; i < 1000; i++) {
+            targets.push_back(anyKey(random));
+        }
+    }
+    return targets;
+}
+
+/// @brief Whether every layout finds the same block as std::lower_bound for every target.
+bool agreesWithLowerBound(const vector<int>& keys, mt19937& random) {
+    vector<long long> rbns;
+    for (size_t i = 0; i < keys.size(); i++) {
+        rbns.push_back(static_cast<long long>(i) * 512 + 7);
+    }
+    BlockIndex index;
+    if (!index.assign(keys, rbns)) {
+        return false;
+    }
+    vector<int> targets = targetsFor(keys, random);
+    for (BlockIndex::Layout layout : LAYOUTS) {
+        index.setLayout(layout);
+        for (int target : targets) {
+            size_t expected = lower_bound(keys.begin(), keys.end(), target) - keys.begin();
+            long long expectedRBN = expected < keys.size() ? rbns[expected] : -1;
+            if (index.lowerBound(target) != expected || index.findBlock(target) != expectedRBN) {
+                cout << BlockIndex::layoutName(layout) << " is wrong for " << target << " in "
+                     << keys.size() << " keys" << endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/// @brief Strictly increasing keys with random gaps, like the greatest keys of a blocked file.
+vector<int> distinctKeys(size_t count, int first, int maxGap, mt19937& random) {
+    uniform_int_distribution<int> anyGap(1, maxGap);
+    vector<int> keys;
+    int key = first;
+    for (size_t i = 0; i < count; i++) {
+        keys.push_back(key);
+        key += anyGap(random);
+    }
+    return keys;
+}
+
+void testDistinctKeys() {
+    mt19937 random(46);
+    const size_t sizes[] = { 1, 2, 3, 15, 16, 17, 31, 32, 33, 255, 256, 257, 1000, 5519, 100000 };
+    bool allAgree = true;
+    for (size_t size : sizes) {
+        allAgree = allAgree && agreesWithLowerBound(distinctKeys(size, 501, 100, random), random);
+    }
+    check(allAgree, "distinct keys");
+
+    // Gaps of very different sizes bend the lines of the learned index
+    vector<int> uneven = distinctKeys(3000, -50000, 3, random);
+    vector<int> far = distinctKeys(3000, uneven.back() + 1000000, 5000, random);
+    uneven.insert(uneven.end(), far.begin(), far.end());
+    check(agreesWithLowerBound(uneven, random), "uneven gaps");
+}
+
+void testRepeatedKeys() {
+    mt19937 random(47);
+    vector<int> keys;
+    uniform_int_distribution<int> anyRun(1, 40);
+    for (int key = 1000; keys.size() < 20000; key += 3) {
+        keys.insert(keys.end(), anyRun(random), key);
+    }
+    check(agreesWithLowerBound(keys, random), "repeated keys");
+    check(agreesWithLowerBound(vector<int>(100, 42), random), "one key repeated");
+    check(agreesWithLowerBound({ 7, 7, 9, 9, 9, 12 }, random), "short runs");
+}
+
+void testExtremeKeys() {
+    mt19937 random(48);
+    check(agreesWithLowerBound({ INT_MIN, -1, 0, INT_MAX }, random), "keys at the ends of the int range");
+    vector<int> keys = distinctKeys(100, INT_MAX - 2000, 10, random);
+    keys.push_back(INT_MAX);
+    keys.push_back(INT_MAX);
+    check(agreesWithLowerBound(keys, random), "repeated greatest int key");
+}
+
+void testEmptyIndex() {
+    BlockIndex index;
+    bool allEmpty = true;
+    for (BlockIndex::Layout layout : LAYOUTS) {
+        index.setLayout(layout);
+        allEmpty = allEmpty && index.lowerBound(501) == 0 && index.findBlock(501) == -1;
+    }
+    check(allEmpty, "empty index");
+    check(!index.assign({ 3, 2 }, { 0, 1 }) && !index.assign({ 1 }, {}), "unsorted or mismatched keys rejected");
+}
+
+int main() {
+    testDistinctKeys();
+    testRepeatedKeys();
+    testExtremeKeys();
+    testEmptyIndex();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file ColumnStoreTester.cpp
+ * @brief Tests that a ColumnStore holds every record of its blocked file, in order, and its state extrema.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Writes a blocked file of random records with BlockWriter, builds its
+ *    columns, then checks every column against the records, the sorted
+ *    dictionaries, the state extrema against the viewer's row by row
+ *    rules, and that a damaged or stale column file is built again, or
+ *    refused once there is no data file to build it from. The files it
+ *    writes are removed at the end.
+ * \n
+ * \n Compile from the Testing directory:
+ * \n g++ -std=c++11 -I.. -o ColumnStoreTester ColumnStoreTester.cpp ../ColumnStore.cpp ../BlockWriter.cpp
+ *    ../ZoneMap.cpp ../ZipCodeBuffer.cpp ../BlockBuffer.cpp ../HeaderBuffer.cpp ../Stats.cpp ../DataFingerprint.cpp
+ */
+// ----------------------------------------------------------------------------
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "ColumnStore.h"
+#include "BlockWriter.h"
+
+using namespace std;
+
+int failures = 0;
+
+void check(bool passed, const string& testName) {
+    if (passed) {
+        cout << "Test passed for " << testName << endl;
+    } else {
+        cout << "\nTest failed for " << testName << endl;
+        failures++;
+    }
+}
+
+struct TestRecord {
+    uint32_t zipCode;
+    string place;
+    string state;
+    string county;
+    int32_t latitude;       // Microdegrees
+    int32_t longitude;
+};
+
+/// @brief Cuts the last byte off the column file of a data file.
+void cutColumnFile(const string& fileName) {
+    ifstream whole(ColumnStore::fileName(fileName), ios::binary);
+    string image((istreambuf_iterator<char>(whole)), istreambuf_iterator<char>());
+    whole.close();
+    ofstream cut(ColumnStore::fileName(fileName), ios::binary | ios::trunc);
+    cut.write(image.data(), image.size() - 1);
+}
+
+void testColumns() {
+    const string fileName = "column_store_test.txt";
+    const string indexName = "column_store_test_index.txt";
+    const vector<string> states = { "WI", "CT", "MN", "AK", "NY" };
+    const vector<string> counties = { "Dane", "Hartford", "Hennepin", "Kenai Peninsula", "Suffolk", "Erie" };
+    mt19937 random(47);
+    uniform_int_distribution<int32_t> anyLatitude(25000000, 49000000);
+    uniform_int_distribution<int32_t> anyLongitude(-124000000, -67000000);
+
+    // Coordinates with four decimal places, as in the real data, so microdegrees hold them exactly
+    vector<TestRecord> records;
+    {
+        BlockWriter writer(fileName, indexName, 256, 75);
+        for (uint32_t zipCode = 1000; zipCode < 3000; zipCode++) {
+            TestRecord record = { zipCode, "Place " + to_string(random() % 300), states[random() % states.size()],
+                                  counties[random() % counties.size()], anyLatitude(random) / 100 * 100,
+                                  anyLongitude(random) / 100 * 100 };
+            records.push_back(record);
+            char coordinates[64];
+            snprintf(coordinates, sizeof(coordinates), "%.4f,%.4f", record.latitude / 1e6, record.longitude / 1e6);
+            writer.addRecord(to_string(zipCode) + "," + record.place + "," + record.state + "," + record.county + ","
+                             + coordinates);
+        }
+        check(writer.close(), "write blocked file");
+    }
+
+    check(ColumnStore::build(fileName), "build columns");
+    ColumnStore columns(fileName);
+    check(columns.open() && columns.rowCount() == records.size(), "open columns");
+
+    bool rowsMatch = true;
+    for (size_t row = 0; row < columns.rowCount() && row < records.size(); row++) {
+        const TestRecord& record = records[row];
+        rowsMatch = rowsMatch && columns.zipCodes()[row] == record.zipCode
+                 && columns.latitudes()[row] == record.latitude && columns.longitudes()[row] == record.longitude
+                 && columns.stateName(columns.states()[row]) == record.state
+                 && columns.countyName(columns.counties()[row]) == record.county
+                 && columns.placeName(columns.places()[row]) == record.place;
+    }
+    check(rowsMatch, "columns match records in order");
+
+    bool sorted = columns.stateCount() == states.size() && columns.countyCount() == counties.size();
+    for (size_t i = 1; i < columns.stateCount(); i++) {
+        sorted = sorted && columns.stateName(i - 1) < columns.stateName(i);
+    }
+    for (size_t i = 1; i < columns.placeCount(); i++) {
+        sorted = sorted && columns.placeName(i - 1) < columns.placeName(i);
+    }
+    check(sorted, "dictionaries sorted");
+    check(columns.stateNumber("AK") == 0 && columns.stateNumber("WI") == 4 && columns.stateNumber("MA") == -1,
+          "state numbers");
+
+    // The viewer's rules: east is the least longitude, and a tie keeps the first record
+    map<string, vector<int32_t> > expectedCoordinates;
+    map<string, vector<uint32_t> > expectedZipCodes;
+    for (const TestRecord& record : records) {
+        if (expectedCoordinates.count(record.state) == 0) {
+            expectedCoordinates[record.state] = { record.longitude, record.longitude, record.latitude, record.latitude };
+            expectedZipCodes[record.state] = vector<uint32_t>(4, record.zipCode);
+            continue;
+        }
+        vector<int32_t>& extrema = expectedCoordinates[record.state];
+        vector<uint32_t>& zipCodes = expectedZipCodes[record.state];
+        if (record.longitude < extrema[0]) { extrema[0] = record.longitude; zipCodes[0] = record.zipCode; }
+        if (record.longitude > extrema[1]) { extrema[1] = record.longitude; zipCodes[1] = record.zipCode; }
+        if (record.latitude > extrema[2]) { extrema[2] = record.latitude; zipCodes[2] = record.zipCode; }
+        if (record.latitude < extrema[3]) { extrema[3] = record.latitude; zipCodes[3] = record.zipCode; }
+    }
+    vector<ColumnStore::Extrema> extrema = columns.stateExtrema();
+    bool extremaMatch = extrema.size() == expectedZipCodes.size();
+    for (const ColumnStore::Extrema& state : extrema) {
+        string name = columns.stateName(state.state);
+        extremaMatch = extremaMatch
+                    && vector<uint32_t>(state.zipCodes, state.zipCodes + 4) == expectedZipCodes[name]
+                    && vector<int32_t>(state.coordinates, state.coordinates + 4) == expectedCoordinates[name];
+    }
+    check(extremaMatch, "state extrema");
+
+    // A column file cut short must be built again rather than read past its end
+    cutColumnFile(fileName);
+    ColumnStore damaged(fileName);
+    check(damaged.open() && damaged.rowCount() == records.size(), "damaged column file rebuilt");
+
+    // The columns of the file as it was must not be read once it is written again
+    {
+        BlockWriter writer(fileName, indexName, 256, 75);
+        for (size_t i = 0; i < 100; i++) {
+            writer.addRecord(to_string(records[i].zipCode) + "," + records[i].place + "," + records[i].state + ","
+                             + records[i].county + ",45.0000,-93.0000");
+        }
+        writer.close();
+    }
+    ColumnStore changed(fileName);
+    check(changed.open() && changed.rowCount() == 100 && changed.latitudes()[0] == 45000000,
+          "changed data file rebuilds columns");
+
+    remove(fileName.c_str());
+    cutColumnFile(fileName);
+    ColumnStore orphaned(fileName);
+    check(!orphaned.open() && orphaned.rowCount() == 0, "damaged column file without data file refused");
+
+    remove(indexName.c_str());
+    remove(ColumnStore::fileName(fileName).c_str());
+}
+
+int main() {
+    testColumns();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file ConcurrentBPlusTreeTester.cpp
+ * @brief Tests ConcurrentBPlusTree alone against std::map, then with writers and readers at once.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Compile from the Testing directory:
+ * \n g++ -std=c++11 -O2 -pthread -I.. -o ConcurrentBPlusTreeTester ConcurrentBPlusTreeTester.cpp ../EpochManager.cpp
+ */
+// ----------------------------------------------------------------------------
+
+#include <atomic>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ConcurrentBPlusTree.h"
+
+using namespace std;
+
+int failures = 0;
+
+void check(bool passed, const string& testName) {
+    if (passed) {
+        cout << "Test passed for " << testName << endl;
+    } else {
+        cout << "\nTest failed for " << testName << endl;
+        failures++;
+    }
+}
+
+/// @brief Random inserts, removes and finds from one thread agree with std::map.
+template <int ORDER>
+void testOneThread() {
+    const string name = "order " + to_string(ORDER);
+    ConcurrentBPlusTree<int, int, ORDER> tree;
+    map<int, int> expected;
+    mt19937 random(ORDER);
+    uniform_int_distribution<int> anyKey(0, 3000);
+
+    bool agree = true;
+    for (int step = 0; step < 50000; step++) {
+        int key = anyKey(random);
+        if (random() % 2 == 0) {
+            agree = agree && tree.insert(key, step) == expected.insert(make_pair(key, step)).second;
+        } else {
+            agree = agree && tree.remove(key) == (expected.erase(key) == 1);
+        }
+        int target = anyKey(random);
+        int value = -1;
+        bool found = tree.find(target, value);
+        auto expectedIt = expected.find(target);
+        agree = agree && found == (expectedIt != expected.end()) && (!found || value == expectedIt->second);
+    }
+    check(agree && tree.size() == expected.size(), name + " one thread matches std::map");
+}
+
+/// @brief Writers insert and remove their own keys while readers check keys nobody changes.
+void testManyThreads() {
+    const int WRITERS = 4, READERS = 4, KEYS_PER_WRITER = 20000, STABLE_KEYS = 5000;
+    ConcurrentBPlusTree<int, int, 8> tree;
+
+    // Stable keys are multiples of 10, written keys are not, so no thread touches another's keys
+    for (int i = 0; i < STABLE_KEYS; i++) {
+        tree.insert(i * 10 * WRITERS, i);
+    }
+
+    atomic<bool> writing(true);
+    atomic<int> readerErrors(0);
+    vector<thread> threads;
+    vector<int> writerErrors(WRITERS, 0);
+    for (int w = 0; w < WRITERS; w++) {
+        threads.push_back(thread([&, w]() {
+            // Insert every key, then remove the even ones, twice over
+            for (int round = 0; round < 2; round++) {
+                for (int i = 0; i < KEYS_PER_WRITER; i++) {
+                    int key = i * 10 * WRITERS + w + 1;
+                    if (tree.insert(key, key) != (round == 0 || i % 2 == 0)) {
+                        writerErrors[w]++;
+                    }
+                }
+                for (int i = 0; i < KEYS_PER_WRITER; i += 2) {
+                    if (!tree.remove(i * 10 * WRITERS + w + 1)) {
+                        writerErrors[w]++;
+                    }
+                }
+            }
+        }));
+    }
+    for (int r = 0; r < READERS; r++) {
+        threads.push_back(thread([&, r]() {
+            mt19937 random(r);
+            while (writing.load()) {
+                int i = static_cast<int>(random() % STABLE_KEYS);
+                int value = -1;
+                if (!tree.find(i * 10 * WRITERS, value) || value != i) {
+                    readerErrors++;
+                }
+            }
+        }));
+    }
+    for (int w = 0; w < WRITERS; w++) {
+        threads[w].join();
+    }
+    writing = false;
+    for (int r = 0; r < READERS; r++) {
+        threads[WRITERS + r].join();
+    }
+
+    int errors = 0;
+    for (int count : writerErrors) {
+        errors += count;
+    }
+    check(errors == 0, "writers see their own inserts and removes");
+    check(readerErrors == 0, "readers always find unchanged keys");
+
+    bool final = tree.size() == static_cast<size_t>(STABLE_KEYS + WRITERS * KEYS_PER_WRITER / 2);
+    for (int w = 0; w < WRITERS; w++) {
+        for (int i = 0; i < KEYS_PER_WRITER; i++) {
+            final = final && tree.contains(i * 10 * WRITERS + w + 1) == (i % 2 == 1);
+        }
+    }
+    check(final, "keys after concurrent writes");
+}
+
+int main() {
+    testOneThread<3>();
+    testOneThread<4>();
+    testOneThread<32>();
+    testManyThreads();
+    return failures == 0 ? 0 : 1;
+}
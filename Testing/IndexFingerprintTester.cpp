@@ -0,0 +1,229 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file IndexFingerprintTester.cpp
+ * @brief Tests that ZipCodeIndexer reuses its index file until the data file changes.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Checks that loadOrCreateIndex:
+ * \n  -- creates and writes the index, with a fingerprint line, the first time
+ * \n  -- loads it while the data file is unchanged, even after a touch
+ * \n  -- creates it again after a change of the same size, an appended
+ *       record, or from an index file written without a fingerprint
+ * \n  -- creates it again for a length-indicated file whose header Stale Flag
+ *       is set, and clears the flag in place in the header, so no byte but
+ *       the flag's changes and no position moves
+ * \n  -- sets the Stale Flag in the header of a length-indicated file that
+ *       changed, and clears it once the index is created again
+ * \n The files it writes are removed at the end. Run from the Testing
+ *    directory, as it copies ../us_postal_codes.txt.
+ * \n
+ * \n Compile from the Testing directory:
+ * \n g++ -std=c++11 -I.. -o IndexFingerprintTester IndexFingerprintTester.cpp ../ZipCodeIndexer.cpp
+ *    ../ZipCodeBuffer.cpp ../BlockBuffer.cpp ../HeaderBuffer.cpp ../Stats.cpp ../DataFingerprint.cpp
+ */
+// ----------------------------------------------------------------------------
+
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+#include "ZipCodeIndexer.h"
+
+using namespace std;
+
+int failures = 0;
+
+void check(bool passed, const string& testName) {
+    if (passed) {
+        cout << "Test passed for " << testName << endl;
+    } else {
+        cout << "\nTest failed for " << testName << endl;
+        failures++;
+    }
+}
+
+const string CSV_FILE = "index_fingerprint_test.csv";
+const string L_FILE = "index_fingerprint_test.txt";
+
+string readFile(const string& fileName) {
+    ifstream file(fileName, ios::binary);
+    return string((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+}
+
+void writeFile(const string& fileName, const string& contents) {
+    ofstream file(fileName, ios::binary | ios::trunc);
+    file << contents;
+}
+
+/// @brief Sets a file's modification time to a fixed time, leaving its contents alone.
+void touch(const string& fileName, long seconds) {
+    struct timespec times[2] = { { seconds, 0 }, { seconds, 0 } };
+    utimensat(AT_FDCWD, fileName.c_str(), times, 0);
+}
+
+/// @brief Runs loadOrCreateIndex as a search would. Returns whether the index file was loaded.
+/// @param staleFlag If not -1, the Stale Flag to give the header after it is read.
+bool loadOrCreate(const string& dataFile, char fileType, map<string, streampos>& index, HeaderBuffer& headerBuffer,
+                  int staleFlag = -1) {
+    headerBuffer = HeaderBuffer(dataFile);
+    if (fileType != 'C') {
+        headerBuffer.readHeader();
+    }
+    if (staleFlag != -1) {
+        headerBuffer.setstaleFlag(staleFlag);
+    }
+    ifstream file(dataFile);
+    ZipCodeIndexer indexer(file, fileType, dataFile + "_index.txt", headerBuffer, dataFile);
+    bool loaded = indexer.loadOrCreateIndex(headerBuffer);
+    index = indexer.getIndex();
+    return loaded;
+}
+
+/// @brief Whether every position in the index holds the record of its ZIP code.
+bool positionsMatch(const string& dataFile, char fileType, const map<string, streampos>& index) {
+    HeaderBuffer headerBuffer(dataFile);
+    if (fileType != 'C') {
+        headerBuffer.readHeader();
+    }
+    ifstream file(dataFile);
+    ZipCodeBuffer buffer(file, fileType, headerBuffer);
+    bool match = !index.empty();
+    for (const auto& entry : index) {
+        buffer.setCurrentPosition(entry.second);
+        match = match && buffer.readNextRecord().zipCode == entry.first;
+    }
+    return match;
+}
+
+void testCsvFile() {
+    writeFile(CSV_FILE, "\"Zip Code\",\"Place Name\",State,County,Lat,Long\n"
+                        "501,Holtsville,NY,Suffolk,40.8154,-73.0451\n"
+                        "1001,Agawam,MA,Hampden,42.0702,-72.6227\n"
+                        "56301,Saint Cloud,MN,Stearns,45.541,-94.1819\n");
+    touch(CSV_FILE, 1700000000);
+    HeaderBuffer headerBuffer;
+    map<string, streampos> created, loaded;
+    check(!loadOrCreate(CSV_FILE, 'C', created, headerBuffer) && created.size() == 3, "index created first time");
+    check(readFile(CSV_FILE + "_index.txt").compare(0, 8, "# Data: ") == 0, "fingerprint line written");
+    check(loadOrCreate(CSV_FILE, 'C', loaded, headerBuffer) && loaded == created, "unchanged file reuses index");
+
+    touch(CSV_FILE, 1800000000);
+    check(loadOrCreate(CSV_FILE, 'C', loaded, headerBuffer) && loaded == created, "touched file reuses index");
+    check(readFile(CSV_FILE + "_index.txt").find(" 1800000000000000000 ") != string::npos,
+          "new modification time recorded");
+
+    // One digit changed, so only the hash tells
+    string contents = readFile(CSV_FILE);
+    contents.replace(contents.find("56301"), 5, "56302");
+    writeFile(CSV_FILE, contents);
+    check(!loadOrCreate(CSV_FILE, 'C', loaded, headerBuffer) && loaded.count("56302") == 1
+          && loaded.count("56301") == 0, "change of same size rebuilds index");
+
+    writeFile(CSV_FILE, contents + "99950,Ketchikan,AK,Ketchikan Gateway,55.5428,-131.4313\n");
+    check(!loadOrCreate(CSV_FILE, 'C', loaded, headerBuffer) && loaded.size() == 4
+          && positionsMatch(CSV_FILE, 'C', loaded), "appended record rebuilds index");
+
+    // An index file from before fingerprints is still read, but not trusted
+    writeFile(CSV_FILE + "_index.txt", "501 47\n");
+    check(!loadOrCreate(CSV_FILE, 'C', loaded, headerBuffer) && loaded.size() == 4, "index without fingerprint rebuilt");
+    check(loadOrCreate(CSV_FILE, 'C', loaded, headerBuffer) && positionsMatch(CSV_FILE, 'C', loaded),
+          "loaded positions read records");
+
+    remove(CSV_FILE.c_str());
+    remove((CSV_FILE + "_index.txt").c_str());
+}
+
+/// @brief Copies the header and first records of ../us_postal_codes.txt, with the Stale Flag given.
+void writeLengthIndicatedFile(const string& staleFlag) {
+    ifstream source("../us_postal_codes.txt", ios::binary);
+    string contents, line;
+    int records = -1;
+    while (getline(source, line) && records < 200) {
+        // The file's lines end in CRLF, which is kept
+        string ending = (!line.empty() && line.back() == '\r') ? "\r" : "";
+        line = line.substr(0, line.size() - ending.size());
+        if (line == " - Stale Flag: 0") {
+            line = " - Stale Flag: " + staleFlag;
+        }
+        else if (line.find(" - Header Size (bytes): ") == 0) {
+            // A wider flag makes the header longer
+            int headerSize = stoi(line.substr(line.find(": ") + 2)) + static_cast<int>(staleFlag.size()) - 1;
+            line = " - Header Size (bytes): " + to_string(headerSize);
+        }
+        contents += line + ending + "\n";
+        if (records >= 0 || line.find("Data:") != string::npos) {
+            records++;
+        }
+    }
+    writeFile(L_FILE, contents);
+}
+
+/// @brief The Stale Flag in the data file's header.
+int writtenStaleFlag() {
+    HeaderBuffer written(L_FILE);
+    written.readHeader();
+    return written.getStaleFlag();
+}
+
+void testStaleFlag() {
+    HeaderBuffer headerBuffer;
+    map<string, streampos> index;
+    writeLengthIndicatedFile("0");
+    check(!loadOrCreate(L_FILE, 'L', index, headerBuffer) && index.size() == 200
+          && positionsMatch(L_FILE, 'L', index), "length-indicated index created");
+    check(loadOrCreate(L_FILE, 'L', index, headerBuffer), "length-indicated index reused");
+
+    // The index is current, so only the flag makes it be created again. The flag is
+    // written over its old value, so the records stay where they were
+    map<string, streampos> created = index;
+    string before = readFile(L_FILE);
+    check(!loadOrCreate(L_FILE, 'L', index, headerBuffer, 1) && headerBuffer.getStaleFlag() == 0,
+          "stale flag rebuilds current index");
+    check(writtenStaleFlag() == 0 && index == created && readFile(L_FILE) == before,
+          "positions kept with flag cleared in place");
+    check(loadOrCreate(L_FILE, 'L', index, headerBuffer) && positionsMatch(L_FILE, 'L', index),
+          "cleared flag reuses index");
+
+    // A change to the data file sets the flag until the index is created again
+    string changed = readFile(L_FILE);
+    changed.replace(changed.find("Holtsville"), 10, "Holtsvillf");
+    writeFile(L_FILE, changed);
+    {
+        HeaderBuffer changedHeader(L_FILE);
+        changedHeader.readHeader();
+        ifstream file(L_FILE);
+        ZipCodeIndexer indexer(file, 'L', L_FILE + "_index.txt", changedHeader, L_FILE);
+        bool sameModified;
+        check(!indexer.markStaleIfChanged(changedHeader, sameModified) && changedHeader.getStaleFlag() == 1
+              && writtenStaleFlag() == 1, "changed data file sets stale flag");
+    }
+    check(!loadOrCreate(L_FILE, 'L', index, headerBuffer) && writtenStaleFlag() == 0 && index == created
+          && readFile(L_FILE) == changed, "rebuilt index clears stale flag");
+    check(loadOrCreate(L_FILE, 'L', index, headerBuffer), "index reused after stale flag cleared");
+
+    // A wider flag is cleared to the same width
+    writeLengthIndicatedFile("10");
+    before = readFile(L_FILE);
+    check(!loadOrCreate(L_FILE, 'L', index, headerBuffer) && writtenStaleFlag() == 0
+          && readFile(L_FILE).size() == before.size() && positionsMatch(L_FILE, 'L', index),
+          "stale flag in file cleared");
+    check(readFile(L_FILE).find(" - Stale Flag:  0\r\n") != string::npos, "cleared flag padded to width");
+
+    remove(L_FILE.c_str());
+    remove((L_FILE + "_index.txt").c_str());
+}
+
+int main() {
+    testCsvFile();
+    testStaleFlag();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file LargeFileTester.cpp
+ * @brief Tests reading records at offsets above 4 GiB using sparse files.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Builds sparse files whose records sit past the 4 GiB mark, so no real
+ *    disk space is used, and checks that every reader seeks to them:
+ * \n  -- BlockBuffer following a next RBN whose address is above 4 GiB
+ * \n  -- BlockSearch with a block index entry for that RBN
+ * \n  -- ZipCodeIndexer loading a position above 4 GiB from its index file
+ *       and ZipCodeBuffer reading the length-indicated record there
+ * \n
+ * \n Compile from the Testing directory:
+ * \n g++ -std=c++11 -I.. -o LargeFileTester LargeFileTester.cpp ../BlockBuffer.cpp
+ *    ../BlockSearch.cpp ../BlockIndex.cpp ../HeaderBuffer.cpp ../Stats.cpp ../LatencyHistogram.cpp ../ZipCodeBuffer.cpp ../ZipCodeIndexer.cpp ../DataFingerprint.cpp
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "HeaderBuffer.h"
+#include "BlockBuffer.h"
+#include "BlockSearch.h"
+#include "ZipCodeBuffer.h"
+#include "ZipCodeIndexer.h"
+
+using namespace std;
+
+const long long FOUR_GIB = 4LL * 1024 * 1024 * 1024;
+const int BLOCK_SIZE = 4096;
+const long long FAR_RBN = 1300000;                 // 1300000 * 4096 bytes is about 5 GiB
+const string FAR_RECORD = "99950,Ketchikan,AK,Ketchikan Gateway,55.3422,-131.6461";
+const string NEAR_RECORD = "501,Holtsville,NY,Suffolk,40.8154,-73.0451";
+
+int failures = 0;
+
+void check(bool passed, const string& testName) {
+    if (passed) {
+        cout << "Test passed for " << testName << endl;
+    } else {
+        cout << "\nTest failed for " << testName << endl;
+        failures++;
+    }
+}
+
+/// @brief Writes one padded block at the current position of the file.
+void writeBlock(ofstream& file, long long rbn, long long prevRBN, long long nextRBN, const string& record) {
+    string metadata = to_string(rbn) + ",1," + to_string(prevRBN) + "," + to_string(nextRBN) + ",";
+    metadata = to_string(metadata.length() + 3) + "," + metadata;
+    string records = to_string(record.length()) + "," + record;
+    file << metadata << records << string(BLOCK_SIZE - 1 - metadata.length() - records.length(), '~') << "\n";
+}
+
+/// @brief A blocked file with block 0 linked to a block past 4 GiB.
+void testBlockedFile() {
+    const string dataFile = "large_blocked_test.txt";
+    const string indexFile = "large_blocked_test_index.txt";
+
+    HeaderBuffer header(dataFile);
+    header.setFileStructureType("3.0");
+    header.setFileStructureVersion("2.0");
+    header.setSizeFormatType("ASCII");
+    header.setBlockSize(BLOCK_SIZE);
+    header.setPrimaryKeyIndexFileName(indexFile);
+    header.setRecordCount(2);
+    header.setBlockCount(FAR_RBN + 1);
+    header.setRBNA(-1);
+    header.setRBNS(0);
+    header.setHeaderSizeBytes(header.calculateHeaderSize());
+    header.writeHeaderToFile(dataFile);
+
+    {
+        ofstream file(dataFile, ios::binary | ios::in | ios::out);
+        file.seekp(header.getHeaderSizeBytes());
+        writeBlock(file, 0, -1, FAR_RBN, NEAR_RECORD);
+        file.seekp(header.getHeaderSizeBytes() + FAR_RBN * BLOCK_SIZE); // Leaves a hole in the file
+        writeBlock(file, FAR_RBN, 0, -1, FAR_RECORD);
+    }
+    {
+        ofstream index(indexFile);
+        index << 0 << "," << 501 << "\n" << FAR_RBN << "," << 99950 << "\n";
+    }
+
+    ifstream file(dataFile, ios::binary);
+    BlockBuffer blockBuffer(file, HeaderBuffer(dataFile));
+    check(blockBuffer.calculateBlockAddress(FAR_RBN) > FOUR_GIB, "block address above 4 GiB");
+
+    vector<string> first = blockBuffer.readNextBlock();
+    check(first.size() == 1 && first[0] == NEAR_RECORD, "first block");
+    check(blockBuffer.getNextRBN() == FAR_RBN, "next RBN above 2^31 bytes");
+
+    vector<string> far = blockBuffer.readNextBlock();
+    check(far.size() == 1 && far[0] == FAR_RECORD, "block past 4 GiB");
+    check(blockBuffer.getCurrentRBN() == FAR_RBN && blockBuffer.getPrevRBN() == 0, "metadata of block past 4 GiB");
+    check(blockBuffer.readNextBlock().empty(), "end of the sequence set");
+
+    BlockSearch searcher(indexFile, dataFile);
+    check(searcher.searchForRecord(99950) == FAR_RECORD, "BlockSearch past 4 GiB");
+    check(searcher.searchForRecord(99949) == "-1", "BlockSearch miss past 4 GiB");
+
+    file.close();
+    remove(dataFile.c_str());
+    remove(indexFile.c_str());
+}
+
+/// @brief A length-indicated file with a record past 4 GiB and its index.
+void testLengthIndicatedFile() {
+    const string dataFile = "large_li_test.txt";
+    const string indexFile = "large_li_test.txt_index.txt";
+    const long long farPosition = FOUR_GIB + 123456789;
+
+    {
+        ofstream file(dataFile, ios::binary);
+        file << "Header:\n - Block Size: 0\n\nData:\n";
+        file << NEAR_RECORD.length() << "," << NEAR_RECORD << "\n";
+        file.seekp(farPosition);                                      // Leaves a hole in the file
+        file << FAR_RECORD.length() << "," << FAR_RECORD << "\n";
+    }
+    {
+        ofstream index(indexFile);
+        index << "99950 " << farPosition << "\n";
+    }
+
+    ifstream file(dataFile, ios::binary);
+    HeaderBuffer headerBuffer(dataFile);
+    ZipCodeIndexer indexer(file, 'L', indexFile, headerBuffer);
+    indexer.loadIndexFromRAM();
+    long long position = static_cast<long long>(std::streamoff(indexer.getRecordPosition("99950")));
+    check(position == farPosition, "index position above 4 GiB");
+
+    ZipCodeBuffer buffer(file, 'L', headerBuffer);
+    buffer.setCurrentPosition(std::streampos(static_cast<std::streamoff>(position)));
+    ZipCodeRecord record = buffer.readNextRecord();
+    check(record.zipCode == "99950" && record.county == "Ketchikan Gateway", "record past 4 GiB");
+    check(static_cast<long long>(std::streamoff(buffer.getCurrentPosition())) > FOUR_GIB, "position after record past 4 GiB");
+
+    file.close();
+    remove(dataFile.c_str());
+    remove(indexFile.c_str());
+}
+
+int main() {
+    testBlockedFile();
+    testLengthIndicatedFile();
+
+    if (failures > 0) {
+        cout << failures << " test(s) failed." << endl;
+        return 1;
+    }
+    return 0;
+}
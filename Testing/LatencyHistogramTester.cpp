@@ -0,0 +1,101 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file LatencyHistogramTester.cpp
+ * @brief Tests the bucketing, percentiles and merging of LatencyHistogram.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Compile from the Testing directory:
+ * \n g++ -std=c++11 -pthread -I.. -o LatencyHistogramTester LatencyHistogramTester.cpp ../LatencyHistogram.cpp
+ */
+// ----------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LatencyHistogram.h"
+
+using namespace std;
+
+int failures = 0;
+
+void check(bool passed, const string& testName) {
+    if (passed) {
+        cout << "Test passed for " << testName << endl;
+    } else {
+        cout << "\nTest failed for " << testName << endl;
+        failures++;
+    }
+}
+
+/// @brief Every value lands in a bucket that contains it and is at most 1/32 wide.
+void testBuckets() {
+    bool contained = true, precise = true, ordered = true;
+    int lastIndex = 0;
+    for (unsigned long long value = 0; value < (1ULL << 40); value = value * 9 / 8 + 1) {
+        int index = LatencyHistogram::bucketIndex(value);
+        unsigned long long lowest = LatencyHistogram::bucketLowest(index);
+        unsigned long long highest = LatencyHistogram::bucketHighest(index);
+        contained = contained && lowest <= value && value <= highest;
+        precise = precise && (highest - lowest) * 32 <= lowest + 1;
+        ordered = ordered && index >= lastIndex;
+        lastIndex = index;
+    }
+    check(contained, "bucket contains its values");
+    check(precise, "bucket width within 1/32");
+    check(ordered, "buckets in value order");
+    check(LatencyHistogram::bucketIndex(~0ULL) == LatencyHistogram::BUCKET_COUNT - 1, "values past the range are clamped");
+}
+
+/// @brief Percentiles of 1..10000 ns are within the bucket precision.
+void testPercentiles() {
+    LatencyHistogram histogram;
+    for (unsigned long long value = 1; value <= 10000; value++) {
+        histogram.record(value);
+    }
+    check(histogram.getCount() == 10000 && histogram.getMin() == 1 && histogram.getMax() == 10000, "count, min and max");
+    unsigned long long p50 = histogram.percentile(0.50);
+    unsigned long long p99 = histogram.percentile(0.99);
+    unsigned long long p999 = histogram.percentile(0.999);
+    check(p50 >= 5000 && p50 <= 5000 * 33 / 32, "p50");
+    check(p99 >= 9900 && p99 <= 10000, "p99");
+    check(p999 >= 9990 && p999 <= 10000, "p99.9");
+    check(histogram.getMean() == 5000.5, "mean");
+}
+
+/// @brief Per-thread histograms for a path merge into one.
+void testThreads() {
+    vector<thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.push_back(thread([t]() {
+            for (int i = 0; i < 1000; i++) {
+                LatencyHistogram::local(LatencyHistogram::RANGE_SCAN).record(100 * (t + 1));
+            }
+        }));
+    }
+    for (thread& worker : threads) {
+        worker.join();
+    }
+    LatencyHistogram merged;
+    LatencyHistogram::collect(LatencyHistogram::RANGE_SCAN, merged);
+    check(merged.getCount() == 4000, "merged count across threads");
+    check(merged.getMin() == 100 && merged.getMax() == 400, "merged min and max across threads");
+    check(merged.percentile(0.25) >= 100 && merged.percentile(0.25) <= 103 && merged.percentile(1.0) == 400, "merged percentiles across threads");
+}
+
+int main() {
+    testBuckets();
+    testPercentiles();
+    testThreads();
+
+    if (failures > 0) {
+        cout << failures << " test(s) failed." << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,207 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file NGramIndexTester.cpp
+ * @brief Tests NGramIndex edit distances and fuzzy searches against a brute force search of the same terms.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Checks the bit-parallel edit distance against the full table for
+ *    random strings of up to and past 64 characters, then builds an index of
+ *    random place and county names and checks searches for misspellings of
+ *    them against measuring the distance to every term, and that a change
+ *    to the data file makes open build the index again. The files it
+ *    writes are removed at the end.
+ * \n
+ * \n Compile from the Testing directory:
+ * \n g++ -std=c++11 -pthread -I.. -o NGramIndexTester NGramIndexTester.cpp ../NGramIndex.cpp ../SecondaryIndex.cpp ../DataFingerprint.cpp
+ *    ../ZipCodeBuffer.cpp ../BlockBuffer.cpp ../HeaderBuffer.cpp ../Stats.cpp
+ */
+// ----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "NGramIndex.h"
+#include "SecondaryIndex.h"
+
+using namespace std;
+
+int failures = 0;
+
+void check(bool passed, const string& testName) {
+    if (passed) {
+        cout << "Test passed for " << testName << endl;
+    } else {
+        cout << "\nTest failed for " << testName << endl;
+        failures++;
+    }
+}
+
+/// @brief The edit distance by the textbook table.
+int tableDistance(const string& a, const string& b) {
+    vector<vector<int> > table(a.size() + 1, vector<int>(b.size() + 1));
+    for (size_t i = 0; i <= a.size(); i++) {
+        for (size_t j = 0; j <= b.size(); j++) {
+            if (i == 0 || j == 0) {
+                table[i][j] = static_cast<int>(i + j);
+            } else {
+                table[i][j] = min(table[i - 1][j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1),
+                                  min(table[i - 1][j], table[i][j - 1]) + 1);
+            }
+        }
+    }
+    return table[a.size()][b.size()];
+}
+
+string randomString(mt19937& random, size_t maxLength) {
+    uniform_int_distribution<size_t> anyLength(0, maxLength);
+    string text(anyLength(random), ' ');
+    for (char& c : text) {
+        c = "abcde "[random() % 6];       // Few letters, so strings have much in common
+    }
+    return text;
+}
+
+void testEditDistance() {
+    mt19937 random(44);
+    bool allMatch = true;
+    for (int i = 0; i < 5000; i++) {
+        string a = randomString(random, 70);
+        string b = randomString(random, 70);
+        allMatch = allMatch && NGramIndex::editDistance(a, b) == tableDistance(a, b);
+    }
+    check(allMatch, "edit distance of random strings");
+    check(NGramIndex::editDistance("holtsvile", "holtsville") == 1 && NGramIndex::editDistance("", "abc") == 3
+          && NGramIndex::editDistance("abc", "") == 3 && NGramIndex::editDistance("kitten", "sitting") == 3,
+          "edit distance examples");
+    check(NGramIndex::defaultDistance(3) == 0 && NGramIndex::defaultDistance(4) == 1
+          && NGramIndex::defaultDistance(9) == 2 && NGramIndex::defaultDistance(40) == 3, "default distances");
+}
+
+/// @brief Random names from a few syllables, so many are a few edits apart.
+void testAgainstBruteForce() {
+    const string dataName = "ngram_index_test.csv";
+    const vector<string> syllables = { "spring", "field", "hol", "ts", "ville", "new", " port", "a", "on" };
+    const vector<string> states = { "MA", "NY", "OH" };
+    mt19937 random(45);
+    uniform_int_distribution<int> anySyllable(0, static_cast<int>(syllables.size()) - 1);
+    uniform_int_distribution<int> anyLength(1, 4);
+
+    NGramIndex::Builder builder;
+    map<string, pair<string, size_t> > places;      // Normalized name to key and ZIP count
+    map<string, pair<string, size_t> > counties;    // County term to key and ZIP count
+    ofstream dataFile(dataName);
+    dataFile << "Zip Code,Place Name,State,County,Lat,Long\n";
+    for (int zipCode = 1000; zipCode < 1500; zipCode++) {
+        string place, county;
+        for (int s = anyLength(random); s > 0; s--) {
+            place += syllables[anySyllable(random)];
+        }
+        for (int s = anyLength(random); s > 0; s--) {
+            county += syllables[anySyllable(random)];
+        }
+        const string& state = states[random() % states.size()];
+        builder.add(place, state, county, zipCode);
+        dataFile << zipCode << "," << place << "," << state << "," << county << ",42.1,-72.6\n";
+        string placeTerm = SecondaryIndex::placeTerm(place);
+        places[placeTerm].first = placeTerm;
+        places[placeTerm].second++;
+        string countyTerm = SecondaryIndex::countyTerm(state, county);
+        counties[countyTerm].first = SecondaryIndex::normalize(county);
+        counties[countyTerm].second++;
+    }
+    dataFile.close();
+    // The index is written from the terms, and only takes the fingerprint of the data file
+    DataFingerprint fingerprint;
+    check(fingerprint.read(dataName) && builder.write(NGramIndex::indexFileName(dataName), fingerprint), "write");
+    NGramIndex index(dataName);
+    check(index.open() && index.termCount() == places.size() + counties.size(), "open");
+
+    // Ranks every term within the default distance: fewest edits, most ZIP codes, then places before counties
+    bool allMatch = true;
+    size_t searches = 0;
+    for (const auto& place : places) {
+        for (int variant = 0; variant < 3; variant++) {
+            string query = place.first;
+            size_t at = random() % query.size();
+            if (variant == 1) {
+                query[at] = 'x';
+            } else if (variant == 2) {
+                query.erase(at, 1);
+            }
+            string key = SecondaryIndex::normalize(query);
+            int bound = NGramIndex::defaultDistance(key.size());
+            vector<pair<pair<int, size_t>, pair<int, string> > > expected;
+            const map<string, pair<string, size_t> >* fields[] = { &places, &counties };
+            for (int f = 0; f < 2; f++) {
+                for (const auto& term : *fields[f]) {
+                    int distance = tableDistance(key, term.second.first);
+                    if (distance <= bound) {
+                        expected.push_back(make_pair(make_pair(distance, ~term.second.second),
+                                                     make_pair(f, term.first)));
+                    }
+                }
+            }
+            sort(expected.begin(), expected.end());
+
+            vector<NGramIndex::Match> matches = index.search(query, 1000);
+            bool same = matches.size() == expected.size();
+            for (size_t i = 0; same && i < matches.size(); i++) {
+                same = matches[i].distance == expected[i].first.first
+                    && matches[i].zipCodes.size() == ~expected[i].first.second
+                    && static_cast<int>(matches[i].field) == expected[i].second.first;
+            }
+            allMatch = allMatch && same;
+            searches++;
+        }
+    }
+    check(allMatch, "searches of " + to_string(searches) + " misspellings");
+
+    vector<NGramIndex::Match> limited = index.search("springfield", 2);
+    check(limited.size() == 2 && limited[0].distance <= limited[1].distance, "match count limit");
+    check(index.search("", 10).empty() && index.search("qqqqqqqq", 10).empty(), "queries matching nothing");
+    vector<NGramIndex::Match> typed = index.search("HOLTS-VILLE", 1);
+    vector<NGramIndex::Match> normalized = index.search("holts ville", 1);
+    check(typed.size() == 1 && normalized.size() == 1 && typed[0].name == normalized[0].name, "query normalization");
+
+    // An index of the data file as it was is not used once it changes
+    {
+        ofstream changed(dataName, ios::trunc);
+        changed << "Zip Code,Place Name,State,County,Lat,Long\n"
+                << "92309,Zzyzx,CA,San Bernardino,35.1428,-116.1042\n";
+    }
+    NGramIndex rebuilt(dataName);
+    vector<NGramIndex::Match> found;
+    check(rebuilt.open() && rebuilt.termCount() == 2 && (found = rebuilt.search("zzyzz", 5)).size() == 1
+          && found[0].zipCodes == vector<int>(1, 92309), "changed data file rebuilds index");
+
+    remove(dataName.c_str());
+    remove(NGramIndex::indexFileName(dataName).c_str());
+}
+
+void testDamagedFile() {
+    const string dataName = "ngram_index_damaged";
+    {
+        ofstream damaged(NGramIndex::indexFileName(dataName), ios::binary);
+        damaged << "not an index at all, but long enough to hold a header";
+    }
+    NGramIndex index(dataName);
+    check(!index.open() && index.search("abcd", 5).empty(), "damaged file rejected");
+    remove(NGramIndex::indexFileName(dataName).c_str());
+}
+
+int main() {
+    testEditDistance();
+    testAgainstBruteForce();
+    testDamagedFile();
+    return failures == 0 ? 0 : 1;
+}
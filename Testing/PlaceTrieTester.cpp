@@ -0,0 +1,154 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file PlaceTrieTester.cpp
+ * @brief Tests PlaceTrie completions and lookups against a brute force search of the same names.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Builds a trie of random place names sharing many prefixes, then checks
+ *    every prefix of every name, with counts below, at and above the
+ *    stored top lists, against ranking the names by hand, and that a
+ *    change to the data file makes open build the trie again. The files it
+ *    writes are removed at the end.
+ * \n
+ * \n Compile from the Testing directory:
+ * \n g++ -std=c++11 -pthread -I.. -o PlaceTrieTester PlaceTrieTester.cpp ../PlaceTrie.cpp ../SecondaryIndex.cpp ../DataFingerprint.cpp
+ *    ../ZipCodeBuffer.cpp ../BlockBuffer.cpp ../HeaderBuffer.cpp ../Stats.cpp
+ */
+// ----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "PlaceTrie.h"
+#include "SecondaryIndex.h"
+
+using namespace std;
+
+int failures = 0;
+
+void check(bool passed, const string& testName) {
+    if (passed) {
+        cout << "Test passed for " << testName << endl;
+    } else {
+        cout << "\nTest failed for " << testName << endl;
+        failures++;
+    }
+}
+
+/// @brief The expected completions: names starting with the key, most ZIP codes first, then alphabetical.
+vector<string> bruteForce(const map<string, vector<int> >& names, const string& key, size_t count) {
+    vector<pair<string, size_t> > matches;
+    for (const auto& entry : names) {
+        if (entry.first.compare(0, key.size(), key) == 0) {
+            matches.push_back(make_pair(entry.first, entry.second.size()));
+        }
+    }
+    stable_sort(matches.begin(), matches.end(), [](const pair<string, size_t>& a, const pair<string, size_t>& b) {
+        return a.second > b.second;
+    });
+    vector<string> expected;
+    for (size_t i = 0; i < matches.size() && i < count; i++) {
+        expected.push_back(matches[i].first);
+    }
+    return expected;
+}
+
+/// @brief Random names from a few syllables, so they share prefixes and some are prefixes of others.
+void testAgainstBruteForce() {
+    const string dataName = "place_trie_test.csv";
+    const vector<string> syllables = { "spring", "field", "new", " port", "ville", "a", "ab", "s" };
+    mt19937 random(43);
+    uniform_int_distribution<int> anySyllable(0, static_cast<int>(syllables.size()) - 1);
+    uniform_int_distribution<int> anyLength(1, 4);
+
+    PlaceTrie::Builder builder;
+    map<string, vector<int> > names;        // Normalized name to ZIP codes
+    ofstream dataFile(dataName);
+    dataFile << "Zip Code,Place Name,State,County,Lat,Long\n";
+    for (int zipCode = 1000; zipCode < 2500; zipCode++) {
+        string name;
+        for (int s = anyLength(random); s > 0; s--) {
+            name += syllables[anySyllable(random)];
+        }
+        builder.add(name, zipCode);
+        names[SecondaryIndex::placeTerm(name)].push_back(zipCode);
+        dataFile << zipCode << "," << name << ",MA,Hampden,42.1,-72.6\n";
+    }
+    dataFile.close();
+    // The trie is written from the names, and only takes the fingerprint of the data file
+    DataFingerprint fingerprint;
+    check(fingerprint.read(dataName) && builder.write(PlaceTrie::indexFileName(dataName), fingerprint), "write");
+    PlaceTrie trie(dataName);
+    check(trie.open() && trie.nameCount() == names.size(), "open");
+
+    const size_t counts[] = { 1, 3, PlaceTrie::TOP_COMPLETIONS, PlaceTrie::TOP_COMPLETIONS + 5, 1000 };
+    bool allMatch = true;
+    bool zipsMatch = true;
+    for (const auto& entry : names) {
+        for (size_t length = 0; length <= entry.first.size(); length++) {
+            string key = entry.first.substr(0, length);
+            for (size_t count : counts) {
+                vector<PlaceTrie::Completion> completions = trie.complete(key, count);
+                vector<string> expected = bruteForce(names, SecondaryIndex::placeTerm(key), count);
+                vector<string> found;
+                for (const PlaceTrie::Completion& completion : completions) {
+                    found.push_back(SecondaryIndex::placeTerm(completion.placeName));
+                }
+                allMatch = allMatch && found == expected;
+            }
+        }
+        vector<int> zipCodes;
+        zipsMatch = zipsMatch && trie.lookup(entry.first, zipCodes) && zipCodes == entry.second;
+    }
+    check(allMatch, "completions of every prefix");
+    check(zipsMatch, "lookups");
+
+    vector<int> none;
+    check(!trie.lookup("springfiel", none) || names.count("springfiel") == 1, "lookup of a prefix that is not a name");
+    check(trie.complete("zzz", 10).empty(), "prefix with no names");
+    vector<PlaceTrie::Completion> typed = trie.complete("SPRING-Port", 1);
+    vector<PlaceTrie::Completion> normalized = trie.complete("spring port", 1);
+    check(typed.size() == 1 && normalized.size() == 1 && typed[0].placeName == normalized[0].placeName,
+          "prefix normalization");
+
+    // A trie of the data file as it was is not used once it changes
+    {
+        ofstream changed(dataName, ios::trunc);
+        changed << "Zip Code,Place Name,State,County,Lat,Long\n"
+                << "92309,Zzyzx,CA,San Bernardino,35.1428,-116.1042\n";
+    }
+    PlaceTrie rebuilt(dataName);
+    vector<int> zipCodes;
+    check(rebuilt.open() && rebuilt.nameCount() == 1 && rebuilt.lookup("zzyzx", zipCodes)
+          && zipCodes == vector<int>(1, 92309), "changed data file rebuilds trie");
+
+    remove(dataName.c_str());
+    remove(PlaceTrie::indexFileName(dataName).c_str());
+}
+
+void testDamagedFile() {
+    const string dataName = "place_trie_damaged";
+    {
+        ofstream damaged(PlaceTrie::indexFileName(dataName), ios::binary);
+        damaged << "not a trie at all, but long enough to hold a header";
+    }
+    PlaceTrie trie(dataName);
+    check(!trie.open() && trie.complete("a", 5).empty(), "damaged file rejected");
+    remove(PlaceTrie::indexFileName(dataName).c_str());
+}
+
+int main() {
+    testAgainstBruteForce();
+    testDamagedFile();
+    return failures == 0 ? 0 : 1;
+}
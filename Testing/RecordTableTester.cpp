@@ -0,0 +1,172 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file RecordTableTester.cpp
+ * @brief Tests that a RecordTable gives back every record it was given, with each name interned once.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Adds random records to a RecordTable and checks their views against
+ *    the records as ZipCodeBuffer::parseRecord parses them, that equal
+ *    names share one place in the arena, that find works in and out of ZIP
+ *    code order, and that load reads a CSV file into ZIP code order. The
+ *    file it writes is removed at the end.
+ * \n
+ * \n Compile from the Testing directory:
+ * \n g++ -std=c++11 -I.. -o RecordTableTester RecordTableTester.cpp ../RecordTable.cpp ../ZipCodeBuffer.cpp
+ *    ../BlockBuffer.cpp ../HeaderBuffer.cpp ../Stats.cpp
+ */
+// ----------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "RecordTable.h"
+
+using namespace std;
+
+int failures = 0;
+
+void check(bool passed, const string& testName) {
+    if (passed) {
+        cout << "Test passed for " << testName << endl;
+    } else {
+        cout << "\nTest failed for " << testName << endl;
+        failures++;
+    }
+}
+
+/// @brief A record string's fields, as ZipCodeBuffer::parseRecord gives them.
+ZipCodeRecord parse(const string& recordString) {
+    vector<string> fields;
+    istringstream recordStream(recordString);
+    string field;
+    while (getline(recordStream, field, ',')) {
+        fields.push_back(field);
+    }
+    ZipCodeRecord record;
+    record.zipCode = fields[0];
+    record.placeName = fields[1];
+    record.state = fields[2];
+    record.county = fields[3];
+    record.latitude = stod(fields[4]);
+    record.longitude = stod(fields[5]);
+    return record;
+}
+
+/// @brief Whether a view holds the same fields as a parsed record.
+bool sameRecord(const RecordTable::RecordView& view, const ZipCodeRecord& record) {
+    return to_string(view.zipCode()) == record.zipCode && view.placeName() == record.placeName
+        && view.state() == record.state && view.county() == record.county && view.latitude() == record.latitude
+        && view.longitude() == record.longitude;
+}
+
+/// @brief Random records with four decimal places, as in the real data, in ZIP code order if asked.
+vector<string> randomRecords(mt19937& random, bool inZipOrder) {
+    const vector<string> states = { "MN", "WI", "NY", "PR", "AK" };
+    const vector<string> counties = { "Hennepin", "Dane", "Suffolk", "San Juan", "Kenai Peninsula Borough" };
+    vector<string> records;
+    for (int zipCode = 501; zipCode < 3501; zipCode++) {
+        char coordinates[64];
+        snprintf(coordinates, sizeof(coordinates), "%.4f,%.4f", (random() % 400000) / 10000.0 + 18,
+                 -static_cast<int>(random() % 1000000) / 10000.0 - 66);
+        records.push_back(to_string(inZipOrder ? zipCode : 4000 - zipCode) + ",Place Name Number "
+                          + to_string(random() % 500) + "," + states[random() % states.size()] + ","
+                          + counties[random() % counties.size()] + "," + coordinates);
+    }
+    return records;
+}
+
+void testViews() {
+    mt19937 random(48);
+    vector<string> records = randomRecords(random, true);
+    RecordTable table;
+    bool allAdded = true;
+    for (const string& record : records) {
+        allAdded = allAdded && table.addRecord(record);
+    }
+    check(allAdded && table.size() == records.size(), "add records");
+    check(!table.addRecord("501,Holtsville,NY") && !table.addRecord("501,Holtsville,NY,Suffolk,40.8,-73.0,x")
+          && table.size() == records.size(), "records without six fields refused");
+
+    bool viewsMatch = true;
+    size_t row = 0;
+    for (RecordTable::RecordView view : table) {
+        ZipCodeRecord record = parse(records[row++]);
+        viewsMatch = viewsMatch && sameRecord(view, record) && view.toRecord().placeName == record.placeName;
+    }
+    check(viewsMatch && row == records.size(), "views match parsed records");
+
+    // Interned names are stored once, so equal names are the same characters
+    bool interned = table.stateCount() == 5 && table.countyCount() == 5 && table.placeCount() <= 500;
+    for (size_t i = 1; i < table.size(); i++) {
+        if (table[i].stateId() == table[0].stateId()) {
+            interned = interned && table[i].state().data == table[0].state().data;
+        }
+        bool samePlace = table[i].placeName() == table[0].placeName().str();
+        interned = interned && (table[i].placeId() == table[0].placeId()) == samePlace;
+    }
+    check(interned, "names interned once");
+    check(table.stateId("PR") >= 0 && table.stateId("PRX") == -1 && table.stateId("") == -1, "state ids");
+
+    bool found = table.find(499) == table.end() && table.find(3501) == table.end();
+    for (uint32_t zipCode = 501; zipCode < 3501; zipCode += 7) {
+        RecordTable::Iterator record = table.find(zipCode);
+        found = found && record != table.end() && (*record).zipCode() == zipCode;
+    }
+    check(found, "find in ZIP code order");
+
+    RecordTable unordered;
+    for (const string& record : randomRecords(random, false)) {
+        unordered.addRecord(record);
+    }
+    bool foundUnordered = unordered.find(4000) == unordered.end();
+    for (uint32_t zipCode = 501; zipCode < 3501; zipCode += 7) {
+        RecordTable::Iterator record = unordered.find(zipCode);
+        foundUnordered = foundUnordered && record != unordered.end() && (*record).zipCode() == zipCode;
+    }
+    check(foundUnordered, "find out of ZIP code order");
+}
+
+void testLoad() {
+    const string fileName = "record_table_test.csv";
+    mt19937 random(480);
+    vector<string> records = randomRecords(random, false);
+    {
+        ofstream file(fileName, ios::binary | ios::trunc);
+        file << "\"Zip Code\",\"Place Name\",State,County,Lat,Long\n";
+        for (const string& record : records) {
+            file << record << "\n";
+        }
+    }
+
+    RecordTable table;
+    check(table.load(fileName) && table.size() == records.size(), "load CSV file");
+    bool sorted = true;
+    for (size_t i = 1; i < table.size(); i++) {
+        sorted = sorted && table[i - 1].zipCode() < table[i].zipCode();
+    }
+    check(sorted, "loaded in ZIP code order");
+
+    ZipCodeRecord first = parse(records.front());
+    RecordTable::Iterator record = table.find(static_cast<uint32_t>(atoi(first.zipCode.c_str())));
+    check(record != table.end() && sameRecord(*record, first), "find after load");
+
+    RecordTable missing;
+    check(!missing.load("no_such_file.csv"), "missing file refused");
+    remove(fileName.c_str());
+}
+
+int main() {
+    testViews();
+    testLoad();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file RoaringBitmapTester.cpp
+ * @brief Tests RoaringBitmap against std::set for sparse, dense and mixed sets.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Compile from the Testing directory:
+ * \n g++ -std=c++11 -I.. -o RoaringBitmapTester RoaringBitmapTester.cpp ../RoaringBitmap.cpp
+ */
+// ----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include "RoaringBitmap.h"
+
+using namespace std;
+
+int failures = 0;
+
+void check(bool passed, const string& testName) {
+    if (passed) {
+        cout << "Test passed for " << testName << endl;
+    } else {
+        cout << "\nTest failed for " << testName << endl;
+        failures++;
+    }
+}
+
+/// @brief Whether the bitmap holds exactly the values of the set.
+bool sameValues(const RoaringBitmap& bitmap, const set<uint32_t>& expected) {
+    vector<uint32_t> values = bitmap.toVector();
+    return bitmap.cardinality() == expected.size() && values == vector<uint32_t>(expected.begin(), expected.end());
+}
+
+/// @brief Random values below limit, so a small limit makes bitmap containers and a large one array containers.
+void fill(RoaringBitmap& bitmap, set<uint32_t>& expected, size_t count, uint32_t limit, unsigned seed) {
+    mt19937 random(seed);
+    uniform_int_distribution<uint32_t> anyValue(0, limit);
+    for (size_t i = 0; i < count; i++) {
+        uint32_t value = anyValue(random);
+        bitmap.add(value);
+        expected.insert(value);
+    }
+}
+
+void testAddAndContains() {
+    RoaringBitmap bitmap;
+    set<uint32_t> expected;
+    check(bitmap.empty() && !bitmap.contains(0), "empty bitmap");
+
+    fill(bitmap, expected, 20000, 100000, 1);           // Dense: bitmap containers
+    fill(bitmap, expected, 5000, 0xFFFFFFFFu, 2);       // Sparse: array containers
+    bitmap.add(0xFFFFFFFFu);
+    expected.insert(0xFFFFFFFFu);
+    check(sameValues(bitmap, expected), "values after adds");
+
+    bool allContained = true;
+    for (uint32_t value : expected) {
+        allContained = allContained && bitmap.contains(value);
+    }
+    check(allContained && bitmap.contains(100001) == (expected.count(100001) == 1), "contains");
+
+    size_t before = bitmap.cardinality();
+    bitmap.add(*expected.begin());
+    check(bitmap.cardinality() == before, "adding a value twice");
+
+    RoaringBitmap range;
+    range.addRange(65530, 65545);
+    check(range.cardinality() == 16 && range.contains(65535) && range.contains(65536), "range across containers");
+}
+
+void testOperations() {
+    const uint32_t limits[] = { 70000, 10000000 };
+    for (uint32_t limitA : limits) {
+        for (uint32_t limitB : limits) {
+            RoaringBitmap a, b;
+            set<uint32_t> expectedA, expectedB;
+            fill(a, expectedA, 30000, limitA, limitA);
+            fill(b, expectedB, 30000, limitB, limitB + 1);
+
+            set<uint32_t> both, either;
+            set_intersection(expectedA.begin(), expectedA.end(), expectedB.begin(), expectedB.end(),
+                             inserter(both, both.end()));
+            set_union(expectedA.begin(), expectedA.end(), expectedB.begin(), expectedB.end(),
+                      inserter(either, either.end()));
+            string name = to_string(limitA) + " with " + to_string(limitB);
+            check(sameValues(a & b, both), "intersection of " + name);
+            check(sameValues(a | b, either), "union of " + name);
+            check((a & b) == (b & a) && (a | b) == (b | a), "operations commute for " + name);
+        }
+    }
+
+    // A dense intersection small enough to become an array container again
+    RoaringBitmap evens, low;
+    for (uint32_t value = 0; value < 65536; value += 2) {
+        evens.add(value);
+    }
+    low.addRange(0, 5000);
+    check((evens & low).cardinality() == 2501 && (evens & low).memoryBytes() < evens.memoryBytes(),
+          "dense intersection shrinks to an array");
+}
+
+void testSerialize() {
+    RoaringBitmap bitmap;
+    set<uint32_t> expected;
+    fill(bitmap, expected, 20000, 100000, 3);
+    fill(bitmap, expected, 3000, 50000000, 4);
+
+    string image = "prefix";
+    bitmap.serialize(image);
+    RoaringBitmap restored;
+    size_t used = 0;
+    check(restored.deserialize(image.data() + 6, image.size() - 6, used) && used == image.size() - 6
+          && restored == bitmap, "serialize round trip");
+
+    RoaringBitmap truncated;
+    check(!truncated.deserialize(image.data() + 6, image.size() - 7, used), "truncated image rejected");
+
+    RoaringBitmap empty, emptyRestored;
+    string emptyImage;
+    empty.serialize(emptyImage);
+    check(emptyRestored.deserialize(emptyImage.data(), emptyImage.size(), used) && emptyRestored.empty(),
+          "empty round trip");
+}
+
+int main() {
+    testAddAndContains();
+    testOperations();
+    testSerialize();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file SecondaryIndexTester.cpp
+ * @brief Tests SecondaryIndex postings encoding, term normalization, and lookups against a full scan.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Writes a small CSV file, indexes it, and checks that every place and
+ *    county finds exactly the records a scan of the file finds, and that a
+ *    change to the file makes open build the index again. Also checks that
+ *    a ZipCodeStore cursor stops at a record it cannot read, rather than
+ *    returning an empty one. The files it writes are removed at the end.
+ * \n
+ * \n Compile from the Testing directory:
+ * \n g++ -std=c++11 -pthread -I.. -o SecondaryIndexTester SecondaryIndexTester.cpp ../SecondaryIndex.cpp
+ *    ../ZipCodeStore.cpp ../ZipCodeBuffer.cpp ../BlockBuffer.cpp ../HeaderBuffer.cpp ../BlockIndex.cpp
+ *    ../ZipCodeIndexer.cpp ../DataFingerprint.cpp ../SpatialOrder.cpp ../BlockWriter.cpp ../ZoneMap.cpp ../Stats.cpp
+ */
+// ----------------------------------------------------------------------------
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "SecondaryIndex.h"
+#include "ZipCodeStore.h"
+
+using namespace std;
+
+int failures = 0;
+
+void check(bool passed, const string& testName) {
+    if (passed) {
+        cout << "Test passed for " << testName << endl;
+    } else {
+        cout << "\nTest failed for " << testName << endl;
+        failures++;
+    }
+}
+
+/// @brief Locations near each other, far apart, and past 32 bits survive encoding.
+void testPostingsRoundTrip() {
+    vector<long long> locations = { 0, 1, 127, 128, 300, 16384, 1LL << 31, (1LL << 40) + 5 };
+    string encoded;
+    SecondaryIndex::encodePostings(locations, encoded);
+    vector<long long> decoded;
+    check(SecondaryIndex::decodePostings(encoded.data(), encoded.size(), locations.size(), decoded)
+          && decoded == locations, "postings round trip");
+
+    vector<long long> truncated;
+    check(!SecondaryIndex::decodePostings(encoded.data(), encoded.size() - 1, locations.size(), truncated),
+          "truncated postings rejected");
+
+    // Records next to each other take one byte each
+    vector<long long> dense;
+    for (long long location = 1000; location < 2000; location += 40) {
+        dense.push_back(location);
+    }
+    string denseEncoded;
+    SecondaryIndex::encodePostings(dense, denseEncoded);
+    check(denseEncoded.size() == dense.size() + 1, "dense postings size");
+}
+
+void testTerms() {
+    check(SecondaryIndex::placeTerm("  Saint-Louis ") == "saint louis", "place term punctuation");
+    check(SecondaryIndex::placeTerm("SPRINGFIELD") == "springfield", "place term case");
+    check(SecondaryIndex::countyTerm("ma", "Hampden") == "MA/hampden", "county term");
+    check(SecondaryIndex::recordTerm(SecondaryIndex::COUNTY, "1001,Agawam,MA,Hampden,42.0702,-72.6227") == "MA/hampden",
+          "record county term");
+    check(SecondaryIndex::recordTerm(SecondaryIndex::PLACE, "1001,Agawam,MA") == "", "short record has no term");
+}
+
+/// @brief Every place and county of a small file finds the ZIP codes a scan finds.
+void testLookupAgainstScan() {
+    const string fileName = "secondary_index_test.csv";
+    const vector<string> records = {
+        "1001,Agawam,MA,Hampden,42.0702,-72.6227",
+        "1101,Springfield,MA,Hampden,42.1015,-72.5898",
+        "1102,Springfield,MA,Hampden,42.1015,-72.5898",
+        "1201,Pittsfield,MA,Berkshire,42.4517,-73.2605",
+        "62701,Springfield,IL,Sangamon,39.8,-89.6495",
+        "65801,Springfield,MO,Greene,37.2153,-93.2982",
+        "13338,Greene,NY,Chenango,42.3297,-75.7698",
+        "63101,Saint Louis,MO,Saint Louis City,38.6318,-90.1928"
+    };
+    {
+        ofstream file(fileName);
+        file << "Zip Code,Place Name,State,County,Lat,Long\n";
+        for (const string& record : records) {
+            file << record << "\n";
+        }
+    }
+
+    check(SecondaryIndex::build(fileName), "build");
+    ZipCodeStore store(fileName);
+    SecondaryIndex places(fileName, SecondaryIndex::PLACE);
+    SecondaryIndex counties(fileName, SecondaryIndex::COUNTY);
+    check(store.open() && places.open() && counties.open(), "open");
+    check(places.termCount() == 5 && counties.termCount() == 6, "term counts");
+
+    SecondaryIndex* indexes[] = { &places, &counties };
+    for (SecondaryIndex* index : indexes) {
+        // The scan: the records of each term
+        map<string, set<string> > expected;
+        for (const string& record : records) {
+            expected[SecondaryIndex::recordTerm(index->getField(), record)].insert(record);
+        }
+        bool allFound = true;
+        for (const auto& entry : expected) {
+            vector<long long> locations;
+            set<string> found;
+            if (index->lookup(entry.first, locations)) {
+                for (long long location : locations) {
+                    vector<string> read;
+                    store.readLocation(location, read);
+                    found.insert(read.begin(), read.end());
+                }
+            }
+            allFound = allFound && found == entry.second;
+        }
+        check(allFound, string(index->getField() == SecondaryIndex::PLACE ? "place" : "county") + " lookups match the scan");
+    }
+
+    vector<long long> none;
+    check(!places.lookup("boston", none) && none.empty(), "missing term");
+
+    // A record added at the start moves every other one, so the old postings would be wrong
+    {
+        ofstream file(fileName);
+        file << "Zip Code,Place Name,State,County,Lat,Long\n" << "501,Holtsville,NY,Suffolk,40.8154,-73.0451\n";
+        for (const string& record : records) {
+            file << record << "\n";
+        }
+    }
+    ZipCodeStore changedStore(fileName);
+    SecondaryIndex changedPlaces(fileName, SecondaryIndex::PLACE);
+    vector<long long> locations;
+    vector<string> read;
+    check(changedStore.open() && changedPlaces.open() && changedPlaces.lookup("agawam", locations)
+          && locations.size() == 1 && (changedStore.readLocation(locations[0], read), read.size() == 1)
+          && read[0] == records[0] && changedPlaces.termCount() == 6, "changed data file rebuilds index");
+
+    remove(fileName.c_str());
+    remove((fileName + "_index.txt").c_str());
+    remove(SecondaryIndex::indexFileName(fileName, SecondaryIndex::PLACE).c_str());
+    remove(SecondaryIndex::indexFileName(fileName, SecondaryIndex::COUNTY).c_str());
+}
+
+/// @brief An index entry past the end of the file ends a range instead of adding an empty record.
+void testUnreadableRecord() {
+    const string fileName = "cursor_test.csv";
+    const string header = "Zip Code,Place Name,State,County,Lat,Long\n";
+    const string record = "1001,Agawam,MA,Hampden,42.0702,-72.6227";
+    {
+        ofstream file(fileName);
+        file << header << record << "\n";
+    }
+    map<string, streampos> index;
+    index["1001"] = streampos(header.size());
+    index["1002"] = streampos(100000);
+    ZipCodeStore store(fileName);
+    vector<string> records;
+    string missing;
+    check(store.open(&index) && (store.range(0, 99999, records), records == vector<string>(1, record))
+          && !store.lookup(1002, missing), "unreadable record ends the cursor");
+    remove(fileName.c_str());
+}
+
+int main() {
+    testPostingsRoundTrip();
+    testTerms();
+    testLookupAgainstScan();
+    testUnreadableRecord();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file SnapshotTester.cpp
+ * @brief Tests that a Snapshot answers as its data file does, and is rebuilt when it is stale or damaged.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Writes a CSV file of random records, some sharing a ZIP code, then
+ *    checks that a Snapshot of it finds every ZIP code's first record, lists
+ *    each state's records in ZIP code order and keeps the header line. Then
+ *    it changes the data file, damages the image in several ways, and checks
+ *    that open builds it again each time and that verify catches a damaged
+ *    record. The files it writes are removed at the end.
+ * \n
+ * \n Compile from the Testing directory:
+ * \n g++ -std=c++11 -I.. -o SnapshotTester SnapshotTester.cpp ../Snapshot.cpp ../ZipCodeBuffer.cpp
+ *    ../BlockBuffer.cpp ../HeaderBuffer.cpp ../Stats.cpp ../DataFingerprint.cpp
+ */
+// ----------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "Snapshot.h"
+
+using namespace std;
+
+int failures = 0;
+
+void check(bool passed, const string& testName) {
+    if (passed) {
+        cout << "Test passed for " << testName << endl;
+    } else {
+        cout << "\nTest failed for " << testName << endl;
+        failures++;
+    }
+}
+
+const string DATA_FILE = "snapshot_test.csv";
+const string HEADER_LINE = "\"Zip Code\",\"Place Name\",State,County,Lat,Long";
+
+/// @brief Random records, out of ZIP code order, with every tenth ZIP code used twice.
+vector<string> randomRecords(mt19937& random) {
+    const vector<string> states = { "MN", "WI", "NY", "PR", "AK" };
+    vector<string> records;
+    for (int i = 0; i < 3000; i++) {
+        int zipCode = 501 + static_cast<int>(random() % 2000) * 3;
+        char coordinates[64];
+        snprintf(coordinates, sizeof(coordinates), "%.4f,%.3f", (random() % 400000) / 10000.0 + 18,
+                 -static_cast<int>(random() % 100000) / 1000.0 - 66);
+        string record = to_string(zipCode) + ",Place " + to_string(random() % 300) + ","
+                      + states[random() % states.size()] + ",County " + to_string(random() % 40) + "," + coordinates;
+        records.push_back(record);
+        if (i % 10 == 0) {
+            records.push_back(to_string(zipCode) + ",Second Place,MN,Second County,45.0000,-93.0000");
+        }
+    }
+    return records;
+}
+
+void writeDataFile(const vector<string>& records) {
+    ofstream file(DATA_FILE, ios::binary | ios::trunc);
+    file << HEADER_LINE << "\n";
+    for (const string& record : records) {
+        file << record << "\n";
+    }
+}
+
+/// @brief Overwrites bytes of the image, or truncates it to its first bytes if truncate is set.
+void damageImage(size_t offset, const string& bytes, bool truncate = false) {
+    string imageName = Snapshot::fileName(DATA_FILE);
+    fstream image(imageName, ios::binary | ios::in | ios::out);
+    string contents((istreambuf_iterator<char>(image)), istreambuf_iterator<char>());
+    image.close();
+    contents = truncate ? contents.substr(0, offset) : contents.replace(offset, bytes.size(), bytes);
+    ofstream rewritten(imageName, ios::binary | ios::trunc);
+    rewritten << contents;
+}
+
+void testLookups(const vector<string>& records) {
+    Snapshot snapshot(DATA_FILE);
+    check(snapshot.open() && snapshot.recordCount() == records.size(), "open builds image");
+    check(snapshot.headerText() == HEADER_LINE + "\n", "header line kept");
+    check(snapshot.verify(), "verify new image");
+
+    // The first record of a ZIP code in file order is the one found
+    map<int, string> firstRecords;
+    map<string, map<int, vector<string> > > stateRecords;
+    for (const string& record : records) {
+        firstRecords.insert(make_pair(atoi(record.c_str()), record));
+        string state = record.substr(record.find(',', record.find(',') + 1) + 1, 2);
+        stateRecords[state][atoi(record.c_str())].push_back(record);
+    }
+    bool allFound = true;
+    for (const auto& entry : firstRecords) {
+        string record;
+        allFound = allFound && snapshot.lookup(entry.first, record) && record == entry.second;
+    }
+    string record;
+    check(allFound && !snapshot.lookup(500, record) && !snapshot.lookup(502, record) && !snapshot.lookup(-1, record),
+          "lookups match first records");
+
+    bool statesMatch = true;
+    for (const auto& state : stateRecords) {
+        vector<string> expected;
+        for (const auto& zipCode : state.second) {
+            expected.insert(expected.end(), zipCode.second.begin(), zipCode.second.end());
+        }
+        vector<string> found;
+        statesMatch = statesMatch && snapshot.stateRecords(state.first, found) && found == expected;
+    }
+    vector<string> none;
+    check(statesMatch && !snapshot.stateRecords("ZZ", none) && none.empty(), "state records in ZIP code order");
+
+    bool inOrder = true;
+    for (size_t row = 1; row < snapshot.recordCount(); row++) {
+        inOrder = inOrder && atoi(snapshot.record(row - 1).c_str()) <= atoi(snapshot.record(row).c_str());
+    }
+    check(inOrder, "rows in ZIP code order");
+}
+
+void testRebuilds(vector<string>& records) {
+    string record;
+    {
+        // A changed data file makes the image stale
+        records.push_back("99999,Added Place,MN,Added County,44.9778,-93.265");
+        writeDataFile(records);
+        Snapshot snapshot(DATA_FILE);
+        check(snapshot.open() && snapshot.lookup(99999, record) && record == records.back(),
+              "stale image rebuilt");
+    }
+    {
+        damageImage(0, "NOTSNAP!");
+        Snapshot snapshot(DATA_FILE);
+        check(snapshot.open() && snapshot.lookup(99999, record), "bad magic rebuilt");
+    }
+    {
+        damageImage(8, "\x07");     // The version, which the header checksum covers
+        Snapshot snapshot(DATA_FILE);
+        check(snapshot.open() && snapshot.lookup(99999, record), "other version rebuilt");
+    }
+    {
+        Snapshot opened(DATA_FILE);
+        opened.open();
+        size_t imageBytes = opened.imageBytes();
+        damageImage(imageBytes / 2, "", true);
+        Snapshot snapshot(DATA_FILE);
+        check(snapshot.open() && snapshot.imageBytes() == imageBytes && snapshot.verify(), "truncated image rebuilt");
+    }
+    {
+        // A damaged record passes open's checks, but not verify
+        Snapshot opened(DATA_FILE);
+        opened.open();
+        damageImage(opened.imageBytes() - 3, "#");
+        Snapshot snapshot(DATA_FILE);
+        check(snapshot.open() && !snapshot.verify(), "verify catches damaged record");
+    }
+
+    remove(DATA_FILE.c_str());
+    Snapshot missing(DATA_FILE);
+    check(!missing.open() && missing.recordCount() == 0 && !missing.lookup(501, record), "missing data file refused");
+}
+
+int main() {
+    mt19937 random(49);
+    vector<string> records = randomRecords(random);
+    writeDataFile(records);
+    testLookups(records);
+    testRebuilds(records);
+    remove(Snapshot::fileName(DATA_FILE).c_str());
+    return failures == 0 ? 0 : 1;
+}
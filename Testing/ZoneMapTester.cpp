@@ -0,0 +1,173 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file ZoneMapTester.cpp
+ * @brief Tests that ZoneMap never skips a block holding a match, and that the zones written and built agree.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n Writes a blocked file of random records with BlockWriter, then checks
+ *    random bounding boxes and state sets: every block holding a matching
+ *    record must be a candidate, and reading only the candidates must find
+ *    as many matches as reading every block. Then it writes the blocked
+ *    file again and checks that open builds the zone map again. The files
+ *    it writes are removed at the end.
+ * \n
+ * \n Compile from the Testing directory:
+ * \n g++ -std=c++11 -I.. -o ZoneMapTester ZoneMapTester.cpp ../ZoneMap.cpp ../BlockWriter.cpp
+ *    ../BlockBuffer.cpp ../HeaderBuffer.cpp ../Stats.cpp ../DataFingerprint.cpp
+ */
+// ----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "ZoneMap.h"
+#include "BlockWriter.h"
+#include "BlockBuffer.h"
+#include "HeaderBuffer.h"
+
+using namespace std;
+
+int failures = 0;
+
+void check(bool passed, const string& testName) {
+    if (passed) {
+        cout << "Test passed for " << testName << endl;
+    } else {
+        cout << "\nTest failed for " << testName << endl;
+        failures++;
+    }
+}
+
+void testPredicate() {
+    ZoneMap::Predicate predicate;
+    check(predicate.parse("42,-72,40,-75:ny, ct") && predicate.hasBox && predicate.minLatitude == 40
+          && predicate.maxLongitude == -72 && predicate.states == vector<string>({ "CT", "NY" }), "parse box and states");
+    check(predicate.matches("501,Holtsville,NY,Suffolk,40.8154,-73.0451")
+          && !predicate.matches("501,Holtsville,MA,Suffolk,40.8154,-73.0451")
+          && !predicate.matches("501,Holtsville,NY,Suffolk,43.8154,-73.0451")
+          && !predicate.matches("501,Holtsville,NY"), "match records");
+
+    ZoneMap::Predicate statesOnly;
+    check(statesOnly.parse(":MN") && !statesOnly.hasBox && statesOnly.matches("55001,Afton,MN,Washington,44.9,-92.8"),
+          "parse states only");
+    ZoneMap::Predicate invalid;
+    check(!invalid.parse("") && !invalid.parse("1,2,3") && !invalid.parse("1,2,3,x") && !invalid.parse(":"),
+          "invalid filters rejected");
+}
+
+void testScans() {
+    const string fileName = "zone_map_test.txt";
+    const string indexName = "zone_map_test_index.txt";
+    const vector<string> states = { "CT", "MA", "MN", "NY", "WI" };
+    mt19937 random(45);
+    uniform_real_distribution<double> anyLatitude(25, 49);
+    uniform_real_distribution<double> anyLongitude(-124, -67);
+
+    // Records in ZIP code order, with states in runs as in the real data
+    {
+        BlockWriter writer(fileName, indexName, 256, 75);
+        writer.setZoneMapFileName(ZoneMap::fileName(fileName));
+        for (int zipCode = 1000; zipCode < 4000; zipCode++) {
+            string state = states[(zipCode / 300 + random() % 2) % states.size()];
+            writer.addRecord(to_string(zipCode) + ",Place,"  + state + ",County," + to_string(anyLatitude(random))
+                             + "," + to_string(anyLongitude(random)));
+        }
+        check(writer.close(), "write blocked file");
+    }
+    ZoneMap written(fileName);
+    check(written.open() && !written.getZones().empty(), "open written zone map");
+
+    // Every block's records, to check the zones against
+    map<long long, vector<string> > blocks;
+    {
+        ifstream file(fileName, ios::binary);
+        HeaderBuffer headerBuffer(fileName);
+        BlockBuffer blockBuffer(file, headerBuffer);
+        while (true) {
+            vector<string> records = blockBuffer.readNextBlock();
+            if (blockBuffer.getCurrentRBN() == -1) {
+                break;
+            }
+            blocks[blockBuffer.getCurrentRBN()] = records;
+        }
+    }
+
+    bool noMatchSkipped = true;
+    bool someSkipped = false;
+    for (int i = 0; i < 300; i++) {
+        double latitude = anyLatitude(random);
+        double longitude = anyLongitude(random);
+        string filter = to_string(latitude) + "," + to_string(longitude) + "," + to_string(latitude + 3) + ","
+                      + to_string(longitude + 5);
+        if (i % 3 == 1) {
+            filter += ":" + states[random() % states.size()];
+        } else if (i % 3 == 2) {
+            filter = ":" + states[random() % states.size()] + "," + states[random() % states.size()];
+        }
+        ZoneMap::Predicate predicate;
+        predicate.parse(filter);
+
+        size_t skipped = 0;
+        vector<long long> candidates = written.candidates(predicate, skipped);
+        size_t everyMatch = 0;
+        size_t candidateMatches = 0;
+        for (const auto& block : blocks) {
+            bool isCandidate = find(candidates.begin(), candidates.end(), block.first) != candidates.end();
+            for (const string& record : block.second) {
+                everyMatch += predicate.matches(record);
+                candidateMatches += isCandidate && predicate.matches(record);
+            }
+        }
+        noMatchSkipped = noMatchSkipped && everyMatch == candidateMatches
+                      && candidates.size() + skipped == written.getZones().size();
+        someSkipped = someSkipped || skipped > 0;
+    }
+    check(noMatchSkipped, "no block with a match skipped");
+    check(someSkipped, "blocks skipped");
+
+    // A zone map built from the blocks must be the one written with them
+    ifstream writtenFile(ZoneMap::fileName(fileName));
+    string writtenText((istreambuf_iterator<char>(writtenFile)), istreambuf_iterator<char>());
+    writtenFile.close();
+    check(ZoneMap::build(fileName), "build zone map");
+    ifstream builtFile(ZoneMap::fileName(fileName));
+    string builtText((istreambuf_iterator<char>(builtFile)), istreambuf_iterator<char>());
+    check(builtText == writtenText, "built zone map matches written");
+
+    // Written again without its zone map, the blocked file no longer matches the old one
+    {
+        BlockWriter writer(fileName, indexName, 256, 75);
+        for (int zipCode = 1000; zipCode < 1100; zipCode++) {
+            writer.addRecord(to_string(zipCode) + ",Place,MN,County,45.0,-93.0");
+        }
+        writer.close();
+    }
+    ZoneMap rewritten(fileName);
+    int recordTotal = 0;
+    bool onlyMinnesota = rewritten.open();
+    for (const ZoneMap::Zone& zone : rewritten.getZones()) {
+        recordTotal += zone.recordCount;
+        onlyMinnesota = onlyMinnesota && zone.states == vector<string>(1, "MN");
+    }
+    check(onlyMinnesota && recordTotal == 100, "changed blocked file rebuilds zone map");
+
+    remove(fileName.c_str());
+    remove(indexName.c_str());
+    remove(ZoneMap::fileName(fileName).c_str());
+}
+
+int main() {
+    testPredicate();
+    testScans();
+    return failures == 0 ? 0 : 1;
+}
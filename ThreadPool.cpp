@@ -0,0 +1,72 @@
+/// @file ThreadPool.cpp
+/// @class ThreadPool
+/// See ThreadPool.h for full documentation.
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(size_t threads) : running(0), stopping(false) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    if (threads == 0) {
+        threads = 1; // hardware_concurrency may not know
+    }
+    for (size_t i = 0; i < threads; i++) {
+        workers.push_back(std::thread(&ThreadPool::workerLoop, this));
+    }
+}
+
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskReady.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+
+/// @brief Queues a task for the next free worker.
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    taskReady.notify_one();
+}
+
+
+/// @brief Blocks until every submitted task has finished.
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    allDone.wait(lock, [this]() { return tasks.empty() && running == 0; });
+}
+
+
+/// @brief Runs queued tasks until the pool is destroyed and the queue is empty.
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskReady.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return; // Stopping, and nothing left to run
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            running++;
+        }
+
+        task();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        running--;
+        if (running == 0 && tasks.empty()) {
+            allDone.notify_all();
+        }
+    }
+}
@@ -0,0 +1,67 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file ThreadPool.h
+ * @class ThreadPool
+ * @brief A fixed number of worker threads running submitted tasks.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n The workers are started by the constructor and take tasks from one
+ *    shared queue in the order they were submitted. wait blocks until every
+ *    task submitted so far has finished, so a batch of tasks can be run and
+ *    then its results read. The destructor finishes the queued tasks and
+ *    joins the workers.
+ * \n
+ * \n Tasks must not throw. Results are passed back through whatever the
+ *    task captured, each task writing only its own slot.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    /**
+     * @brief Starts the workers.
+     * @param threads The number of workers. 0 uses the number of hardware threads.
+     */
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// @brief Queues a task for the next free worker.
+    void submit(std::function<void()> task);
+
+    /// @brief Blocks until every submitted task has finished.
+    void wait();
+
+    size_t size() const { return workers.size(); }
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()> > tasks;
+    std::mutex mutex;
+    std::condition_variable taskReady;  // Signalled when a task is queued or the pool stops
+    std::condition_variable allDone;    // Signalled when the last running task finishes
+    size_t running;                     // Tasks taken from the queue and not yet finished
+    bool stopping;
+
+    void workerLoop();
+};
+
+#endif // THREADPOOL_H
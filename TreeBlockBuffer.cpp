@@ -47,10 +47,10 @@ vector<string> TreeBlockBuffer::unpackBlockRecords() {
 /// @brief Reads the block metadata for the current block.
 void TreeBlockBuffer::readBlockMetadata() {
     int metadataRecordLength = -1;
-    int newRelativeBlockNumber = -1;
+    long long newRelativeBlockNumber = -1;
     int newNumRecordsInBlock = -1;
-    int newPrevRBN = -1;
-    int newNextRBN = -1;
+    long long newPrevRBN = -1;
+    long long newNextRBN = -1;
     
     file >> metadataRecordLength;
     file.ignore(1); // Ignore the commas separating the fields
@@ -74,22 +74,22 @@ void TreeBlockBuffer::readBlockMetadata() {
 
 
 /// @brief Calculates the address of a Relative Block Number (RBN) within the file.
-int TreeBlockBuffer::calculateBlockAddress(int relativeBlockNumber) {
-    return headerSize + relativeBlockNumber*blockSize;
+long long TreeBlockBuffer::calculateBlockAddress(long long relativeBlockNumber) {
+    return headerSize + relativeBlockNumber*static_cast<long long>(blockSize);
 }
 
 
 
 /// @brief Moves the file pointer to the address of the block at the given Relative Block Number (RBN).
-void TreeBlockBuffer::moveToBlock(int relativeBlockNumber) {
-    int address = calculateBlockAddress(relativeBlockNumber);
-    file.seekg(address);
+void TreeBlockBuffer::moveToBlock(long long relativeBlockNumber) {
+    long long address = calculateBlockAddress(relativeBlockNumber);
+    file.seekg(static_cast<std::streamoff>(address));
 }
 
 
 
 /// @brief Reads the block at the given Relative Block Number (RBN) and returns it as a vector of records in string form.
-vector<string> TreeBlockBuffer::readBlock(int relativeBlockNumber) {
+vector<string> TreeBlockBuffer::readBlock(long long relativeBlockNumber) {
     vector<string> recordStrings;
     std::string line;
 
@@ -16,10 +16,10 @@
  * \n
  * \n  Each block starts with these five metadata fields:
  * \n  -- Length of metadata record (int)
- * \n  -- Relative Block Number (int)
+ * \n  -- Relative Block Number (64-bit int)
  * \n  -- Number of records in the block (int)
- * \n  -- Previous Relative Block Number (int)
- * \n  -- Next Relative Block Number (int)
+ * \n  -- Previous Relative Block Number (64-bit int)
+ * \n  -- Next Relative Block Number (64-bit int)
  * \n
  * \n The Relative Block Number (RBN) is used to navigate the file and starts
  *    at 0 for the first block. The Previous RBN and Next RBN are used to
@@ -49,11 +49,11 @@ class TreeBlockBuffer {
 private: 
     std::ifstream &file;        // The ifstream to read blocks from.
     int numRecordsInBlock = 0;  // Number of records in the current block (read from metadata)
-    int currentRBN = 0;         // Relative Block Number (RBN) of the current block
-    int prevRBN = -1;           // RBN of the previous block in the linked list
-    int nextRBN = 0;            // RBN of the next block in the linked list 
+    long long currentRBN = 0;   // Relative Block Number (RBN) of the current block
+    long long prevRBN = -1;     // RBN of the previous block in the linked list
+    long long nextRBN = 0;      // RBN of the next block in the linked list 
     int blockSize = 512;        // Number of bytes in every block, which will be read from the metadata
-    int headerSize = 53;        // Number of bytes in the metadata header record, which will be read from the metadata
+    long long headerSize = 53;  // Number of bytes in the metadata header record, which will be read from the metadata
 
 public:
     /**
@@ -84,9 +84,9 @@ public:
     void readBlockMetadata();
 
     // Metadata getters
-    int getCurrentRBN() const { return currentRBN; }
-    int getPrevRBN() const { return prevRBN; }
-    int getNextRBN() const { return nextRBN; }
+    long long getCurrentRBN() const { return currentRBN; }
+    long long getPrevRBN() const { return prevRBN; }
+    long long getNextRBN() const { return nextRBN; }
     int getNumRecordsInBlock() const { return numRecordsInBlock; }
 
 
@@ -97,7 +97,7 @@ public:
      * @pre: The file is open and in a blocked length-indicated file format.
      * @post: The block is broken down into records and the file pointer is after the records in the block.
      */
-    vector<string> readBlock(int relativeBlockNumber);
+    vector<string> readBlock(long long relativeBlockNumber);
 
     /**
      * @brief Reads the current block after the file pointer and returns it as a vector of records in string form.
@@ -121,11 +121,11 @@ public:
 
     /**
      * @brief Calculates the address of a Relative Block Number (RBN) within the file.
-     * @return The address of the RBN.
+     * @return The address of the RBN as a 64-bit offset, so files past 2 GiB can be addressed.
      * @pre The file metadata has been read.
      * @post The calculation results have been returned.
     */
-    int calculateBlockAddress(int relativeBlockNumber);
+    long long calculateBlockAddress(long long relativeBlockNumber);
 
 
     /**
@@ -133,7 +133,7 @@ public:
      * @pre The file is open.
      * @post The file pointer is moved to the start of the block at the given RBN.
     */
-    void moveToBlock(int relativeBlockNumber);
+    void moveToBlock(long long relativeBlockNumber);
 
 };
 
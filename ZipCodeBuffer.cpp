@@ -10,6 +10,7 @@
 #include "ZipCodeBuffer.h"
 #include "BlockBuffer.h"
 #include "HeaderBuffer.h"
+#include "Stats.h"
 
 /// @brief Constructor that accepts the filename.
 ZipCodeBuffer::ZipCodeBuffer(std::ifstream &file, char fileType = 'L', HeaderBuffer headerBuffer = HeaderBuffer("us_postal_codes.txt")) : file(file),
@@ -45,6 +46,7 @@ ZipCodeBuffer::ZipCodeBuffer(std::ifstream &file, char fileType = 'L', HeaderBuf
 ZipCodeRecord ZipCodeBuffer::parseRecord(std::string recordString) {
     ZipCodeRecord record;
 
+    ZIPCODE_STAT(RECORDS_PARSED, 1);
     std::istringstream recordStream(recordString);
     std::string field;
 
@@ -79,15 +81,32 @@ ZipCodeRecord ZipCodeBuffer::parseRecord(std::string recordString) {
 /// @brief Reads the next ZIP Code record from the file.
 ZipCodeRecord ZipCodeBuffer::readNextRecord() {
     ZipCodeRecord record;
-    std::string recordString;
+    std::string recordString = readNextRecordString();
 
-    if (file.eof())
+    // If not the end of the file, read the fields in the line into the record object
+    if (recordString.empty())
     {
-        // End of file reached. Return terminal character
+        
+        // Did not read a valid record (likely due to the end of file newline), so return terminal character
         record.zipCode = "";
         return record;
     }
     
+    record = parseRecord(recordString);
+    return record;
+};
+
+
+/// @brief Reads the next record from the file without parsing it.
+std::string ZipCodeBuffer::readNextRecordString() {
+    std::string recordString;
+
+    if (file.eof())
+    {
+        // End of file reached. Return terminal string
+        return recordString;
+    }
+    
     if (fileType == 'B')
     {
         if (blockRecordsIndex >= blockRecords.size() || blockRecordsIndex == -1)
@@ -99,22 +118,23 @@ ZipCodeRecord ZipCodeBuffer::readNextRecord() {
                 recordString = blockRecords[0]; // Retrieve the first record in the block
                 blockRecordsIndex = 1;          // Skip 0 because it reads it immediately
             }
-            else
-            {
-                // Did not read a valid block (likely due to the end of file), so return terminal character
-                record.zipCode = "";
-                return record;
-            }
+            // Otherwise did not read a valid block (likely due to the end of file), so return terminal string
         }
         else
         {
             recordString = blockRecords[blockRecordsIndex++];
+            ZIPCODE_STAT(CACHE_HITS, 1); // Served from the block already in memory
         }
     }
     else if (fileType == 'C')
     {
         // If CSV, retrieve the next line in the file as the record to parse
         getline(file, recordString);
+        if (!recordString.empty() && recordString.back() == '\r')
+        {
+            recordString.pop_back(); // Files written on Windows end lines with CRLF
+        }
+        ZIPCODE_STAT(BYTES_READ, recordString.size() + 1);
     }
     else if (fileType == 'L')
     {
@@ -124,19 +144,10 @@ ZipCodeRecord ZipCodeBuffer::readNextRecord() {
         file.ignore(1);                // Skip the comma after the length field
         recordString.resize(numCharactersToRead);
         file.read(&recordString[0], numCharactersToRead);
+        ZIPCODE_STAT(BYTES_READ, file.gcount());
     }
 
-    // If not the end of the file, read the fields in the line into the record object
-    if (recordString.empty())
-    {
-        
-        // Did not read a valid record (likely due to the end of file newline), so return terminal character
-        record.zipCode = "";
-        return record;
-    }
-    
-    record = parseRecord(recordString);
-    return record;
+    return recordString;
 };
 
 /// @brief Method to get the current position in the file.
@@ -147,5 +158,6 @@ std::streampos ZipCodeBuffer::getCurrentPosition() {
 /// @brief Method to set the current position in the file to a given streampos.
 std::ifstream& ZipCodeBuffer::setCurrentPosition(std::streampos pos) {
     file.seekg(pos);
+    ZIPCODE_STAT(SEEKS, 1);
     return file;
 }
\ No newline at end of file
@@ -123,6 +123,18 @@ public:
      */
     ZipCodeRecord readNextRecord();
 
+    /**
+     * @brief Reads the next record from the file without parsing it.
+     *
+     * @pre The file is positioned at the start of a record (or block).
+     * @post The next record in the file was returned as it is stored,
+     *      without its length indicator.
+     *
+     * @return The next record string. When it reaches the end of the file,
+     *      it returns "" as a terminal string.
+     */
+    std::string readNextRecordString();
+
     /// @brief Method to get the current position in the file.
     std::streampos getCurrentPosition();
     /// @brief Method to set the current position in the file to a given streampos.
@@ -4,14 +4,22 @@
 
 #include "ZipCodeIndexer.h"
 #include "HeaderBuffer.h"
+#include "Stats.h"
+
+namespace {
+    // Starts the fingerprint line of an index file. A ZIP code never starts with '#'.
+    const std::string FINGERPRINT_PREFIX = "# Data: ";
+}
 
 /// @brief Constructor for the ZipCodeIndexer class.
 // Initializes the buffer object with the given file name
 // and sets the index file name
 /// @param fileName The name of the  file to index as a string.
 /// @param idxFileName The name of the index file to save/load as a string.
-ZipCodeIndexer::ZipCodeIndexer(std::ifstream &file, char fileType, const std::string& idxFileName, HeaderBuffer headerBuffer)
-    : buffer(file, fileType, headerBuffer), indexFileName(idxFileName) {}
+/// @param dataFileName The name of the file to index, for its fingerprint, or empty.
+ZipCodeIndexer::ZipCodeIndexer(std::ifstream &file, char fileType, const std::string& idxFileName, HeaderBuffer headerBuffer,
+                               const std::string& dataFileName)
+    : indexFileName(idxFileName), buffer(file, fileType, headerBuffer), dataFileName(dataFileName), fileType(fileType) {}
 
 /// @brief Create an index of ZIP codes to their positions in the file.
 // This function creates an index of ZIP codes to their positions in the file
@@ -21,6 +29,7 @@ void ZipCodeIndexer::createIndex() {
     std::streampos position = buffer.getCurrentPosition();
     while (!(record = buffer.readNextRecord()).zipCode.empty()) {
         index[record.zipCode] = position; // Save the position of this ZIP code in the index
+        ZIPCODE_STAT(ALLOCATIONS, 1);
         position = buffer.getCurrentPosition(); // Get the position of the next record
     }
 }
@@ -28,9 +37,15 @@ void ZipCodeIndexer::createIndex() {
 /// @brief Write the created index to a file.
 /// This function writes the created index to a file. Each line in the file contains a ZIP code and its position in the file.
 void ZipCodeIndexer::writeIndexToFile() {
+    // The fingerprint is taken before the file is written, so a change since is seen as one
+    DataFingerprint fingerprint;
+    bool fingerprinted = !dataFileName.empty() && fingerprint.read(dataFileName);
     std::ofstream outFile(indexFileName);
+    if (fingerprinted) {
+        outFile << FINGERPRINT_PREFIX << fingerprint.text() << "\n";
+    }
     for (const auto& pair : index) {
-        outFile << pair.first << " " << pair.second << "\n"; // ZIP code and position
+        outFile << pair.first << " " << static_cast<long long>(std::streamoff(pair.second)) << "\n"; // ZIP code and 64-bit position
     }
     outFile.close();
 }
@@ -42,11 +57,14 @@ void ZipCodeIndexer::loadIndexFromRAM() {
     index.clear(); // Clear any existing index
     std::ifstream inFile(indexFileName);
     std::string zip;
-    std::streampos pos;
-    int posInt;
-    while (inFile >> zip >> posInt) {
-        pos = posInt;
-        index[zip] = pos; // Load the ZIP code and its position into the index
+    long long offset; // 64-bit, so positions past 2 GiB load correctly
+    if (inFile.peek() == '#') {
+        std::getline(inFile, zip); // Skip the fingerprint
+    }
+    while (inFile >> zip >> offset) {
+        index[zip] = std::streampos(static_cast<std::streamoff>(offset)); // Load the ZIP code and its position into the index
+        ZIPCODE_STAT(INDEX_LINES_SCANNED, 1);
+        ZIPCODE_STAT(ALLOCATIONS, 1);
     }
     inFile.close();
 }
@@ -63,3 +81,66 @@ std::streampos ZipCodeIndexer::getRecordPosition(const std::string& zipCode) {
         return std::streampos(-1);  // Invalid position to indicate not found
     }
 }
+
+/// @brief Read the fingerprint line at the start of the index file.
+/// @return false if the index file is missing or was written without one.
+bool ZipCodeIndexer::readIndexFingerprint(DataFingerprint& fingerprint) const {
+    std::ifstream inFile(indexFileName);
+    std::string line;
+    if (!std::getline(inFile, line) || line.compare(0, FINGERPRINT_PREFIX.size(), FINGERPRINT_PREFIX) != 0) {
+        return false;
+    }
+    return fingerprint.parse(line.substr(FINGERPRINT_PREFIX.size()));
+}
+
+/// @brief Check the index file's fingerprint against the data file.
+/// @param sameModified Set to whether the modification time matched.
+/// @return true if the index file was created from the data file as it is now.
+bool ZipCodeIndexer::isIndexCurrent(bool& sameModified) const {
+    sameModified = false;
+    DataFingerprint recorded;
+    return !dataFileName.empty() && readIndexFingerprint(recorded) && recorded.matches(dataFileName, &sameModified);
+}
+
+/// @brief Check the index against the data file, setting the Stale Flag if it is out of date.
+/// @param headerBuffer The HeaderBuffer of the data file.
+/// @param sameModified Set to whether the modification time matched.
+/// @return true if the index file is current and the Stale Flag clear.
+bool ZipCodeIndexer::markStaleIfChanged(HeaderBuffer& headerBuffer, bool& sameModified) {
+    sameModified = false;
+    if (headerBuffer.getStaleFlag() != 0) {
+        return false;
+    }
+    if (isIndexCurrent(sameModified)) {
+        return true;
+    }
+    // Written over the old value in place, so no record moves
+    headerBuffer.setstaleFlag(1);
+    if (fileType != 'C') {
+        headerBuffer.writeStaleFlag();
+    }
+    return false;
+}
+
+/// @brief Load the index file if it is current, or else create the index and write it.
+/// @param headerBuffer The HeaderBuffer of the data file, whose Stale Flag is kept in step with the index.
+/// @return true if the index file was loaded, false if the index was created.
+bool ZipCodeIndexer::loadOrCreateIndex(HeaderBuffer& headerBuffer) {
+    bool sameModified = false;
+    if (markStaleIfChanged(headerBuffer, sameModified)) {
+        loadIndexFromRAM();
+        if (!sameModified) {
+            writeIndexToFile(); // Record the new modification time, so the next check skips the hash
+        }
+        return true;
+    }
+
+    createIndex();
+    // Cleared before the fingerprint is taken, since writing the flag changes the data file
+    headerBuffer.setstaleFlag(0);
+    if (fileType != 'C') {
+        headerBuffer.writeStaleFlag();
+    }
+    writeIndexToFile();
+    return false;
+}
\ No newline at end of file
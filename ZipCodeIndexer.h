@@ -18,6 +18,12 @@
   * saving it to a file, loading it into RAM, and retrieving the position of a
   * specific ZIP code record in the file.
   *
+  The first line of an index file written for a named data file is its
+  * fingerprint: "# Data: <bytes> <modified> <hash>", the data file's size,
+  * modification time in nanoseconds and FNV-1a hash. loadOrCreateIndex
+  * loads the index instead of creating it again while the fingerprint
+  * matches, comparing the hash only if the modification time differs.
+  *
 
   *
   Assumptions:
@@ -36,6 +42,7 @@
 #include <fstream>            ///< For file operations
 #include "ZipCodeBuffer.h"    ///< For accessing the ZipCodeBuffer class
 #include "HeaderBuffer.h"
+#include "DataFingerprint.h"
 
 /**
  * @class ZipCodeIndexer
@@ -57,6 +64,15 @@ private:
     // Instance of ZipCodeBuffer to read ZIP code records from the file.
     ZipCodeBuffer buffer;
 
+    // Name of the data file, for its fingerprint. Empty if not given.
+    std::string dataFileName;
+
+    // Type of the data file, [C]SV or [L]ength-indicated.
+    char fileType;
+
+    // Reads the fingerprint line of the index file. Returns false if it has none.
+    bool readIndexFingerprint(DataFingerprint& fingerprint) const;
+
 public:
     /**
      * @brief Constructor: initializes the ZipCodeIndexer with a file name and index file name.
@@ -65,8 +81,10 @@ public:
      * @param fileType The type of the file, [C]SV or [L]ength-indicated
      * @param idxFileName The name of the index file to save/load as a string.
      * @param headerBuffer A HeaderBuffer object for the file.
+     * @param dataFileName The name of the file to index, to record its fingerprint. Without it none is written.
      */
-    ZipCodeIndexer(std::ifstream &file, char fileType, const std::string& idxFileName, HeaderBuffer headerBuffer);
+    ZipCodeIndexer(std::ifstream &file, char fileType, const std::string& idxFileName, HeaderBuffer headerBuffer,
+                   const std::string& dataFileName = "");
 
     /**
      * @brief Method to create an index by reading the file and storing ZIP codes and their positions.
@@ -87,9 +105,45 @@ public:
      * @brief Method to load the index from a file into RAM.
      *
      * This method loads the index data from a file into RAM for quick retrieval.
+     * A fingerprint line is skipped.
      */
     void loadIndexFromRAM();
 
+    /**
+     * @brief Method to check whether the index file was created from the data file as it is now.
+     *
+     * @param sameModified Set to whether the modification time matched, so the hash was not compared.
+     * @return true if the index file has a fingerprint, and the data file has its size and either its
+     *      modification time or its hash.
+     */
+    bool isIndexCurrent(bool& sameModified) const;
+
+    /**
+     * @brief Method to check the index file against the data file, setting the Stale Flag if it is out of date.
+     *
+     * The flag is set to 1 in headerBuffer and, for length-indicated files, in place in the data
+     * file's header, so the file stays marked stale until loadOrCreateIndex creates the index again.
+     *
+     * @param headerBuffer The HeaderBuffer of the data file, read with readHeader unless it is a CSV file.
+     * @param sameModified Set to whether the modification time matched.
+     * @return true if the index file is current and the Stale Flag clear.
+     */
+    bool markStaleIfChanged(HeaderBuffer& headerBuffer, bool& sameModified);
+
+    /**
+     * @brief Method to load the index file if it is current, or else create the index and write it.
+     *
+     * A data file that changed has its Stale Flag set by markStaleIfChanged, and a flag
+     * already 1 also makes the index be created again. Once it is, the flag is cleared in
+     * headerBuffer and, for length-indicated files, in place in the data file's header,
+     * before the fingerprint is taken. No record moves, so other indexes of the file keep
+     * their offsets.
+     *
+     * @param headerBuffer The HeaderBuffer of the data file, read with readHeader unless it is a CSV file.
+     * @return true if the index file was loaded, false if the index was created.
+     */
+    bool loadOrCreateIndex(HeaderBuffer& headerBuffer);
+
     /**
      * @brief Method to get the position of a specific ZIP code record in the file.
      *
@@ -97,6 +151,13 @@ public:
      * @return The position of the ZIP code record in the file.
      */
     std::streampos getRecordPosition(const std::string& zipCode);
+
+    /**
+     * @brief Method to get the whole index, for callers that keep it in another form.
+     *
+     * @return Every ZIP code and its position in the file, in string order.
+     */
+    const std::map<std::string, std::streampos>& getIndex() const { return index; }
 };
 
 // End of the include guard.
@@ -1,12 +1,13 @@
 /// See ZipCodeRecordSearch.h for details.
 
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
 #include <string>
 #include <stdexcept>
 #include "ZipCodeBuffer.h"
 #include "ZipCodeRecordSearch.h"
-#include "ZipCodeIndexer.h"
-#include "HeaderBuffer.h"
+#include "LatencyHistogram.h"
 
 /**
  * @brief Checks to see if a given string is a number.
@@ -34,7 +35,31 @@ void displayHelp(const std::string& commandName) {
     << "Usage: " << commandName << " [options]" << std::endl
     << "-h, --help            Show help options" << std::endl
     << "-Z <zipcode>," << std::endl
-    << "--zipcode <zipcode>   Search record file for <zipcode>" << std::endl << std::endl;
+    << "--zipcode <zipcode>   Search record file for <zipcode>" << std::endl
+    << "-R<low>-<high>        Search a blocked file for every ZIP code in a range" << std::endl
+    << "-G<minLat>,<minLon>,<maxLat>,<maxLon>[:<state>[,<state>...]]" << std::endl
+    << "                      Search a blocked file for every record in a box or states, skipping blocks" << std::endl
+    << "-P <place>," << std::endl
+    << "--place <place>       Search record file for every record of a place name" << std::endl
+    << "-C <state>,<county>," << std::endl
+    << "--county <state>,<county>" << std::endl
+    << "                      Search record file for every record of a county" << std::endl
+    << "-S <state>[,<state>...]," << std::endl
+    << "--state <state>[,<state>...]" << std::endl
+    << "                      Search record file for every record of the states" << std::endl
+    << "-N <state>[,<state>...]," << std::endl
+    << "--count <state>[,<state>...]" << std::endl
+    << "                      Count the records of the states without reading them" << std::endl
+    << "-A <prefix>," << std::endl
+    << "--complete <prefix>   Complete a place name, with the ZIP codes of each" << std::endl
+    << "-F <name>," << std::endl
+    << "--fuzzy <name>        Find the place names and counties closest to a misspelled name" << std::endl
+    << "                      Blocked files take -P<place>, -C<state>,<county>, -S<states>, -N<states>, -A<prefix>" << std::endl
+    << "                      and -F<name>" << std::endl
+    << "--stats[=json]        Print I/O and parse counters at exit" << std::endl
+    << "--latency[=json]      Print lookup latency percentiles at exit" << std::endl
+    << "--serve <file> [<socket> | -]" << std::endl
+    << "                      Serve queries on a Unix socket, or stdin/stdout with -" << std::endl << std::endl;
 }
 
 /**
@@ -48,40 +73,126 @@ void defaultMessage(const std::string& commandName) {
 }
 
 /**
- * @brief Helper function to search the buffer for a given ZIP code
+ * @brief Prints a record found by a search to the console
  * 
- * @param fileName Name of the file to open.
- * @param fileType Type of the file to open to pass to the indexer for the buffer.
- * @param zip ZIP codes to search for, if any.
+ * @param record The record to print.
  */
-void searchHelper(std::string fileName, char fileType, char* zip) {
-    // Create an index and load it from the index file
-    std::ifstream file(fileName);
-    HeaderBuffer headerBuffer(fileName);
-    ZipCodeIndexer index(file, fileType, fileName + "_index.txt", headerBuffer);
-    index.loadIndexFromRAM();
+void printRecord(const ZipCodeRecord& record) {
+    std::cout << "Zip Code: " << record.zipCode << std::endl
+        << "Place Name: " << record.placeName << std::endl
+        << "State: " << record.state << std::endl
+        << "County: " << record.county << std::endl
+        << "Latitude: " << record.latitude << " Longitude: " << record.longitude
+        << std::endl << std::endl;
+}
 
-    // Get the position of the ZIP code in the file
-    std::streampos position = index.getRecordPosition(zip);
+/**
+ * @brief Looks up many ZIP codes at once on the threads of a pool
+ * 
+ * The store is opened once by the caller and shared by every thread. The ZIP
+ * codes are split into a few chunks per thread, so a thread that finishes
+ * early takes another chunk instead of waiting.
+ * 
+ * @param store The opened store to search.
+ * @param pool The threads to search on.
+ * @param zipCodes ZIP codes to search for.
+ * @return One result per ZIP code, in the same order as zipCodes.
+ */
+std::vector<LookupResult> lookupConcurrently(const ZipCodeStore& store, ThreadPool& pool, const std::vector<int>& zipCodes) {
+  std::vector<LookupResult> results(zipCodes.size());
+  size_t chunkSize = zipCodes.size() / (pool.size() * 4) + 1;
+
+  for (size_t start = 0; start < zipCodes.size(); start += chunkSize) {
+    size_t end = std::min(start + chunkSize, zipCodes.size());
+    pool.submit([&store, &zipCodes, &results, start, end]() {
+      for (size_t i = start; i < end; i++) {
+        // Time each lookup under the path of its file type
+        if (store.getFileType() == 'B') {
+          ZIPCODE_LATENCY_TIMER(BLOCK_SEARCH);
+          results[i].found = store.lookup(zipCodes[i], results[i].record);
+        }
+        else {
+          ZIPCODE_LATENCY_TIMER(SEARCH_HELPER);
+          results[i].found = store.lookup(zipCodes[i], results[i].record);
+        }
+      }
+    });
+  }
+  pool.wait();
+  return results;
+}
 
-    if (position != std::streampos(-1)) {
-        // Open the buffer and set the position
-        ZipCodeBuffer buffer(file, fileType, headerBuffer);
-        buffer.setCurrentPosition(position);
 
-        // Read the record at the specified position
-        ZipCodeRecord record = buffer.readNextRecord();
+/**
+ * @brief Finds every record with a term of a secondary index.
+ * 
+ * @param store The store of the file the index is of, already opened.
+ * @param index The secondary index, already opened.
+ * @param term A term made by SecondaryIndex::placeTerm or SecondaryIndex::countyTerm.
+ * @return The record strings with the term, sorted by ZIP code.
+ */
+std::vector<std::string> secondaryLookup(const ZipCodeStore& store, const SecondaryIndex& index, const std::string& term) {
+  std::vector<long long> locations;
+  std::vector<std::string> matches;
+  if (!index.lookup(term, locations)) {
+    return matches;
+  }
 
-        // Print the record info
-        std::cout << "Zip Code: " << record.zipCode << std::endl
-            << "Place Name: " << record.placeName << std::endl
-            << "State: " << record.state << std::endl
-            << "County: " << record.county << std::endl
-            << "Latitude: " << record.latitude << " Longitude: " << record.longitude
-            << std::endl << std::endl;
+  // A location of a blocked file is a whole block, which holds other terms too
+  std::vector<std::string> records;
+  for (long long location : locations) {
+    store.readLocation(location, records);
+  }
+  for (const std::string& record : records) {
+    if (SecondaryIndex::recordTerm(index.getField(), record) == term) {
+      matches.push_back(record);
     }
-    else {
-        // If record not found, print a message
-        std::cout << "No record of " << zip << std::endl << std::endl;
+  }
+  std::sort(matches.begin(), matches.end(), [](const std::string& a, const std::string& b) {
+    return std::atoi(a.c_str()) < std::atoi(b.c_str());
+  });
+  return matches;
+}
+
+
+/**
+ * @brief Finds every record of any of the states through the state bitmaps.
+ * 
+ * @param store The store of the file the index is of, already opened.
+ * @param index The state index, already opened.
+ * @param states State codes, in any case.
+ * @return The record strings of the states, sorted by ZIP code.
+ */
+std::vector<std::string> stateLookup(const ZipCodeStore& store, const StateIndex& index, const std::vector<std::string>& states) {
+  std::vector<std::string> records;
+  index.readRecords(store, index.anyOf(states), records);
+  std::sort(records.begin(), records.end(), [](const std::string& a, const std::string& b) {
+    return std::atoi(a.c_str()) < std::atoi(b.c_str());
+  });
+  return records;
+}
+
+
+/**
+ * @brief Finds every record of a blocked file satisfying a predicate, reading only the blocks whose zones may hold one.
+ * 
+ * @param store The store of the blocked file, already opened.
+ * @param zoneMap The zone map of the blocked file, already opened.
+ * @param predicate The bounding box and states to filter by.
+ * @param skippedBlocks Receives the number of blocks not read.
+ * @return The record strings satisfying the predicate, in sequence set order.
+ */
+std::vector<std::string> zoneScan(const ZipCodeStore& store, const ZoneMap& zoneMap, const ZoneMap::Predicate& predicate, size_t& skippedBlocks) {
+  std::vector<std::string> matches;
+  std::vector<std::string> blockRecords;
+  for (long long rbn : zoneMap.candidates(predicate, skippedBlocks)) {
+    blockRecords.clear();
+    store.readLocation(rbn, blockRecords);
+    for (const std::string& record : blockRecords) {
+      if (predicate.matches(record)) {
+        matches.push_back(record);
+      }
     }
+  }
+  return matches;
 }
@@ -59,11 +59,28 @@
 #define ZIPCODERECORDSEARCH_H
 
 #include <string>
+#include <vector>
+#include "ZipCodeBuffer.h"
+#include "ZipCodeStore.h"
+#include "ThreadPool.h"
+#include "SecondaryIndex.h"
+#include "StateIndex.h"
+#include "ZoneMap.h"
+
+/// @brief The result of one lookup done by lookupConcurrently.
+struct LookupResult {
+    bool found = false;
+    std::string record;     // The record string, if found
+};
 
 /// See ZipCodeRecordSearch.cpp for details.
 bool isNumber(const char* s);
 void displayHelp(const std::string& commandName);
 void defaultMessage(const std::string& commandName);
-void searchHelper(std::string fileName, char fileType, char* zip);
+void printRecord(const ZipCodeRecord& record);
+std::vector<LookupResult> lookupConcurrently(const ZipCodeStore& store, ThreadPool& pool, const std::vector<int>& zipCodes);
+std::vector<std::string> secondaryLookup(const ZipCodeStore& store, const SecondaryIndex& index, const std::string& term);
+std::vector<std::string> stateLookup(const ZipCodeStore& store, const StateIndex& index, const std::vector<std::string>& states);
+std::vector<std::string> zoneScan(const ZipCodeStore& store, const ZoneMap& zoneMap, const ZoneMap::Predicate& predicate, size_t& skippedBlocks);
 
 #endif
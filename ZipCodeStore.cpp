@@ -0,0 +1,313 @@
+/// @file ZipCodeStore.cpp
+/// @class ZipCodeStore
+/// See ZipCodeStore.h for full documentation.
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+#include "ZipCodeStore.h"
+#include "BlockBuffer.h"
+#include "ZipCodeIndexer.h"
+#include "SpatialOrder.h"
+#include "Stats.h"
+
+namespace {
+    /// @brief The key of a record string, the field before the first comma.
+    int recordKey(const std::string& record) {
+        return std::atoi(record.c_str());
+    }
+
+    /// @brief Bytes read at once for a C or L record, enough for any US postal code record.
+    const size_t RECORD_READ_BYTES = 256;
+}
+
+
+ZipCodeStore::ZipCodeStore(const std::string& fileName)
+    : fileName(fileName), fileType('L'), fd(-1), headerBuffer(fileName), headerSize(0), blockSize(0), zipMapped(false) {
+}
+
+
+ZipCodeStore::~ZipCodeStore() {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+
+/// @brief Opens the file and loads its header and index.
+bool ZipCodeStore::open(const std::map<std::string, std::streampos>* index) {
+    fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Error: Could not open " << fileName << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    // Find the file type the same way ZipCodeTableViewer does
+    if (fileName.find(".csv") != std::string::npos) {
+        fileType = 'C';
+    }
+    else {
+        headerBuffer.readHeader();
+        fileType = (headerBuffer.getBlockSize() == 0) ? 'L' : 'B';
+    }
+
+    if (fileType == 'B') {
+        headerSize = headerBuffer.getHeaderSizeBytes();
+        blockSize = headerBuffer.getBlockSize();
+        if (headerBuffer.getPrimaryKeyIndexFileSchema() == SpatialOrder::INDEX_SCHEMA) {
+            zipMapped = true;
+            return SpatialOrder::loadZipMap(SpatialOrder::zipMapFileName(fileName), positions);
+        }
+        blockIndex.setLayout(BlockIndex::EYTZINGER);
+        return blockIndex.load(headerBuffer.getPrimaryKeyIndexFileName());
+    }
+
+    // Load the index file, or build it if the data changed, unless given one, then keep it sorted by numeric ZIP code
+    std::ifstream indexFile(fileName, std::ios::binary);
+    ZipCodeIndexer indexer(indexFile, fileType, fileName + "_index.txt", headerBuffer, fileName);
+    if (index == nullptr) {
+        indexer.loadOrCreateIndex(headerBuffer);
+        index = &indexer.getIndex();
+    }
+    for (const auto& entry : *index) {
+        positions.push_back(std::make_pair(std::atoi(entry.first.c_str()),
+                                           static_cast<long long>(std::streamoff(entry.second))));
+    }
+    std::sort(positions.begin(), positions.end());
+    return true;
+}
+
+
+/// @brief Reads up to length bytes at an absolute position. data is shorter at the end of the file.
+bool ZipCodeStore::readAt(long long position, size_t length, std::string& data) const {
+    data.resize(length);
+    size_t total = 0;
+    while (total < length) {
+        ssize_t bytesRead = ::pread(fd, &data[total], length - total, static_cast<off_t>(position + total));
+        if (bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytesRead <= 0) {
+            break;
+        }
+        total += static_cast<size_t>(bytesRead);
+    }
+    data.resize(total);
+    ZIPCODE_STAT(BYTES_READ, total);
+    return total > 0;
+}
+
+
+/// @brief Reads a block through the sharded least recently used cache.
+std::shared_ptr<const ZipCodeStore::CachedBlock> ZipCodeStore::readBlock(long long rbn) const {
+    CacheShard& shard = cacheShards[static_cast<unsigned long long>(rbn) % CACHE_SHARDS];
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto entry = shard.entries.find(rbn);
+        if (entry != shard.entries.end()) {
+            ZIPCODE_STAT(CACHE_HITS, 1);
+            shard.order.splice(shard.order.begin(), shard.order, entry->second);
+            return entry->second->second;
+        }
+    }
+
+    // Read and parse without holding the lock. Two threads missing the same
+    // block both read it, and the second one's copy replaces the first.
+    std::string blockData;
+    if (!readAt(headerSize + rbn * static_cast<long long>(blockSize), blockSize, blockData)) {
+        return std::shared_ptr<const CachedBlock>();
+    }
+    ZIPCODE_STAT(BLOCKS_READ, 1);
+
+    std::shared_ptr<CachedBlock> block = std::make_shared<CachedBlock>();
+    BlockBuffer::BlockMetadata metadata;
+    block->records = BlockBuffer::parseBlock(blockData, metadata);
+    block->nextRBN = block->records.empty() ? -1 : metadata.nextRBN;
+    ZIPCODE_STAT(RECORDS_PARSED, block->records.size());
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto entry = shard.entries.find(rbn);
+    if (entry != shard.entries.end()) {
+        shard.order.erase(entry->second);
+    }
+    shard.order.push_front(std::make_pair(rbn, std::shared_ptr<const CachedBlock>(block)));
+    shard.entries[rbn] = shard.order.begin();
+    if (shard.order.size() > BLOCK_CACHE_CAPACITY / CACHE_SHARDS) {
+        shard.entries.erase(shard.order.back().first);
+        shard.order.pop_back();
+    }
+    return block;
+}
+
+
+/// @brief Reads the record of a C or L file at a position.
+std::string ZipCodeStore::readRecordAt(long long position) const {
+    std::string data;
+    if (!readAt(position, RECORD_READ_BYTES, data)) {
+        return "";
+    }
+
+    if (fileType == 'C') {
+        // The record is the rest of the line, which may be longer than one read
+        size_t end = data.find('\n');
+        while (end == std::string::npos) {
+            std::string more;
+            if (!readAt(position + data.size(), RECORD_READ_BYTES, more)) {
+                break;
+            }
+            data += more;
+            end = data.find('\n');
+        }
+        if (end != std::string::npos) {
+            data.resize(end);
+        }
+        if (!data.empty() && data.back() == '\r') {
+            data.pop_back(); // Files written on Windows end lines with CRLF
+        }
+        return data;
+    }
+
+    // L records are "<length>,<record>"
+    size_t comma = data.find(',');
+    if (comma == std::string::npos) {
+        return "";
+    }
+    size_t length = static_cast<size_t>(std::atoi(data.c_str()));
+    if (comma + 1 + length > data.size()) {
+        std::string more;
+        readAt(position + data.size(), comma + 1 + length - data.size(), more);
+        data += more;
+        if (comma + 1 + length > data.size()) {
+            return "";      // The file ends inside the record
+        }
+    }
+    return data.substr(comma + 1, length);
+}
+
+
+/// @brief Reads the record of an entry of positions: at a byte offset, or in a block of a ZIP map.
+std::string ZipCodeStore::readPositionRecord(const std::pair<int, long long>& position) const {
+    if (!zipMapped) {
+        return readRecordAt(position.second);
+    }
+    std::shared_ptr<const CachedBlock> block = readBlock(position.second);
+    if (block) {
+        for (const std::string& record : block->records) {
+            if (recordKey(record) == position.first) {
+                return record;
+            }
+        }
+    }
+    return "";
+}
+
+
+/// @brief Looks up one ZIP code.
+bool ZipCodeStore::lookup(int zipCode, std::string& record) const {
+    if (fileType == 'B' && !zipMapped) {
+        long long rbn = blockIndex.findBlock(zipCode);
+        if (rbn == -1) {
+            return false;
+        }
+        std::shared_ptr<const CachedBlock> block = readBlock(rbn);
+        if (!block) {
+            return false;
+        }
+        for (const std::string& candidate : block->records) {
+            if (recordKey(candidate) == zipCode) {
+                record = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    auto it = std::lower_bound(positions.begin(), positions.end(), std::make_pair(zipCode, -1LL));
+    if (it == positions.end() || it->first != zipCode) {
+        return false;
+    }
+    record = readPositionRecord(*it);
+    return !record.empty();
+}
+
+
+/// @brief Appends every record with a ZIP code from low to high to records.
+void ZipCodeStore::range(int low, int high, std::vector<std::string>& records) const {
+    if (low > high) {
+        return;
+    }
+    Cursor cursor = seek(low);
+    std::string record;
+    while (cursor.next(record) && recordKey(record) <= high) {
+        records.push_back(record);
+    }
+}
+
+
+/// @brief Appends the records at a location of a SecondaryIndex to records.
+void ZipCodeStore::readLocation(long long location, std::vector<std::string>& records) const {
+    if (fileType == 'B') {
+        std::shared_ptr<const CachedBlock> block = readBlock(location);
+        if (block) {
+            records.insert(records.end(), block->records.begin(), block->records.end());
+        }
+        return;
+    }
+
+    std::string record = readRecordAt(location);
+    if (!record.empty()) {
+        records.push_back(record);
+    }
+}
+
+
+/// @brief A cursor at the first record with a ZIP code of at least zipCode.
+ZipCodeStore::Cursor ZipCodeStore::seek(int zipCode) const {
+    Cursor cursor(*this);
+    if (fileType == 'B' && !zipMapped) {
+        long long rbn = blockIndex.findBlock(zipCode);
+        if (rbn == -1) {
+            return cursor;
+        }
+        cursor.block = readBlock(rbn);
+        if (cursor.block) {
+            const std::vector<std::string>& records = cursor.block->records;
+            while (cursor.recordIndex < records.size() && recordKey(records[cursor.recordIndex]) < zipCode) {
+                cursor.recordIndex++;
+            }
+        }
+        return cursor;
+    }
+
+    cursor.positionIndex = std::lower_bound(positions.begin(), positions.end(), std::make_pair(zipCode, -1LL))
+                         - positions.begin();
+    return cursor;
+}
+
+
+/// @brief Reads the record at the cursor and moves past it.
+bool ZipCodeStore::Cursor::next(std::string& record) {
+    if (store->fileType != 'B' || store->zipMapped) {
+        if (positionIndex >= store->positions.size()) {
+            return false;
+        }
+        record = store->readPositionRecord(store->positions[positionIndex++]);
+        return !record.empty();
+    }
+
+    // Follow the sequence set past the end of each block
+    while (block && recordIndex >= block->records.size()) {
+        block = (block->nextRBN == -1) ? std::shared_ptr<const CachedBlock>() : store->readBlock(block->nextRBN);
+        recordIndex = 0;
+    }
+    if (!block) {
+        return false;
+    }
+    record = block->records[recordIndex++];
+    return true;
+}
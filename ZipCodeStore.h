@@ -0,0 +1,159 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file ZipCodeStore.h
+ * @class ZipCodeStore
+ * @brief Read-only handle to a C, L or B file that any number of threads can share.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n ZipCodeBuffer, BlockBuffer and TreeBlockBuffer read through an
+ *    std::ifstream& and keep the current position and block as members, so
+ *    each thread needs its own stream and buffers. A ZipCodeStore is opened
+ *    once and then only read:
+ * \n  -- the header and index are loaded by open and never change afterwards
+ * \n  -- records and blocks are read with pread at absolute offsets, so
+ *       threads never share a file position
+ * \n  -- blocks of B files are kept in a least recently used cache split
+ *       into CACHE_SHARDS shards, each with its own mutex, so threads reading
+ *       different blocks rarely wait for each other. Cached blocks are held
+ *       by shared_ptr, so a block evicted while another thread reads it
+ *       stays valid until that thread is done with it
+ * \n
+ * \n lookup and range may be called from any thread once open has returned
+ *    true. For iteration, each thread makes its own Cursor, which holds only
+ *    the block or index position it is at.
+ * \n
+ * \n The index of a C or L file is created once with ZipCodeIndexer, as
+ *    ZipCodeTableViewer does, or taken from an indexer that already created
+ *    it, and kept sorted by numeric ZIP code. The
+ *    index of a B file is the block index named in its header, except for a
+ *    file in SpatialOrder, whose blocks are not in ZIP code order: its ZIP
+ *    map gives the block of every ZIP code instead, and cursors follow the
+ *    ZIP map rather than the sequence set.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef ZIPCODESTORE_H
+#define ZIPCODESTORE_H
+
+#include <ios>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "BlockIndex.h"
+#include "HeaderBuffer.h"
+
+class ZipCodeStore {
+public:
+    static const size_t BLOCK_CACHE_CAPACITY = 4096;
+    static const size_t CACHE_SHARDS = 16;
+
+    /// @brief A block's records and the next RBN of the sequence set.
+    struct CachedBlock {
+        std::vector<std::string> records;
+        long long nextRBN;
+    };
+
+    /**
+     * @brief A position in ZIP code order, owned by one thread.
+     * @details Cursors of the same store may be used on different threads at
+     *    the same time. One cursor must not be shared between threads.
+     */
+    class Cursor {
+    public:
+        /**
+         * @brief Reads the record at the cursor and moves past it.
+         * @param record Receives the record string.
+         * @return false once there are no more records, or if the next one could not be read.
+         */
+        bool next(std::string& record);
+
+    private:
+        friend class ZipCodeStore;
+        Cursor(const ZipCodeStore& store) : store(&store) {}
+
+        const ZipCodeStore* store;
+        std::shared_ptr<const CachedBlock> block;   // For B files, the block being read
+        size_t recordIndex = 0;                     // For B files, the next record in block
+        size_t positionIndex = 0;                   // For C, L and ZIP-mapped B files, the next entry of positions
+    };
+
+    /**
+     * @brief Construct a new Zip Code Store object for a data file.
+     * @param fileName The C, L or B file to read. Files ending in ".csv" are C files.
+     */
+    explicit ZipCodeStore(const std::string& fileName);
+    ~ZipCodeStore();
+
+    ZipCodeStore(const ZipCodeStore&) = delete;
+    ZipCodeStore& operator=(const ZipCodeStore&) = delete;
+
+    /**
+     * @brief Opens the file and loads its header and index.
+     * @param index For C and L files, an index already created with ZipCodeIndexer
+     *    to use instead of loading one. Without it, ZipCodeIndexer::loadOrCreateIndex
+     *    loads the index file, creating it again only if the file changed. Ignored
+     *    for B files.
+     * @return false if the file or its index could not be loaded.
+     * @post On success, the store is only read from, so it may be shared between threads.
+     */
+    bool open(const std::map<std::string, std::streampos>* index = nullptr);
+
+    /// @brief Looks up one ZIP code. Returns false if there is no record of it.
+    bool lookup(int zipCode, std::string& record) const;
+
+    /// @brief Appends every record with a ZIP code from low to high to records, in order.
+    void range(int low, int high, std::vector<std::string>& records) const;
+
+    /// @brief A cursor at the first record with a ZIP code of at least zipCode.
+    Cursor seek(int zipCode) const;
+
+    /**
+     * @brief Appends the records at a location of a SecondaryIndex to records.
+     * @param location For B files, the RBN of a block, all of whose records are appended.
+     *    For C and L files, the byte offset of one record.
+     */
+    void readLocation(long long location, std::vector<std::string>& records) const;
+
+    /// @brief Whether ZIP codes are found through a SpatialOrder ZIP map rather than the block index.
+    bool isZipMapped() const { return zipMapped; }
+
+    char getFileType() const { return fileType; }
+    const std::string& getFileName() const { return fileName; }
+    const HeaderBuffer& getHeader() const { return headerBuffer; }
+
+private:
+    /// @brief One shard of the block cache, most recently used first.
+    struct CacheShard {
+        std::mutex mutex;
+        std::list<std::pair<long long, std::shared_ptr<const CachedBlock> > > order;
+        std::unordered_map<long long, std::list<std::pair<long long, std::shared_ptr<const CachedBlock> > >::iterator> entries;
+    };
+
+    std::string fileName;
+    char fileType;
+    int fd;
+    HeaderBuffer headerBuffer;
+    long long headerSize;
+    int blockSize;
+    BlockIndex blockIndex;                              // For B files
+    std::vector<std::pair<int, long long> > positions;  // For C and L files, or the RBNs of a ZIP map, sorted by ZIP code
+    bool zipMapped;                                     // Whether positions holds the ZIP map of a B file
+    mutable CacheShard cacheShards[CACHE_SHARDS];
+
+    std::shared_ptr<const CachedBlock> readBlock(long long rbn) const;
+    std::string readRecordAt(long long position) const;
+    std::string readPositionRecord(const std::pair<int, long long>& position) const;
+    bool readAt(long long position, size_t length, std::string& data) const;
+};
+
+#endif // ZIPCODESTORE_H
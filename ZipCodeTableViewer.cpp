@@ -32,12 +32,71 @@
  * \n  -- Northernmost ZIP Code
  * \n  -- Southernmost ZIP Code
  * \n
+ * \n For blocked files, the table is computed from the ZIP code, state and
+ *    coordinate columns of a memory-mapped ColumnStore, built the first
+ *    time it is needed and whenever the file changes, instead of parsing
+ *    every record.
+ * \n
  * \n Length-indicated files also have a "Record Length" field at the start of
  *    the record.
  * \n
  * \n If the program is launched with command line arguments -Z or --Zip, it
  * \n will do a search. See ZipCodeRecordSearch.cpp and BlockSearch.cpp for
- *    details.
+ *    details. All the ZIP codes given are looked up at once on a ThreadPool
+ *    sharing one ZipCodeStore, so the index is loaded once, and the results
+ *    are printed in the order the ZIP codes were given. For C and L files,
+ *    a search of ZIP codes alone is answered from a memory-mapped Snapshot
+ *    image, built the first time it is needed and whenever the file
+ *    changes, so it starts without reading the file or building an index,
+ *    unless the header's Stale Flag is set. Loading the index sets the flag
+ *    when it finds the file changed and clears it once the index is
+ *    created again, so a file left mid-rebuild goes through the index.
+ *    Other searches load the index file, whose first line records the
+ *    size, modification time and hash of the data file it was made from,
+ *    and generate it again only when the data file has changed.
+ * \n
+ * \n For blocked files, -R<low>-<high> displays every record with a ZIP
+ *    code in the range. A range that is not two numbers with low at most
+ *    high is reported as invalid.
+ * \n
+ * \n -P <place> or --place <place> displays every record of a place name,
+ *    and -C <state>,<county> or --county <state>,<county> every record of a
+ *    county, e.g. -C MA,Hampden. Blocked files take -P<place> and
+ *    -C<state>,<county>. They read the postings of a SecondaryIndex, which
+ *    is built from the file the first time it is needed, then only the
+ *    records or blocks it lists. Names are matched ignoring case and
+ *    punctuation.
+ * \n
+ * \n -S <states> or --state <states> displays every record of a comma
+ *    separated list of state codes, e.g. -S MN,WI, and -N <states> or
+ *    --count <states> only counts them. Blocked files take -S<states> and
+ *    -N<states>. They use the bitmaps of a StateIndex, built the first time
+ *    it is needed: a count reads only the index, and a search reads only
+ *    the records or blocks of the states.
+ * \n
+ * \n -A <prefix> or --complete <prefix> lists the place names starting with
+ *    a prefix, those with the most ZIP codes first, and their ZIP codes,
+ *    from a memory-mapped PlaceTrie. Blocked files take -A<prefix>.
+ * \n
+ * \n -F <name> or --fuzzy <name> lists the place names and counties within
+ *    a few edits of a possibly misspelled name, the closest first, and
+ *    their ZIP codes, from a memory-mapped NGramIndex. Blocked files take
+ *    -F<name>.
+ * \n
+ * \n For blocked files, -G<minLat>,<minLon>,<maxLat>,<maxLon> displays every
+ *    record in a bounding box, -G:<states> every record of the states, and
+ *    -G<box>:<states> both at once, e.g. -G40,-75,42,-72:NY,CT. Only the
+ *    blocks whose ZoneMap zone could hold a match are read, and the number
+ *    of blocks skipped is printed.
+ * \n
+ * \n ZipCode.exe --serve <file> [<socket path> | -] loads the file once and
+ *    answers queries over a Unix domain socket (zipcode.sock by default) or,
+ *    with "-", over stdin and stdout. See QueryServer.h and QueryProtocol.h.
+ * \n
+ * \n With --stats, the I/O and parse counters (see Stats.h) are printed to
+ *    the error stream at exit, or written as JSON with --stats=json.
+ *    --latency and --latency=json do the same for the lookup latency
+ *    percentiles (see LatencyHistogram.h).
  * \n
  * \n  Assumptions:
  * \n  -- The file is in the same directory as the program.
@@ -54,17 +113,207 @@
 #include <vector>
 #include <set>
 #include <iomanip>
+#include <cstdlib>
+#include <stdexcept>
 #include "ZipCodeBuffer.h"
 #include "ZipCodeRecordSearch.h"
 #include "ZipCodeIndexer.h"
 #include "HeaderBuffer.h"
 #include "BlockSearch.h"
 #include "Dump.h"
+#include "Stats.h"
+#include "LatencyHistogram.h"
+#include "QueryServer.h"
+#include "QueryProtocol.h"
+#include "ZipCodeStore.h"
+#include "ThreadPool.h"
+#include "SecondaryIndex.h"
+#include "StateIndex.h"
+#include "PlaceTrie.h"
+#include "NGramIndex.h"
+#include "ColumnStore.h"
+#include "Snapshot.h"
+
+
+// How to report the counters and latencies at exit: "" for not at all, "text" or "json"
+static std::string statsFormat = "";
+static std::string latencyFormat = "";
+
+/// @brief Reports the counters and latencies to the error stream, registered with atexit when --stats or --latency is given.
+static void reportStats() {
+    if (statsFormat == "json") {
+        Stats::writeJSON(std::cerr);
+    }
+    else if (statsFormat == "text") {
+        Stats::print(std::cerr);
+    }
+
+    if (latencyFormat == "json") {
+        LatencyHistogram::writeAllJSON(std::cerr);
+    }
+    else if (latencyFormat == "text") {
+        LatencyHistogram::printAll(std::cerr);
+    }
+}
+
 
+/**
+ * @brief Finds every record of a place or county through its secondary index.
+ * @param field 'P' for a place name, 'C' for "<state>,<county>".
+ * @return false if the index could not be built or loaded.
+ */
+static bool secondaryQuery(const ZipCodeStore& store, char field, const std::string& value, std::vector<std::string>& records) {
+    SecondaryIndex index(store.getFileName(), field == 'P' ? SecondaryIndex::PLACE : SecondaryIndex::COUNTY);
+    if (!index.open()) {
+        return false;
+    }
+    size_t comma = value.find(',');
+    std::string term = (field == 'P') ? SecondaryIndex::placeTerm(value)
+                                      : SecondaryIndex::countyTerm(value.substr(0, comma), value.substr(comma + 1));
+    records = secondaryLookup(store, index, term);
+    return true;
+}
 
+/// @brief Splits a comma-separated list of state codes.
+static std::vector<std::string> stateCodes(const std::string& states) {
+    std::vector<std::string> codes;
+    std::istringstream list(states);
+    std::string code;
+    while (std::getline(list, code, ',')) {
+        codes.push_back(code);
+    }
+    return codes;
+}
+
+/**
+ * @brief Finds every record of a comma-separated list of states through the state bitmaps.
+ * @return false if the index could not be built or loaded.
+ */
+static bool stateQuery(const ZipCodeStore& store, const std::string& states, std::vector<std::string>& records) {
+    StateIndex index(store.getFileName());
+    if (!index.open()) {
+        return false;
+    }
+    records = stateLookup(store, index, stateCodes(states));
+    return true;
+}
+
+/**
+ * @brief Counts the records of a comma-separated list of states from the state bitmaps alone.
+ * @return false if the index could not be built or loaded.
+ */
+static bool stateCount(const ZipCodeStore& store, const std::string& states, size_t& count) {
+    StateIndex index(store.getFileName());
+    if (!index.open()) {
+        return false;
+    }
+    count = index.anyOf(stateCodes(states)).cardinality();
+    return true;
+}
+
+/**
+ * @brief Prints the best place name completions of a prefix, with their ZIP codes.
+ * @return false if the trie could not be built or loaded.
+ */
+static bool completeQuery(const std::string& fileName, const std::string& prefix) {
+    PlaceTrie trie(fileName);
+    if (!trie.open()) {
+        return false;
+    }
+    std::vector<PlaceTrie::Completion> completions = trie.complete(prefix, PlaceTrie::TOP_COMPLETIONS);
+    std::cout << completions.size() << " completion(s) of " << prefix << ":" << std::endl;
+    for (const PlaceTrie::Completion& completion : completions) {
+        std::cout << completion.placeName << " (" << completion.zipCodes.size() << " ZIP codes):";
+        for (int zipCode : completion.zipCodes) {
+            std::cout << " " << zipCode;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl;
+    return true;
+}
+
+/**
+ * @brief Finds every record of a blocked file in a bounding box or states, skipping blocks by their zones.
+ * @param skipped Receives the number of blocks not read.
+ * @param blocks Receives the number of data blocks.
+ * @return false if the filter could not be parsed or the zone map built or loaded.
+ */
+static bool zoneQuery(const ZipCodeStore& store, const std::string& filter, std::vector<std::string>& records,
+                      size_t& skipped, size_t& blocks) {
+    ZoneMap::Predicate predicate;
+    if (!predicate.parse(filter)) {
+        std::cerr << "Invalid filter format: " << filter << std::endl;
+        return false;
+    }
+    ZoneMap zoneMap(store.getFileName());
+    if (!zoneMap.open()) {
+        return false;
+    }
+    records = zoneScan(store, zoneMap, predicate, skipped);
+    blocks = zoneMap.getZones().size();
+    return true;
+}
+
+/**
+ * @brief Prints the place names and counties closest to a possibly misspelled name, with their ZIP codes.
+ * @return false if the index could not be built or loaded.
+ */
+static bool fuzzyQuery(const std::string& fileName, const std::string& name) {
+    NGramIndex index(fileName);
+    if (!index.open()) {
+        return false;
+    }
+    std::vector<NGramIndex::Match> matches = index.search(name, PlaceTrie::TOP_COMPLETIONS);
+    std::cout << matches.size() << " match(es) for " << name << ":" << std::endl;
+    for (const NGramIndex::Match& match : matches) {
+        std::cout << match.name << " (" << (match.field == SecondaryIndex::PLACE ? "place" : "county")
+                  << ", " << match.distance << " edit(s), " << match.zipCodes.size() << " ZIP codes):";
+        for (int zipCode : match.zipCodes) {
+            std::cout << " " << zipCode;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl;
+    return true;
+}
 
 int main(int argc, char* argv[]) {
 
+    // Take out the --stats and --latency options, so the remaining arguments are handled as before
+    std::vector<char*> arguments;
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--stats" || arg == "--stats=text" || arg == "--stats=json") {
+            statsFormat = (arg == "--stats=json") ? "json" : "text";
+        }
+        else if (arg == "--latency" || arg == "--latency=text" || arg == "--latency=json") {
+            latencyFormat = (arg == "--latency=json") ? "json" : "text";
+        }
+        else {
+            arguments.push_back(argv[i]);
+        }
+    }
+    argc = static_cast<int>(arguments.size());
+    argv = arguments.data();
+    if (!statsFormat.empty() || !latencyFormat.empty()) {
+        std::atexit(reportStats);
+    }
+
+    // Server mode loads the file once and answers queries until stopped
+    if (argc >= 3 && std::string(argv[1]) == "--serve") {
+        QueryServer server(argv[2]);
+        if (!server.load()) {
+            return 1;
+        }
+        std::string socketPath = (argc >= 4) ? argv[3] : QueryProtocol::DEFAULT_SOCKET_PATH;
+        if (socketPath == "-") {
+            server.serveStream(0, 1);
+            return 0;
+        }
+        return server.serveSocket(socketPath) ? 0 : 1;
+    }
+
     std::ifstream file;
     std::string fileName;
     char fileType = 'L'; // Default to length-indicated file type
@@ -137,58 +386,71 @@ int main(int argc, char* argv[]) {
         std::map<std::string, std::vector<double>> stateCodeToCoordinatesMap;
         std::map<std::string, std::vector<std::string>> stateCodeToZipCodesMap;
 
-        // Iterate through records until the terminal string "" is returned from the buffer
-        while (true)
-        {
-            ZipCodeRecord record = recordBuffer.readNextRecord();
-            if (record.zipCode == "") {
-                // Exit the loop if the terminal string "" was returned from the buffer
-                break;
+        // Blocked files have a ColumnStore, so only the columns the table needs are read, without parsing
+        ColumnStore columns(fileName);
+        if (fileType == 'B' && columns.open()) {
+            for (const ColumnStore::Extrema& extrema : columns.stateExtrema()) {
+                std::string stateCode = columns.stateName(extrema.state);
+                stateCodes.insert(stateCode);
+                for (uint32_t zipCode : extrema.zipCodes) {
+                    stateCodeToZipCodesMap[stateCode].push_back(std::to_string(zipCode));
+                }
             }
+        }
+        else {
+            // Iterate through records until the terminal string "" is returned from the buffer
+            while (true)
+            {
+                ZipCodeRecord record = recordBuffer.readNextRecord();
+                if (record.zipCode == "") {
+                    // Exit the loop if the terminal string "" was returned from the buffer
+                    break;
+                }
 
-            // Try to add the state initial to the set and save the boolean result of whether it succeeded
-            std::pair<std::set<std::string>::iterator, bool> result = stateCodes.insert(record.state);
+                // Try to add the state initial to the set and save the boolean result of whether it succeeded
+                std::pair<std::set<std::string>::iterator, bool> result = stateCodes.insert(record.state);
 
-            if (result.second) {
-                // The initial was not already present in the set, so add it to the maps too
+                if (result.second) {
+                    // The initial was not already present in the set, so add it to the maps too
             
-                // Create a vector with the current longitude and latitude values in all four extrema
-                std::vector<double> coordinates;
-                coordinates.push_back(record.longitude); // [0] Easternmost
-                coordinates.push_back(record.longitude); // [1] Westernmost
-                coordinates.push_back(record.latitude);  // [2] Northernmost
-                coordinates.push_back(record.latitude);  // [3] Southernmost
-                stateCodeToCoordinatesMap[record.state] = coordinates;
-
-                // Create a vector with the current ZIP code in all four extrema
-                std::vector<std::string> zipCodes;
-                zipCodes.push_back(record.zipCode); // [0] Easternmost
-                zipCodes.push_back(record.zipCode); // [1] Westernmost
-                zipCodes.push_back(record.zipCode); // [2] Northernmost
-                zipCodes.push_back(record.zipCode); // [3] Southernmost
-                stateCodeToZipCodesMap[record.state] = zipCodes;
-            }
-            else {
-                if (record.longitude < stateCodeToCoordinatesMap[record.state][0]) {
-                    // New Easternmost (least longitude)
-                    stateCodeToCoordinatesMap[record.state][0] = record.longitude;
-                    stateCodeToZipCodesMap[record.state][0] = record.zipCode;
-                }
-                else if (record.longitude > stateCodeToCoordinatesMap[record.state][1]) {
-                    // New Westernmost
-                    stateCodeToCoordinatesMap[record.state][1] = record.longitude;
-                    stateCodeToZipCodesMap[record.state][1] = record.zipCode;
-                }
+                    // Create a vector with the current longitude and latitude values in all four extrema
+                    std::vector<double> coordinates;
+                    coordinates.push_back(record.longitude); // [0] Easternmost
+                    coordinates.push_back(record.longitude); // [1] Westernmost
+                    coordinates.push_back(record.latitude);  // [2] Northernmost
+                    coordinates.push_back(record.latitude);  // [3] Southernmost
+                    stateCodeToCoordinatesMap[record.state] = coordinates;
 
-                if (record.latitude > stateCodeToCoordinatesMap[record.state][2]) {
-                    // New Northernmost (greatest latitude)
-                    stateCodeToCoordinatesMap[record.state][2] = record.latitude;
-                    stateCodeToZipCodesMap[record.state][2] = record.zipCode;
+                    // Create a vector with the current ZIP code in all four extrema
+                    std::vector<std::string> zipCodes;
+                    zipCodes.push_back(record.zipCode); // [0] Easternmost
+                    zipCodes.push_back(record.zipCode); // [1] Westernmost
+                    zipCodes.push_back(record.zipCode); // [2] Northernmost
+                    zipCodes.push_back(record.zipCode); // [3] Southernmost
+                    stateCodeToZipCodesMap[record.state] = zipCodes;
                 }
-                else if (record.latitude < stateCodeToCoordinatesMap[record.state][3]) {
-                    // New Southernmost
-                    stateCodeToCoordinatesMap[record.state][3] = record.latitude;
-                    stateCodeToZipCodesMap[record.state][3] = record.zipCode;
+                else {
+                    if (record.longitude < stateCodeToCoordinatesMap[record.state][0]) {
+                        // New Easternmost (least longitude)
+                        stateCodeToCoordinatesMap[record.state][0] = record.longitude;
+                        stateCodeToZipCodesMap[record.state][0] = record.zipCode;
+                    }
+                    else if (record.longitude > stateCodeToCoordinatesMap[record.state][1]) {
+                        // New Westernmost
+                        stateCodeToCoordinatesMap[record.state][1] = record.longitude;
+                        stateCodeToZipCodesMap[record.state][1] = record.zipCode;
+                    }
+
+                    if (record.latitude > stateCodeToCoordinatesMap[record.state][2]) {
+                        // New Northernmost (greatest latitude)
+                        stateCodeToCoordinatesMap[record.state][2] = record.latitude;
+                        stateCodeToZipCodesMap[record.state][2] = record.zipCode;
+                    }
+                    else if (record.latitude < stateCodeToCoordinatesMap[record.state][3]) {
+                        // New Southernmost
+                        stateCodeToCoordinatesMap[record.state][3] = record.latitude;
+                        stateCodeToZipCodesMap[record.state][3] = record.zipCode;
+                    }
                 }
             }
         }
@@ -222,12 +484,6 @@ int main(int argc, char* argv[]) {
         // If command line parameters were given, do a search.
 
         if (fileType != 'B') {
-            // Generate an index
-            std::ifstream searchFile(fileName);
-            ZipCodeIndexer index(searchFile, fileType, fileName + "_index.txt", headerBuffer);
-            index.createIndex();
-            index.writeIndexToFile();
-
             const std::string COMMAND_NAME = std::string(argv[0]);
             // If no flags are used, display the default message
             if (argc == 1) {
@@ -239,13 +495,41 @@ int main(int argc, char* argv[]) {
                 return 0;
             }
             else {
+                // Each query is a flag, Z, P or C, and its value, kept in argument order
+                std::vector<std::pair<char, std::string> > queries;
+                std::vector<std::string> zips;
                 std::string flag = "";
                 for (int i = 1; i < argc; i++) {
                     if (flag == "") {
                         flag = std::string(argv[i]);
                     }
                     else if ((flag == "-Z" || flag == "-z" || flag == "--zipcode") && isNumber(argv[i])) {
-                        searchHelper(fileName, fileType, argv[i]);
+                        queries.push_back(std::make_pair('Z', std::string(argv[i])));
+                        zips.push_back(argv[i]);
+                        flag = "";
+                    }
+                    else if (flag == "-P" || flag == "-p" || flag == "--place") {
+                        queries.push_back(std::make_pair('P', std::string(argv[i])));
+                        flag = "";
+                    }
+                    else if ((flag == "-C" || flag == "-c" || flag == "--county") && std::string(argv[i]).find(',') != std::string::npos) {
+                        queries.push_back(std::make_pair('C', std::string(argv[i])));
+                        flag = "";
+                    }
+                    else if (flag == "-S" || flag == "-s" || flag == "--state") {
+                        queries.push_back(std::make_pair('S', std::string(argv[i])));
+                        flag = "";
+                    }
+                    else if (flag == "-N" || flag == "-n" || flag == "--count") {
+                        queries.push_back(std::make_pair('N', std::string(argv[i])));
+                        flag = "";
+                    }
+                    else if (flag == "-A" || flag == "-a" || flag == "--complete") {
+                        queries.push_back(std::make_pair('A', std::string(argv[i])));
+                        flag = "";
+                    }
+                    else if (flag == "-F" || flag == "-f" || flag == "--fuzzy") {
+                        queries.push_back(std::make_pair('F', std::string(argv[i])));
                         flag = "";
                     }
                     else {
@@ -254,38 +538,220 @@ int main(int argc, char* argv[]) {
                         return 1;
                     }
                 }
+
+                // ZIP code queries alone are answered from the snapshot image, without reading the data file.
+                // A set Stale Flag is cleared by loading the index below, so it skips the snapshot
+                bool zipQueriesOnly = !queries.empty() && headerBuffer.getStaleFlag() == 0;
+                for (const std::pair<char, std::string>& query : queries) {
+                    zipQueriesOnly = zipQueriesOnly && query.first == 'Z';
+                }
+                Snapshot snapshot(fileName);
+                if (zipQueriesOnly && snapshot.open()) {
+                    for (const std::string& zip : zips) {
+                        std::string record;
+                        if (snapshot.lookup(std::atoi(zip.c_str()), record)) {
+                            printRecord(recordBuffer.parseRecord(record));
+                        }
+                        else {
+                            std::cout << "No record of " << zip << std::endl << std::endl;
+                        }
+                    }
+                    return 0;
+                }
+
+                // Load the index, generating it only if the file changed since it was written
+                std::ifstream searchFile(fileName);
+                ZipCodeIndexer index(searchFile, fileType, fileName + "_index.txt", headerBuffer, fileName);
+                index.loadOrCreateIndex(headerBuffer);
+
+                // Look up every ZIP code at once against the index just created, then print in argument order
+                ZipCodeStore store(fileName);
+                if (!store.open(&index.getIndex())) {
+                    return 1;
+                }
+                std::vector<int> zipCodes;
+                for (const std::string& zip : zips) {
+                    zipCodes.push_back(std::atoi(zip.c_str()));
+                }
+                ThreadPool pool;
+                std::vector<LookupResult> results = lookupConcurrently(store, pool, zipCodes);
+                size_t zipIndex = 0;
+                for (const std::pair<char, std::string>& query : queries) {
+                    if (query.first == 'Z') {
+                        const LookupResult& result = results[zipIndex++];
+                        if (result.found) {
+                            printRecord(recordBuffer.parseRecord(result.record));
+                        }
+                        else {
+                            std::cout << "No record of " << query.second << std::endl << std::endl;
+                        }
+                        continue;
+                    }
+
+                    if (query.first == 'A') {
+                        if (!completeQuery(fileName, query.second)) {
+                            return 1;
+                        }
+                        continue;
+                    }
+                    if (query.first == 'F') {
+                        if (!fuzzyQuery(fileName, query.second)) {
+                            return 1;
+                        }
+                        continue;
+                    }
+                    if (query.first == 'N') {
+                        size_t count;
+                        if (!stateCount(store, query.second, count)) {
+                            return 1;
+                        }
+                        std::cout << count << " record(s) in " << query.second << std::endl << std::endl;
+                        continue;
+                    }
+
+                    // Place and county queries read the postings of their secondary index, state queries the state bitmaps
+                    std::vector<std::string> records;
+                    if (!(query.first == 'S' ? stateQuery(store, query.second, records)
+                                             : secondaryQuery(store, query.first, query.second, records))) {
+                        return 1;
+                    }
+                    std::cout << records.size() << (query.first == 'S' ? " record(s) in " : " record(s) of ") << query.second << std::endl << std::endl;
+                    for (const std::string& record : records) {
+                        printRecord(recordBuffer.parseRecord(record));
+                    }
+                }
             }
         }
         else // else fileType == B
         {
             // Run blocked file search
 
+            // Resolve every -Z argument at once on a pool of threads sharing one
+            // loaded block index and block cache, then print in argument order
+            std::vector<int> zipCodes;
+            std::vector<int> zipArgument(argc, -1); // Index into zipCodes of each -Z argument
+            for (int i = 1; i < argc; ++i) {
+                string arg = argv[i];
+                if (arg.size() > 2 && (arg[0] == '-' && (arg[1] == 'z' || arg[1] == 'Z'))) {
+                    try {
+                        zipCodes.push_back(stoi(arg.substr(2)));
+                        zipArgument[i] = static_cast<int>(zipCodes.size()) - 1;
+                    } catch (const logic_error& e) {
+                        // Reported below, in argument order
+                    }
+                }
+            }
+            std::vector<LookupResult> results;
+            ZipCodeStore store(fileName);
+            if (!store.open()) {
+                return 1;
+            }
+            if (!zipCodes.empty()) {
+                ThreadPool pool;
+                results = lookupConcurrently(store, pool, zipCodes);
+            }
+
             for (int i = 1; i < argc; ++i) {
                 string arg = argv[i];
 
                 // Check if argument starts with -z or -Z
                 if (arg.size() > 2 && (arg[0] == '-' && (arg[1] == 'z' || arg[1] == 'Z'))) {
-                    string zipcodeStr = arg.substr(2);  // Extract the zipcode part
-                    int zipcode;
+                    if (zipArgument[i] == -1) {
+                        cerr << "Invalid zipcode format: " << arg.substr(2) << endl;
+                        continue;
+                    }
+                    int zipcode = zipCodes[zipArgument[i]];
+                    const LookupResult& result = results[zipArgument[i]];
 
+                    if (result.found) {
+                        cout << "Information for zipcode " << zipcode << ":\n";
+                        BlockSearch::displayRecord(result.record);
+                    } else {
+                        cout << "Zipcode " << zipcode << " not found." << "\n\n";
+                    }
+                } else if (arg.size() > 2 && arg[0] == '-' && (arg[1] == 'r' || arg[1] == 'R')) {
+                    // Range search, -R<low>-<high>
+                    size_t dash = arg.find('-', 2);
                     try {
-                        BlockSearch searcher;
-                        zipcode = stoi(zipcodeStr);
-                        string result = searcher.searchForRecord(zipcode);
-
-                        if (result != "-1") {
-                            cout << "Information for zipcode " << zipcode << ":\n";
-                            searcher.displayRecord(result);
-                        } else {
-                            cout << "Zipcode " << zipcode << " not found." << "\n\n";
+                        int low = stoi(arg.substr(2, dash - 2));
+                        int high = (dash == string::npos) ? low : stoi(arg.substr(dash + 1));
+                        if (low > high) {
+                            throw invalid_argument(arg);
                         }
-                    } catch (const invalid_argument& ia) {
-                        cerr << "Invalid zipcode format: " << zipcodeStr << endl;
+                        // The store follows its loaded block index, or the ZIP map of a spatially ordered file
+                        vector<string> results;
+                        {
+                            ZIPCODE_LATENCY_TIMER(RANGE_SCAN);
+                            store.range(low, high, results);
+                        }
+
+                        cout << results.size() << " zipcode(s) from " << low << " to " << high << ":\n";
+                        for (const string& result : results) {
+                            BlockSearch::displayRecord(result);
+                        }
+                    } catch (const logic_error& e) {
+                        // Not a number, too large for an int, or low above high
+                        cerr << "Invalid range format: " << arg.substr(2) << endl;
+                    }
+                } else if (arg.size() > 2 && arg[0] == '-' && toupper(arg[1]) == 'A') {
+                    // Place name completion, -A<prefix>
+                    if (!completeQuery(fileName, arg.substr(2))) {
+                        return 1;
+                    }
+                } else if (arg.size() > 2 && arg[0] == '-' && toupper(arg[1]) == 'G') {
+                    // Bounding box and state scan, -G<minLat>,<minLon>,<maxLat>,<maxLon>[:<state>[,<state>...]]
+                    vector<string> records;
+                    size_t skipped = 0;
+                    size_t blocks = 0;
+                    if (!zoneQuery(store, arg.substr(2), records, skipped, blocks)) {
+                        continue;
+                    }
+                    cout << records.size() << " record(s) in " << arg.substr(2) << ", " << skipped << " of " << blocks
+                         << " blocks skipped:\n";
+                    for (const string& record : records) {
+                        BlockSearch::displayRecord(record);
+                    }
+                } else if (arg.size() > 2 && arg[0] == '-' && toupper(arg[1]) == 'F') {
+                    // Fuzzy place and county search, -F<name>
+                    if (!fuzzyQuery(fileName, arg.substr(2))) {
+                        return 1;
+                    }
+                } else if (arg.size() > 2 && arg[0] == '-' && toupper(arg[1]) == 'N') {
+                    // State count, -N<state>[,<state>...]
+                    size_t count;
+                    if (!stateCount(store, arg.substr(2), count)) {
+                        return 1;
+                    }
+                    cout << count << " record(s) in " << arg.substr(2) << "\n\n";
+                } else if (arg.size() > 2 && arg[0] == '-' && toupper(arg[1]) == 'S') {
+                    // State search, -S<state>[,<state>...]
+                    vector<string> records;
+                    if (!stateQuery(store, arg.substr(2), records)) {
+                        return 1;
+                    }
+                    cout << records.size() << " record(s) in " << arg.substr(2) << ":\n";
+                    for (const string& record : records) {
+                        BlockSearch::displayRecord(record);
+                    }
+                } else if (arg.size() > 2 && arg[0] == '-' && (toupper(arg[1]) == 'P' || toupper(arg[1]) == 'C')) {
+                    // Place search, -P<place>, or county search, -C<state>,<county>
+                    char field = static_cast<char>(toupper(arg[1]));
+                    if (field == 'C' && arg.find(',') == string::npos) {
+                        cerr << "Invalid county format: " << arg.substr(2) << endl;
+                        continue;
+                    }
+                    vector<string> records;
+                    if (!secondaryQuery(store, field, arg.substr(2), records)) {
+                        return 1;
+                    }
+                    cout << records.size() << " record(s) of " << arg.substr(2) << ":\n";
+                    for (const string& record : records) {
+                        BlockSearch::displayRecord(record);
                     }
                 } else {
                     // Invalid argument format
                     cout << "Invalid argument: " << arg << endl;
-                    cout << "Please use the format: -z<zipcode> or -Z<zipcode>" << endl;
+                    cout << "Please use the format: -z<zipcode>, -Z<zipcode>, -P<place>, -C<state>,<county>, -S<states>, -N<states>, -A<prefix>, -F<name> or -G<box>[:<states>]" << endl;
                 }
             }
         }
@@ -0,0 +1,292 @@
+/// @file ZoneMap.cpp
+/// @class ZoneMap
+/// See ZoneMap.h for full documentation.
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "ZoneMap.h"
+#include "BlockBuffer.h"
+#include "HeaderBuffer.h"
+#include "Stats.h"
+
+namespace {
+    /// @brief Splits text into the fields between delimiters.
+    std::vector<std::string> splitFields(const std::string& text, char delimiter) {
+        std::vector<std::string> fields;
+        std::istringstream textStream(text);
+        std::string field;
+        while (std::getline(textStream, field, delimiter)) {
+            fields.push_back(field);
+        }
+        return fields;
+    }
+
+    /// @brief Parses a whole field as a number. Returns false if anything else is in it.
+    bool parseNumber(const std::string& field, double& value) {
+        char* end = nullptr;
+        value = std::strtod(field.c_str(), &end);
+        return !field.empty() && end == field.c_str() + field.size();
+    }
+
+    /// @brief A state code with spaces removed and letters made uppercase.
+    std::string stateCode(const std::string& state) {
+        std::string code;
+        for (char c : state) {
+            if (!std::isspace(static_cast<unsigned char>(c))) {
+                code += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            }
+        }
+        return code;
+    }
+}
+
+
+std::string ZoneMap::fileName(const std::string& blockedFileName) {
+    return blockedFileName + "_zone_map.idx";
+}
+
+
+bool ZoneMap::Predicate::parse(const std::string& text) {
+    size_t colon = text.find(':');
+    std::string box = text.substr(0, colon);
+    std::string stateList = (colon == std::string::npos) ? "" : text.substr(colon + 1);
+    if (box.empty() && stateList.empty()) {
+        return false;
+    }
+
+    hasBox = !box.empty();
+    if (hasBox) {
+        std::vector<std::string> corners = splitFields(box, ',');
+        double values[4];
+        if (corners.size() != 4) {
+            return false;
+        }
+        for (int i = 0; i < 4; i++) {
+            if (!parseNumber(corners[i], values[i])) {
+                return false;
+            }
+        }
+        minLatitude = std::min(values[0], values[2]);
+        maxLatitude = std::max(values[0], values[2]);
+        minLongitude = std::min(values[1], values[3]);
+        maxLongitude = std::max(values[1], values[3]);
+    }
+
+    states.clear();
+    for (const std::string& state : splitFields(stateList, ',')) {
+        if (!stateCode(state).empty()) {
+            states.push_back(stateCode(state));
+        }
+    }
+    std::sort(states.begin(), states.end());
+    states.erase(std::unique(states.begin(), states.end()), states.end());
+    return hasBox || !states.empty();
+}
+
+
+bool ZoneMap::Predicate::matches(const std::string& record) const {
+    std::vector<std::string> fields = splitFields(record, ',');
+    if (fields.size() != 6) {
+        return false;
+    }
+    if (!states.empty() && !std::binary_search(states.begin(), states.end(), stateCode(fields[2]))) {
+        return false;
+    }
+    if (hasBox) {
+        double latitude = std::atof(fields[4].c_str());
+        double longitude = std::atof(fields[5].c_str());
+        return latitude >= minLatitude && latitude <= maxLatitude
+            && longitude >= minLongitude && longitude <= maxLongitude;
+    }
+    return true;
+}
+
+
+void ZoneMap::Zone::addRecord(const std::string& record) {
+    std::vector<std::string> fields = splitFields(record, ',');
+    if (fields.size() != 6) {
+        return;
+    }
+    double latitude = std::atof(fields[4].c_str());
+    double longitude = std::atof(fields[5].c_str());
+    if (recordCount == 0) {
+        minLatitude = maxLatitude = latitude;
+        minLongitude = maxLongitude = longitude;
+    }
+    else {
+        minLatitude = std::min(minLatitude, latitude);
+        maxLatitude = std::max(maxLatitude, latitude);
+        minLongitude = std::min(minLongitude, longitude);
+        maxLongitude = std::max(maxLongitude, longitude);
+    }
+    recordCount++;
+
+    std::string code = stateCode(fields[2]);
+    auto position = std::lower_bound(states.begin(), states.end(), code);
+    if (position == states.end() || *position != code) {
+        states.insert(position, code);
+    }
+}
+
+
+bool ZoneMap::Zone::mayMatch(const Predicate& predicate) const {
+    if (recordCount == 0) {
+        return false;
+    }
+    if (predicate.hasBox && (maxLatitude < predicate.minLatitude || minLatitude > predicate.maxLatitude
+                             || maxLongitude < predicate.minLongitude || minLongitude > predicate.maxLongitude)) {
+        return false;
+    }
+    if (predicate.states.empty()) {
+        return true;
+    }
+    // Both lists are sorted, so walk them together looking for a shared state
+    auto zoneState = states.begin();
+    auto wanted = predicate.states.begin();
+    while (zoneState != states.end() && wanted != predicate.states.end()) {
+        if (*zoneState == *wanted) {
+            return true;
+        }
+        if (*zoneState < *wanted) {
+            ++zoneState;
+        }
+        else {
+            ++wanted;
+        }
+    }
+    return false;
+}
+
+
+ZoneMap::ZoneMap(const std::string& blockedFileName) : blockedFileName(blockedFileName) {
+}
+
+
+bool ZoneMap::write(const std::string& zoneMapFileName, const std::vector<Zone>& zones, const DataFingerprint& data) {
+    std::ofstream zoneFile(zoneMapFileName, std::ios::binary | std::ios::trunc);
+    zoneFile << "ZoneMap," << zones.size() << "," << data.text() << "\n" << std::setprecision(10);
+    for (const Zone& zone : zones) {
+        zoneFile << zone.rbn << "," << zone.recordCount << "," << zone.minLatitude << "," << zone.maxLatitude << ","
+                 << zone.minLongitude << "," << zone.maxLongitude << ",";
+        for (size_t i = 0; i < zone.states.size(); i++) {
+            zoneFile << (i > 0 ? "|" : "") << zone.states[i];
+        }
+        zoneFile << "\n";
+    }
+    if (!zoneFile) {
+        std::cerr << "Error: Could not write " << zoneMapFileName << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+/// @brief Follows the sequence set from its first block, summarizing every block it reads.
+bool ZoneMap::build(const std::string& blockedFileName) {
+    DataFingerprint fingerprint;
+    std::ifstream file(blockedFileName, std::ios::binary);
+    if (!file.is_open() || !fingerprint.read(blockedFileName)) {
+        std::cerr << "Error: Could not open " << blockedFileName << " to index." << std::endl;
+        return false;
+    }
+    HeaderBuffer headerBuffer(blockedFileName);
+    headerBuffer.readHeader();
+    if (headerBuffer.getBlockSize() == 0) {
+        std::cerr << "Error: " << blockedFileName << " is not a blocked file." << std::endl;
+        return false;
+    }
+
+    BlockBuffer blockBuffer(file, headerBuffer);
+    std::vector<Zone> zones;
+    // The block count bounds the walk, in case a damaged file links blocks in a cycle
+    for (long long i = 0; i < headerBuffer.getBlockCount(); i++) {
+        std::vector<std::string> records = blockBuffer.readNextBlock();
+        if (blockBuffer.getCurrentRBN() == -1) {
+            break;
+        }
+        Zone zone;
+        zone.rbn = blockBuffer.getCurrentRBN();
+        for (const std::string& record : records) {
+            zone.addRecord(record);
+        }
+        zones.push_back(zone);
+        if (blockBuffer.getNextRBN() == -1) {
+            break;
+        }
+    }
+    return write(fileName(blockedFileName), zones, fingerprint);
+}
+
+
+bool ZoneMap::open() {
+    std::string zoneMapName = fileName(blockedFileName);
+    std::ifstream zoneFile(zoneMapName, std::ios::binary);
+    std::string line;
+    std::getline(zoneFile, line);
+    std::vector<std::string> headerFields = splitFields(line, ',');
+
+    // Zones of the blocks as they were before, or from before fingerprints, are built again
+    DataFingerprint fingerprint;
+    if (headerFields.size() != 3 || !fingerprint.parse(headerFields[2]) || !fingerprint.matches(blockedFileName)) {
+        zoneFile.close();
+        if (!build(blockedFileName)) {
+            return false;
+        }
+        zoneFile.open(zoneMapName, std::ios::binary);
+        std::getline(zoneFile, line);
+        headerFields = splitFields(line, ',');
+    }
+    if (headerFields.size() != 3 || headerFields[0] != "ZoneMap") {
+        std::cerr << "Error: " << zoneMapName << " is not a zone map." << std::endl;
+        return false;
+    }
+    ZIPCODE_STAT(HEADER_PARSES, 1);
+
+    size_t zoneTotal = static_cast<size_t>(std::atoll(headerFields[1].c_str()));
+    zones.clear();
+    zones.reserve(zoneTotal);
+    for (size_t i = 0; i < zoneTotal && std::getline(zoneFile, line); i++) {
+        std::vector<std::string> fields = splitFields(line, ',');
+        if (fields.size() < 6) {
+            break;
+        }
+        Zone zone;
+        zone.rbn = std::atoll(fields[0].c_str());
+        zone.recordCount = std::atoi(fields[1].c_str());
+        zone.minLatitude = std::atof(fields[2].c_str());
+        zone.maxLatitude = std::atof(fields[3].c_str());
+        zone.minLongitude = std::atof(fields[4].c_str());
+        zone.maxLongitude = std::atof(fields[5].c_str());
+        if (fields.size() > 6) {
+            zone.states = splitFields(fields[6], '|');
+        }
+        zones.push_back(zone);
+        ZIPCODE_STAT(INDEX_LINES_SCANNED, 1);
+    }
+    if (zones.size() != zoneTotal) {
+        std::cerr << "Error: " << zoneMapName << " ends before its last zone." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+std::vector<long long> ZoneMap::candidates(const Predicate& predicate, size_t& skipped) const {
+    std::vector<long long> rbns;
+    skipped = 0;
+    for (const Zone& zone : zones) {
+        if (zone.mayMatch(predicate)) {
+            rbns.push_back(zone.rbn);
+        }
+        else {
+            skipped++;
+        }
+    }
+    ZIPCODE_STAT(BLOCKS_SKIPPED, skipped);
+    return rbns;
+}
@@ -0,0 +1,124 @@
+// ----------------------------------------------------------------------------
+/**
+ * @file ZoneMap.h
+ * @class ZoneMap
+ * @brief Per-block latitude, longitude and state summaries of a blocked file, for skipping blocks in filtered scans.
+ * @author Kent Biernath
+ * @date 2026-10-19
+ * @version 1.0
+ */
+// ----------------------------------------------------------------------------
+/**
+ * @details
+ * \n The metadata of a block only says where it is and how many records it
+ *    holds, so a scan for the records in a bounding box or a set of states
+ *    must read every block. A Zone adds, for one block, the least and
+ *    greatest latitude and longitude of its records and the distinct state
+ *    codes among them. A block whose zone cannot satisfy a Predicate holds
+ *    no record that can, so candidates lists only the blocks worth reading
+ *    and counts the rest as skipped.
+ * \n
+ * \n The zones of a blocked file are kept beside its block index, in the
+ *    text file named by fileName, rather than in the blocks themselves, so
+ *    a scan reads them without reading any block and the block layout read
+ *    by BlockBuffer is unchanged. The file is a "ZoneMap,<zones>,<data>"
+ *    line, data being the DataFingerprint of the blocked file, then one
+ *    "RBN,Records,MinLat,MaxLat,MinLon,MaxLon,States" line per data block
+ *    in sequence set order, the states joined with '|'.
+ * \n
+ * \n BlockWriter writes the zone map of a blocked file once it has written
+ *    the blocks when given its name, as BlockGenerator does, and open builds
+ *    it from the blocks when it does not exist or the blocked file no longer
+ *    matches its fingerprint.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef ZONEMAP_H
+#define ZONEMAP_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "DataFingerprint.h"
+
+class ZoneMap {
+public:
+    /// @brief A filter on records. Records must satisfy every part that is set.
+    struct Predicate {
+        bool hasBox = false;                // Whether the bounding box below applies
+        double minLatitude = 0;
+        double maxLatitude = 0;
+        double minLongitude = 0;
+        double maxLongitude = 0;
+        std::vector<std::string> states;    // Uppercase state codes, or empty for any state
+
+        /**
+         * @brief Parses "<minLat>,<minLon>,<maxLat>,<maxLon>", ":<states>" or both, as in "40,-75,42,-72:NY,CT".
+         * @return false if the text is neither. Corners may be given in either order.
+         */
+        bool parse(const std::string& text);
+
+        /// @brief Whether a record string satisfies the predicate. Records without six fields never do.
+        bool matches(const std::string& record) const;
+    };
+
+    /// @brief The summary of one block.
+    struct Zone {
+        long long rbn = -1;
+        int recordCount = 0;
+        double minLatitude = 0;
+        double maxLatitude = 0;
+        double minLongitude = 0;
+        double maxLongitude = 0;
+        std::vector<std::string> states;    // Distinct, sorted
+
+        /// @brief Widens the zone to cover a record string. Records without six fields are ignored.
+        void addRecord(const std::string& record);
+
+        /// @brief Whether any record of the block could satisfy the predicate.
+        bool mayMatch(const Predicate& predicate) const;
+    };
+
+    /**
+     * @brief Construct a new Zone Map object for a blocked file.
+     * @param blockedFileName The B file the zones are of.
+     */
+    explicit ZoneMap(const std::string& blockedFileName);
+
+    /**
+     * @brief Reads every block of a blocked file once and writes its zone map.
+     * @return false if the blocked file could not be read or the zone map written.
+     */
+    static bool build(const std::string& blockedFileName);
+
+    /**
+     * @brief Writes zones to a zone map file. Returns false if it could not be written.
+     * @param data The fingerprint of the blocked file the zones are of, as it was when they were read.
+     */
+    static bool write(const std::string& zoneMapFileName, const std::vector<Zone>& zones, const DataFingerprint& data);
+
+    /**
+     * @brief Loads the zone map, building it first if it does not exist or its blocked file has changed.
+     * @return false if the zone map could not be built or loaded.
+     */
+    bool open();
+
+    /**
+     * @brief The blocks that may hold records satisfying a predicate.
+     * @param predicate The filter of the scan.
+     * @param skipped Receives the number of blocks that cannot, which need not be read.
+     * @return The RBNs of the other blocks, in sequence set order.
+     */
+    std::vector<long long> candidates(const Predicate& predicate, size_t& skipped) const;
+
+    const std::vector<Zone>& getZones() const { return zones; }
+
+    /// @brief The zone map file of a blocked file.
+    static std::string fileName(const std::string& blockedFileName);
+
+private:
+    std::string blockedFileName;
+    std::vector<Zone> zones;    // In sequence set order
+};
+
+#endif // ZONEMAP_H
@@ -4,7 +4,7 @@
  * @brief This class creates an index file for a blocked data file. 
  * @author Andrew Clayton
  * @date 11/13/2023
- * @version 1.4
+ * @version 2.0
  */
 // ----------------------------------------------------------------------------
 /**
@@ -13,98 +13,66 @@
  * The index file consists of pairs of block number, and the greatest key (zipcode) value in the block. 
  * The index file is sorted by block number.
  * 
+ * The blocks are read with a BlockBuffer, so the block size comes from the header of the blocked file.
+ * 
+ * Usage: block_idx_gen [blocked file] [index file]
+ * 
  */
 // ----------------------------------------------------------------------------
 
 #include <iostream>
 #include <fstream>
 #include <string>
-#include <algorithm>
+#include <vector>
 #include "HeaderBuffer.h"
+#include "BlockBuffer.h"
 
 using namespace std;
 
 int findZipcode(const string& record) {
+    // The records returned by the BlockBuffer no longer have their length indicator,
+    // so the zipcode is the first field
     size_t firstComma = record.find(',');
-    size_t secondComma = record.find(',', firstComma + 1);
-    if (firstComma == string::npos || secondComma == string::npos) {
+    if (firstComma == string::npos) {
         cerr << "Error parsing record for zipcode: " << record << "\n";
         return -1;
     }
-    return stoi(record.substr(firstComma + 1, secondComma - firstComma - 1));
+    return stoi(record.substr(0, firstComma));
 }
 
 
-int main() {
-
-    // We need to first read and write the header of the file
-    /* HeaderBuffer header = HeaderBuffer("blocked_postal_codes.txt");
-    header.readHeader();
-    header.writeHeaderToFile("blocked_Index.txt"); */          // The blocked index file actually does not include any metadata
-
+int main(int argc, char* argv[]) {
+    string dataFileName = (argc > 1) ? argv[1] : "us_postal_codes_blocked.txt";
+    string indexFileName = (argc > 2) ? argv[2] : "blocked_Index.txt";
 
     ofstream writeFile;
-    writeFile.open("blocked_Index.txt");
+    writeFile.open(indexFileName);
     if (!writeFile.is_open()) {
-        cerr << "Error: Could not open file 'blocked_Index.txt' for writing.\n";
+        cerr << "Error: Could not open file '" << indexFileName << "' for writing.\n";
         return 1;
     }
     
-    ifstream readFile("us_postal_codes_blocked.txt");
+    ifstream readFile(dataFileName, ios::binary);
     if (!readFile.is_open()) {
-        cerr << "Error: Could not open file 'us_postal_codes_blocked.txt' for reading.\n";
+        cerr << "Error: Could not open file '" << dataFileName << "' for reading.\n";
         return 1;
     }
 
-    // We need to skip past the metadata, up to the "Data: line"
-    string line;
-    while (getline(readFile, line)) {
-        if (line == "Data:") {
-            break;
-        }
-    }
-
-    int blockNumber = 0;
-    int maxZipcode = 0;
-    string currentBlock;
-
-    while (getline(readFile, currentBlock)) {
-        // for each line, we have to skip the metadata!  
-        int start = stoi(currentBlock.substr(0, 2));
-        size_t endOfBlock = currentBlock.find('~'); // Assuming '~' is the padding character
+    // The BlockBuffer reads the block size and the first RBN from the header
+    BlockBuffer blockBuffer(readFile, HeaderBuffer(dataFileName));
 
-        maxZipcode = 0;
-
-        // Put all the records into a vector
-        vector<string> records;
-
-        while (start < endOfBlock) {
-            size_t recordLength;
-            try {
-                recordLength = stoi(currentBlock.substr(start, 2)) + 3; // plus three since `LI,` does not include itself
-            } catch (const std::invalid_argument& ia) {
-                cerr << "Invalid argument: " << ia.what() << " for record length at block " << blockNumber << "\n";
-                return 1;
-            }
-            
-            // Traversing record by record
-            string currentRecord = currentBlock.substr(start, recordLength);
-            records.push_back(currentRecord);
-            // Checking the zipcode of each individual record
-
-
-            start += recordLength;
+    // Follow the sequence set in logical order and record the greatest key in each block
+    while (true) {
+        vector<string> records = blockBuffer.readNextBlock();
+        if (records.empty()) {
+            break;
         }
 
-        maxZipcode = findZipcode(records.back());
-
-        writeFile << blockNumber << "," << maxZipcode << "\n";
-
-        blockNumber++;
-        // maxZipcode = 0;
+        int maxZipcode = findZipcode(records.back());
+        writeFile << blockBuffer.getCurrentRBN() << "," << maxZipcode << "\n";
     }
 
     readFile.close();
     writeFile.close();
     return 0;
-}
\ No newline at end of file
+}